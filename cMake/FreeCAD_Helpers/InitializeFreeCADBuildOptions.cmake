@@ -137,6 +137,7 @@ macro(InitializeFreeCADBuildOptions)
     option(BUILD_VR "Build the FreeCAD Oculus Rift support (need Oculus SDK 4.x or higher)" OFF)
     option(BUILD_CLOUD "Build the FreeCAD cloud module" OFF)
     option(ENABLE_DEVELOPER_TESTS "Build the FreeCAD unit tests suit" ON)
+    option(FREECAD_BUILD_BENCHMARKS "Build the FreeCAD benchmarks (requires ENABLE_DEVELOPER_TESTS)" OFF)
 
     if(MSVC)
         set(FREECAD_3CONNEXION_SUPPORT "NavLib" CACHE STRING "Select version of the 3Dconnexion device integration")
@@ -77,6 +77,7 @@ macro(PrintFinalReport)
     value(CMAKE_CXX_FLAGS)
     value(CMAKE_BUILD_TYPE)
     value(ENABLE_DEVELOPER_TESTS)
+    value(FREECAD_BUILD_BENCHMARKS)
     value(FREECAD_USE_FREETYPE)
     value(FREECAD_USE_EXTERNAL_SMESH)
     value(BUILD_SMESH)
@@ -75,17 +75,21 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #endif //USE_OLD_DAG
 
 #include <boost/regex.hpp>
+#include <limits>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
 
 #include <QCryptographicHash>
 #include <QCoreApplication>
+#include <QtConcurrentMap>
 
 #include <App/DocumentPy.h>
+#include <Base/BinaryXML.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
 #include <Base/TimeInfo.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -499,6 +503,7 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        _checkUndoMemSize();
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -690,12 +695,64 @@ int Document::getUndoMode() const
 
 unsigned int Document::getUndoMemSize () const
 {
-    return d->UndoMemSize;
+    std::size_t size = 0;
+    for (auto transaction : mUndoTransactions)
+        size += transaction->getMemUsage();
+    for (auto transaction : mRedoTransactions)
+        size += transaction->getMemUsage();
+    return static_cast<unsigned int>(
+            std::min<std::size_t>(size, std::numeric_limits<unsigned int>::max()));
 }
 
 void Document::setUndoLimit(unsigned int UndoMemSize)
 {
     d->UndoMemSize = UndoMemSize;
+    _checkUndoMemSize();
+}
+
+unsigned int Document::getUndoLimit() const
+{
+    return d->UndoMemSize;
+}
+
+void Document::_checkUndoMemSize()
+{
+    if (!d->UndoMemSize || mUndoTransactions.size() < 2)
+        return;
+
+    auto memSize = [this]() {
+        std::size_t size = 0;
+        for (auto transaction : mUndoTransactions)
+            size += transaction->getMemUsage();
+        return size;
+    };
+    std::size_t size = memSize();
+    if (size <= d->UndoMemSize)
+        return;
+
+    Base::TimeElapsed start;
+    std::size_t oldSize = size;
+
+    // Leave the latest transaction alone as it is the most likely one to be
+    // undone. Start with the oldest one, first compress, then spill to files.
+    auto last = std::prev(mUndoTransactions.end());
+    for (auto it = mUndoTransactions.begin(); it != last && size > d->UndoMemSize; ++it) {
+        (*it)->compress();
+        size = memSize();
+    }
+    for (auto it = mUndoTransactions.begin(); it != last && size > d->UndoMemSize; ++it) {
+        (*it)->spill();
+        size = memSize();
+    }
+    while (size > d->UndoMemSize && mUndoTransactions.size() > 1) {
+        mUndoMap.erase(mUndoTransactions.front()->getID());
+        delete mUndoTransactions.front();
+        mUndoTransactions.pop_front();
+        size = memSize();
+    }
+
+    FC_LOG("undo memory of " << getName() << " reduced from " << oldSize << " to "
+            << size << " bytes in " << Base::TimeElapsed::diffTimeF(start) << " s");
 }
 
 void Document::setMaxUndoStackSize(unsigned int UndoMaxStackSize)
@@ -1962,6 +2019,10 @@ bool Document::saveToFile(const char* filename) const
     Base::FileInfo tmp(fn);
 
 
+    // Document.xml is kept to also store it in binary form, see Base::BinaryXML
+    bool saveBinary = hGrp->GetBool("SaveBinaryDocument", false);
+    std::stringbuf xml;
+
     // open extra scope to close ZipWriter properly
     {
         Base::ofstream file(tmp, std::ios::out | std::ios::binary);
@@ -1972,11 +2033,21 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        // Compression level per file extension, e.g. 0 to store already compressed files
+        for (const auto& it : hGrp->GetGroup("CompressionLevels")->GetIntMap()) {
+            writer.setLevel(it.first,
+                            Base::clamp<int>(it.second, Z_NO_COMPRESSION, Z_BEST_COMPRESSION));
+        }
+        writer.setConcurrent(hGrp->GetBool("ParallelSave", false));
         writer.putNextEntry("Document.xml");
 
         if (hGrp->GetBool("SaveBinaryBrep", false))
             writer.setMode("BinaryBrep");
 
+        std::streambuf* zipbuf = nullptr;
+        if (saveBinary)
+            zipbuf = writer.Stream().rdbuf(&xml);
+
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
                         << "<!--" << endl
                         << " FreeCAD Document, see https://www.freecad.org for more information..." << endl
@@ -1986,9 +2057,30 @@ bool Document::saveToFile(const char* filename) const
         // Special handling for Gui document.
         signalSaveDocument(writer);
 
+        if (saveBinary) {
+            writer.Stream().rdbuf(zipbuf);
+            std::string data = xml.str();
+            writer.Stream() << data;
+            writer.putNextEntry("Document.fcbx");
+            writer.Stream() << Base::BinaryXML::fromXML(data);
+        }
+
         // write additional files
         writer.writeFiles();
 
+        if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG)) {
+            // report the most expensive files first
+            auto times = writer.getFileTimes();
+            std::stable_sort(times.begin(), times.end(), [](const auto& a, const auto& b) {
+                return a.Time > b.Time;
+            });
+            for (const auto& it : times) {
+                auto prop = dynamic_cast<const Property*>(it.Object);
+                FC_LOG("save " << (prop ? prop->getFullName() : it.FileName)
+                        << " (" << it.FileName << "): " << it.Time << " s");
+            }
+        }
+
         if (writer.hasErrors()) {
             throw Base::FileException("Failed to write all data to file", tmp);
         }
@@ -2032,6 +2124,36 @@ bool Document::isAnyRestoring() {
     return globalIsRestoring;
 }
 
+// Returns the binary form of Document.xml if the project file has an up-to-date one
+static std::shared_ptr<const Base::BinaryXML> getBinaryDocument(const char *filename)
+{
+    try {
+        zipios::ZipFile project(filename);
+        auto xml = project.getEntry("Document.xml");
+        auto entry = project.getEntry("Document.fcbx");
+        if (!xml || !entry)
+            return {};
+        // The entry is deflated like all others, so it's inflated into memory
+        // once instead of being mapped
+        std::unique_ptr<std::istream> str(project.getInputStream(entry));
+        if (!str)
+            return {};
+        std::string data {std::istreambuf_iterator<char>(*str), {}};
+        auto binary = Base::BinaryXML::fromBuffer(std::move(data));
+        // Document.xml may have been changed by another application
+        if (binary->getSourceCrc() == static_cast<std::uint32_t>(xml->getCrc()))
+            return binary;
+        FC_WARN("Ignore outdated Document.fcbx of " << filename);
+    }
+    catch (const Base::Exception &e) {
+        FC_WARN("Failed to read Document.fcbx of " << filename << ": " << e.what());
+    }
+    catch (const std::exception &e) {
+        FC_WARN("Failed to read Document.fcbx of " << filename << ": " << e.what());
+    }
+    return {};
+}
+
 // Open the document
 void Document::restore (const char *filename,
         bool delaySignal, const std::vector<std::string> &objNames)
@@ -2073,12 +2195,28 @@ void Document::restore (const char *filename,
     if (size < 22) // an empty zip archive has 22 bytes
         throw Base::FileException("Invalid project file",filename);
 
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    std::shared_ptr<const Base::BinaryXML> binary;
+    if (hGrp->GetBool("ReadBinaryDocument", true))
+        binary = getBinaryDocument(filename);
+
+    // With the binary document the Document.xml entry is skipped by readFiles()
     zipios::ZipInputStream zipstream(file);
-    Base::XMLReader reader(filename, zipstream);
+    std::unique_ptr<Base::XMLReader> xmlReader;
+    if (binary)
+        xmlReader = std::make_unique<Base::XMLReader>(filename, binary);
+    else
+        xmlReader = std::make_unique<Base::XMLReader>(filename, zipstream);
+    Base::XMLReader &reader = *xmlReader;
 
     if (!reader.isValid())
         throw Base::FileException("Error reading compression file",filename);
 
+    reader.setConcurrentRead(hGrp->GetBool("ParallelRestore", false));
+    // Keep shape and mesh data compressed until first access
+    reader.setDeferredRestore(hGrp->GetBool("DeferredRestore", false));
+
     GetApplication().signalStartRestoreDocument(*this);
     setStatus(Document::Restoring, true);
 
@@ -2831,6 +2969,33 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
             "User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute",true);
 
+    // In parallel mode the objects that support it have their
+    // executeConcurrent() called in batches. An object can join a batch as
+    // soon as the loop below has passed all of its dependencies, so that the
+    // objects are still recomputed and signaled in topological order.
+    bool parallel = hGrp->GetBool("ParallelRecompute",false);
+    std::unordered_map<App::DocumentObject*, size_t> positions;
+    std::vector<std::vector<App::DocumentObject*>> readyAt;
+    if (parallel) {
+        for (size_t i = 0; i < topoSortedObjects.size(); ++i)
+            positions[topoSortedObjects[i]] = i;
+        readyAt.resize(topoSortedObjects.size() + 1);
+        for (auto obj : topoSortedObjects) {
+            if (!obj->canExecuteConcurrently())
+                continue;
+            size_t ready = 0;
+            for (auto dep : obj->getOutList()) {
+                auto it = positions.find(dep);
+                if (it != positions.end())
+                    ready = std::max(ready, it->second + 1);
+            }
+            readyAt[ready].push_back(obj);
+        }
+    }
+    std::set<App::DocumentObject *> prepared;
+    std::vector<App::DocumentObject *> pending;
+    size_t readyIdx = 0;
+
     std::set<App::DocumentObject *> filter;
     size_t idx = 0;
 
@@ -2844,16 +3009,39 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
                 seq = std::make_unique<Base::SequencerLauncher>("Recompute...", topoSortedObjects.size());
             }
             FC_LOG("Recompute pass " << passes);
+            prepared.clear();
+            pending.clear();
+            readyIdx = 0;
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
+                if (parallel) {
+                    for (; readyIdx <= idx; ++readyIdx)
+                        pending.insert(pending.end(), readyAt[readyIdx].begin(), readyAt[readyIdx].end());
+                }
                 if(!obj->isAttachedToDocument() || filter.find(obj)!=filter.end())
                     continue;
+                if (parallel && !prepared.count(obj) && obj->canExecuteConcurrently()
+                        && obj->mustRecompute()) {
+                    // drop the objects already passed, then collect those
+                    // whose dependencies are all recomputed
+                    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                            [&](App::DocumentObject *o) {
+                                return positions[o] < idx || prepared.count(o) || filter.count(o);
+                            }), pending.end());
+                    std::vector<App::DocumentObject*> batch;
+                    for (auto o : pending) {
+                        if (o->isAttachedToDocument() && o->mustRecompute())
+                            batch.push_back(o);
+                    }
+                    if (batch.size() > 1)
+                        _prepareConcurrentRecompute(batch, prepared);
+                }
                 // ask the object if it should be recomputed
                 bool doRecompute = false;
                 if (obj->mustRecompute()) {
                     doRecompute = true;
                     ++objectCount;
-                    int res = _recomputeFeature(obj);
+                    int res = _recomputeFeature(obj, prepared.erase(obj) > 0);
                     if(res) {
                         if(hasError)
                             *hasError = true;
@@ -3117,14 +3305,65 @@ const char * Document::getErrorDescription(const App::DocumentObject*Obj) const
     return d->findRecomputeLog(Obj);
 }
 
+void Document::_prepareConcurrentRecompute(const std::vector<DocumentObject*> &objs,
+                                           std::set<DocumentObject*> &prepared)
+{
+    FC_TIME_INIT(t);
+
+    // The input expressions may involve Python, so evaluate them here in the
+    // calling thread. Objects with failing expressions are left to
+    // _recomputeFeature() for error reporting.
+    std::vector<DocumentObject*> batch;
+    batch.reserve(objs.size());
+    for (auto obj : objs) {
+        DocumentObjectExecReturn *ret = nullptr;
+        try {
+            ret = obj->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        }
+        catch (Base::AbortException &) {
+            throw;
+        }
+        catch (...) {
+            continue;
+        }
+        if (ret != DocumentObject::StdReturn) {
+            delete ret;
+            continue;
+        }
+        batch.push_back(obj);
+        prepared.insert(obj);
+    }
+
+    {
+        // let executeConcurrent() acquire the GIL in case it's needed anyway
+        std::unique_ptr<Base::PyGILStateRelease> release;
+        if (PyGILState_Check())
+            release = std::make_unique<Base::PyGILStateRelease>();
+
+        QtConcurrent::blockingMap(batch, [](DocumentObject *obj) {
+            try {
+                obj->executeConcurrent();
+            }
+            catch (...) {
+                // execute() will compute (and report) it again
+            }
+        });
+    }
+
+    FC_TIME_LOG(t, "Concurrent recompute of " << batch.size() << " objects");
+}
+
 // call the recompute of the Feature and handle the exceptions and errors.
-int Document::_recomputeFeature(DocumentObject* Feat)
+int Document::_recomputeFeature(DocumentObject* Feat, bool prepared)
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
-    DocumentObjectExecReturn  *returnCode = nullptr;
+    DocumentObjectExecReturn  *returnCode = DocumentObject::StdReturn;
     try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        if (!prepared) {
+            returnCode =
+                Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        }
         if (returnCode == DocumentObject::StdReturn) {
             returnCode = Feat->recompute();
             if(returnCode == DocumentObject::StdReturn)
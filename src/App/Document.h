@@ -403,8 +403,15 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /** Set the Undo limit in Byte!
+     *
+     * If exceeded on committing a transaction, the property values stored in
+     * older transactions are compressed, then moved to temporary files, and
+     * finally the oldest transactions are removed. Zero means no limit.
+     */
     void setUndoLimit(unsigned int UndoMemSize=0);
+    /// Returns the Undo limit in Byte
+    unsigned int getUndoLimit() const;
     /// Returns the actual memory consumption of the Undo redo stuff.
     unsigned int getUndoMemSize () const;
     /// Set the Undo limit as stack size
@@ -563,8 +570,14 @@ protected:
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject *Who, const Property *What);
     /// helper which Recompute only this feature
+    /// @param prepared: true if the non-output expressions are already
+    /// evaluated by _prepareConcurrentRecompute()
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
-    int _recomputeFeature(DocumentObject* Feat);
+    int _recomputeFeature(DocumentObject* Feat, bool prepared=false);
+    /// helper which runs DocumentObject::executeConcurrent() of a batch of
+    /// independent objects in the global thread pool
+    void _prepareConcurrentRecompute(const std::vector<DocumentObject*> &objs,
+                                     std::set<DocumentObject*> &prepared);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -588,6 +601,8 @@ protected:
     void _commitTransaction(bool notify=false);
     /// Internally called by App::Application to abort the running transaction.
     void _abortTransaction();
+    /// Reduce the memory of the Undo stack to the limit, see setUndoLimit()
+    void _checkUndoMemSize();
 
 private:
     // # Data Member of the document +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
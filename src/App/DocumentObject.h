@@ -601,6 +601,25 @@ protected:
       */
     virtual App::DocumentObjectExecReturn *execute();
 
+    /** Whether this object supports concurrent recompute
+     * If true, the document may call executeConcurrent() from a worker
+     * thread before calling execute() on the main thread. Objects that
+     * touch Python or any shared state must return false (the default).
+     * @sa executeConcurrent()
+     */
+    virtual bool canExecuteConcurrently() const {return false;}
+
+    /** Compute the expensive part of execute() in a worker thread
+     * It is only called if canExecuteConcurrently() returns true, and only
+     * after the input properties of this object are up to date. The
+     * implementation must not modify any property, emit signals or access
+     * Python. It shall keep the result in a private cache, which is then
+     * consumed by the following execute() call on the main thread. If an
+     * exception is thrown, or the cache is otherwise missing, execute()
+     * must fall back to computing the result itself.
+     */
+    virtual void executeConcurrent() {}
+
     /**
      * Executes the extensions of a document object.
      */
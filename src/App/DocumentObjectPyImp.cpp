@@ -761,6 +761,19 @@ PyObject* DocumentObjectPy::getElementMapVersion(PyObject* args)
         Py::String(getDocumentObjectPtr()->getElementMapVersion(prop, Base::asBoolean(restored))));
 }
 
+PyObject* DocumentObjectPy::getExpressionStats(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    const auto& stats = getDocumentObjectPtr()->ExpressionEngine.getExecuteStats();
+    Py::Dict dict;
+    dict.setItem("evaluated", Py::Long(static_cast<unsigned long>(stats.evaluated)));
+    dict.setItem("skipped", Py::Long(static_cast<unsigned long>(stats.skipped)));
+    return Py::new_reference_to(dict);
+}
+
 PyObject *DocumentObjectPy::getCustomAttributes(const char* ) const
 {
         return nullptr;
@@ -23,6 +23,8 @@
 
 #include "PreCompiled.h"
 
+#include <limits>
+
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 #include <Base/Stream.h>
@@ -768,6 +770,19 @@ Py::Int DocumentPy::getUndoRedoMemSize() const
     return Py::Int((long)getDocumentPtr()->getUndoMemSize());
 }
 
+Py::Int DocumentPy::getUndoMemLimit() const
+{
+    return Py::Int((long)getDocumentPtr()->getUndoLimit());
+}
+
+void DocumentPy::setUndoMemLimit(Py::Int arg)
+{
+    long limit = arg;
+    if (limit < 0 || limit > static_cast<long>(std::numeric_limits<unsigned int>::max()))
+        throw Py::ValueError("Undo memory limit out of range");
+    getDocumentPtr()->setUndoLimit(static_cast<unsigned int>(limit));
+}
+
 Py::Int DocumentPy::getUndoCount() const
 {
     return Py::Int((long)getDocumentPtr()->getAvailableUndos());
@@ -1,5 +1,6 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <atomic>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -44,6 +45,18 @@ namespace Data
 static std::unordered_map<const ElementMap*, unsigned> _elementMapToId;
 static std::unordered_map<unsigned, ElementMapPtr> _idToElementMap;
 
+// Element maps are also created by the worker threads of a concurrent recompute
+static std::atomic<ElementMap::Storage>& defaultStorage()
+{
+    static std::atomic<ElementMap::Storage> storage {[]() {
+        auto hGrp = ::App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+        return hGrp->GetBool("FlatElementMap", false) ? ElementMap::Storage::Flat
+                                                      : ElementMap::Storage::Tree;
+    }()};
+    return storage;
+}
+
 
 void ElementMap::init()
 {
@@ -68,10 +81,21 @@ void ElementMap::init()
 }
 
 ElementMap::ElementMap()
+    : mappedNames(getDefaultStorage())
 {
     init();
 }
 
+void ElementMap::setDefaultStorage(Storage storage)
+{
+    defaultStorage() = storage;
+}
+
+ElementMap::Storage ElementMap::getDefaultStorage()
+{
+    return defaultStorage();
+}
+
 
 void ElementMap::beforeSave(const ::App::StringHasherRef& hasherRef) const
 {
@@ -440,7 +464,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef, std::istream
                     }
                 }
 
-                this->mappedNames.emplace(ref->name, idx);
+                this->mappedNames.insert(ref->name, idx);
 
                 if (!hasherRef) {
                     if (offset + 1 < (int)tokens.size()) {
@@ -504,25 +528,27 @@ MappedName ElementMap::addName(MappedName& name, const IndexedName& idx, const E
         if (overwrite) {
             erase(idx);
         }
-        auto ret = mappedNames.insert(std::make_pair(name, idx));
-        if (ret.second) {              // element just inserted did not exist yet in the map
-            ret.first->first.compact();// FIXME see MappedName.cpp
-            mappedRef(idx).append(ret.first->first, sids);
+        auto ret = mappedNames.insert(name, idx);
+        if (ret.inserted) {      // element just inserted did not exist yet in the map
+            ret.name->compact();// FIXME see MappedName.cpp
+            MappedName res = *ret.name;
+            mappedRef(idx).append(res, sids);
             FC_TRACE(idx << " -> " << name);// NOLINT
-            return ret.first->first;
+            return res;
         }
-        if (ret.first->second == idx) {
+        if (*ret.index == idx) {
             FC_TRACE("duplicate " << idx << " -> " << name);// NOLINT
-            return ret.first->first;
+            return *ret.name;
         }
         if (!overwrite) {
             if (existing) {
-                *existing = ret.first->second;
+                *existing = *ret.index;
             }
             return {};
         }
 
-        erase(ret.first->first);
+        MappedName duplicate = *ret.name;
+        erase(duplicate);
     };
 }
 
@@ -759,16 +785,16 @@ MappedName ElementMap::renameDuplicateElement(int index, const IndexedName& elem
 
 void ElementMap::erase(const MappedName& name)
 {
-    auto it = this->mappedNames.find(name);
-    if (it == this->mappedNames.end()) {
+    const IndexedName* idx = this->mappedNames.find(name);
+    if (!idx) {
         return;
     }
-    MappedNameRef* ref = findMappedRef(it->second);
+    MappedNameRef* ref = findMappedRef(*idx);
     if (!ref) {
         return;
     }
     ref->erase(name);
-    this->mappedNames.erase(it);
+    this->mappedNames.erase(name);
 }
 
 void ElementMap::erase(const IndexedName& idx)
@@ -800,8 +826,8 @@ bool ElementMap::empty() const
 
 IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
 {
-    auto nameIter = mappedNames.find(name);
-    if (nameIter == mappedNames.end()) {
+    const IndexedName* nameIdx = mappedNames.find(name);
+    if (!nameIdx) {
         if (childElements.isEmpty()) {
             return IndexedName();
         }
@@ -838,7 +864,7 @@ IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
     }
 
     if (sids) {
-        const MappedNameRef* ref = findMappedRef(nameIter->second);
+        const MappedNameRef* ref = findMappedRef(*nameIdx);
         for (; ref; ref = ref->next.get()) {
             if (ref->name == name) {
                 if (sids->empty()) {
@@ -851,7 +877,7 @@ IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
             }
         }
     }
-    return nameIter->second;
+    return *nameIdx;
 }
 
 MappedName ElementMap::find(const IndexedName& idx, ElementIDRefs* sids) const
@@ -1047,9 +1073,9 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
-    }
+    this->mappedNames.forEach([&](const MappedName& name, const IndexedName&) {
+        addPostfix(name.constPostfix(), postfixMap, postfixes);
+    });
 
     childMaps.push_back(this);
     res.first->second = (int)childMaps.size();
@@ -1268,9 +1294,9 @@ std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
-    }
+    this->mappedNames.forEach([&](const MappedName& name, const IndexedName& idx) {
+        ret.emplace_back(name, idx);
+    });
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
         IndexedName idx(child.indexedName);
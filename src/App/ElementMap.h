@@ -30,6 +30,7 @@
 
 #include "Application.h"
 #include "MappedElement.h"
+#include "MappedNameMap.h"
 #include "StringHasher.h"
 
 #include <cstring>
@@ -66,7 +67,8 @@ typedef std::function<bool(const MappedName&, int, long, long)> TraceCallback;
  * `indexedNames` maps a string to both a name queue and children.
  *   each of those children store an IndexedName, offset details, postfix, ids, and
  *   possibly a recursive elementmap
- * `mappedNames` maps a MappedName to a specific IndexedName.
+ * `mappedNames` maps a MappedName to a specific IndexedName, see MappedNameMap for the
+ *   available storage.
  */
 class AppExport ElementMap: public std::enable_shared_from_this<ElementMap> //TODO can remove shared_from_this?
 {
@@ -77,6 +79,18 @@ public:
     */
     ElementMap();
 
+    using Storage = MappedNameMap::Storage;
+
+    /** Set the storage of the MappedName lookup of element maps created afterwards.
+     *
+     * The default is read once from the parameter FlatElementMap in
+     * BaseApp/Preferences/Document unless set explicitly.
+     */
+    static void setDefaultStorage(Storage storage);
+
+    /// Return the storage of the MappedName lookup of new element maps
+    static Storage getDefaultStorage();
+
     /** Ensures that naming is properly assigned. It then marks as "used" all the StringID
      * that are used to make up this particular map and are stored in the hasherRef passed
      * as a parameter. Finally do this recursively for all childEelementMaps as well.
@@ -291,7 +305,7 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    MappedNameMap mappedNames;
 
     struct ChildMapInfo
     {
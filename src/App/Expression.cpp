@@ -34,6 +34,7 @@
 #include <boost/math/special_functions/round.hpp>
 #include <boost/math/special_functions/trunc.hpp>
 
+#include <atomic>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -856,6 +857,39 @@ void Expression::Component::toString(std::ostream &ss, bool persistent) const {
 
 TYPESYSTEM_SOURCE_ABSTRACT(App::Expression, Base::BaseClass)
 
+/* The numeric value of a node is asked for by the numeric evaluation of its
+ * parent, and again by the Python evaluation of the parent if the parent
+ * cannot be evaluated without Python. To convert each node once, the value
+ * is kept in the node together with the id of the evaluation. Nested
+ * evaluations share the id of the outermost one.
+ */
+struct Expression::NumericCache {
+    std::size_t evaluation = 0;
+    NumericType type = NumericNone;
+    Quantity value;
+};
+
+namespace {
+
+std::atomic<std::size_t> numericEvaluations;
+thread_local std::size_t numericEvaluation;
+thread_local int numericEvaluationDepth;
+
+class NumericEvaluationScope {
+public:
+    NumericEvaluationScope() {
+        if(numericEvaluationDepth++ == 0)
+            numericEvaluation = ++numericEvaluations;
+    }
+    ~NumericEvaluationScope() {
+        --numericEvaluationDepth;
+    }
+    NumericEvaluationScope(const NumericEvaluationScope &) = delete;
+    NumericEvaluationScope &operator=(const NumericEvaluationScope &) = delete;
+};
+
+}
+
 Expression::Expression(const DocumentObject *_owner)
     : owner(const_cast<App::DocumentObject*>(_owner))
 {
@@ -1106,12 +1140,55 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
     return ExpressionPtr(expr);
 }
 
+static Py::Object pyFromNumeric(Expression::NumericType type, const Quantity &value) {
+    switch(type) {
+    case Expression::NumericInteger:
+        return Py::Long(static_cast<long>(value.getValue()));
+    case Expression::NumericFloat:
+        return Py::Float(value.getValue());
+    default:
+        return Py::asObject(new QuantityPy(new Quantity(value)));
+    }
+}
+
+Expression::NumericType Expression::getNumericValue(Quantity &value) const {
+    if(!components.empty())
+        return NumericNone;
+    NumericEvaluationScope scope;
+    if(!numericCache)
+        numericCache = std::make_unique<NumericCache>();
+    if(numericCache->evaluation != numericEvaluation) {
+        try {
+            numericCache->type = _getNumericValue(numericCache->value);
+        }catch(Base::Exception &) {
+            // let the Python path report the error
+            numericCache->type = NumericNone;
+        }
+        numericCache->evaluation = numericEvaluation;
+    }
+    value = numericCache->value;
+    return numericCache->type;
+}
+
 App::any Expression::getValueAsAny() const {
+    NumericEvaluationScope scope;
+    Quantity q;
+    switch(getNumericValue(q)) {
+    case NumericInteger:
+        return App::any(static_cast<long>(q.getValue()));
+    case NumericFloat:
+        return App::any(q.getValue());
+    case NumericQuantity:
+        return App::any(q);
+    default:
+        break;
+    }
     Base::PyGILStateLocker lock;
     return pyObjectToAny(getPyValue());
 }
 
 Py::Object Expression::getPyValue() const {
+    NumericEvaluationScope scope;
     try {
         Py::Object pyobj = _getPyValue();
         if(!components.empty()) {
@@ -1138,6 +1215,10 @@ void Expression::visit(ExpressionVisitor &v) {
 }
 
 Expression* Expression::eval() const {
+    NumericEvaluationScope scope;
+    Quantity q;
+    if(getNumericValue(q) != NumericNone)
+        return new NumberExpression(owner,q);
     Base::PyGILStateLocker lock;
     return expressionFromPy(owner,getPyValue());
 }
@@ -1271,6 +1352,25 @@ Py::Object UnitExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+Expression::NumericType UnitExpression::_getNumericValue(Quantity &value) const {
+    // Must agree with pyFromQuantity()
+    if(!quantity.getUnit().isEmpty()) {
+        value = quantity;
+        return NumericQuantity;
+    }
+    long l;
+    int i;
+    switch(essentiallyInteger(quantity.getValue(),l,i)) {
+    case 1:
+    case 2:
+        value = Quantity(static_cast<double>(l));
+        return NumericInteger;
+    default:
+        value = quantity;
+        return NumericFloat;
+    }
+}
+
 //
 // NumberExpression class
 //
@@ -1477,9 +1577,97 @@ static Py::Object calc(const Expression *expr, int op,
 }
 
 Py::Object OperatorExpression::_getPyValue() const {
+    Quantity q;
+    NumericType type = getNumericValue(q);
+    if(type != NumericNone)
+        return pyFromNumeric(type,q);
     return calc(this,op,left,right,false);
 }
 
+Expression::NumericType OperatorExpression::_getNumericValue(Quantity &value) const {
+    switch(op) {
+    case ADD:
+    case SUB:
+    case MUL:
+    case UNIT:
+    case DIV:
+    case NEG:
+    case POS:
+        break;
+    default:
+        return NumericNone;
+    }
+
+    Quantity l;
+    NumericType ltype = left->getNumericValue(l);
+    if(ltype == NumericNone)
+        return NumericNone;
+    if(op == POS) {
+        value = l;
+        return ltype;
+    }
+    if(op == NEG) {
+        value = l * -1.0;
+        return ltype;
+    }
+
+    Quantity r;
+    NumericType rtype = right->getNumericValue(r);
+    if(rtype == NumericNone)
+        return NumericNone;
+
+    // Same as QuantityPy number protocol, any Quantity operand makes the
+    // result a Quantity.
+    if(ltype == NumericQuantity || rtype == NumericQuantity) {
+        switch(op) {
+        case ADD:
+            value = l + r;
+            break;
+        case SUB:
+            value = l - r;
+            break;
+        case DIV:
+            value = l / r;
+            break;
+        default:
+            value = l * r;
+            break;
+        }
+        return NumericQuantity;
+    }
+
+    // Otherwise follow the Python int/float semantics
+    double a = l.getValue();
+    double b = r.getValue();
+    double res;
+    switch(op) {
+    case ADD:
+        res = a + b;
+        break;
+    case SUB:
+        res = a - b;
+        break;
+    case DIV:
+        // leave it to Python to raise ZeroDivisionError
+        if(b == 0.0)
+            return NumericNone;
+        value = Quantity(a / b);
+        return NumericFloat;
+    default:
+        res = a * b;
+        break;
+    }
+    value = Quantity(res);
+    if(ltype == NumericInteger && rtype == NumericInteger) {
+        // Python integers have arbitrary precision, leave big ones to Python
+        static const double maxInt = std::min(9007199254740992.0, static_cast<double>(LONG_MAX));
+        if(std::fabs(res) > maxInt)
+            return NumericNone;
+        return NumericInteger;
+    }
+    return NumericFloat;
+}
+
 /**
   * Simplify the expression. For OperatorExpressions, we return a NumberExpression if
   * both the left and right side can be simplified to NumberExpressions. In this case
@@ -2394,19 +2582,41 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
 
     Py::Object e1 = args[0]->getPyValue();
     Quantity v1 = pyToQuantity(e1,expr,"Invalid first argument.");
-    Py::Object e2;
     Quantity v2;
-    if (args.size() > 1) {
-        e2 = args[1]->getPyValue();
-        v2 = pyToQuantity(e2,expr,"Invalid second argument.");
-    }
-    Py::Object e3;
+    if (args.size() > 1)
+        v2 = pyToQuantity(args[1]->getPyValue(),expr,"Invalid second argument.");
     Quantity v3;
-    if (args.size() > 2) {
-        e3 = args[2]->getPyValue();
-        v3 = pyToQuantity(e3,expr,"Invalid third argument.");
+    if (args.size() > 2)
+        v3 = pyToQuantity(args[2]->getPyValue(),expr,"Invalid third argument.");
+
+    switch (f) {
+    case ROTATIONX:
+    case ROTATIONY:
+    case ROTATIONZ:
+        if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
+            _EXPR_THROW("Unit must be either empty or an angle.", expr);
+        return Py::asObject(new Base::RotationPy(Base::Rotation(
+            Vector3d(static_cast<double>(f == ROTATIONX),
+                     static_cast<double>(f == ROTATIONY),
+                     static_cast<double>(f == ROTATIONZ)),
+            v1.getValue() * M_PI / 180.0)));
+    case TRANSLATIONM:
+        if (v1.isDimensionlessOrUnit(Unit::Length)
+            && v2.isDimensionlessOrUnit(Unit::Length)
+            && v3.isDimensionlessOrUnit(Unit::Length))
+            return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
+        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
+    default:
+        break;
     }
 
+    Quantity result = evaluateScalar(expr, f, args.size(), v1, v2, v3);
+    return Py::asObject(new QuantityPy(new Quantity(result)));
+}
+
+Quantity FunctionExpression::evaluateScalar(const Expression *expr, int f, std::size_t argc,
+        const Quantity &v1, const Quantity &v2, const Quantity &v3)
+{
     double output;
     Unit unit;
     double scaler = 1;
@@ -2418,9 +2628,6 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case COS:
     case SIN:
     case TAN:
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
         if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
             _EXPR_THROW("Unit must be either empty or an angle.", expr);
 
@@ -2504,7 +2711,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -2513,12 +2720,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         scaler = 180.0 / M_PI;
         break;
     case MOD:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         unit = v1.getUnit() / v2.getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.isDimensionless())
@@ -2536,23 +2743,17 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
+        if (argc > 2) {
             if (v2.getUnit() != v3.getUnit())
                 _EXPR_THROW("Units must be equal.",expr);
         }
         unit = v1.getUnit();
         break;
-    case TRANSLATIONM:
-        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
-            break;
-        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
     default:
         _EXPR_THROW("Unknown function: " << f,0);
     }
@@ -2617,11 +2818,13 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2)
+                      + (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2)
+                      - (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2636,25 +2839,63 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case FLOOR:
         output = floor(value);
         break;
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
-        return Py::asObject(new Base::RotationPy(Base::Rotation(
-            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
-            value)));
-    case TRANSLATIONM:
-        return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
     default:
         _EXPR_THROW("Unknown function: " << f,0);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
+    Quantity q;
+    if(getNumericValue(q) != NumericNone)
+        return pyFromNumeric(NumericQuantity,q);
     return evaluate(this,f,args);
 }
 
+Expression::NumericType FunctionExpression::_getNumericValue(Quantity &value) const {
+    if(args.empty() || args.size() > 3)
+        return NumericNone;
+
+    switch (f) {
+    case ACOS:
+    case ASIN:
+    case ATAN:
+    case ABS:
+    case EXP:
+    case LOG:
+    case LOG10:
+    case SIN:
+    case SINH:
+    case TAN:
+    case TANH:
+    case SQRT:
+    case CBRT:
+    case COS:
+    case COSH:
+    case MOD:
+    case ATAN2:
+    case POW:
+    case HYPOT:
+    case CATH:
+    case ROUND:
+    case TRUNC:
+    case CEIL:
+    case FLOOR:
+        break;
+    default:
+        return NumericNone;
+    }
+
+    Quantity v[3];
+    for(std::size_t i=0; i<args.size(); ++i) {
+        if(args[i]->getNumericValue(v[i]) == NumericNone)
+            return NumericNone;
+    }
+    value = evaluateScalar(this, f, args.size(), v[0], v[1], v[2]);
+    return NumericQuantity;
+}
+
 /**
   * Try to simplify the expression, i.e calculate all constant expressions.
   *
@@ -2969,6 +3210,27 @@ Py::Object VariableExpression::_getPyValue() const {
     return var.getPyValue(true);
 }
 
+Expression::NumericType VariableExpression::_getNumericValue(Quantity &value) const {
+    // Only handle plain numeric properties, in the same way as their
+    // getPyObject() would do.
+    auto prop = var.getWholeProperty();
+    if(!prop)
+        return NumericNone;
+    if(auto qprop = freecad_dynamic_cast<PropertyQuantity>(prop)) {
+        value = qprop->getQuantityValue();
+        return NumericQuantity;
+    }
+    if(auto fprop = freecad_dynamic_cast<PropertyFloat>(prop)) {
+        value = Quantity(fprop->getValue());
+        return NumericFloat;
+    }
+    if(auto iprop = freecad_dynamic_cast<PropertyInteger>(prop)) {
+        value = Quantity(static_cast<double>(iprop->getValue()));
+        return NumericInteger;
+    }
+    return NumericNone;
+}
+
 void VariableExpression::_toString(std::ostream &ss, bool persistent,int) const {
     if(persistent)
         ss << var.toPersistentString();
@@ -3334,6 +3596,12 @@ Py::Object ConstantExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+Expression::NumericType ConstantExpression::_getNumericValue(Quantity &value) const {
+    if(!isNumber())
+        return NumericNone;
+    return NumberExpression::_getNumericValue(value);
+}
+
 bool ConstantExpression::isNumber() const {
     return strcmp(name,"None")
         && strcmp(name,"True")
@@ -183,6 +183,32 @@ public:
 
     Py::Object getPyValue() const;
 
+    /// Type of the value obtained by getNumericValue()
+    enum NumericType {
+        /// The expression cannot be evaluated without Python
+        NumericNone,
+        /// Dimensionless integer, the Python path would give an int
+        NumericInteger,
+        /// Dimensionless number, the Python path would give a float
+        NumericFloat,
+        /// Number with unit, the Python path would give a Quantity
+        NumericQuantity,
+    };
+
+    /** Evaluate the expression without involving Python
+     *
+     * Expression trees made of numbers, arithmetic operators, plain
+     * numeric properties and the common math functions can be evaluated
+     * directly on Base::Quantity, which is much cheaper than creating and
+     * destroying Python objects for each intermediate result.
+     *
+     * @param value: output the value of the expression
+     * @return Returns the type of the value, or NumericNone if the
+     * expression must be evaluated through getPyValue(). Any error also
+     * results in NumericNone, so that the Python path can report it.
+     */
+    NumericType getNumericValue(Base::Quantity &value) const;
+
     bool isSame(const Expression &other, bool checkComment=true) const;
 
     friend class ExpressionVisitor;
@@ -209,6 +235,7 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) {}
     virtual void _offsetCells(int, int, ExpressionVisitor &) {}
     virtual Py::Object _getPyValue() const = 0;
+    virtual NumericType _getNumericValue(Base::Quantity &) const {return NumericNone;}
     virtual void _visit(ExpressionVisitor &) {}
 
 protected:
@@ -218,6 +245,11 @@ protected:
 
 public:
     std::string comment;
+
+private:
+    struct NumericCache;
+    /// The result of getNumericValue() in the current evaluation
+    mutable std::unique_ptr<NumericCache> numericCache;
 };
 
 }
@@ -97,6 +97,7 @@ protected:
     Expression * _copy() const override;
     void _toString(std::ostream &ss, bool persistent, int indent) const override;
     Py::Object _getPyValue() const override;
+    NumericType _getNumericValue(Base::Quantity &value) const override;
 
 protected:
     mutable PyObject *cache = nullptr;
@@ -139,6 +140,7 @@ public:
 
 protected:
     Py::Object _getPyValue() const override;
+    NumericType _getNumericValue(Base::Quantity &value) const override;
     void _toString(std::ostream &ss, bool persistent, int indent) const override;
     Expression* _copy() const override;
 
@@ -193,6 +195,8 @@ protected:
 
     Py::Object _getPyValue() const override;
 
+    NumericType _getNumericValue(Base::Quantity &value) const override;
+
     void _toString(std::ostream &ss, bool persistent, int indent) const override;
 
     void _visit(ExpressionVisitor & v) override;
@@ -352,7 +356,10 @@ protected:
         const std::vector<Expression*> &arguments,
         const Base::Matrix4D *transformationMatrix);
     static Py::Object translationMatrix(double x, double y, double z);
+    static Base::Quantity evaluateScalar(const Expression *expr, int f, std::size_t argc,
+            const Base::Quantity &v1, const Base::Quantity &v2, const Base::Quantity &v3);
     Py::Object _getPyValue() const override;
+    NumericType _getNumericValue(Base::Quantity &value) const override;
     Expression * _copy() const override;
     void _visit(ExpressionVisitor & v) override;
     void _toString(std::ostream &ss, bool persistent, int indent) const override;
@@ -394,6 +401,7 @@ public:
 protected:
     Expression * _copy() const override;
     Py::Object _getPyValue() const override;
+    NumericType _getNumericValue(Base::Quantity &value) const override;
     void _toString(std::ostream &ss, bool persistent, int indent) const override;
     bool _isIndexable() const override;
     void _getIdentifiers(std::map<App::ObjectIdentifier,bool> &) const override;
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#include "MappedNameMap.h"
+
+
+namespace Data
+{
+
+namespace
+{
+constexpr std::size_t minCapacity = 16;
+
+std::size_t hashBytes(std::size_t hash, const QByteArray& bytes)
+{
+    // FNV-1a
+    constexpr std::uint64_t prime = 0x100000001b3ULL;
+    for (char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash = static_cast<std::size_t>(hash * prime);
+    }
+    return hash;
+}
+}// namespace
+
+MappedNameMap::MappedNameMap(Storage storage)
+    : _storage(storage)
+{}
+
+std::size_t MappedNameMap::hash(const MappedName& name)
+{
+    // Hash the concatenated bytes to stay consistent with MappedName::operator==()
+    constexpr std::uint64_t offset = 0xcbf29ce484222325ULL;
+    std::size_t res = hashBytes(static_cast<std::size_t>(offset), name.dataBytes());
+    return hashBytes(res, name.postfixBytes());
+}
+
+std::size_t MappedNameMap::findSlot(const MappedName& name, std::size_t hash) const
+{
+    // Returns the slot holding the name, or else the first free slot of the probe
+    const std::size_t mask = _slots.size() - 1;
+    std::size_t freeSlot = _slots.size();
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        std::uint32_t slot = _slots[i];
+        if (slot == EmptySlot) {
+            return freeSlot < _slots.size() ? freeSlot : i;
+        }
+        if (slot == ErasedSlot) {
+            if (freeSlot == _slots.size()) {
+                freeSlot = i;
+            }
+            continue;
+        }
+        const Entry& entry = _entries[slot - FirstEntry];
+        if (entry.hash == hash && entry.name == name) {
+            return i;
+        }
+    }
+}
+
+void MappedNameMap::rehash(std::size_t capacity)
+{
+    if (_erased != 0) {
+        // Drop erased entries, keeping the insertion order
+        std::size_t pos = 0;
+        for (auto& entry : _entries) {
+            if (!entry.erased) {
+                _entries[pos++] = std::move(entry);
+            }
+        }
+        _entries.resize(pos);
+        _erased = 0;
+    }
+    std::size_t size = minCapacity;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    _slots.assign(size, EmptySlot);
+    const std::size_t mask = size - 1;
+    for (std::size_t n = 0; n < _entries.size(); ++n) {
+        std::size_t i = _entries[n].hash & mask;
+        while (_slots[i] != EmptySlot) {
+            i = (i + 1) & mask;
+        }
+        _slots[i] = static_cast<std::uint32_t>(n + FirstEntry);
+    }
+}
+
+MappedNameMap::InsertResult MappedNameMap::insert(const MappedName& name, const IndexedName& idx)
+{
+    if (_storage == Storage::Tree) {
+        auto ret = _tree.insert(std::make_pair(name, idx));
+        return {&ret.first->first, &ret.first->second, ret.second};
+    }
+
+    // Keep the load, including erased slots, below 3/4
+    if ((_entries.size() + 1) * 4 > _slots.size() * 3) {
+        rehash((_count + 1) * 2);
+    }
+    std::size_t hash = MappedNameMap::hash(name);
+    std::size_t i = findSlot(name, hash);
+    std::uint32_t slot = _slots[i];
+    if (slot >= FirstEntry) {
+        Entry& entry = _entries[slot - FirstEntry];
+        return {&entry.name, &entry.index, false};
+    }
+    _slots[i] = static_cast<std::uint32_t>(_entries.size() + FirstEntry);
+    _entries.push_back(Entry {name, idx, hash, false});
+    ++_count;
+    Entry& entry = _entries.back();
+    return {&entry.name, &entry.index, true};
+}
+
+const IndexedName* MappedNameMap::find(const MappedName& name) const
+{
+    if (_storage == Storage::Tree) {
+        auto it = _tree.find(name);
+        return it == _tree.end() ? nullptr : &it->second;
+    }
+
+    if (_count == 0) {
+        return nullptr;
+    }
+    std::uint32_t slot = _slots[findSlot(name, hash(name))];
+    if (slot < FirstEntry) {
+        return nullptr;
+    }
+    return &_entries[slot - FirstEntry].index;
+}
+
+bool MappedNameMap::erase(const MappedName& name)
+{
+    if (_storage == Storage::Tree) {
+        return _tree.erase(name) != 0;
+    }
+
+    if (_count == 0) {
+        return false;
+    }
+    std::size_t i = findSlot(name, hash(name));
+    std::uint32_t slot = _slots[i];
+    if (slot < FirstEntry) {
+        return false;
+    }
+    Entry& entry = _entries[slot - FirstEntry];
+    entry.erased = true;
+    entry.name = MappedName();
+    _slots[i] = ErasedSlot;
+    --_count;
+    ++_erased;
+    if (_erased > _count + minCapacity) {
+        rehash(_count * 2);
+    }
+    return true;
+}
+
+std::size_t MappedNameMap::size() const
+{
+    if (_storage == Storage::Tree) {
+        return _tree.size();
+    }
+    return _count;
+}
+
+void MappedNameMap::clear()
+{
+    _tree.clear();
+    _entries.clear();
+    _slots.clear();
+    _count = 0;
+    _erased = 0;
+}
+
+}// namespace Data
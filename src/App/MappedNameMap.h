@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef DATA_MAPPEDNAMEMAP_H
+#define DATA_MAPPEDNAMEMAP_H
+
+#include "FCGlobal.h"
+
+#include "IndexedName.h"
+#include "MappedName.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+
+namespace Data
+{
+
+/** Maps MappedName to IndexedName for ElementMap
+ *
+ * The storage is chosen on construction:
+ * - Tree: a std::map, iterated in name order.
+ * - Flat: an open addressing hash table over a contiguous array of entries,
+ *   iterated in insertion order. Lookups hash the name once instead of
+ *   comparing it byte by byte on every level of a tree.
+ *
+ * The keys are the names themselves, not interned integer ids. With a
+ * StringHasher, ElementMap::hashElementName() already replaces a long name by
+ * the short text of its StringID, so the keys stay a few bytes long. Integer
+ * keys would need a hasher for every map, and maps without one would be saved
+ * differently.
+ */
+class AppExport MappedNameMap
+{
+public:
+    enum class Storage
+    {
+        Tree,
+        Flat
+    };
+
+    explicit MappedNameMap(Storage storage = Storage::Tree);
+
+    Storage storage() const
+    {
+        return _storage;
+    }
+
+    struct InsertResult
+    {
+        /// the stored name, valid until the next modification
+        const MappedName* name;
+        /// the stored index, valid until the next modification
+        IndexedName* index;
+        /// false if the name exists already
+        bool inserted;
+    };
+
+    /// Insert the mapping if \c name does not exist yet
+    InsertResult insert(const MappedName& name, const IndexedName& idx);
+
+    /// Return the index of \c name or null if not found
+    const IndexedName* find(const MappedName& name) const;
+
+    /// Remove \c name, return true if it has been found
+    bool erase(const MappedName& name);
+
+    std::size_t size() const;
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear();
+
+    /// Call \c func with each name and its index
+    template<typename Func>
+    void forEach(Func func) const
+    {
+        if (_storage == Storage::Tree) {
+            for (const auto& it : _tree) {
+                func(it.first, it.second);
+            }
+            return;
+        }
+        for (const auto& entry : _entries) {
+            if (!entry.erased) {
+                func(entry.name, entry.index);
+            }
+        }
+    }
+
+    /// Hash of the bytes of \c name, regardless of how they are split into data and postfix
+    static std::size_t hash(const MappedName& name);
+
+private:
+    std::size_t findSlot(const MappedName& name, std::size_t hash) const;
+    void rehash(std::size_t capacity);
+
+    struct Entry
+    {
+        MappedName name;
+        IndexedName index;
+        std::size_t hash;
+        bool erased;
+    };
+
+    // slot values in _slots, otherwise the entry index plus FirstEntry
+    static constexpr std::uint32_t EmptySlot = 0;
+    static constexpr std::uint32_t ErasedSlot = 1;
+    static constexpr std::uint32_t FirstEntry = 2;
+
+    Storage _storage;
+    std::map<MappedName, IndexedName, std::less<>> _tree;
+    std::vector<Entry> _entries;
+    std::vector<std::uint32_t> _slots;
+    std::size_t _count = 0;
+    std::size_t _erased = 0;
+};
+
+}// namespace Data
+
+#endif// DATA_MAPPEDNAMEMAP_H
@@ -1267,6 +1267,16 @@ Property *ObjectIdentifier::getProperty(int *ptype) const
     return result.resolvedProperty;
 }
 
+Property *ObjectIdentifier::getWholeProperty() const
+{
+    ResolveResults result(*this);
+    if (result.propertyType != PseudoNone
+            || (int)components.size() - result.propertyIndex != 1
+            || (!subObjectName.getString().empty() && !result.resolvedSubObject))
+        return nullptr;
+    return result.resolvedProperty;
+}
+
 Property *ObjectIdentifier::resolveProperty(const App::DocumentObject *obj,
         const char *propertyName, App::DocumentObject *&sobj, int &ptype) const
 {
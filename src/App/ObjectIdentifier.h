@@ -323,6 +323,12 @@ public:
 
     App::Property *getProperty(int *ptype=nullptr) const;
 
+    /** Obtain the property if this identifier refers to it as a whole
+     * @return Returns nullptr if the identifier cannot be resolved, refers to
+     * a pseudo property, or has any component after the property name.
+     */
+    App::Property *getWholeProperty() const;
+
     App::ObjectIdentifier canonicalPath() const;
 
     // Document-centric functions
@@ -242,6 +242,13 @@ public:
     virtual Property *Copy() const = 0;
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
+    /** Returns true if a copy can be kept compressed in the undo stack
+     *
+     * This requires SaveDocFile() to write the complete value, and a new
+     * instance to restore it through deferRestoreDocFile(), see
+     * canDeferRestoreDocFile(). The default implementation returns false.
+     */
+    virtual bool canCompressUndo() const { return false; }
 
     /// Called when a child property has changed value
     virtual void hasSetChildValue(Property &) {}
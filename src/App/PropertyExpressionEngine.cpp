@@ -76,6 +76,146 @@ struct PropertyExpressionEngine::Private {
     // defined in header, hence the private structure here.
     std::vector<boost::signals2::scoped_connection> conns;
     std::unordered_map<std::string, std::vector<ObjectIdentifier> > propMap;
+
+    // Incremental evaluation, see PropertyExpressionEngine::execute()
+    struct TrackedObject {
+        // The document whose tracker signals the changes of the object
+        const Document *doc = nullptr;
+        // Expressions depending on any property of the object
+        std::vector<ObjectIdentifier> anyProp;
+        // Expressions depending on a given property of the object
+        std::unordered_map<std::string, std::vector<ObjectIdentifier> > props;
+    };
+    // The objects are removed once the tracker signals their deletion
+    std::unordered_map<const DocumentObject*, TrackedObject> tracked;
+    // Tracked objects seen frozen, whose changes are not signaled
+    std::set<const DocumentObject*> frozen;
+    // Expressions bound to a given property of the owner object
+    std::unordered_map<std::string, std::vector<ObjectIdentifier> > targets;
+    // Expressions with dependencies that cannot be tracked, always evaluated
+    std::set<ObjectIdentifier> untracked;
+    std::set<ObjectIdentifier> dirty;
+    // Cached evaluation order of all expressions
+    std::vector<ObjectIdentifier> order;
+    // Cached evaluation order filtered by the execute option
+    std::map<int, std::vector<ObjectIdentifier> > filteredOrder;
+    ExecuteStats stats;
+    bool allDirty = true;
+    bool singleChange = false;
+    bool trackingValid = false;
+    bool orderValid = false;
+};
+
+/* Forwards the changes of the objects the expression engines depend on to the
+ * engines, with one tracker per document. Each change costs one lookup, rather
+ * than a call for every engine of the document.
+ */
+struct PropertyExpressionEngine::Tracker {
+    explicit Tracker(Document *doc) {
+        //NOLINTBEGIN
+        conns.emplace_back(doc->signalChangedObject.connect(std::bind(
+                    &Tracker::slotChanged,this,sp::_1,sp::_2)));
+        conns.emplace_back(doc->signalTouchedObject.connect(std::bind(
+                    &Tracker::slotTouched,this,sp::_1)));
+        conns.emplace_back(doc->signalDeletedObject.connect(std::bind(
+                    &Tracker::slotDeleted,this,sp::_1)));
+        //NOLINTEND
+    }
+
+    ~Tracker() {
+        // The objects are gone with the document
+        auto objs = std::move(engines);
+        for(auto &v : objs) {
+            for(auto engine : v.second)
+                engine->slotTrackedDeleted(v.first);
+        }
+    }
+
+    static Tracker *get(const Document *doc, bool create) {
+        // Never destroyed, as engines may outlive it at exit
+        static auto &trackers = // NOLINT
+            *new std::unordered_map<const Document*, std::unique_ptr<Tracker> >();
+        static bool inited;
+        if(!inited) {
+            inited = true;
+            //NOLINTBEGIN
+            GetApplication().signalDeleteDocument.connect([](const Document &doc) {
+                trackers.erase(&doc);
+            });
+            GetApplication().signalAppendDynamicProperty.connect(&Tracker::slotProperty);
+            GetApplication().signalRemoveDynamicProperty.connect(&Tracker::slotProperty);
+            //NOLINTEND
+        }
+        auto it = trackers.find(doc);
+        if(it != trackers.end())
+            return it->second.get();
+        if(!create)
+            return nullptr;
+        auto res = trackers.emplace(doc,
+                std::make_unique<Tracker>(const_cast<Document*>(doc))); // NOLINT
+        return res.first->second.get();
+    }
+
+    void add(const DocumentObject *obj, PropertyExpressionEngine *engine) {
+        engines[obj].push_back(engine);
+    }
+
+    void remove(const DocumentObject *obj, PropertyExpressionEngine *engine) {
+        auto it = engines.find(obj);
+        if(it == engines.end())
+            return;
+        auto &v = it->second;
+        v.erase(std::remove(v.begin(), v.end(), engine), v.end());
+        if(v.empty())
+            engines.erase(it);
+    }
+
+    const std::vector<PropertyExpressionEngine*> *find(const DocumentObject *obj) const {
+        auto it = engines.find(obj);
+        return it == engines.end() ? nullptr : &it->second;
+    }
+
+    void slotChanged(const DocumentObject &obj, const Property &prop) {
+        if(auto v = find(&obj)) {
+            for(auto engine : *v)
+                engine->slotTrackedChange(obj, prop);
+        }
+    }
+
+    void slotTouched(const DocumentObject &obj) {
+        if(auto v = find(&obj)) {
+            for(auto engine : *v)
+                engine->slotTrackedTouched(obj);
+        }
+    }
+
+    void slotDeleted(const DocumentObject &obj) {
+        auto it = engines.find(&obj);
+        if(it == engines.end())
+            return;
+        auto v = std::move(it->second);
+        engines.erase(it);
+        for(auto engine : v)
+            engine->slotTrackedDeleted(&obj);
+    }
+
+    // A dynamic property added to or removed from a tracked object may change
+    // what the identifiers resolve to.
+    static void slotProperty(const Property &prop) {
+        auto obj = freecad_dynamic_cast<DocumentObject>(prop.getContainer());
+        if(!obj || !obj->getDocument())
+            return;
+        auto tracker = get(obj->getDocument(), false);
+        if(!tracker)
+            return;
+        if(auto v = tracker->find(obj)) {
+            for(auto engine : *v)
+                engine->invalidateTracking(obj);
+        }
+    }
+
+    std::unordered_map<const DocumentObject*, std::vector<PropertyExpressionEngine*> > engines;
+    std::vector<boost::signals2::scoped_connection> conns;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +228,7 @@ TYPESYSTEM_SOURCE(App::PropertyExpressionEngine , App::PropertyExpressionContain
 
 PropertyExpressionEngine::PropertyExpressionEngine()
     : validator(0)
+    , pimpl(std::make_unique<Private>())
 {
 }
 
@@ -95,7 +236,10 @@ PropertyExpressionEngine::PropertyExpressionEngine()
  * @brief Destroy the PropertyExpressionEngine object.
  */
 
-PropertyExpressionEngine::~PropertyExpressionEngine() = default;
+PropertyExpressionEngine::~PropertyExpressionEngine()
+{
+    clearTracking();
+}
 
 /**
  * @brief Estimate memory size of this property.
@@ -128,6 +272,16 @@ Property *PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    // Dependencies may have changed, the tracking information is rebuilt on
+    // next execute(). Unless a single expression is changed by setValue(),
+    // consider all expressions as dirty.
+    pimpl->trackingValid = false;
+    pimpl->orderValid = false;
+    if(!pimpl->singleChange)
+        pimpl->allDirty = true;
+    if(expressions.empty())
+        clearTracking();
+
     App::DocumentObject *owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if(!owner || !owner->isAttachedToDocument() || owner->isRestoring() || testFlag(LinkDetached)) {
         PropertyExpressionContainer::hasSetValue();
@@ -150,10 +304,8 @@ void PropertyExpressionEngine::hasSetValue()
 
     updateDeps(std::move(deps));
 
-    if(pimpl) {
-        pimpl->conns.clear();
-        pimpl->propMap.clear();
-    }
+    pimpl->conns.clear();
+    pimpl->propMap.clear();
     // check if there is any hidden references
     bool hasHidden = false;
     for(auto &v : _Deps) {
@@ -163,9 +315,6 @@ void PropertyExpressionEngine::hasSetValue()
         }
     }
     if(hasHidden) {
-        if(!pimpl) {
-            pimpl = std::make_unique<Private>();
-        }
         for(auto &e : expressions) {
             auto expr = e.second.expression;
             if(!expr) continue;
@@ -202,8 +351,6 @@ void PropertyExpressionEngine::hasSetValue()
 }
 
 void PropertyExpressionEngine::updateHiddenReference(const std::string &key) {
-    if(!pimpl)
-        return;
     auto it = pimpl->propMap.find(key);
     if(it == pimpl->propMap.end())
         return;
@@ -491,11 +638,14 @@ void PropertyExpressionEngine::setValue(const ObjectIdentifier & path, std::shar
         AtomicPropertyChange signaller(*this);
         expressions[usePath] = ExpressionInfo(expr);
         expressionChanged(usePath);
+        pimpl->dirty.insert(usePath);
+        Base::StateLocker guard(pimpl->singleChange);
         signaller.tryInvoke();
     } else if (it != expressions.end()) {
         AtomicPropertyChange signaller(*this);
         expressions.erase(it);
         expressionChanged(usePath);
+        Base::StateLocker guard(pimpl->singleChange);
         signaller.tryInvoke();
     }
 }
@@ -535,19 +685,8 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap & exprs,
 
     // Build data structure for graph
     for (const auto & expr : exprs) {
-        if(option!=ExecuteAll) {
-            auto prop = expr.first.getProperty();
-            if(!prop)
-                throw Base::RuntimeError("Path does not resolve to a property.");
-            bool is_output = prop->testStatus(App::Property::Output)||(prop->getType()&App::Prop_Output);
-            if((is_output && option==ExecuteNonOutput) || (!is_output && option==ExecuteOutput))
-                continue;
-            if(option == ExecuteOnRestore
-                    && !prop->testStatus(Property::Transient)
-                    && !(prop->getType() & Prop_Transient)
-                    && !prop->testStatus(Property::EvalOnRestore))
-                continue;
-        }
+        if(!matchOption(expr.first, option))
+            continue;
         buildGraphStructures(expr.first, expr.second.expression, nodes, revNodes, edges);
     }
 
@@ -571,6 +710,28 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap & exprs,
     }
 }
 
+/**
+ * @brief Check whether the binding of \a path is evaluated with \a option.
+ */
+
+bool PropertyExpressionEngine::matchOption(const ObjectIdentifier &path, ExecuteOption option)
+{
+    if(option == ExecuteAll)
+        return true;
+    auto prop = path.getProperty();
+    if(!prop)
+        throw Base::RuntimeError("Path does not resolve to a property.");
+    bool is_output = prop->testStatus(App::Property::Output)||(prop->getType()&App::Prop_Output);
+    if((is_output && option==ExecuteNonOutput) || (!is_output && option==ExecuteOutput))
+        return false;
+    if(option == ExecuteOnRestore
+            && !prop->testStatus(Property::Transient)
+            && !(prop->getType() & Prop_Transient)
+            && !prop->testStatus(Property::EvalOnRestore))
+        return false;
+    return true;
+}
+
 /**
  * The code below builds a graph for all expressions in the engine, and
  * finds any circular dependencies. It also computes the internal evaluation
@@ -611,7 +772,7 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
     if (!docObj)
         throw Base::RuntimeError("PropertyExpressionEngine must be owned by a DocumentObject.");
 
-    if (running)
+    if (running || expressions.empty())
         return DocumentObject::StdReturn;
 
     if(option == ExecuteOnRestore) {
@@ -647,10 +808,54 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
 
     resetter r(running);
 
-    // Compute evaluation order
-    std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
+    if(!pimpl->trackingValid)
+        updateTracking(docObj);
+    // Frozen objects may have changed without notice
+    for(auto obj : pimpl->frozen)
+        markDirty(obj);
+    if(pimpl->allDirty) {
+        for(auto &e : expressions)
+            pimpl->dirty.insert(e.first);
+        pimpl->allDirty = false;
+    }
+
+    // Compute evaluation order. The order of all expressions, and of the
+    // bindings matching each option, is cached as long as the expressions and
+    // their dependencies are unchanged. Bindings with untracked dependencies
+    // are still part of the order, they are just never considered clean.
+    if(!pimpl->orderValid) {
+        pimpl->filteredOrder.clear();
+        try {
+            pimpl->order = computeEvaluationOrder(ExecuteAll);
+            pimpl->orderValid = true;
+        }
+        catch (Base::Exception &) {
+            // The cycle may not involve the bindings of the given option,
+            // leave the report to the graph built below.
+        }
+    }
+    std::vector<App::ObjectIdentifier> uncachedOrder;
+    const std::vector<App::ObjectIdentifier> *order = &pimpl->order;
+    if(!pimpl->orderValid) {
+        uncachedOrder = computeEvaluationOrder(option);
+        order = &uncachedOrder;
+    }
+    else if(option != ExecuteAll) {
+        auto res = pimpl->filteredOrder.emplace(option, std::vector<ObjectIdentifier>());
+        if(res.second) {
+            for(auto &path : pimpl->order) {
+                if(matchOption(path, option))
+                    res.first->second.push_back(path);
+            }
+        }
+        order = &res.first->second;
+    }
+    const std::vector<App::ObjectIdentifier> &evaluationOrder = *order;
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
 
+    auto &stats = pimpl->stats;
+    const ExecuteStats before = stats;
+
 #ifdef FC_PROPERTYEXPRESSIONENGINE_LOG
     std::clog << "Computing expressions for " << getName() << std::endl;
 #endif
@@ -658,6 +863,14 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
     /* Evaluate the expressions, and update properties */
     for (;it != evaluationOrder.end();++it) {
 
+        /* Skip the binding if none of its inputs changed since last evaluation.
+         * Changed outputs mark their dependent bindings as dirty through
+         * slotTrackedChange(). */
+        if (!isDirty(*it)) {
+            ++stats.skipped;
+            continue;
+        }
+
         // Get property to update
         Property * prop = it->getProperty();
 
@@ -670,6 +883,8 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
         if (parent != docObj)
             throw Base::RuntimeError("Invalid property owner.");
 
+        ++stats.evaluated;
+
         /* Set value of property */
         App::any value;
         try {
@@ -691,13 +906,16 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
                 //
                 // if (option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore))
                 {
-                    if (isAnyEqual(value, prop->getPathValue(*it)))
+                    if (isAnyEqual(value, prop->getPathValue(*it))) {
+                        pimpl->dirty.erase(*it);
                         continue;
+                    }
                     if (touched)
                         *touched = true;
                 }
                 prop->setPathValue(*it, value);
             }
+            pimpl->dirty.erase(*it);
         }catch(Base::Exception &e) {
             std::ostringstream ss;
             ss << e.what() << std::endl << "in property binding '" << prop->getFullName() << "'";
@@ -714,9 +932,200 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
             throw Base::RuntimeError(ss.str().c_str());
         }
     }
+
+    FC_LOG(getFullName() << " evaluated " << stats.evaluated - before.evaluated
+            << ", skipped " << stats.skipped - before.skipped << " expression(s)");
     return DocumentObject::StdReturn;
 }
 
+/**
+ * @brief Statistics of all calls to execute() so far, i.e. the number of
+ * expressions evaluated, and the number of expressions skipped because none
+ * of their dependencies changed.
+ */
+
+const PropertyExpressionEngine::ExecuteStats &PropertyExpressionEngine::getExecuteStats() const
+{
+    return pimpl->stats;
+}
+
+bool PropertyExpressionEngine::isDirty(const ObjectIdentifier &path) const
+{
+    return pimpl->dirty.count(path) || pimpl->untracked.count(path);
+}
+
+/**
+ * @brief Rebuild the map from the properties the expressions depend on to
+ * the expressions, used to mark changed expressions as dirty.
+ *
+ * Expressions with dependencies not resolving to a property of a document
+ * object (e.g. pseudo properties), or read through a link property, are never
+ * considered clean.
+ */
+
+void PropertyExpressionEngine::updateTracking(DocumentObject *owner)
+{
+    clearTracking();
+
+    auto track = [this](DocumentObject *obj) -> Private::TrackedObject & {
+        auto res = pimpl->tracked.emplace(obj, Private::TrackedObject());
+        if(res.second) {
+            res.first->second.doc = obj->getDocument();
+            if(res.first->second.doc)
+                Tracker::get(res.first->second.doc, true)->add(obj, this);
+            if(obj->isFreezed())
+                pimpl->frozen.insert(obj);
+        }
+        return res.first->second;
+    };
+
+    // Track the bound properties to re-apply the expression on outside changes
+    track(owner);
+
+    for(auto &e : expressions) {
+        if(!e.second.expression)
+            continue;
+        if(auto prop = e.first.getProperty())
+            pimpl->targets[prop->getName()].push_back(e.first);
+        for(auto &dep : e.second.expression->getIdentifiers()) {
+            const ObjectIdentifier &var = dep.first;
+            int ptype = 0;
+            auto prop = var.getProperty(&ptype);
+            auto obj = (prop && !ptype) ?
+                freecad_dynamic_cast<DocumentObject>(prop->getContainer()) : nullptr;
+            // The value read through a link is another object, whose
+            // changes are not signaled to the link
+            if(!obj || !prop->getName() || !obj->isAttachedToDocument()
+                    || prop->isDerivedFrom(PropertyLinkBase::getClassTypeId())) {
+                pimpl->untracked.insert(e.first);
+                break;
+            }
+            track(obj).props[prop->getName()].push_back(e.first);
+
+            // Besides the property, the identifier depends on the objects it
+            // is resolved through, e.g. a sub-object path, and on the objects
+            // reached by its components, e.g. through a link
+            for(auto &objDep : var.getDep(true)) {
+                if(!objDep.first->isAttachedToDocument())
+                    continue;
+                auto &trackedObj = track(objDep.first);
+                for(auto &propName : objDep.second) {
+                    if(propName.empty())
+                        trackedObj.anyProp.push_back(e.first);
+                    else
+                        trackedObj.props[propName].push_back(e.first);
+                }
+            }
+        }
+    }
+    pimpl->trackingValid = true;
+}
+
+/**
+ * @brief Stop receiving the changes of the tracked objects.
+ */
+
+void PropertyExpressionEngine::clearTracking()
+{
+    for(auto &v : pimpl->tracked) {
+        if(!v.second.doc)
+            continue;
+        if(auto tracker = Tracker::get(v.second.doc, false))
+            tracker->remove(v.first, this);
+    }
+    pimpl->tracked.clear();
+    pimpl->frozen.clear();
+    pimpl->targets.clear();
+    pimpl->untracked.clear();
+}
+
+void PropertyExpressionEngine::markDirty(const DocumentObject *obj)
+{
+    auto it = pimpl->tracked.find(obj);
+    if(it == pimpl->tracked.end())
+        return;
+    auto &dirty = pimpl->dirty;
+    dirty.insert(it->second.anyProp.begin(), it->second.anyProp.end());
+    for(auto &v : it->second.props)
+        dirty.insert(v.second.begin(), v.second.end());
+}
+
+/**
+ * @brief Mark the dependents of a tracked object as dirty, and rebuild the
+ * tracking on next execute() as the expressions may resolve differently.
+ */
+
+void PropertyExpressionEngine::invalidateTracking(const DocumentObject *obj)
+{
+    markDirty(obj);
+    pimpl->trackingValid = false;
+    pimpl->orderValid = false;
+}
+
+void PropertyExpressionEngine::slotTrackedChange(const App::DocumentObject &obj,
+                                                 const App::Property &prop)
+{
+    if(!prop.getName())
+        return;
+    // A link or a sub-object may be retargeted, so that the identifiers
+    // resolve to other objects
+    if(prop.isDerivedFrom(PropertyLinkBase::getClassTypeId()))
+        invalidateTracking(&obj);
+    if(pimpl->allDirty)
+        return;
+    auto it = pimpl->tracked.find(&obj);
+    if(it == pimpl->tracked.end())
+        return;
+    auto &dirty = pimpl->dirty;
+    dirty.insert(it->second.anyProp.begin(), it->second.anyProp.end());
+    auto iter = it->second.props.find(prop.getName());
+    if(iter != it->second.props.end())
+        dirty.insert(iter->second.begin(), iter->second.end());
+
+    // A bound property changed by someone else than us, re-apply the binding.
+    if(!running && &obj == getContainer()) {
+        auto iter = pimpl->targets.find(prop.getName());
+        if(iter != pimpl->targets.end())
+            dirty.insert(iter->second.begin(), iter->second.end());
+    }
+}
+
+/**
+ * @brief Changes of frozen objects are not signaled, so keep the objects
+ * seen frozen. Touching a tracked object, e.g. when unfreezing it, marks its
+ * dependents as dirty, and touching the owner all its expressions, like
+ * before expressions were skipped.
+ */
+
+void PropertyExpressionEngine::slotTrackedTouched(const App::DocumentObject &obj)
+{
+    if(obj.isFreezed()) {
+        pimpl->frozen.insert(&obj);
+        return;
+    }
+    if(&obj == getContainer()) {
+        pimpl->allDirty = true;
+        return;
+    }
+    pimpl->frozen.erase(&obj);
+    markDirty(&obj);
+}
+
+/**
+ * @brief The tracked object is deleted, or its document is closed. Only the
+ * address of the object is used, as it may already be destroyed.
+ */
+
+void PropertyExpressionEngine::slotTrackedDeleted(const App::DocumentObject *obj)
+{
+    if(!pimpl->tracked.count(obj))
+        return;
+    // The dependencies no longer resolve, rebuild the tracking on next execute()
+    invalidateTracking(obj);
+    pimpl->tracked.erase(obj);
+    pimpl->frozen.erase(obj);
+}
+
 /**
  * @brief Find paths to document object.
  * @param obj Document object
@@ -137,6 +137,15 @@ public:
      */
     DocumentObjectExecReturn * execute(ExecuteOption option=ExecuteAll, bool *touched=nullptr);
 
+    /// Statistics of all calls to execute()
+    struct ExecuteStats {
+        /// Number of expressions evaluated
+        std::size_t evaluated = 0;
+        /// Number of expressions skipped because none of their inputs changed
+        std::size_t skipped = 0;
+    };
+    const ExecuteStats &getExecuteStats() const;
+
     void getPathsToDocumentObject(DocumentObject*, std::vector<App::ObjectIdentifier> & paths) const;
 
     bool depsAreTouched() const;
@@ -192,6 +201,16 @@ private:
     void slotChangedProperty(const App::DocumentObject &obj, const App::Property &prop);
     void updateHiddenReference(const std::string &key);
 
+    void slotTrackedChange(const App::DocumentObject &obj, const App::Property &prop);
+    void slotTrackedTouched(const App::DocumentObject &obj);
+    void slotTrackedDeleted(const App::DocumentObject *obj);
+    void markDirty(const App::DocumentObject *obj);
+    void invalidateTracking(const App::DocumentObject *obj);
+    void updateTracking(App::DocumentObject *owner);
+    void clearTracking();
+    bool isDirty(const App::ObjectIdentifier &path) const;
+    static bool matchOption(const App::ObjectIdentifier &path, ExecuteOption option);
+
     bool running = false; /**< Boolean used to avoid loops */
     bool restoring = false;
 
@@ -209,6 +228,7 @@ private:
 
     struct Private;
     std::unique_ptr<Private> pimpl;
+    struct Tracker;
 
     friend class AtomicPropertyChange;
 
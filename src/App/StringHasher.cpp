@@ -24,7 +24,11 @@
 
 #include <QCryptographicHash>
 #include <QHash>
+#include <array>
+#include <atomic>
 #include <deque>
+#include <mutex>
+#include <unordered_set>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -33,9 +37,6 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/bimap.hpp>
-#include <boost/bimap/set_of.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
 #include <boost/iostreams/stream.hpp>
 
 #include "MappedElement.h"
@@ -73,15 +74,182 @@ struct StringIDHasher
     }
 };
 
-using HashMapBase =
-    boost::bimap<boost::bimaps::unordered_set_of<StringID*, StringIDHasher, StringIDHasher>,
-                 boost::bimaps::set_of<long>>;
-
-class StringHasher::HashMap: public HashMapBase
+/** Bidirectional map of StringID and its integer ID
+ *
+ * Both directions are split into lock striped shards, selected by the hash of
+ * the content or by the ID respectively, so that lookup and insertion from
+ * multiple threads rarely wait for each other. Insertion locks the content
+ * shard before the ID shard.
+ *
+ * Functions iterating the whole map, and clear(), are not thread safe.
+ */
+class StringHasher::HashMap
 {
 public:
     bool SaveAll = false;
     int Threshold = 0;
+
+    /// Return the stored StringID with the same content as \c key, or null
+    StringID* find(const StringID& key) const
+    {
+        auto& shard = dataShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.items.find(const_cast<StringID*>(&key));
+        return it == shard.items.end() ? nullptr : *it;
+    }
+
+    /// Return the stored StringID with the given \c id, or null
+    StringID* find(long id) const
+    {
+        auto& shard = idShard(id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.items.find(id);
+        return it == shard.items.end() ? nullptr : it->second;
+    }
+
+    /** Insert a StringID unless one with the same content or ID exists
+     * @return the stored StringID with the same content or ID
+     */
+    StringID* insert(StringID* sid)
+    {
+        auto& shard = dataShard(*sid);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto res = shard.items.insert(sid);
+        if (!res.second) {
+            return *res.first;
+        }
+        long id = sid->value();
+        auto& ids = idShard(id);
+        std::lock_guard<std::mutex> idLock(ids.mutex);
+        auto idRes = ids.items.emplace(id, sid);
+        if (!idRes.second) {
+            shard.items.erase(res.first);
+            return idRes.first->second;
+        }
+        long last = lastId.load();
+        while (last < id && !lastId.compare_exchange_weak(last, id)) {}
+        ++count;
+        return sid;
+    }
+
+    /// Remove the StringID with the given \c id, return true if found
+    bool erase(long id)
+    {
+        StringID* sid = find(id);
+        if (!sid) {
+            return false;
+        }
+        auto& shard = dataShard(*sid);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& ids = idShard(id);
+        std::lock_guard<std::mutex> idLock(ids.mutex);
+        auto it = ids.items.find(id);
+        if (it == ids.items.end() || it->second != sid) {
+            return false;
+        }
+        ids.items.erase(it);
+        auto dataIt = shard.items.find(sid);
+        if (dataIt != shard.items.end() && *dataIt == sid) {
+            shard.items.erase(dataIt);
+        }
+        --count;
+        return true;
+    }
+
+    /// Reserve a new ID. Concurrent callers always get different IDs.
+    long nextID()
+    {
+        return ++lastId;
+    }
+
+    /// Make nextID() continue after the largest stored ID
+    void resetNextID()
+    {
+        long last = 0;
+        for (auto& shard : idShards) {
+            if (!shard.items.empty()) {
+                last = std::max(last, shard.items.rbegin()->first);
+            }
+        }
+        lastId = last;
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    void clear()
+    {
+        for (auto& shard : dataShards) {
+            shard.items.clear();
+        }
+        for (auto& shard : idShards) {
+            shard.items.clear();
+        }
+        lastId = 0;
+        count = 0;
+    }
+
+    /// Call \c func with each ID and StringID in the order of ID
+    template<typename Func>
+    void forEach(Func func) const
+    {
+        std::array<std::map<long, StringID*>::const_iterator, ShardCount> its;
+        for (std::size_t i = 0; i < ShardCount; ++i) {
+            its[i] = idShards[i].items.begin();
+        }
+        for (;;) {
+            std::size_t next = ShardCount;
+            for (std::size_t i = 0; i < ShardCount; ++i) {
+                if (its[i] != idShards[i].items.end()
+                    && (next == ShardCount || its[i]->first < its[next]->first)) {
+                    next = i;
+                }
+            }
+            if (next == ShardCount) {
+                return;
+            }
+            auto it = its[next]++;
+            func(it->first, it->second);
+        }
+    }
+
+private:
+    static constexpr std::size_t ShardCount = 32;
+
+    struct DataShard
+    {
+        std::mutex mutex;
+        std::unordered_set<StringID*, StringIDHasher, StringIDHasher> items;
+    };
+
+    struct IDShard
+    {
+        std::mutex mutex;
+        std::map<long, StringID*> items;
+    };
+
+    DataShard& dataShard(const StringID& sid) const
+    {
+        std::size_t hash = StringIDHasher()(&sid);
+        return dataShards[(hash ^ (hash >> 16)) % ShardCount];
+    }
+
+    IDShard& idShard(long id) const
+    {
+        return idShards[static_cast<std::size_t>(id) % ShardCount];
+    }
+
+    mutable std::array<DataShard, ShardCount> dataShards;
+    mutable std::array<IDShard, ShardCount> idShards;
+    std::atomic<long> lastId {0};
+    std::atomic<std::size_t> count {0};
 };
 
 ///////////////////////////////////////////////////////////
@@ -91,7 +259,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
-        _hasher->_hashes->right.erase(_id);
+        _hasher->_hashes->erase(_id);
     }
 }
 
@@ -198,18 +366,18 @@ void StringHasher::compact()
     // Make a list of all the table entries that have only a single reference and are not marked
     // "persistent"
     std::deque<StringIDRef> pendings;
-    for (auto& hasher : _hashes->right) {
-        if (!hasher.second->isPersistent() && hasher.second->getRefCount() == 1) {
-            pendings.emplace_back(hasher.second);
+    _hashes->forEach([&pendings](long, StringID* sid) {
+        if (!sid->isPersistent() && sid->getRefCount() == 1) {
+            pendings.emplace_back(sid);
         }
-    }
+    });
 
     // Recursively remove the unused StringIDs
     while (!pendings.empty()) {
         StringIDRef sid = pendings.front();
         pendings.pop_front();
         // Try to erase the map entry for this StringID
-        if (_hashes->right.erase(sid.value()) == 0U) {
+        if (!_hashes->erase(sid.value())) {
             continue;// If nothing was erased, there's nothing more to do
         }
         sid._sid->_hasher = nullptr;
@@ -224,6 +392,7 @@ void StringHasher::compact()
             }
         }
     }
+    _hashes->resetNextID();
 }
 
 bool StringHasher::getSaveAll() const
@@ -241,14 +410,9 @@ int StringHasher::getThreshold() const
     return _hashes->Threshold;
 }
 
-long StringHasher::lastID() const
+long StringHasher::nextID()
 {
-    if (_hashes->right.empty()) {
-        return 0;
-    }
-    auto it = _hashes->right.end();
-    --it;
-    return it->first;
+    return _hashes->nextID();
 }
 
 StringIDRef StringHasher::getID(const char* text, int len, bool hashable)
@@ -277,9 +441,8 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
         dataID._data = data;
     }
 
-    auto it = _hashes->left.find(&dataID);
-    if (it != _hashes->left.end()) {
-        return {it->first};
+    if (StringID* existing = _hashes->find(dataID)) {
+        return {existing};
     }
 
     if (!hashed && !nocopy) {
@@ -294,7 +457,7 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
     if (hashed) {
         flags.setFlag(StringID::Flag::Hashed);
     }
-    StringIDRef sid(new StringID(lastID() + 1, dataID._data, flags));
+    StringIDRef sid(new StringID(nextID(), dataID._data, flags));
     return {insert(sid)};
 }
 
@@ -321,9 +484,8 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
     }
 
     // Check to see if there is already an entry in the hash table for this StringID
-    auto it = _hashes->left.find(&tempID);
-    if (it != _hashes->left.end()) {
-        auto res = StringIDRef(it->first);
+    if (StringID* existing = _hashes->find(tempID)) {
+        auto res = StringIDRef(existing);
         if (indexed) {
             res._index = indexed.getIndex();
         }
@@ -349,7 +511,7 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
     }
 
     // The real StringID object that we are going to insert
-    StringIDRef newStringIDRef(new StringID(lastID() + 1, tempID._data));
+    StringIDRef newStringIDRef(new StringID(nextID(), tempID._data));
     StringID& newStringID = *newStringIDRef._sid;
     if (tempID._postfix.size() != 0) {
         newStringID._flags.setFlag(StringID::Flag::Postfixed);
@@ -437,11 +599,11 @@ StringIDRef StringHasher::getID(long id, int index) const
     if (id <= 0) {
         return {};
     }
-    auto it = _hashes->right.find(id);
-    if (it == _hashes->right.end()) {
+    StringID* sid = _hashes->find(id);
+    if (!sid) {
         return {};
     }
-    StringIDRef res(it->second);
+    StringIDRef res(sid);
     res._index = index;
     return res;
 }
@@ -468,11 +630,11 @@ void StringHasher::Save(Base::Writer& writer) const
     }
     else {
         count = 0;
-        for (auto& hasher : _hashes->right) {
-            if (hasher.second->isMarked() || hasher.second->isPersistent()) {
+        _hashes->forEach([&count](long, const StringID* sid) {
+            if (sid->isMarked() || sid->isPersistent()) {
                 ++count;
             }
-        }
+        });
     }
 
     writer.Stream() << writer.ind() << "<StringHasher saveall=\"" << _hashes->SaveAll
@@ -516,11 +678,11 @@ void StringHasher::saveStream(std::ostream& stream) const
     long lastID = 0;
     bool relative = false;
 
-    for (auto& hasher : _hashes->right) {
-        auto& d = *hasher.second;
+    _hashes->forEach([&](long, const StringID* sid) {
+        auto& d = *sid;
         long id = d._id;
         if (!_hashes->SaveAll && !d.isMarked() && !d.isPersistent()) {
-            continue;
+            return;
         }
 
         // We use relative coding to save space. But in order to have some
@@ -599,7 +761,7 @@ void StringHasher::saveStream(std::ostream& stream) const
             stream << ' ';
             textStreamWrapper << d._data.constData();
         }
-    }
+    });
 }
 
 void StringHasher::RestoreDocFile(Base::Reader& reader)
@@ -742,13 +904,12 @@ StringID* StringHasher::insert(const StringIDRef& sid)
     auto& hasher = *sid._sid;
     hasher._hasher = this;
     hasher.ref();
-    auto res = _hashes->right.insert(_hashes->right.end(),
-                                     HashMap::right_map::value_type(sid.value(), &hasher));
-    if (res->second != &hasher) {
+    StringID* res = _hashes->insert(&hasher);
+    if (res != &hasher) {
         hasher._hasher = nullptr;
         hasher.unref();
     }
-    return res->second;
+    return res;
 }
 
 void StringHasher::restoreStream(std::istream& stream, std::size_t count)
@@ -772,10 +933,10 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
-    for (auto& hasher : _hashes->right) {
-        hasher.second->_hasher = nullptr;
-        hasher.second->unref();
-    }
+    _hashes->forEach([](long, StringID* sid) {
+        sid->_hasher = nullptr;
+        sid->unref();
+    });
     _hashes->clear();
 }
 
@@ -787,11 +948,11 @@ size_t StringHasher::size() const
 size_t StringHasher::count() const
 {
     size_t count = 0;
-    for (auto& hasher : _hashes->right) {
-        if (hasher.second->getRefCount() > 1) {
+    _hashes->forEach([&count](long, const StringID* sid) {
+        if (sid->getRefCount() > 1) {
             ++count;
         }
-    }
+    });
     return count;
 }
 
@@ -863,15 +1024,15 @@ PyObject* StringHasher::getPyObject()
 std::map<long, StringIDRef> StringHasher::getIDMap() const
 {
     std::map<long, StringIDRef> ret;
-    for (auto& hasher : _hashes->right) {
-        ret.emplace_hint(ret.end(), hasher.first, StringIDRef(hasher.second));
-    }
+    _hashes->forEach([&ret](long id, StringID* sid) {
+        ret.emplace_hint(ret.end(), id, StringIDRef(sid));
+    });
     return ret;
 }
 
 void StringHasher::clearMarks() const
 {
-    for (auto& hasher : _hashes->right) {
-        hasher.second->_flags.setFlag(StringID::Flag::Marked, false);
-    }
+    _hashes->forEach([](long, const StringID* sid) {
+        sid->_flags.setFlag(StringID::Flag::Marked, false);
+    });
 }
@@ -630,6 +630,12 @@ private:
 /// If the string is longer than a given threshold, instead of storing the string, its SHA1 hash is
 /// stored (and the original string discarded). This allows an upper threshold on the length of a
 /// stored string, while still effectively guaranteeing uniqueness in the table.
+///
+/// The getID() functions may be called concurrently from multiple threads, e.g. when generating
+/// element maps of several shapes in parallel. The table is split into lock striped shards for
+/// this purpose. The IDs are then assigned in the order the threads get there first. All other
+/// modifying functions (e.g. clear(), compact() and restore) must not run concurrently with
+/// anything else.
 class AppExport StringHasher: public Base::Persistence, public Base::Handled
 {
 
@@ -772,7 +778,7 @@ public:
 
 protected:
     StringID* insert(const StringIDRef& sid);
-    long lastID() const;
+    long nextID();
     void saveStream(std::ostream& stream) const;
     void restoreStream(std::istream& stream, std::size_t count);
     void restoreStreamNew(std::istream& stream, std::size_t count);
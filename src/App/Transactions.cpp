@@ -28,7 +28,10 @@
 # include <cassert>
 #endif
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
+#include <QCryptographicHash>
 #include <Base/Console.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -111,7 +114,34 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize () const
 {
-    return 0;
+    return static_cast<unsigned int>(
+            std::min<std::size_t>(getMemUsage(), std::numeric_limits<unsigned int>::max()));
+}
+
+std::size_t Transaction::getMemUsage() const
+{
+    // the content does not change any more once committed
+    if (!memSizeValid) {
+        memSize = 0;
+        for (const auto & It : _Objects.get<0>())
+            memSize += It.second->getMemUsage();
+        memSizeValid = true;
+    }
+    return memSize;
+}
+
+void Transaction::compress()
+{
+    for (const auto & It : _Objects.get<0>())
+        It.second->compress();
+    memSizeValid = false;
+}
+
+void Transaction::spill()
+{
+    for (const auto & It : _Objects.get<0>())
+        It.second->spill();
+    memSizeValid = false;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -142,6 +172,7 @@ bool Transaction::hasObject(const TransactionalObject *Obj) const
 void Transaction::addOrRemoveProperty(TransactionalObject *Obj,
                                     const Property* pcProp, bool add)
 {
+    memSizeValid = false;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -190,6 +221,7 @@ void Transaction::apply(Document &Doc, bool forward)
 
 void Transaction::addObjectNew(TransactionalObject *Obj)
 {
+    memSizeValid = false;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
     if (pos != index.end()) {
@@ -219,6 +251,7 @@ void Transaction::addObjectNew(TransactionalObject *Obj)
 
 void Transaction::addObjectDel(const TransactionalObject *Obj)
 {
+    memSizeValid = false;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -240,6 +273,7 @@ void Transaction::addObjectDel(const TransactionalObject *Obj)
 
 void Transaction::addObjectChange(const TransactionalObject *Obj, const Property *Prop)
 {
+    memSizeValid = false;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -404,9 +438,92 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
     }
 }
 
+// Compressed property values of all transactions by the SHA1 of their
+// content, to share the data of values that did not change between them.
+static std::unordered_map<std::string, std::weak_ptr<Base::DeferredFile>> _Snapshots;
+static std::size_t _SnapshotsPruneSize = 64;
+
+static std::shared_ptr<Base::DeferredFile> getSnapshot(const Property* prop,
+                                                       const std::string& content)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const std::size_t chunk = 1 << 30;
+    for (std::size_t pos = 0; pos < content.size(); pos += chunk) {
+        hash.addData(content.data() + pos,
+                     static_cast<int>(std::min(chunk, content.size() - pos)));
+    }
+    QByteArray key = hash.result();
+
+    auto &entry = _Snapshots[std::string(key.constData(), key.size())];
+    auto snapshot = entry.lock();
+    if (snapshot && snapshot->getSize() == content.size())
+        return snapshot;
+
+    snapshot = Base::DeferredFile::deflate(prop->getTypeId().getName(), content);
+    entry = snapshot;
+
+    if (_Snapshots.size() >= _SnapshotsPruneSize) {
+        for (auto it = _Snapshots.begin(); it != _Snapshots.end();) {
+            if (it->second.expired())
+                it = _Snapshots.erase(it);
+            else
+                ++it;
+        }
+        _SnapshotsPruneSize = std::max<std::size_t>(64, _Snapshots.size() * 2);
+    }
+    return snapshot;
+}
+
+void TransactionObject::compress()
+{
+    for (auto &v : _PropChangeMap) {
+        auto &data = v.second;
+        if (!data.property || data.snapshot || !data.property->canCompressUndo())
+            continue;
+
+        auto prop = static_cast<Property*>(data.property->getTypeId().createInstance());
+        if (!prop)
+            continue;
+        try {
+            Base::StringWriter writer;
+            data.property->SaveDocFile(writer);
+            data.snapshot = getSnapshot(data.property, writer.getString());
+        } catch (Base::Exception &e) {
+            e.ReportException();
+            FC_ERR("exception while compressing " << data.name << ' '
+                    << data.property->getTypeId().getName() << ": " << e.what());
+            delete prop;
+            continue;
+        }
+        prop->setStatusValue(data.property->getStatus());
+        prop->deferRestoreDocFile(data.snapshot);
+        delete data.property;
+        data.property = prop;
+    }
+}
+
+void TransactionObject::spill()
+{
+    for (auto &v : _PropChangeMap) {
+        if (v.second.snapshot)
+            v.second.snapshot->spill();
+    }
+}
+
 unsigned int TransactionObject::getMemSize () const
 {
-    return 0;
+    return static_cast<unsigned int>(
+            std::min<std::size_t>(getMemUsage(), std::numeric_limits<unsigned int>::max()));
+}
+
+std::size_t TransactionObject::getMemUsage() const
+{
+    std::size_t size = 0;
+    for (auto &v : _PropChangeMap) {
+        if (v.second.property)
+            size += v.second.property->getMemSize();
+    }
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
@@ -25,11 +25,17 @@
 #ifndef APP_TRANSACTION_H
 #define APP_TRANSACTION_H
 
+#include <memory>
 #include <unordered_map>
 #include <Base/Factory.h>
 #include <Base/Persistence.h>
 #include <App/PropertyContainer.h>
 
+namespace Base
+{
+class DeferredFile;
+}
+
 namespace App
 {
 
@@ -66,6 +72,8 @@ public:
     std::string Name;
 
     unsigned int getMemSize () const override;
+    /// The memory used by the transaction, not clamped to the range of getMemSize()
+    std::size_t getMemUsage() const;
     void Save (Base::Writer &writer) const override;
     /// This method is used to restore properties from an XML document.
     void Restore(Base::XMLReader &reader) override;
@@ -87,8 +95,15 @@ public:
     void addObjectDel(const TransactionalObject *Obj);
     void addObjectChange(const TransactionalObject *Obj, const Property *Prop);
 
+    /// Keep large property values compressed, see Property::canCompressUndo()
+    void compress();
+    /// Move the compressed property values to temporary files
+    void spill();
+
 private:
     int transID;
+    mutable std::size_t memSize = 0;
+    mutable bool memSizeValid = false;
     using Info = std::pair<const TransactionalObject*, TransactionObject*>;
     bmi::multi_index_container<
         Info,
@@ -120,7 +135,14 @@ public:
     void setProperty(const Property* pcProp);
     void addOrRemoveProperty(const Property* pcProp, bool add);
 
+    /// Replace large property copies by compressed ones
+    void compress();
+    /// Move the compressed property values to temporary files
+    void spill();
+
     unsigned int getMemSize () const override;
+    /// The memory used by the property copies, not clamped to the range of getMemSize()
+    std::size_t getMemUsage() const;
     void Save (Base::Writer &writer) const override;
     /// This method is used to restore properties from an XML document.
     void Restore(Base::XMLReader &reader) override;
@@ -133,6 +155,8 @@ protected:
     struct PropData : DynamicProperty::PropData {
         Base::Type propertyType;
         const Property *propertyOrig = nullptr;
+        /// compressed value of \c property, if any
+        std::shared_ptr<Base::DeferredFile> snapshot;
     };
     std::unordered_map<int64_t, PropData> _PropChangeMap;
 
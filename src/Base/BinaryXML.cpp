@@ -0,0 +1,388 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <cstring>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#include <QFile>
+#include <zlib.h>
+
+#include "BinaryXML.h"
+#include "Exception.h"
+#include "Reader.h"
+
+
+using namespace Base;
+
+namespace
+{
+
+constexpr std::uint32_t ByteOrderMark = 0x01020304;
+constexpr std::size_t Alignment = 8;
+
+std::size_t align(std::size_t size)
+{
+    return (size + Alignment - 1) & ~(Alignment - 1);
+}
+
+std::uint32_t toIndex(std::size_t size)
+{
+    if (size > std::numeric_limits<std::uint32_t>::max()) {
+        throw Base::XMLParseException("Document too large for binary format");
+    }
+    return static_cast<std::uint32_t>(size);
+}
+
+/// Collects the events of an XML document
+class Builder
+{
+public:
+    Builder()
+    {
+        offsets.push_back(0);
+    }
+
+    void add(BinaryXML::EventType type,
+             const std::string& name,
+             const std::map<std::string, std::string>& attrs,
+             const std::string& chars)
+    {
+        using EventType = BinaryXML::EventType;
+
+        BinaryXML::Event event {};
+        event.Type = type;
+        std::uint32_t index = toIndex(events.size());
+        switch (type) {
+            case EventType::Chars:
+                event.Name = addString(chars);
+                break;
+            case EventType::StartElement:
+            case EventType::StartEndElement:
+                event.Name = addString(name);
+                event.First = toIndex(attributes.size());
+                event.Count = toIndex(attrs.size());
+                for (const auto& it : attrs) {
+                    attributes.push_back({addString(it.first), addString(it.second)});
+                }
+                for (auto parent : open) {
+                    if (events[parent].Name == event.Name) {
+                        events[parent].Flags |= BinaryXML::NestedName;
+                    }
+                }
+                event.End = index;
+                if (type == EventType::StartElement) {
+                    open.push_back(index);
+                }
+                break;
+            case EventType::EndElement:
+                if (open.empty()) {
+                    throw Base::XMLParseException("Unbalanced end element");
+                }
+                event.Name = addString(name);
+                events[open.back()].End = index;
+                open.pop_back();
+                break;
+            default:
+                break;
+        }
+        events.push_back(event);
+    }
+
+    std::string finish(std::uint32_t crc) const
+    {
+        BinaryXML::Header header {};
+        std::memcpy(header.Magic, "FCBX", sizeof(header.Magic));
+        header.Schema = BinaryXML::SchemaVersion;
+        header.ByteOrder = ByteOrderMark;
+        header.SourceCrc = crc;
+        header.EventCount = toIndex(events.size());
+        header.AttributeCount = toIndex(attributes.size());
+        header.StringCount = toIndex(offsets.size() - 1);
+        header.EventOffset = align(sizeof(header));
+        header.AttributeOffset =
+            align(header.EventOffset + events.size() * sizeof(BinaryXML::Event));
+        header.StringIndexOffset =
+            align(header.AttributeOffset + attributes.size() * sizeof(BinaryXML::Attribute));
+        header.StringDataOffset = header.StringIndexOffset + offsets.size() * sizeof(std::uint64_t);
+        header.StringDataSize = data.size();
+
+        std::string result(header.StringDataOffset + data.size(), '\0');
+        std::memcpy(&result[0], &header, sizeof(header));
+        std::memcpy(&result[header.EventOffset], events.data(), events.size() * sizeof(events[0]));
+        std::memcpy(&result[header.AttributeOffset],
+                    attributes.data(),
+                    attributes.size() * sizeof(attributes[0]));
+        std::memcpy(&result[header.StringIndexOffset],
+                    offsets.data(),
+                    offsets.size() * sizeof(offsets[0]));
+        std::memcpy(&result[header.StringDataOffset], data.data(), data.size());
+        return result;
+    }
+
+private:
+    std::uint32_t addString(const std::string& str)
+    {
+        auto res = ids.emplace(str, toIndex(offsets.size() - 1));
+        if (res.second) {
+            data.append(str.c_str(), str.size() + 1);
+            offsets.push_back(data.size());
+        }
+        return res.first->second;
+    }
+
+    std::vector<BinaryXML::Event> events;
+    std::vector<BinaryXML::Attribute> attributes;
+    std::vector<std::uint64_t> offsets;
+    std::string data;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::vector<std::uint32_t> open;
+};
+
+void writeEscaped(std::ostream& out, const char* str, bool attribute)
+{
+    for (; *str; ++str) {
+        switch (*str) {
+            case '&':
+                out << "&amp;";
+                break;
+            case '<':
+                out << "&lt;";
+                break;
+            case '>':
+                out << "&gt;";
+                break;
+            case '\r':
+                out << "&#13;";
+                break;
+            case '"':
+                out << (attribute ? "&quot;" : "\"");
+                break;
+            case '\n':
+                out << (attribute ? "&#10;" : "\n");
+                break;
+            case '\t':
+                out << (attribute ? "&#9;" : "\t");
+                break;
+            default:
+                out << *str;
+                break;
+        }
+    }
+}
+
+}  // namespace
+
+BinaryXML::~BinaryXML() = default;
+
+std::string BinaryXML::fromXML(const std::string& xml, const char* fileName)
+{
+    static_assert(int(EventType::Chars) == int(XMLReader::Chars)
+                      && int(EventType::StartElement) == int(XMLReader::StartElement)
+                      && int(EventType::EndCDATA) == int(XMLReader::EndCDATA),
+                  "Event types must match XMLReader");
+
+    std::istringstream str(xml);
+    XMLReader reader(fileName, str);
+    if (!reader.isValid()) {
+        throw Base::XMLParseException(std::string("Failed to parse ") + fileName);
+    }
+
+    // Record the state of the reader after each step
+    Builder builder;
+    for (;;) {
+        builder.add(static_cast<EventType>(reader.ReadType),
+                    reader.LocalName,
+                    reader.AttrMap,
+                    reader.Characters);
+        if (reader.ReadType == XMLReader::EndDocument) {
+            break;
+        }
+        reader.read();
+    }
+
+    auto crc = crc32(crc32(0, Z_NULL, 0),
+                     reinterpret_cast<const Bytef*>(xml.data()),  // NOLINT
+                     static_cast<uInt>(xml.size()));
+    return builder.finish(static_cast<std::uint32_t>(crc));
+}
+
+std::shared_ptr<const BinaryXML> BinaryXML::fromBuffer(std::string data)
+{
+    std::shared_ptr<BinaryXML> binary(new BinaryXML());
+    binary->buffer = std::move(data);
+    binary->setData(binary->buffer.data(), binary->buffer.size(), "Document.fcbx");
+    return binary;
+}
+
+std::shared_ptr<const BinaryXML> BinaryXML::fromFile(const char* fileName)
+{
+    std::shared_ptr<BinaryXML> binary(new BinaryXML());
+    binary->file = std::make_unique<QFile>(QString::fromUtf8(fileName));
+    if (!binary->file->open(QIODevice::ReadOnly)) {
+        throw Base::FileException("Failed to open file", fileName);
+    }
+
+    qint64 size = binary->file->size();
+    const uchar* data = binary->file->map(0, size);
+    if (data) {
+        binary->setData(reinterpret_cast<const char*>(data),  // NOLINT
+                        static_cast<std::size_t>(size),
+                        fileName);
+    }
+    else {
+        // mapping is not supported by all file systems
+        QByteArray bytes = binary->file->readAll();
+        binary->file.reset();
+        binary->buffer.assign(bytes.constData(), bytes.size());
+        binary->setData(binary->buffer.data(), binary->buffer.size(), fileName);
+    }
+    return binary;
+}
+
+void BinaryXML::setData(const char* data, std::size_t size, const char* fileName)
+{
+    auto check = [fileName](bool ok, const char* msg) {
+        if (!ok) {
+            throw Base::FileException(msg, fileName);
+        }
+    };
+    auto inRange = [size](std::uint64_t offset, std::uint64_t count, std::size_t elementSize) {
+        return offset % Alignment == 0 && offset <= size
+            && count <= (size - offset) / elementSize;
+    };
+
+    check(size >= sizeof(Header)
+              && reinterpret_cast<std::uintptr_t>(data) % Alignment == 0,  // NOLINT
+          "Invalid binary document");
+    const auto hdr = reinterpret_cast<const Header*>(data);  // NOLINT
+    check(std::memcmp(hdr->Magic, "FCBX", sizeof(hdr->Magic)) == 0, "Invalid binary document");
+    check(hdr->ByteOrder == ByteOrderMark, "Unsupported byte order of binary document");
+    check(hdr->Schema > 0 && hdr->Schema <= SchemaVersion,
+          "Unsupported schema version of binary document");
+    check(inRange(hdr->EventOffset, hdr->EventCount, sizeof(Event))
+              && inRange(hdr->AttributeOffset, hdr->AttributeCount, sizeof(Attribute))
+              && inRange(hdr->StringIndexOffset,
+                         std::uint64_t(hdr->StringCount) + 1,
+                         sizeof(std::uint64_t))
+              && hdr->StringDataOffset <= size
+              && hdr->StringDataSize <= size - hdr->StringDataOffset,
+          "Truncated binary document");
+
+    // NOLINTBEGIN
+    auto evts = reinterpret_cast<const Event*>(data + hdr->EventOffset);
+    auto attrs = reinterpret_cast<const Attribute*>(data + hdr->AttributeOffset);
+    auto offsets = reinterpret_cast<const std::uint64_t*>(data + hdr->StringIndexOffset);
+    const char* strs = data + hdr->StringDataOffset;
+    // NOLINTEND
+
+    // Validate once, so that the reader can access the data without checks
+    bool ok = offsets[0] == 0 && offsets[hdr->StringCount] == hdr->StringDataSize;
+    for (std::uint32_t i = 0; ok && i < hdr->StringCount; ++i) {
+        ok = offsets[i] < offsets[i + 1] && strs[offsets[i + 1] - 1] == '\0';
+    }
+    check(ok, "Corrupted string table in binary document");
+
+    for (std::uint32_t i = 0; ok && i < hdr->AttributeCount; ++i) {
+        ok = attrs[i].Name < hdr->StringCount && attrs[i].Value < hdr->StringCount;
+    }
+    for (std::uint32_t i = 0; ok && i < hdr->EventCount; ++i) {
+        const Event& event = evts[i];
+        switch (event.Type) {
+            case EventType::Chars:
+            case EventType::EndElement:
+                ok = event.Name < hdr->StringCount;
+                break;
+            case EventType::StartElement:
+            case EventType::StartEndElement:
+                ok = event.Name < hdr->StringCount && event.First <= hdr->AttributeCount
+                    && event.Count <= hdr->AttributeCount - event.First
+                    && event.End < hdr->EventCount && event.End >= i
+                    && (event.Type == EventType::StartEndElement
+                        || evts[event.End].Type == EventType::EndElement);
+                break;
+            default:
+                ok = event.Type <= EventType::EndCDATA;
+                break;
+        }
+    }
+    check(ok, "Corrupted binary document");
+
+    header = hdr;
+    events = evts;
+    attributes = attrs;
+    stringOffsets = offsets;
+    strings = strs;
+}
+
+void BinaryXML::toXML(std::ostream& out) const
+{
+    bool cdata = false;
+    for (std::size_t i = 0; i < getEventCount(); ++i) {
+        const Event& event = events[i];
+        switch (event.Type) {
+            case EventType::StartDocument:
+                out << "<?xml version='1.0' encoding='utf-8'?>\n";
+                break;
+            case EventType::StartElement:
+            case EventType::StartEndElement: {
+                out << '<' << getString(event.Name);
+                const Attribute* attrs = getAttributes(event);
+                for (std::uint32_t j = 0; j < event.Count; ++j) {
+                    out << ' ' << getString(attrs[j].Name) << "=\"";
+                    writeEscaped(out, getString(attrs[j].Value), true);
+                    out << '"';
+                }
+                out << (event.Type == EventType::StartEndElement ? "/>" : ">");
+            } break;
+            case EventType::EndElement:
+                out << "</" << getString(event.Name) << '>';
+                break;
+            case EventType::Chars:
+                if (cdata) {
+                    out.write(getString(event.Name),
+                              static_cast<std::streamsize>(getStringLength(event.Name)));
+                }
+                else {
+                    writeEscaped(out, getString(event.Name), false);
+                }
+                break;
+            case EventType::StartCDATA:
+                out << "<![CDATA[";
+                cdata = true;
+                break;
+            case EventType::EndCDATA:
+                out << "]]>";
+                cdata = false;
+                break;
+            default:
+                break;
+        }
+    }
+}
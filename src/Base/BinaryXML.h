@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_BINARYXML_H
+#define BASE_BINARYXML_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "FCGlobal.h"
+
+class QFile;
+
+namespace Base
+{
+
+/** The BinaryXML class
+ * A binary form of an XML document, e.g. Document.xml, that can be read by
+ * XMLReader without parsing.
+ *
+ * The document is stored as the sequence of events XMLReader sees when
+ * parsing the XML, so that restoring from it gives exactly the same result.
+ * All names, attribute values and character data go into a string table of
+ * null-terminated strings, hence they are used in place. A start element holds
+ * the index of its end element, which allows skipping whole sub-trees.
+ *
+ * The layout consists of fixed-size records at aligned offsets given in the
+ * header, so a file can be memory mapped and used as it is.
+ *
+ * \code
+ * Header
+ * Event[EventCount]
+ * Attribute[AttributeCount]
+ * uint64 StringOffsets[StringCount + 1]
+ * char StringData[StringDataSize]
+ * \endcode
+ */
+class BaseExport BinaryXML
+{
+public:
+    /// Version of the layout, readers accept older versions
+    static constexpr std::uint32_t SchemaVersion = 1;
+
+    enum class EventType : std::uint8_t
+    {
+        None = 0,
+        Chars,
+        StartDocument,
+        EndDocument,
+        StartElement,
+        StartEndElement,
+        EndElement,
+        StartCDATA,
+        EndCDATA
+    };
+
+    enum EventFlags : std::uint8_t
+    {
+        /// A descendant of the element has the same name
+        NestedName = 1
+    };
+
+    struct Header
+    {
+        char Magic[4];
+        std::uint32_t Schema;
+        std::uint32_t ByteOrder;
+        /// CRC32 of the XML text the document was created from
+        std::uint32_t SourceCrc;
+        std::uint32_t EventCount;
+        std::uint32_t AttributeCount;
+        std::uint32_t StringCount;
+        std::uint32_t Reserved;
+        std::uint64_t EventOffset;
+        std::uint64_t AttributeOffset;
+        std::uint64_t StringIndexOffset;
+        std::uint64_t StringDataOffset;
+        std::uint64_t StringDataSize;
+    };
+
+    struct Event
+    {
+        EventType Type;
+        std::uint8_t Flags;
+        std::uint16_t Reserved;
+        /// element name or character data
+        std::uint32_t Name;
+        /// first attribute of a start element
+        std::uint32_t First;
+        /// number of attributes of a start element
+        std::uint32_t Count;
+        /// index of the end event of a start element
+        std::uint32_t End;
+    };
+
+    struct Attribute
+    {
+        std::uint32_t Name;
+        std::uint32_t Value;
+    };
+
+    /** Convert an XML document
+     * @param xml: the XML text
+     * @param fileName: used for error messages
+     * @return the binary document, throws Base::XMLParseException on errors
+     */
+    static std::string fromXML(const std::string& xml, const char* fileName = "Document.xml");
+    /// Use the data of a binary document, throws Base::FileException if invalid
+    static std::shared_ptr<const BinaryXML> fromBuffer(std::string data);
+    /// Memory map a binary document file, throws Base::FileException if invalid
+    static std::shared_ptr<const BinaryXML> fromFile(const char* fileName);
+
+    ~BinaryXML();
+
+    BinaryXML(const BinaryXML&) = delete;
+    BinaryXML(BinaryXML&&) = delete;
+    BinaryXML& operator=(const BinaryXML&) = delete;
+    BinaryXML& operator=(BinaryXML&&) = delete;
+
+    /// Write the document as XML text
+    void toXML(std::ostream& out) const;
+
+    /// CRC32 of the XML text the document was created from
+    std::uint32_t getSourceCrc() const
+    {
+        return header->SourceCrc;
+    }
+    std::size_t getEventCount() const
+    {
+        return header->EventCount;
+    }
+    const Event& getEvent(std::size_t index) const
+    {
+        return events[index];
+    }
+    const Attribute* getAttributes(const Event& event) const
+    {
+        return attributes + event.First;
+    }
+    const char* getString(std::uint32_t index) const
+    {
+        return strings + stringOffsets[index];
+    }
+    std::size_t getStringLength(std::uint32_t index) const
+    {
+        return stringOffsets[index + 1] - stringOffsets[index] - 1;
+    }
+
+private:
+    BinaryXML() = default;
+    void setData(const char* data, std::size_t size, const char* fileName);
+
+    std::string buffer;
+    std::unique_ptr<QFile> file;
+    const Header* header {nullptr};
+    const Event* events {nullptr};
+    const Attribute* attributes {nullptr};
+    const std::uint64_t* stringOffsets {nullptr};
+    const char* strings {nullptr};
+};
+
+}  // namespace Base
+
+#endif  // BASE_BINARYXML_H
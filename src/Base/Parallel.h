@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_PARALLEL_H
+#define BASE_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
+
+
+namespace Base
+{
+
+/**
+ * Calls \a func(first, last) for consecutive ranges of [0, \a count) on at most \a threads
+ * threads, 0 means one per core. The ranges are handed out in blocks of \a grain elements
+ * to balance the load. The calling thread takes part, the other threads are taken from the
+ * global QThreadPool, so no thread is started per call.
+ *
+ * As long as \a func only writes the elements of its range the result doesn't depend on
+ * the number of threads. The first exception thrown by \a func stops the remaining blocks
+ * and is rethrown.
+ */
+template<class Func>
+void parallelFor(std::size_t count, int threads, Func func, std::size_t grain = 1024)
+{
+    grain = std::max<std::size_t>(grain, 1);
+    if (threads <= 0) {
+        threads = QThread::idealThreadCount();
+    }
+    std::size_t blocks = (count + grain - 1) / grain;
+    auto numThreads = std::min<std::size_t>(std::max(threads, 1), blocks);
+    if (numThreads < 2) {
+        if (count > 0) {
+            func(std::size_t(0), count);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next {0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto run = [&]() {
+        try {
+            for (;;) {
+                std::size_t first = next.fetch_add(grain);
+                if (first >= count) {
+                    break;
+                }
+                func(first, std::min(first + grain, count));
+            }
+        }
+        catch (...) {
+            next = count;
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    // A task that hasn't started yet when waiting for it is run by the waiting thread,
+    // so nested calls don't block the pool
+    std::vector<QFuture<void>> futures;
+    futures.reserve(numThreads - 1);
+    for (std::size_t i = 1; i < numThreads; i++) {
+        futures.push_back(QtConcurrent::run(run));
+    }
+    run();
+    for (auto& future : futures) {
+        future.waitForFinished();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Calls \a func for each element of the random access \a container in parallel,
+ * see parallelFor().
+ */
+template<class Container, class Func>
+void parallelForEach(Container& container, int threads, Func func)
+{
+    parallelFor(
+        container.size(),
+        threads,
+        [&container, &func](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                func(container[i]);
+            }
+        },
+        1);
+}
+
+}  // namespace Base
+
+#endif  // BASE_PARALLEL_H
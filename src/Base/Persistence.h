@@ -24,10 +24,13 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <memory>
+
 #include "BaseClass.h"
 
 namespace Base
 {
+class DeferredFile;
 class Reader;
 class Writer;
 class XMLReader;
@@ -112,6 +115,17 @@ public:
      * ostream).
      */
     virtual void SaveDocFile(Writer& /*writer*/) const;
+    /** Returns true if SaveDocFile() can be called from a worker thread
+     * with the given writer settings.
+     *
+     * The writer passed to SaveDocFile() is then a private buffer writer, and
+     * the implementation must neither modify any shared state nor use Python.
+     * The default implementation returns false.
+     */
+    virtual bool canSaveDocFileConcurrently(const Writer& /*writer*/) const
+    {
+        return false;
+    }
     /** This method is used to restore large amounts of data from a file
      * In this method you simply stream in your SaveDocFile() saved data.
      * Again you have to apply for the call of this method in the Restore() call:
@@ -142,6 +156,20 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Returns true if the object can keep the data of its additional file
+     * and restore it on first access.
+     *
+     * If the reader has deferred restoring enabled (see
+     * XMLReader::setDeferredRestore()), deferRestoreDocFile() is then called
+     * instead of RestoreDocFile(). The default implementation returns false.
+     */
+    virtual bool canDeferRestoreDocFile() const
+    {
+        return false;
+    }
+    /// Keep \a file to restore it on demand, see canDeferRestoreDocFile()
+    virtual void deferRestoreDocFile(const std::shared_ptr<DeferredFile>& /*file*/)
+    {}
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
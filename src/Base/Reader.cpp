@@ -28,12 +28,21 @@
 #include <xercesc/sax2/XMLReaderFactory.hpp>
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <locale>
+#include <QThread>
+#include <QtConcurrentRun>
+#include <zlib.h>
 
 #include "Reader.h"
 #include "Base64.h"
 #include "Base64Filter.h"
+#include "BinaryXML.h"
 #include "Console.h"
+#include "Exception.h"
 #include "InputSource.h"
 #include "Persistence.h"
 #include "Sequencer.h"
@@ -44,7 +53,9 @@
 #include <zipios++/zipios-config.h>
 #endif
 #include <zipios++/zipinputstream.h>
+#include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/stream.hpp>
 
 
 XERCES_CPP_NAMESPACE_USE
@@ -93,6 +104,17 @@ Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
 #endif
 }
 
+Base::XMLReader::XMLReader(const char* FileName, std::shared_ptr<const BinaryXML> binary)
+    : _File(FileName)
+    , Binary(std::move(binary))
+{
+    // the first event is the start of the document, as with parseFirst()
+    _valid = Binary && Binary->getEventCount() > 0;
+    if (_valid) {
+        readBinary();
+    }
+}
+
 Base::XMLReader::~XMLReader()
 {
     //  Delete the parser itself.  Must be done prior to calling Terminate, below.
@@ -106,15 +128,36 @@ const char* Base::XMLReader::localName() const
 
 unsigned int Base::XMLReader::getAttributeCount() const
 {
+    if (Binary) {
+        return Binary->getEvent(BinaryElement).Count;
+    }
     return static_cast<unsigned int>(AttrMap.size());
 }
 
-long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
+const char* Base::XMLReader::findAttribute(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    if (Binary) {
+        const auto& event = Binary->getEvent(BinaryElement);
+        const auto* attrs = Binary->getAttributes(event);
+        for (std::uint32_t i = 0; i < event.Count; i++) {
+            if (std::strcmp(Binary->getString(attrs[i].Name), AttrName) == 0) {
+                return Binary->getString(attrs[i].Value);
+            }
+        }
+        return nullptr;
+    }
 
+    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
     if (pos != AttrMap.end()) {
-        return atol(pos->second.c_str());
+        return pos->second.c_str();
+    }
+    return nullptr;
+}
+
+long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
+{
+    if (const char* value = findAttribute(AttrName)) {
+        return atol(value);
     }
     // wrong name, use hasAttribute if not sure!
     std::ostringstream msg;
@@ -124,10 +167,8 @@ long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 
 unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return strtoul(pos->second.c_str(), nullptr, 10);
+    if (const char* value = findAttribute(AttrName)) {
+        return strtoul(value, nullptr, 10);
     }
     // wrong name, use hasAttribute if not sure!
     std::ostringstream msg;
@@ -137,10 +178,8 @@ unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) cons
 
 double Base::XMLReader::getAttributeAsFloat(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return atof(pos->second.c_str());
+    if (const char* value = findAttribute(AttrName)) {
+        return atof(value);
     }
     // wrong name, use hasAttribute if not sure!
     std::ostringstream msg;
@@ -150,10 +189,8 @@ double Base::XMLReader::getAttributeAsFloat(const char* AttrName) const
 
 const char* Base::XMLReader::getAttribute(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
+    if (const char* value = findAttribute(AttrName)) {
+        return value;
     }
     // wrong name, use hasAttribute if not sure!
     std::ostringstream msg;
@@ -163,13 +200,18 @@ const char* Base::XMLReader::getAttribute(const char* AttrName) const
 
 bool Base::XMLReader::hasAttribute(const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != nullptr;
 }
 
 bool Base::XMLReader::read()
 {
     ReadType = None;
 
+    if (Binary) {
+        readBinary();
+        return true;
+    }
+
     try {
         parser->parseNext(token);
     }
@@ -273,6 +315,17 @@ void Base::XMLReader::readEndElement(const char* ElementName, int level)
         throw Base::XMLParseException("End of document reached");
     }
 
+    if (Binary && ReadType == StartElement && ElementName && LocalName == ElementName) {
+        // Jump to the end of the current element, unless the end of a nested
+        // element with the same name would be found first
+        const auto& event = Binary->getEvent(BinaryElement);
+        if (level >= 0 ? level == Level - 1 : (event.Flags & BinaryXML::NestedName) == 0) {
+            BinaryIndex = event.End;
+            readBinary();
+            return;
+        }
+    }
+
     bool ok {};
     do {
         ok = read();
@@ -286,6 +339,55 @@ void Base::XMLReader::readEndElement(const char* ElementName, int level)
              || (ElementName && (LocalName != ElementName || (level >= 0 && level != Level))));
 }
 
+void Base::XMLReader::readBinary()
+{
+    if (BinaryIndex >= Binary->getEventCount()) {
+        ReadType = None;
+        return;
+    }
+
+    std::size_t index = BinaryIndex++;
+    const auto& event = Binary->getEvent(index);
+    switch (event.Type) {
+        case BinaryXML::EventType::Chars:
+            Characters.assign(Binary->getString(event.Name), Binary->getStringLength(event.Name));
+            CharacterCount += static_cast<unsigned int>(Characters.size());
+            ReadType = Chars;
+            break;
+        case BinaryXML::EventType::StartDocument:
+            ReadType = StartDocument;
+            break;
+        case BinaryXML::EventType::EndDocument:
+            ReadType = EndDocument;
+            break;
+        case BinaryXML::EventType::StartElement:
+            Level++;
+            LocalName = Binary->getString(event.Name);
+            BinaryElement = index;
+            ReadType = StartElement;
+            break;
+        case BinaryXML::EventType::StartEndElement:
+            LocalName = Binary->getString(event.Name);
+            BinaryElement = index;
+            ReadType = StartEndElement;
+            break;
+        case BinaryXML::EventType::EndElement:
+            Level--;
+            LocalName = Binary->getString(event.Name);
+            ReadType = EndElement;
+            break;
+        case BinaryXML::EventType::StartCDATA:
+            ReadType = StartCDATA;
+            break;
+        case BinaryXML::EventType::EndCDATA:
+            ReadType = EndCDATA;
+            break;
+        default:
+            ReadType = None;
+            break;
+    }
+}
+
 void Base::XMLReader::readCharacters(const char* filename, CharStreamFormat format)
 {
     Base::FileInfo fi(filename);
@@ -421,6 +523,13 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // project file was created without GUI
         return;
     }
+    if (ConcurrentRead || DeferredRestore) {
+        // the first entry is read by PendingFiles
+        PendingFiles files(zipstream, entry, ConcurrentRead, DeferredRestore);
+        readFiles(files);
+        return;
+    }
+
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -466,6 +575,315 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
     }
 }
 
+void Base::XMLReader::setConcurrentRead(bool on)
+{
+    ConcurrentRead = on;
+}
+
+void Base::XMLReader::setDeferredRestore(bool on)
+{
+    DeferredRestore = on;
+}
+
+/** Queue of the next files of the archive, read ahead of the reader.
+ * With concurrent reading the files are decompressed in worker threads.
+ */
+struct Base::XMLReader::PendingFiles
+{
+    struct Entry
+    {
+        std::shared_ptr<DeferredFile> File;
+        std::string Data;
+        std::exception_ptr Error;
+        QFuture<void> Future;
+        bool Started {false};
+    };
+
+    PendingFiles(zipios::ZipInputStream& zipstream,
+                 zipios::ConstEntryPointer first,
+                 bool concurrent,
+                 bool deferred)
+        : zipstream(zipstream)
+        , next(std::move(first))
+        , window(concurrent ? 2 * std::max(QThread::idealThreadCount(), 1) : 1)
+        , concurrent(concurrent)
+        , deferred(deferred)
+    {}
+
+    ~PendingFiles()
+    {
+        for (auto& entry : entries) {
+            entry->Future.waitForFinished();
+        }
+    }
+
+    /// Returns the next file, or null at the end of the archive
+    Entry* front(const XMLReader& reader)
+    {
+        while (next.get() && entries.size() < window) {
+            if (!next->isValid()) {
+                next = nullptr;
+                break;
+            }
+            auto entry = std::make_shared<Entry>();
+            std::string data;
+            zipstream.readRawEntry(data);
+            entry->File = std::make_shared<DeferredFile>(next->getName(),
+                                                         std::move(data),
+                                                         next->getMethod() == zipios::DEFLATED,
+                                                         next->getSize(),
+                                                         next->getCrc());
+            if (concurrent && !isDeferred(reader, next->getName())) {
+                entry->Started = true;
+                entry->Future = QtConcurrent::run([entry]() {
+                    try {
+                        entry->Data = entry->File->inflate();
+                    }
+                    catch (...) {
+                        entry->Error = std::current_exception();
+                    }
+                });
+            }
+            entries.push_back(entry);
+
+            try {
+                next = zipstream.getNextEntry();
+            }
+            catch (const std::exception&) {
+                // there is no further entry
+                next = nullptr;
+            }
+        }
+        return entries.empty() ? nullptr : entries.front().get();
+    }
+
+    void pop()
+    {
+        entries.pop_front();
+    }
+
+    /// Returns the decompressed data of the entry
+    const std::string& data(Entry& entry) const
+    {
+        if (entry.Started) {
+            entry.Future.waitForFinished();
+            if (entry.Error) {
+                std::rethrow_exception(entry.Error);
+            }
+        }
+        else {
+            entry.Data = entry.File->inflate();
+        }
+        return entry.Data;
+    }
+
+    bool isDeferred(const XMLReader& reader, const std::string& name) const
+    {
+        if (!deferred) {
+            return false;
+        }
+        // Note: the files of an archive may belong to the local reader of a
+        // previous file, in which case they are not deferred.
+        for (const auto& it : reader.FileList) {
+            if (it.FileName == name) {
+                return it.Object->canDeferRestoreDocFile();
+            }
+        }
+        return false;
+    }
+
+    zipios::ZipInputStream& zipstream;
+    zipios::ConstEntryPointer next;
+    std::deque<std::shared_ptr<Entry>> entries;
+    std::size_t window;
+    bool concurrent;
+    bool deferred;
+};
+
+void Base::XMLReader::readFiles(PendingFiles& files) const
+{
+    // Same as readFiles(zipstream), but with the files read ahead
+    std::vector<FileEntry>::const_iterator it = FileList.begin();
+    Base::SequencerLauncher seq("Importing project files...", FileList.size());
+    while (it != FileList.end()) {
+        PendingFiles::Entry* entry = files.front(*this);
+        if (!entry) {
+            break;
+        }
+        const std::string name = entry->File->getFileName();
+        std::vector<FileEntry>::const_iterator jt = it;
+        while (jt != FileList.end() && name != jt->FileName) {
+            ++jt;
+        }
+        std::shared_ptr<XMLReader> localreader;
+        if (jt != FileList.end()) {
+            try {
+                if (files.deferred && jt->Object->canDeferRestoreDocFile()) {
+                    jt->Object->deferRestoreDocFile(entry->File);
+                }
+                else {
+                    const std::string& data = files.data(*entry);
+                    boost::iostreams::stream<boost::iostreams::array_source> str(data.data(),
+                                                                                 data.size());
+                    Base::Reader reader(str, jt->FileName, FileVersion);
+                    jt->Object->RestoreDocFile(reader);
+                    localreader = reader.getLocalReader();
+                }
+            }
+            catch (...) {
+                Base::Console().Error("Reading failed from embedded file: %s\n", name.c_str());
+            }
+            // Go to the next registered file name
+            it = jt + 1;
+        }
+
+        seq.next();
+        files.pop();
+
+        if (localreader) {
+            localreader->readFiles(files);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+Base::DeferredFile::DeferredFile(std::string fileName,
+                                 std::string data,
+                                 bool deflated,
+                                 std::size_t size,
+                                 unsigned long crc)
+    : FileName(std::move(fileName))
+    , Data(std::move(data))
+    , Deflated(deflated)
+    , Size(size)
+    , Crc(crc)
+{}
+
+Base::DeferredFile::~DeferredFile()
+{
+    if (!SpillFile.empty()) {
+        Base::FileInfo(SpillFile).deleteFile();
+    }
+}
+
+std::shared_ptr<Base::DeferredFile>
+Base::DeferredFile::deflate(std::string fileName, const std::string& data, int level)
+{
+    z_stream zs {};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw Base::RuntimeError("Failed to initialize compression");
+    }
+    std::string result(deflateBound(&zs, static_cast<uLong>(data.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));  // NOLINT
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&result[0]);  // NOLINT
+    zs.avail_out = static_cast<uInt>(result.size());
+    int err = ::deflate(&zs, Z_FINISH);
+    deflateEnd(&zs);
+    if (err != Z_STREAM_END) {
+        throw Base::FileException("Failed to compress data", fileName.c_str());
+    }
+    result.resize(zs.total_out);
+    result.shrink_to_fit();
+
+    auto input = reinterpret_cast<const Bytef*>(data.data());  // NOLINT
+    unsigned long crc = crc32(crc32(0, Z_NULL, 0), input, static_cast<uInt>(data.size()));
+    return std::make_shared<DeferredFile>(std::move(fileName),
+                                          std::move(result),
+                                          true,
+                                          data.size(),
+                                          crc);
+}
+
+const std::string& Base::DeferredFile::getFileName() const
+{
+    return FileName;
+}
+
+std::size_t Base::DeferredFile::getDataSize() const
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Data.size();
+}
+
+std::size_t Base::DeferredFile::getSize() const
+{
+    return Size;
+}
+
+unsigned long Base::DeferredFile::getCrc() const
+{
+    return Crc;
+}
+
+bool Base::DeferredFile::spill()
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (!SpillFile.empty()) {
+        return false;
+    }
+    std::string fileName = Base::FileInfo::getTempFileName("FCDeferred");
+    Base::FileInfo fi(fileName);
+    Base::ofstream file(fi, std::ios::out | std::ios::binary);
+    file.write(Data.data(), static_cast<std::streamsize>(Data.size()));
+    file.close();
+    if (!file) {
+        fi.deleteFile();
+        return false;
+    }
+    SpillFile = fileName;
+    Data = std::string();
+    return true;
+}
+
+bool Base::DeferredFile::isSpilled() const
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    return !SpillFile.empty();
+}
+
+std::string Base::DeferredFile::getData() const
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    if (SpillFile.empty()) {
+        return Data;
+    }
+    Base::ifstream file(Base::FileInfo(SpillFile), std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw Base::FileException("Failed to read temporary file", SpillFile.c_str());
+    }
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+std::string Base::DeferredFile::inflate() const
+{
+    std::string data = getData();
+    if (!Deflated) {
+        return data;
+    }
+
+    std::string result(Size, '\0');
+    z_stream zs {};
+    if (inflateInit2(&zs, -MAX_WBITS) != Z_OK) {
+        throw Base::RuntimeError("Failed to initialize decompression");
+    }
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));  // NOLINT
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&result[0]);  // NOLINT
+    zs.avail_out = static_cast<uInt>(result.size());
+    int err = ::inflate(&zs, Z_FINISH);
+    inflateEnd(&zs);
+    if ((err != Z_STREAM_END && err != Z_BUF_ERROR) || zs.total_out != Size) {
+        throw Base::FileException("Failed to decompress embedded file", FileName.c_str());
+    }
+    auto output = reinterpret_cast<const Bytef*>(result.data());  // NOLINT
+    if (crc32(crc32(0, Z_NULL, 0), output, static_cast<uInt>(result.size())) != Crc) {
+        throw Base::FileException("CRC error in embedded file", FileName.c_str());
+    }
+    return result;
+}
+
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
 {
     FileEntry temp;
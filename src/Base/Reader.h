@@ -26,6 +26,7 @@
 #include <bitset>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -50,6 +51,7 @@ XERCES_CPP_NAMESPACE_END
 
 namespace Base
 {
+class BinaryXML;
 class Persistence;
 
 /** The XML reader class
@@ -131,6 +133,10 @@ public:
     };
     /// open the file and read the first element
     XMLReader(const char* FileName, std::istream&);
+    /** read the document from its binary form instead of parsing XML
+     * @see BinaryXML
+     */
+    XMLReader(const char* FileName, std::shared_ptr<const BinaryXML> binary);
     ~XMLReader() override;
 
     /** @name boost iostream device interface */
@@ -232,6 +238,12 @@ public:
     const char* addFile(const char* Name, Base::Persistence* Object);
     /// process the requested file writes
     void readFiles(zipios::ZipInputStream& zipstream) const;
+    /// decompress the requested files in worker threads
+    void setConcurrentRead(bool on);
+    /** keep the still compressed data of requested files whose object supports
+     * it, see Persistence::canDeferRestoreDocFile()
+     */
+    void setDeferredRestore(bool on);
     /// get all registered file names
     const std::vector<std::string>& getFilenames() const;
     bool isRegistered(Base::Persistence* Object) const;
@@ -305,6 +317,13 @@ protected:
     //@}
 
 private:
+    /// the value of the named attribute of the current element, or null
+    const char* findAttribute(const char* AttrName) const;
+    /// read the next event of the binary document
+    void readBinary();
+
+    friend class BinaryXML;
+
     int Level {0};
     std::string LocalName;
     std::string Characters;
@@ -329,8 +348,13 @@ private:
 
 
     FileInfo _File;
-    XERCES_CPP_NAMESPACE_QUALIFIER SAX2XMLReader* parser;
+    XERCES_CPP_NAMESPACE_QUALIFIER SAX2XMLReader* parser {nullptr};
     XERCES_CPP_NAMESPACE_QUALIFIER XMLPScanToken token;
+    std::shared_ptr<const BinaryXML> Binary;
+    /// the next event of the binary document
+    std::size_t BinaryIndex {0};
+    /// the event of the current element of the binary document
+    std::size_t BinaryElement {0};
     bool _valid {false};
     bool _verbose {true};
 
@@ -343,13 +367,77 @@ public:
     std::vector<FileEntry> FileList;
 
 private:
+    struct PendingFiles;
+    void readFiles(PendingFiles& files) const;
+
     std::vector<std::string> FileNames;
 
     std::bitset<32> StatusBits;
+    bool ConcurrentRead {false};
+    bool DeferredRestore {false};
 
     std::unique_ptr<std::istream> CharStream;
 };
 
+/** The DeferredFile class
+ * Holds the data of an additional file as stored in a project archive, i.e.
+ * usually still compressed, to restore an object on demand.
+ * \see Persistence::canDeferRestoreDocFile()
+ */
+class BaseExport DeferredFile
+{
+public:
+    DeferredFile(std::string fileName,
+                 std::string data,
+                 bool deflated,
+                 std::size_t size,
+                 unsigned long crc);
+    ~DeferredFile();
+
+    DeferredFile(const DeferredFile&) = delete;
+    DeferredFile(DeferredFile&&) = delete;
+    DeferredFile& operator=(const DeferredFile&) = delete;
+    DeferredFile& operator=(DeferredFile&&) = delete;
+
+    /** Compress data in memory, e.g. the output of Persistence::SaveDocFile()
+     * @param fileName: name of the data used in error messages
+     * @param data: the uncompressed data
+     * @param level: zlib compression level
+     */
+    static std::shared_ptr<DeferredFile>
+    deflate(std::string fileName, const std::string& data, int level = 1);
+
+    /// name of the file in the archive
+    const std::string& getFileName() const;
+    /// size of the data held in memory, i.e. the compressed size or 0 if spilled
+    std::size_t getDataSize() const;
+    /// size of the uncompressed data
+    std::size_t getSize() const;
+    /// CRC32 of the uncompressed data
+    unsigned long getCrc() const;
+    /// decompress the data, throws an exception on corrupted data
+    std::string inflate() const;
+
+    /** Move the data held in memory to a temporary file
+     * The file is read back on demand and removed on destruction.
+     * @return true if the data has been written to the file
+     */
+    bool spill();
+    /// Check if the data has been moved to a temporary file
+    bool isSpilled() const;
+
+private:
+    std::string getData() const;
+
+    std::string FileName;
+    std::string Data;
+    bool Deflated;
+    std::size_t Size;
+    unsigned long Crc;
+    std::string SpillFile;
+    mutable std::mutex Mutex;
+};
+
 class BaseExport Reader: public std::istream
 {
 public:
@@ -23,9 +23,13 @@
 
 #include "PreCompiled.h"
 
+#include <deque>
+#include <exception>
 #include <limits>
 #include <locale>
 #include <iomanip>
+#include <QThread>
+#include <QtConcurrentRun>
 
 #include "Writer.h"
 #include "Base64.h"
@@ -34,6 +38,7 @@
 #include "FileInfo.h"
 #include "Persistence.h"
 #include "Stream.h"
+#include "TimeInfo.h"
 #include "Tools.h"
 
 #include <boost/iostreams/filtering_stream.hpp>
@@ -346,17 +351,250 @@ ZipWriter::ZipWriter(std::ostream& os)
     ZipStream.setf(ios::fixed, ios::floatfield);
 }
 
+void ZipWriter::setLevel(const std::string& extension, int level)
+{
+    Levels[extension] = level;
+}
+
+int ZipWriter::getLevel(const std::string& fileName) const
+{
+    if (!Levels.empty()) {
+        auto it = Levels.find(FileInfo(fileName).extension());
+        if (it != Levels.end()) {
+            return it->second;
+        }
+    }
+    return Level;
+}
+
 void ZipWriter::writeFiles()
 {
+    if (Concurrent) {
+        writeFilesConcurrent();
+        return;
+    }
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList[index];
+        TimeElapsed start;
+        ZipStream.setLevel(getLevel(entry.FileName));
         ZipStream.putNextEntry(entry.FileName);
         entry.Object->SaveDocFile(*this);
+        FileTimes.push_back({entry.FileName, entry.Object, TimeElapsed::diffTimeF(start)});
         index++;
     }
+    ZipStream.setLevel(Level);
+}
+
+namespace
+{
+
+// String buffer that gives access to the written data without copying it
+class OutputBuffer: public std::stringbuf
+{
+public:
+    OutputBuffer()
+        : std::stringbuf(std::ios::out)
+    {}
+
+    const char* data() const
+    {
+        return pbase();
+    }
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(pptr() - pbase());
+    }
+    void release()
+    {
+        OutputBuffer empty;
+        swap(empty);
+    }
+};
+
+// Writer to serialize an additional file into memory, see ZipWriter::writeFilesConcurrent()
+class BufferWriter: public Writer
+{
+public:
+    explicit BufferWriter(const Writer& parent)
+        : Buffer(&Data)
+    {
+        setModes(parent.getModes());
+        setFileVersion(parent.getFileVersion());
+        setForceXML(parent.isForceXML());
+        ObjectName = parent.ObjectName;
+#ifdef _MSC_VER
+        Buffer.imbue(std::locale::empty());
+#else
+        Buffer.imbue(std::locale::classic());
+#endif
+        Buffer.precision(std::numeric_limits<double>::digits10 + 1);
+        Buffer.setf(ios::fixed, ios::floatfield);
+    }
+
+    std::ostream& Stream() override
+    {
+        return Buffer;
+    }
+    void writeFiles() override
+    {}
+    const std::vector<FileEntry>& getFileList() const
+    {
+        return FileList;
+    }
+
+    OutputBuffer Data;    // NOLINT
+    std::ostream Buffer;  // NOLINT
+};
+
+struct DeflatedFile
+{
+    std::shared_ptr<BufferWriter> Output;
+    std::string Data;
+    uLong Size {0};
+    uLong Crc {0};
+    bool Stored {false};
+    float Time {0.0F};
+    std::exception_ptr Error;
+};
+
+// Compress the content of the buffer writer as raw deflate stream as expected by zip. With
+// level 0 the content is kept in the buffer writer and written as a stored entry.
+void deflateFile(DeflatedFile& file, int level)
+{
+    OutputBuffer& buffer = file.Output->Data;
+    if (buffer.size() > std::numeric_limits<uInt>::max()) {
+        throw Base::RuntimeError("File too large to be stored in a zip archive");
+    }
+
+    auto input = reinterpret_cast<const Bytef*>(buffer.data());  // NOLINT
+    file.Size = static_cast<uLong>(buffer.size());
+    file.Crc = crc32(crc32(0, Z_NULL, 0), input, static_cast<uInt>(buffer.size()));
+    if (level == Z_NO_COMPRESSION) {
+        file.Stored = true;
+        return;
+    }
+
+    z_stream zs {};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw Base::RuntimeError("Failed to initialize compression");
+    }
+    file.Data.resize(deflateBound(&zs, file.Size));
+    zs.next_in = const_cast<Bytef*>(input);  // NOLINT
+    zs.avail_in = static_cast<uInt>(buffer.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&file.Data[0]);  // NOLINT
+    zs.avail_out = static_cast<uInt>(file.Data.size());
+    int err = deflate(&zs, Z_FINISH);
+    file.Data.resize(zs.total_out);
+    deflateEnd(&zs);
+    if (err != Z_STREAM_END) {
+        throw Base::RuntimeError("Failed to compress file");
+    }
+    buffer.release();
+}
+
+}  // namespace
+
+void ZipWriter::writeFilesConcurrent()
+{
+    using Result = std::shared_ptr<DeflatedFile>;
+
+    // Limit the number of files held in memory
+    const std::size_t window = 2 * std::max(QThread::idealThreadCount(), 1);
+    std::deque<std::pair<std::size_t, QFuture<Result>>> pending;
+
+    auto writeNext = [&]() {
+        std::size_t index = pending.front().first;
+        Result file = pending.front().second.result();
+        pending.pop_front();
+        if (file->Error) {
+            std::rethrow_exception(file->Error);
+        }
+        for (const auto& msg : file->Output->getErrors()) {
+            addError(msg);
+        }
+        // files requested while saving this one
+        for (const auto& it : file->Output->getFileList()) {
+            addFile(it.FileName.c_str(), it.Object);
+        }
+        const FileEntry& entry = FileList[index];
+        if (file->Stored) {
+            ZipStream.putRawEntry(zipios::ZipCDirEntry(entry.FileName),
+                                  file->Output->Data.data(),
+                                  static_cast<zipios::uint32>(file->Size),
+                                  static_cast<zipios::uint32>(file->Size),
+                                  static_cast<zipios::uint32>(file->Crc),
+                                  zipios::STORED);
+        }
+        else {
+            ZipStream.putRawEntry(zipios::ZipCDirEntry(entry.FileName),
+                                  file->Data.data(),
+                                  static_cast<zipios::uint32>(file->Data.size()),
+                                  static_cast<zipios::uint32>(file->Size),
+                                  static_cast<zipios::uint32>(file->Crc));
+        }
+        FileTimes.push_back({entry.FileName, entry.Object, file->Time});
+    };
+
+    try {
+        // use a while loop because it is possible that while
+        // processing the files new ones can be added
+        size_t index = 0;
+        while (index < FileList.size() || !pending.empty()) {
+            if (index == FileList.size() || pending.size() >= window) {
+                writeNext();
+                continue;
+            }
+
+            FileEntry entry = FileList[index];
+            int level = getLevel(entry.FileName);
+            auto file = std::make_shared<DeflatedFile>();
+            file->Output = std::make_shared<BufferWriter>(*this);
+
+            if (entry.Object->canSaveDocFileConcurrently(*this)) {
+                pending.emplace_back(index, QtConcurrent::run([file, entry, level]() {
+                    TimeElapsed start;
+                    try {
+                        entry.Object->SaveDocFile(*file->Output);
+                        deflateFile(*file, level);
+                    }
+                    catch (...) {
+                        file->Error = std::current_exception();
+                    }
+                    file->Time = TimeElapsed::diffTimeF(start);
+                    return file;
+                }));
+            }
+            else {
+                // serialize in this thread, compress in the background
+                TimeElapsed start;
+                entry.Object->SaveDocFile(*file->Output);
+                file->Time = TimeElapsed::diffTimeF(start);
+                pending.emplace_back(index, QtConcurrent::run([file, level]() {
+                    TimeElapsed start;
+                    try {
+                        deflateFile(*file, level);
+                    }
+                    catch (...) {
+                        file->Error = std::current_exception();
+                    }
+                    file->Time += TimeElapsed::diffTimeF(start);
+                    return file;
+                }));
+            }
+            index++;
+        }
+    }
+    catch (...) {
+        // the pending tasks still refer to the saved objects
+        for (auto& it : pending) {
+            it.second.waitForFinished();
+        }
+        throw;
+    }
 }
 
 ZipWriter::~ZipWriter()
@@ -24,6 +24,7 @@
 #define BASE_WRITER_H
 
 
+#include <map>
 #include <set>
 #include <string>
 #include <sstream>
@@ -204,20 +205,58 @@ public:
     }
     void setLevel(int level)
     {
+        Level = level;
         ZipStream.setLevel(level);
     }
+    /// Set the compression level of additional files with the given extension
+    void setLevel(const std::string& extension, int level);
     void putNextEntry(const char* str)
     {
         ZipStream.putNextEntry(str);
     }
 
+    /** Serialize and compress the additional files in worker threads.
+     * The files are still written in the order they were added. Files whose
+     * object does not support Persistence::canSaveDocFileConcurrently() are
+     * serialized in the calling thread, and only compressed concurrently.
+     * Files with compression level 0 are written as stored entries.
+     */
+    void setConcurrent(bool on)
+    {
+        Concurrent = on;
+    }
+    bool isConcurrent() const
+    {
+        return Concurrent;
+    }
+
+    struct FileTime
+    {
+        std::string FileName;
+        const Base::Persistence* Object;
+        /// time in seconds to serialize and compress the file
+        float Time;
+    };
+    /// Time spent on each additional file in writeFiles()
+    const std::vector<FileTime>& getFileTimes() const
+    {
+        return FileTimes;
+    }
+
     ZipWriter(const ZipWriter&) = delete;
     ZipWriter(ZipWriter&&) = delete;
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
 private:
+    int getLevel(const std::string& fileName) const;
+    void writeFilesConcurrent();
+
     zipios::ZipOutputStream ZipStream;
+    std::map<std::string, int> Levels;
+    std::vector<FileTime> FileTimes;
+    int Level {Z_DEFAULT_COMPRESSION};
+    bool Concurrent {false};
 };
 
 /** The StringWriter class
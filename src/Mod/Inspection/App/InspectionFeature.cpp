@@ -46,6 +46,7 @@
 #include <Base/Stream.h>
 
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -199,7 +200,8 @@ protected:
         assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
     }
 
-    void AddFacet(const MeshCore::MeshGeomFacet& rclFacet, unsigned long ulFacetIndex)
+    void GetFacetCells(const MeshCore::MeshGeomFacet& rclFacet,
+                       std::vector<unsigned long>& cells) const
     {
         unsigned long ulX1;
         unsigned long ulY1;
@@ -222,21 +224,19 @@ protected:
                 for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
                     for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                         if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                            cells.push_back(CellIndex(ulX, ulY, ulZ));
                         }
                     }
                 }
             }
         }
         else {
-            _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+            cells.push_back(CellIndex(ulX1, ulY1, ulZ1));
         }
     }
 
     void InitGrid() override
     {
-        unsigned long i, j;
-
         Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
         float fLengthX = clBBMesh.LengthX();
@@ -252,14 +252,7 @@ protected:
         _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
         _fMinZ = clBBMesh.MinZ - 0.5f;
 
-        _aulGrid.clear();
-        _aulGrid.resize(_ulCtGridsX);
-        for (i = 0; i < _ulCtGridsX; i++) {
-            _aulGrid[i].resize(_ulCtGridsY);
-            for (j = 0; j < _ulCtGridsY; j++) {
-                _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
-        }
+        _aulGrid.Resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
     }
 
     void RebuildGrid() override
@@ -267,12 +260,12 @@ protected:
         _ulCtElements = _pclMesh->CountFacets();
         InitGrid();
 
-        unsigned long i = 0;
-        MeshCore::MeshFacetIterator clFIter(*_pclMesh);
-        clFIter.Transform(_transform);
-        for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-            AddFacet(*clFIter, i++);
-        }
+        _aulGrid.Build(_ulCtElements,
+                       [this](MeshCore::ElementIndex index, std::vector<unsigned long>& cells) {
+                           MeshCore::MeshGeomFacet facet = _pclMesh->GetFacet(index);
+                           facet.Transform(_transform);
+                           GetFacetCells(facet, cells);
+                       });
     }
 
 private:
@@ -281,36 +274,37 @@ private:
 }  // namespace Inspection
 
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset)
-    : _mesh(rMesh.getKernel())
+    : _pMesh(&rMesh.getKernel())
 {
     Base::Matrix4D tmp;
-    _clTrf = rMesh.getTransform();
-    _bApply = _clTrf != tmp;
-
-    // Max. limit of grid elements
-    float fMaxGridElements = 8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen =
-        (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
+    Base::Matrix4D trf = rMesh.getTransform();
+    _bApply = trf != tmp;
+    _box = _pMesh->GetBoundBox().Transformed(trf);
+    _box.Enlarge(offset);
 
-    // We want to avoid to get too small grid elements otherwise building up the grid structure
-    // would take too much time and memory. Having quite a dense grid speeds up more the following
-    // algorithms extremely. Due to the issue above it's always a compromise between speed and
-    // memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
+    // A rigid transformation keeps the distances and the orientation of the facets, so the
+    // points are transformed into the mesh instead. Otherwise a transformed copy is searched.
+    if (_bApply) {
+        if (trf.hasScale() == Base::ScaleType::NoScaling && trf.determinant3() > 0.0) {
+            _clInv = trf;
+            _clInv.inverseOrthogonal();
+        }
+        else {
+            _pTransformed = new MeshCore::MeshKernel(*_pMesh);
+            _pTransformed->Transform(trf);
+            _pMesh = _pTransformed;
+            _bApply = false;
+        }
+    }
 
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
-    _box.Enlarge(offset);
+    // Unlike a grid the hierarchy adapts to a very uneven facet density
+    _pBVH = new MeshCore::MeshFacetBVH(*_pMesh);
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
+    delete this->_pTransformed;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
@@ -319,30 +313,15 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
         return FLT_MAX;  // must be inside bbox
     }
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
-    }
-
-    float fMinDist = FLT_MAX;
-    bool positive = true;
-    for (unsigned long it : indices) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
-
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
+    Base::Vector3f pnt = _bApply ? _clInv * point : point;
+    MeshCore::FacetIndex index = _pBVH->SearchNearestFromPoint(pnt);
+    if (index == MeshCore::FACET_INDEX_MAX) {
+        return FLT_MAX;
     }
 
-    if (!positive) {
+    MeshCore::MeshGeomFacet geomFace = _pMesh->GetFacet(index);
+    float fMinDist = geomFace.DistanceToPoint(pnt);
+    if (pnt.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) <= 0) {
         fMinDist = -fMinDist;
     }
     return fMinDist;
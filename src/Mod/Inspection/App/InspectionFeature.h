@@ -38,6 +38,7 @@ namespace MeshCore
 {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }  // namespace MeshCore
 
 namespace Mesh
@@ -124,11 +125,12 @@ public:
     float getDistance(const Base::Vector3f&) const override;
 
 private:
-    const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    const MeshCore::MeshKernel* _pMesh;
+    MeshCore::MeshKernel* _pTransformed {nullptr};
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
     bool _bApply;
-    Base::Matrix4D _clTrf;
+    Base::Matrix4D _clInv;
 };
 
 class InspectionExport InspectNominalFastMesh: public InspectNominalGeometry
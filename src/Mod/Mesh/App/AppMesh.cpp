@@ -62,6 +62,7 @@ PyMOD_INIT_FUNC(Mesh)
         "User parameter:BaseApp/Preferences/Mod/Mesh");
     ParameterGrp::handle asy = handle->GetGroup("Asymptote");
     MeshCore::MeshOutput::SetAsymptoteSize(asy->GetASCII("Width", "500"), asy->GetASCII("Height"));
+    MeshCore::MeshDefinitions::SetThreadCount(int(handle->GetInt("ThreadCount", 0)));
 
     // clang-format off
     // add mesh elements
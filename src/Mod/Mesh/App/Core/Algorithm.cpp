@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
+#include <numeric>
 #endif
 
 #include <Base/Console.h>
@@ -31,7 +33,9 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -142,6 +146,15 @@ bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                      const Base::Vector3f& rclDir,
+                                      const MeshFacetBVH& rclBVH,
+                                      Base::Vector3f& rclRes,
+                                      FacetIndex& rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, Mathf::PI, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
                                       const Base::Vector3f& rclDir,
                                       float fMaxSearchArea,
@@ -2116,6 +2129,85 @@ void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 
 //----------------------------------------------------------------------------
 
+void MeshPointAdjacency::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t numPoints = _rclMesh.CountPoints();
+    _ulTopologyVersion = _rclMesh.GetTopologyVersion();
+
+    // A degenerated facet may reference a point twice
+    auto isFirst = [](const MeshFacet& facet, int index) {
+        for (int i = 0; i < index; i++) {
+            if (facet._aulPoints[i] == facet._aulPoints[index]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // The facets of a point are sorted because they are added in ascending order
+    _facetOffsets.assign(numPoints + 1, 0);
+    for (const auto& facet : rFacets) {
+        for (int i = 0; i < 3; i++) {
+            if (isFirst(facet, i)) {
+                _facetOffsets[facet._aulPoints[i] + 1]++;
+            }
+        }
+    }
+    std::partial_sum(_facetOffsets.begin(), _facetOffsets.end(), _facetOffsets.begin());
+    _facets.resize(_facetOffsets.back());
+    std::vector<std::size_t> fill(_facetOffsets.begin(), _facetOffsets.end() - 1);
+    for (FacetIndex index = 0; index < rFacets.size(); index++) {
+        const MeshFacet& facet = rFacets[index];
+        for (int i = 0; i < 3; i++) {
+            if (isFirst(facet, i)) {
+                _facets[fill[facet._aulPoints[i]]++] = index;
+            }
+        }
+    }
+
+    // Each facet adds at most two neighbours to a point, so the neighbours can be
+    // collected in place and made unique independently for each point
+    std::vector<std::size_t> counts(numPoints);
+    std::vector<PointIndex> neighbours(2 * _facets.size());
+    parallel_for(numPoints, [&](std::size_t first, std::size_t last) {
+        for (std::size_t pos = first; pos < last; pos++) {
+            PointIndex* begin = neighbours.data() + 2 * _facetOffsets[pos];
+            PointIndex* end = begin;
+            for (FacetIndex index : GetFacets(pos)) {
+                for (PointIndex point : rFacets[index]._aulPoints) {
+                    if (point != pos) {
+                        *end++ = point;
+                    }
+                }
+            }
+            std::sort(begin, end);
+            counts[pos] = std::unique(begin, end) - begin;
+        }
+    });
+
+    _pointOffsets.resize(numPoints + 1);
+    _pointOffsets[0] = 0;
+    std::partial_sum(counts.begin(), counts.end(), _pointOffsets.begin() + 1);
+    _points.resize(_pointOffsets.back());
+    parallel_for(numPoints, [&](std::size_t first, std::size_t last) {
+        for (std::size_t pos = first; pos < last; pos++) {
+            std::copy_n(neighbours.data() + 2 * _facetOffsets[pos],
+                        counts[pos],
+                        _points.data() + _pointOffsets[pos]);
+        }
+    });
+}
+
+void MeshPointAdjacency::Validate()
+{
+    if (_rclMesh.GetTopologyVersion() != _ulTopologyVersion) {
+        Rebuild();
+    }
+}
+
+//----------------------------------------------------------------------------
+
 void MeshRefEdgeToFacets::Rebuild()
 {
     _map.clear();
@@ -2153,23 +2245,36 @@ void MeshRefNormalToPoints::Rebuild()
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     _norm.resize(rPoints.size());
 
+    // The weighted normals are computed in parallel while they are summed up in facet
+    // order to get the same result as a serial loop
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (const auto& rFacet : rFacets) {
-        const MeshPoint& p0 = rPoints[rFacet._aulPoints[0]];
-        const MeshPoint& p1 = rPoints[rFacet._aulPoints[1]];
-        const MeshPoint& p2 = rPoints[rFacet._aulPoints[2]];
-        float l2p01 = Base::DistanceP2(p0, p1);
-        float l2p12 = Base::DistanceP2(p1, p2);
-        float l2p20 = Base::DistanceP2(p2, p0);
-
-        Base::Vector3f facenormal = _rclMesh.GetFacet(rFacet).GetNormal();
-        _norm[rFacet._aulPoints[0]] += facenormal * (1.0f / (l2p01 * l2p20));
-        _norm[rFacet._aulPoints[1]] += facenormal * (1.0f / (l2p12 * l2p01));
-        _norm[rFacet._aulPoints[2]] += facenormal * (1.0f / (l2p20 * l2p12));
-    }
-    for (auto& it : _norm) {
-        it.Normalize();
+    std::vector<std::array<Base::Vector3f, 3>> weighted(rFacets.size());
+    parallel_for(rFacets.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; index++) {
+            const MeshFacet& rFacet = rFacets[index];
+            const MeshPoint& p0 = rPoints[rFacet._aulPoints[0]];
+            const MeshPoint& p1 = rPoints[rFacet._aulPoints[1]];
+            const MeshPoint& p2 = rPoints[rFacet._aulPoints[2]];
+            float l2p01 = Base::DistanceP2(p0, p1);
+            float l2p12 = Base::DistanceP2(p1, p2);
+            float l2p20 = Base::DistanceP2(p2, p0);
+
+            Base::Vector3f facenormal = _rclMesh.GetFacet(rFacet).GetNormal();
+            weighted[index][0] = facenormal * (1.0f / (l2p01 * l2p20));
+            weighted[index][1] = facenormal * (1.0f / (l2p12 * l2p01));
+            weighted[index][2] = facenormal * (1.0f / (l2p20 * l2p12));
+        }
+    });
+    for (std::size_t index = 0; index < rFacets.size(); index++) {
+        for (int i = 0; i < 3; i++) {
+            _norm[rFacets[index]._aulPoints[i]] += weighted[index][i];
+        }
     }
+    parallel_for(_norm.size(), [this](std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; index++) {
+            _norm[index].Normalize();
+        }
+    });
 }
 
 const Base::Vector3f& MeshRefNormalToPoints::operator[](PointIndex pos) const
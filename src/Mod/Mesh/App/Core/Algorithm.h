@@ -46,6 +46,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -113,6 +114,19 @@ public:
                            const std::vector<FacetIndex>& raulFacets,
                            Base::Vector3f& rclRes,
                            FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the ray defined by
+     * (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method is optimized by using a bounding volume hierarchy which,
+     * unlike a grid, also works well for meshes with a very uneven facet density.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           const MeshFacetBVH& rclBVH,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
     /**
      * Searches for the nearest facet to the ray defined by (\a rclPt, \a  rclDir). The point \a
      * rclRes holds the intersection point with the ray and the nearest facet with index \a
@@ -566,6 +580,88 @@ private:
     std::vector<std::set<PointIndex>> _map;
 };
 
+/**
+ * The MeshPointAdjacency holds the neighbour points and the facets of each point in
+ * compressed row storage, i.e. two flat arrays with offsets per point. Compared to
+ * MeshRefPointToPoints and MeshRefPointToFacets it needs only a few allocations and is
+ * built in parallel, so it suits algorithms that visit all points many times like
+ * smoothing. The indices of a point are sorted in ascending order.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshPointAdjacency
+{
+public:
+    /** The indices of the neighbours of a point. */
+    class Range
+    {
+    public:
+        Range(const ElementIndex* first, const ElementIndex* last)
+            : first(first)
+            , last(last)
+        {}
+        const ElementIndex* begin() const
+        {
+            return first;
+        }
+        const ElementIndex* end() const
+        {
+            return last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+        bool empty() const
+        {
+            return first == last;
+        }
+        ElementIndex operator[](std::size_t index) const
+        {
+            return first[index];
+        }
+
+    private:
+        const ElementIndex* first;
+        const ElementIndex* last;
+    };
+
+    /// Construction
+    explicit MeshPointAdjacency(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Rebuilds the data structure if the topology of the mesh has changed
+    void Validate();
+    /// Returns the points sharing an edge with the given point
+    Range GetPoints(PointIndex pos) const
+    {
+        return {_points.data() + _pointOffsets[pos], _points.data() + _pointOffsets[pos + 1]};
+    }
+    /// Returns the facets referencing the given point
+    Range GetFacets(PointIndex pos) const
+    {
+        return {_facets.data() + _facetOffsets[pos], _facets.data() + _facetOffsets[pos + 1]};
+    }
+    /// A point is at the border if the number of its neighbour points and facets differ
+    bool IsBorder(PointIndex pos) const
+    {
+        return GetPoints(pos).size() != GetFacets(pos).size();
+    }
+
+private:
+    const MeshKernel& _rclMesh;             /**< The mesh kernel. */
+    unsigned long _ulTopologyVersion {0};   /**< Topology version of the mesh when built. */
+    std::vector<std::size_t> _pointOffsets; /**< Offsets into _points per point. */
+    std::vector<std::size_t> _facetOffsets; /**< Offsets into _facets per point. */
+    std::vector<PointIndex> _points;        /**< The neighbour points of all points. */
+    std::vector<FacetIndex> _facets;        /**< The facets of all points. */
+};
+
 /**
  * The MeshRefEdgeToFacets builds up a structure to have access to all facets
  * of an edge. On a manifold mesh an edge has one or two facets associated.
@@ -0,0 +1,491 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MESH_BVH_USE_SSE
+#endif
+
+#include "BVH.h"
+#include "Elements.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+// Nodes with at most this number of facets are never split
+constexpr std::size_t MinLeafSize = 4;
+// Nodes with more facets are split even if the SAH suggests a leaf
+constexpr std::size_t MaxLeafSize = 16;
+// Number of bins per axis to evaluate the SAH
+constexpr int BinCount = 16;
+// Relative enlargement of the node boxes to catch intersections on their faces
+constexpr float BoxTolerance = 1e-5F;
+
+// Half the surface area of a box, which is proportional to the probability that a
+// random ray hits it
+float halfArea(const Base::BoundBox3f& box)
+{
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return dx * dy + dy * dz + dz * dx;
+}
+
+float minimum(const Base::BoundBox3f& box, unsigned short axis)
+{
+    return axis == 0 ? box.MinX : axis == 1 ? box.MinY : box.MinZ;
+}
+
+float maximum(const Base::BoundBox3f& box, unsigned short axis)
+{
+    return axis == 0 ? box.MaxX : axis == 1 ? box.MaxY : box.MaxZ;
+}
+
+// A line given by a point and a unit direction. Near-zero components of the direction
+// are replaced by a tiny value so that the slab test never computes 0 * inf.
+struct Line
+{
+    alignas(16) float org[4];
+    alignas(16) float inv[4];
+
+    Line(const Base::Vector3f& pnt, const Base::Vector3f& dir)
+    {
+        constexpr float minComponent = 1e-30F;
+        for (unsigned short i = 0; i < 3; i++) {
+            float d = dir[i];
+            if (std::fabs(d) < minComponent) {
+                d = std::copysign(minComponent, d);
+            }
+            org[i] = pnt[i];
+            inv[i] = 1.0F / d;
+        }
+        // together with the infinite fourth slab of the nodes this gives an
+        // unbounded interval for the unused component
+        org[3] = 0.0F;
+        inv[3] = 1.0F;
+    }
+};
+}  // namespace
+
+struct MeshFacetBVH::BuildData
+{
+    std::vector<Base::BoundBox3f> boxes;
+    std::vector<Base::Vector3f> centers;
+    float tolerance;
+};
+
+namespace
+{
+// Intersects the line with the box of the node. Returns false if the line misses the
+// box, otherwise the distance from the point of the line to the nearest point of the
+// line inside the box.
+template<typename Node>
+bool intersectLine(const Node& node, const Line& line, float& rfDist)
+{
+#ifdef MESH_BVH_USE_SSE
+    const __m128 org = _mm_load_ps(line.org);
+    const __m128 inv = _mm_load_ps(line.inv);
+    __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.lower), org), inv);
+    __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.upper), org), inv);
+    __m128 lo = _mm_min_ps(t1, t2);
+    __m128 hi = _mm_max_ps(t1, t2);
+    // horizontal maximum of lo and minimum of hi
+    lo = _mm_max_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    lo = _mm_max_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_min_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_min_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    float tmin = _mm_cvtss_f32(lo);
+    float tmax = _mm_cvtss_f32(hi);
+#else
+    float tmin = -std::numeric_limits<float>::max();
+    float tmax = std::numeric_limits<float>::max();
+    for (int i = 0; i < 3; i++) {
+        float t1 = (node.lower[i] - line.org[i]) * line.inv[i];
+        float t2 = (node.upper[i] - line.org[i]) * line.inv[i];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+    }
+#endif
+    if (tmin > tmax) {
+        return false;
+    }
+    rfDist = tmin > 0.0F ? tmin : (tmax < 0.0F ? -tmax : 0.0F);
+    return true;
+}
+
+template<typename Node>
+float distanceP2(const Node& node, const Base::Vector3f& pnt)
+{
+    float dist = 0.0F;
+    for (unsigned short i = 0; i < 3; i++) {
+        float d = std::max({node.lower[i] - pnt[i], 0.0F, pnt[i] - node.upper[i]});
+        dist += d * d;
+    }
+    return dist;
+}
+}  // namespace
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclM)
+    : _rclMesh(rclM)
+    , _ulCtElements(0)
+{
+    Rebuild();
+}
+
+void MeshFacetBVH::Validate()
+{
+    if (_rclMesh.CountFacets() != _ulCtElements) {
+        Rebuild();
+    }
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    _ulCtElements = _rclMesh.CountFacets();
+    _nodes.clear();
+    _facets.resize(_ulCtElements);
+    std::iota(_facets.begin(), _facets.end(), 0);
+    if (_ulCtElements == 0) {
+        return;
+    }
+
+    BuildData data;
+    data.boxes.reserve(_ulCtElements);
+    data.centers.reserve(_ulCtElements);
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    for (const auto& facet : facets) {
+        Base::BoundBox3f box;
+        box.Add(points[facet._aulPoints[0]]);
+        box.Add(points[facet._aulPoints[1]]);
+        box.Add(points[facet._aulPoints[2]]);
+        data.boxes.push_back(box);
+        data.centers.push_back(box.GetCenter());
+    }
+    data.tolerance = BoxTolerance * _rclMesh.GetBoundBox().CalcDiagonalLength();
+
+    // Leaves hold up to MinLeafSize facets, so there are about 2 * n / MinLeafSize nodes.
+    // This is only a hint, smaller leaves make the tree grow up to 2 * n - 1 nodes.
+    _nodes.reserve(2 * _ulCtElements / MinLeafSize + 1);
+    BuildNode(data, 0, _ulCtElements);
+    _nodes.shrink_to_fit();
+}
+
+void MeshFacetBVH::BuildNode(BuildData& data, std::size_t first, std::size_t count)
+{
+    // Note: the references to _nodes get invalid by the recursion, so use the index
+    std::size_t nodeIndex = _nodes.size();
+    _nodes.emplace_back();
+
+    Base::BoundBox3f box;
+    Base::BoundBox3f centerBox;
+    for (std::size_t i = first; i < first + count; i++) {
+        box.Add(data.boxes[_facets[i]]);
+        centerBox.Add(data.centers[_facets[i]]);
+    }
+    {
+        Node& node = _nodes[nodeIndex];
+        for (unsigned short i = 0; i < 3; i++) {
+            node.lower[i] = minimum(box, i) - data.tolerance;
+            node.upper[i] = maximum(box, i) + data.tolerance;
+        }
+        node.lower[3] = -std::numeric_limits<float>::max();
+        node.upper[3] = std::numeric_limits<float>::max();
+        node.index = static_cast<std::uint32_t>(first);
+        node.count = static_cast<std::uint32_t>(count);
+    }
+    if (count <= MinLeafSize) {
+        return;
+    }
+
+    // Find the split with the lowest cost by sorting the facet centers into bins
+    struct Bin
+    {
+        Base::BoundBox3f box;
+        std::size_t count = 0;
+    };
+
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    for (unsigned short axis = 0; axis < 3; axis++) {
+        float lower = minimum(centerBox, axis);
+        float extent = maximum(centerBox, axis) - lower;
+        if (extent <= 0.0F) {
+            continue;
+        }
+
+        float scale = static_cast<float>(BinCount) / extent;
+        Bin bins[BinCount];
+        for (std::size_t i = first; i < first + count; i++) {
+            int bin = static_cast<int>((data.centers[_facets[i]][axis] - lower) * scale);
+            Bin& b = bins[std::min(bin, BinCount - 1)];
+            b.count++;
+            b.box.Add(data.boxes[_facets[i]]);
+        }
+
+        float rightCost[BinCount] {};
+        Base::BoundBox3f right;
+        std::size_t rightCount = 0;
+        for (int i = BinCount - 1; i > 0; i--) {
+            if (bins[i].count > 0) {
+                right.Add(bins[i].box);
+                rightCount += bins[i].count;
+            }
+            rightCost[i] = rightCount > 0 ? halfArea(right) * float(rightCount) : 0.0F;
+        }
+
+        Base::BoundBox3f left;
+        std::size_t leftCount = 0;
+        for (int i = 0; i < BinCount - 1; i++) {
+            if (bins[i].count > 0) {
+                left.Add(bins[i].box);
+                leftCount += bins[i].count;
+            }
+            if (leftCount == 0 || leftCount == count) {
+                continue;
+            }
+            float cost = halfArea(left) * float(leftCount) + rightCost[i + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = int(axis);
+                bestSplit = i + 1;
+            }
+        }
+    }
+
+    float leafCost = halfArea(box) * float(count);
+    if (bestCost >= leafCost && count <= MaxLeafSize) {
+        return;
+    }
+
+    auto begin = _facets.begin() + static_cast<std::ptrdiff_t>(first);
+    auto end = begin + static_cast<std::ptrdiff_t>(count);
+    auto middle = begin + static_cast<std::ptrdiff_t>(count / 2);
+    if (bestAxis >= 0) {
+        auto axis = static_cast<unsigned short>(bestAxis);
+        float lower = minimum(centerBox, axis);
+        float scale = static_cast<float>(BinCount) / (maximum(centerBox, axis) - lower);
+        middle = std::partition(begin, end, [&](FacetIndex index) {
+            int bin = static_cast<int>((data.centers[index][axis] - lower) * scale);
+            return std::min(bin, BinCount - 1) < bestSplit;
+        });
+    }
+    // else all centers coincide, so any split is as good as another
+
+    std::size_t leftCount = static_cast<std::size_t>(middle - begin);
+    _nodes[nodeIndex].count = 0;
+    BuildNode(data, first, leftCount);
+    _nodes[nodeIndex].index = static_cast<std::uint32_t>(_nodes.size());
+    BuildNode(data, first + leftCount, count - leftCount);
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                     const Base::Vector3f& rclDir,
+                                     float fMaxAngle,
+                                     Base::Vector3f& rclRes,
+                                     FacetIndex& rulFacet) const
+{
+    float len = rclDir.Length();
+    if (_nodes.empty() || len == 0.0F) {
+        return false;
+    }
+
+    Line line(rclPt, rclDir / len);
+    float bestDist = std::numeric_limits<float>::max();
+    FacetIndex bestFacet = FACET_INDEX_MAX;
+    Base::Vector3f res;
+
+    // Visit the nearer child first and skip nodes farther away than the best hit
+    std::vector<std::pair<std::uint32_t, float>> stack;
+    stack.reserve(64);
+    float rootDist {};
+    if (intersectLine(_nodes[0], line, rootDist)) {
+        stack.emplace_back(0, rootDist);
+    }
+    while (!stack.empty()) {
+        auto [index, dist] = stack.back();
+        stack.pop_back();
+        if (dist > bestDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                if (_rclMesh.GetFacet(facet).Foraminate(rclPt, rclDir, res, fMaxAngle)) {
+                    float d = Base::Distance(res, rclPt);
+                    // prefer the lower index on a tie like the linear search does
+                    if (d < bestDist || (d == bestDist && facet < bestFacet)) {
+                        bestDist = d;
+                        bestFacet = facet;
+                        rclRes = res;
+                    }
+                }
+            }
+            continue;
+        }
+
+        std::uint32_t left = index + 1;
+        std::uint32_t right = node.index;
+        float distLeft {};
+        float distRight {};
+        bool hitLeft = intersectLine(_nodes[left], line, distLeft);
+        bool hitRight = intersectLine(_nodes[right], line, distRight);
+        if (hitLeft && hitRight && distLeft < distRight) {
+            stack.emplace_back(right, distRight);
+            stack.emplace_back(left, distLeft);
+        }
+        else {
+            if (hitLeft) {
+                stack.emplace_back(left, distLeft);
+            }
+            if (hitRight) {
+                stack.emplace_back(right, distRight);
+            }
+        }
+    }
+
+    if (bestFacet == FACET_INDEX_MAX) {
+        return false;
+    }
+    rulFacet = bestFacet;
+    return true;
+}
+
+FacetIndex MeshFacetBVH::SearchNearestFromPoint(const Base::Vector3f& rclPt,
+                                                float fMaxDist,
+                                                float& rfDist) const
+{
+    if (_nodes.empty()) {
+        return FACET_INDEX_MAX;
+    }
+
+    float bestDist = fMaxDist;
+    FacetIndex bestFacet = FACET_INDEX_MAX;
+
+    std::vector<std::pair<std::uint32_t, float>> stack;
+    stack.reserve(64);
+    stack.emplace_back(0, distanceP2(_nodes[0], rclPt));
+    while (!stack.empty()) {
+        auto [index, dist2] = stack.back();
+        stack.pop_back();
+        if (dist2 > bestDist * bestDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                float d = _rclMesh.GetFacet(facet).DistanceToPoint(rclPt);
+                if (d < bestDist) {
+                    bestDist = d;
+                    bestFacet = facet;
+                }
+            }
+            continue;
+        }
+
+        std::uint32_t left = index + 1;
+        std::uint32_t right = node.index;
+        float distLeft = distanceP2(_nodes[left], rclPt);
+        float distRight = distanceP2(_nodes[right], rclPt);
+        if (distLeft < distRight) {
+            stack.emplace_back(right, distRight);
+            stack.emplace_back(left, distLeft);
+        }
+        else {
+            stack.emplace_back(left, distLeft);
+            stack.emplace_back(right, distRight);
+        }
+    }
+
+    if (bestFacet != FACET_INDEX_MAX) {
+        rfDist = bestDist;
+    }
+    return bestFacet;
+}
+
+FacetIndex MeshFacetBVH::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
+{
+    float dist {};
+    return SearchNearestFromPoint(rclPt, std::numeric_limits<float>::max(), dist);
+}
+
+void MeshFacetBVH::Collect(const std::function<bool(const Base::BoundBox3f&)>& test,
+                           std::vector<FacetIndex>& raulFacets) const
+{
+    if (_nodes.empty()) {
+        return;
+    }
+
+    std::vector<std::uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        std::uint32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[index];
+        if (!test(node.GetBoundBox())) {
+            continue;
+        }
+        if (node.count > 0) {
+            raulFacets.insert(raulFacets.end(),
+                              _facets.begin() + node.index,
+                              _facets.begin() + node.index + node.count);
+        }
+        else {
+            stack.push_back(node.index);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+void MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const
+{
+    std::vector<FacetIndex> facets;
+    Collect(
+        [&rclBB](const Base::BoundBox3f& box) {
+            return box.Intersect(rclBB);
+        },
+        facets);
+    for (FacetIndex facet : facets) {
+        if (_rclMesh.GetFacet(facet).GetBoundBox().Intersect(rclBB)) {
+            raulFacets.push_back(facet);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ *
+ * Unlike MeshFacetGrid it adapts to the distribution of the facets: the tree is split
+ * where the surface area heuristic (SAH) estimates the lowest query cost. So it keeps
+ * its performance for meshes with a very uneven facet density, e.g. meshes of CAD
+ * models with large planar faces next to small fillets.
+ *
+ * The hierarchy refers to the mesh kernel and must be rebuilt when the geometry of
+ * the mesh changes.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Construction
+    explicit MeshFacetBVH(const MeshKernel& rclM);
+
+    /** Rebuilds the hierarchy. */
+    void Rebuild();
+    /** Rebuilds the hierarchy if the number of facets has changed. */
+    void Validate();
+
+    /** @name Search */
+    //@{
+    /**
+     * Searches for the nearest facet to the ray defined by (\a rclPt, \a rclDir).
+     * Like MeshAlgorithm::NearestFacetOnRay() the ray is treated as a line, i.e.
+     * facets behind \a rclPt are found as well. The angle between the ray and the
+     * normal of the facet must be less than or equal to \a fMaxAngle.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           float fMaxAngle,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet from a point within the distance \a fMaxDist.
+     * Returns FACET_INDEX_MAX if there is no such facet, otherwise \a rfDist is set
+     * to the distance.
+     */
+    FacetIndex
+    SearchNearestFromPoint(const Base::Vector3f& rclPt, float fMaxDist, float& rfDist) const;
+    /** Searches for the nearest facet from a point. */
+    FacetIndex SearchNearestFromPoint(const Base::Vector3f& rclPt) const;
+    /** Appends the facets whose bounding boxes intersect \a rclBB to \a raulFacets. */
+    void Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const;
+    /**
+     * Appends the facets of all leaves to \a raulFacets whose bounding boxes pass
+     * \a test. Subtrees whose bounding box doesn't pass the test are skipped, so the
+     * test must also be passed by any box enclosing a passing box.
+     */
+    void Collect(const std::function<bool(const Base::BoundBox3f&)>& test,
+                 std::vector<FacetIndex>& raulFacets) const;
+    //@}
+
+    /** Returns the number of nodes of the hierarchy. */
+    std::size_t CountNodes() const
+    {
+        return _nodes.size();
+    }
+    /** Returns the allocated memory in bytes. */
+    std::size_t GetMemSize() const
+    {
+        return _nodes.capacity() * sizeof(Node) + _facets.capacity() * sizeof(FacetIndex);
+    }
+
+private:
+    // The fourth component of the boxes is unused and set to an infinite slab, so
+    // that a box can be tested against a ray with 4-wide SIMD instructions
+    struct alignas(16) Node
+    {
+        float lower[4];
+        float upper[4];
+        /// first facet of a leaf or the right child of an inner node
+        std::uint32_t index;
+        /// number of facets of a leaf, zero for inner nodes whose left child follows
+        std::uint32_t count;
+
+        Base::BoundBox3f GetBoundBox() const
+        {
+            return Base::BoundBox3f(lower[0], lower[1], lower[2], upper[0], upper[1], upper[2]);
+        }
+    };
+
+    struct BuildData;
+    void BuildNode(BuildData& data, std::size_t first, std::size_t count);
+
+    const MeshKernel& _rclMesh;      /**< The mesh kernel. */
+    unsigned long _ulCtElements;     /**< Number of facets for validation issues. */
+    std::vector<Node> _nodes;        /**< Nodes in depth-first order. */
+    std::vector<FacetIndex> _facets; /**< Facet indices referenced by the leaves. */
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_BVH_H
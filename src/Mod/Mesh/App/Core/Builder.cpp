@@ -85,6 +85,7 @@ void MeshBuilder::Initialize(size_t ctFacets, bool deletion)
 
         // As we have a copy of our vertices in the set we must clear them from our array now  But
         // we can keep its memory as we reuse it later on anyway.
+        MeshKernel::TopologyChange change(_meshKernel);
         _meshKernel._aclPointArray.clear();
         // additional memory
         size_t newCtFacets = _meshKernel._aclFacetArray.size() + ctFacets;
@@ -231,6 +232,7 @@ void MeshBuilder::Finish(bool freeMemory)
 {
     // now we can resize the vertex array to the exact size and copy the vertices with their correct
     // positions in the array
+    MeshKernel::TopologyChange change(_meshKernel);
     PointIndex i = 0;
     _meshKernel._aclPointArray.resize(_pointsIterator.size());
     for (const auto& it : _pointsIterator) {
@@ -23,13 +23,8 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
-#include <functional>
 #endif
 
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
-
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
@@ -37,18 +32,19 @@
 #ifdef OPTIMIZE_CURVATURE
 #include <Eigen/Eigenvalues>
 #else
-#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #endif
 
 #include "Approximation.h"
 #include "Curvature.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Tools.h"
 
 
 using namespace MeshCore;
-namespace sp = std::placeholders;
 
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
     : myKernel(kernel)
@@ -81,16 +77,16 @@ void MeshCurvature::ComputePerFace(bool parallel)
         }
     }
     else {
-        // NOLINTBEGIN
-        QFuture<CurvatureInfo> future =
-            QtConcurrent::mapped(mySegment, std::bind(&FacetCurvature::Compute, &face, sp::_1));
-        // NOLINTEND
-        QFutureWatcher<CurvatureInfo> watcher;
-        watcher.setFuture(future);
-        watcher.waitForFinished();
-        for (const auto& it : future) {
-            myCurvature.push_back(it);
-        }
+        // The facets are handed out in small blocks because the cost per facet varies
+        myCurvature.resize(mySegment.size());
+        parallel_for(
+            mySegment.size(),
+            [this, &face](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; i++) {
+                    myCurvature[i] = face.Compute(mySegment[i]);
+                }
+            },
+            64);
     }
 }
 
@@ -124,59 +120,244 @@ void GenerateComplementBasis(Eigen::Vector3f& rkU, Eigen::Vector3f& rkV, const E
 }
 }  // namespace MeshCore
 
+namespace
+{
+CurvatureInfo ComputeVertexCurvature(std::size_t i,
+                                     const MeshPointAdjacency& adjacency,
+                                     const std::vector<Eigen::Vector3f>& akVertex,
+                                     const std::vector<Eigen::Vector3f>& akNormal)
+{
+    Eigen::Matrix3f akDNormal;
+    akDNormal.setZero();
+    Eigen::Matrix3f akWWTrn;
+    akWWTrn.setZero();
+    Eigen::Matrix3f akDWTrn;
+    akDWTrn.setZero();
+
+    int iV0 = static_cast<int>(i);
+    int iV1;
+    for (PointIndex it : adjacency.GetPoints(i)) {
+        iV1 = static_cast<int>(it);
+
+        // Compute edge from V0 to V1, project to tangent plane of vertex,
+        // and compute difference of adjacent normals.
+        Eigen::Vector3f kE = akVertex[iV1] - akVertex[iV0];
+        Eigen::Vector3f kW = kE - (kE.dot(akNormal[iV0])) * akNormal[iV0];
+        Eigen::Vector3f kD = akNormal[iV1] - akNormal[iV0];
+        for (int iRow = 0; iRow < 3; iRow++) {
+            for (int iCol = 0; iCol < 3; iCol++) {
+                akWWTrn(iRow, iCol) += 2 * kW[iRow] * kW[iCol];
+                akDWTrn(iRow, iCol) += 2 * kD[iRow] * kW[iCol];
+            }
+        }
+    }
+
+    // Add in N*N^T to W*W^T for numerical stability.  In theory 0*0^T gets
+    // added to D*W^T, but of course no update needed in the implementation.
+    // Compute the matrix of normal derivatives.
+    for (int iRow = 0; iRow < 3; iRow++) {
+        for (int iCol = 0; iCol < 3; iCol++) {
+            akWWTrn(iRow, iCol) =
+                0.5 * akWWTrn(iRow, iCol) + akNormal[i][iRow] * akNormal[i][iCol];
+            akDWTrn(iRow, iCol) *= 0.5;
+        }
+    }
+
+    akDNormal = akDWTrn * akWWTrn.inverse();
+
+    // If N is a unit-length normal at a vertex, let U and V be unit-length
+    // tangents so that {U, V, N} is an orthonormal set.  Define the matrix
+    // J = [U | V], a 3-by-2 matrix whose columns are U and V.  Define J^T
+    // to be the transpose of J, a 2-by-3 matrix.  Let dN/dX denote the
+    // matrix of first-order derivatives of the normal vector field.  The
+    // shape matrix is
+    //   S = (J^T * J)^{-1} * J^T * dN/dX * J = J^T * dN/dX * J
+    // where the superscript of -1 denotes the inverse.  (The formula allows
+    // for J built from non-perpendicular vectors.) The matrix S is 2-by-2.
+    // The principal curvatures are the eigenvalues of S.  If k is a principal
+    // curvature and W is the 2-by-1 eigenvector corresponding to it, then
+    // S*W = k*W (by definition).  The corresponding 3-by-1 tangent vector at
+    // the vertex is called the principal direction for k, and is J*W.
+    // compute U and V given N
+    float minCurvature;
+    float maxCurvature;
+    Base::Vector3f minDirection;
+    Base::Vector3f maxDirection;
+
+    Eigen::Vector3f kU, kV;
+    Eigen::Vector3f kN = akNormal[i];
+    float len = kN.squaredNorm();
+    if (len == 0) {
+        return {};  // skip
+    }
+    MeshCore::GenerateComplementBasis(kU, kV, kN);
+
+    // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
+    // because we have estimated dN/dX, we must slightly adjust our
+    // calculations to make sure S is symmetric.
+    float fS01 = kU.dot(akDNormal * kV);
+    float fS10 = kV.dot(akDNormal * kU);
+    float fSAvr = 0.5 * (fS01 + fS10);
+    Eigen::Matrix2f kS;
+    kS(0, 0) = kU.dot(akDNormal * kU);
+    kS(0, 1) = fSAvr;
+    kS(1, 0) = fSAvr;
+    kS(1, 1) = kV.dot(akDNormal * kV);
+
+    // compute the eigenvalues of S (min and max curvatures)
+    float fTrace = kS(0, 0) + kS(1, 1);
+    float fDet = kS(0, 0) * kS(1, 1) - kS(0, 1) * kS(1, 0);
+    float fDiscr = fTrace * fTrace - (4.0) * fDet;
+    float fRootDiscr = sqrt(fabs(fDiscr));
+    minCurvature = (0.5) * (fTrace - fRootDiscr);
+    maxCurvature = (0.5) * (fTrace + fRootDiscr);
+
+    // compute the eigenvectors of S
+    Eigen::Vector2f kW0(kS(0, 1), minCurvature - kS(0, 0));
+    Eigen::Vector2f kW1(minCurvature - kS(1, 1), kS(1, 0));
+    if (kW0.squaredNorm() >= kW1.squaredNorm()) {
+        float len = kW0.squaredNorm();
+        if (len > 0 && len != 1) {
+            kW0.normalize();
+        }
+        Eigen::Vector3f v = kU * kW0[0] + kV * kW0[1];
+        minDirection.Set(v[0], v[1], v[2]);
+    }
+    else {
+        float len = kW1.squaredNorm();
+        if (len > 0 && len != 1) {
+            kW1.normalize();
+        }
+        Eigen::Vector3f v = kU * kW1[0] + kV * kW1[1];
+        minDirection.Set(v[0], v[1], v[2]);
+    }
+
+    kW0 = Eigen::Vector2f(kS(0, 1), maxCurvature - kS(0, 0));
+    kW1 = Eigen::Vector2f(maxCurvature - kS(1, 1), kS(1, 0));
+    if (kW0.squaredNorm() >= kW1.squaredNorm()) {
+        float len = kW0.squaredNorm();
+        if (len > 0 && len != 1) {
+            kW0.normalize();
+        }
+        Eigen::Vector3f v = kU * kW0[0] + kV * kW0[1];
+        maxDirection.Set(v[0], v[1], v[2]);
+    }
+    else {
+        float len = kW1.squaredNorm();
+        if (len > 0 && len != 1) {
+            kW1.normalize();
+        }
+        Eigen::Vector3f v = kU * kW1[0] + kV * kW1[1];
+        maxDirection.Set(v[0], v[1], v[2]);
+    }
+
+    CurvatureInfo ci;
+    ci.fMaxCurvature = maxCurvature;
+    ci.cMaxCurvDir = maxDirection;
+    ci.fMinCurvature = minCurvature;
+    ci.cMinCurvDir = minDirection;
+    return ci;
+}
+}  // namespace
+
 void MeshCurvature::ComputePerVertex()
 {
     // get all points
     const MeshPointArray& pts = myKernel.GetPoints();
 
-    MeshCore::MeshRefPointToFacets pt2f(myKernel);
-    MeshCore::MeshRefPointToPoints pt2p(myKernel);
-    unsigned long numPoints = myKernel.CountPoints();
+    MeshPointAdjacency adjacency(myKernel);
+    std::size_t numPoints = myKernel.CountPoints();
 
     myCurvature.clear();
-    myCurvature.reserve(numPoints);
 
+    // the normal of a point is the area weighted sum of the normals of its facets
     std::vector<Eigen::Vector3f> akNormal(numPoints);
     std::vector<Eigen::Vector3f> akVertex(numPoints);
-    for (unsigned long i = 0; i < numPoints; i++) {
-        Base::Vector3f n = pt2f.GetNormal(i);
-        akNormal[i][0] = n.x;
-        akNormal[i][1] = n.y;
-        akNormal[i][2] = n.z;
-        const Base::Vector3f& p = pts[i];
-        akVertex[i][0] = p.x;
-        akVertex[i][1] = p.y;
-        akVertex[i][2] = p.z;
-    }
+    parallel_for(numPoints, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            Base::Vector3f n;
+            for (FacetIndex index : adjacency.GetFacets(i)) {
+                MeshGeomFacet f = myKernel.GetFacet(index);
+                n += f.Area() * f.GetNormal();
+            }
+            n.Normalize();
+            akNormal[i][0] = n.x;
+            akNormal[i][1] = n.y;
+            akNormal[i][2] = n.z;
+            const Base::Vector3f& p = pts[i];
+            akVertex[i][0] = p.x;
+            akVertex[i][1] = p.y;
+            akVertex[i][2] = p.z;
+        }
+    });
 
     // One could iterate over the triangles and then for each vertex of a triangle compute the
     // derivates. One could also iterate over the points and then for each adjacent point calculate
     // the derivates. Both methods must lead to the same values in the above matrices.
     //
-    // Iterate over the vertexes
-    for (unsigned long i = 0; i < numPoints; i++) {
-        Eigen::Matrix3f akDNormal;
-        akDNormal.setZero();
-        Eigen::Matrix3f akWWTrn;
-        akWWTrn.setZero();
-        Eigen::Matrix3f akDWTrn;
-        akDWTrn.setZero();
-
-        int iV0 = i;
-        int iV1;
-        const std::set<unsigned long>& nb = pt2p[i];
-        for (std::set<unsigned long>::const_iterator it = nb.begin(); it != nb.end(); ++it) {
-            iV1 = *it;
-
-            // Compute edge from V0 to V1, project to tangent plane of vertex,
-            // and compute difference of adjacent normals.
-            Eigen::Vector3f kE = akVertex[iV1] - akVertex[iV0];
-            Eigen::Vector3f kW = kE - (kE.dot(akNormal[iV0])) * akNormal[iV0];
-            Eigen::Vector3f kD = akNormal[iV1] - akNormal[iV0];
-            for (int iRow = 0; iRow < 3; iRow++) {
-                for (int iCol = 0; iCol < 3; iCol++) {
-                    akWWTrn(iRow, iCol) += 2 * kW[iRow] * kW[iCol];
-                    akDWTrn(iRow, iCol) += 2 * kD[iRow] * kW[iCol];
+    // Iterate over the vertexes, a point without normal gets an empty curvature
+    myCurvature.resize(numPoints);
+    parallel_for(numPoints, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            myCurvature[i] = ComputeVertexCurvature(i, adjacency, akVertex, akNormal);
+        }
+    });
+}
+#else
+namespace
+{
+// The computation of Wm4::MeshCurvature per vertex. The facets of a point are visited
+// in ascending order like in Wm4::MeshCurvature, so the sums and results don't change.
+class VertexCurvature
+{
+public:
+    using Vector2 = Wm4::Vector2<double>;
+    using Vector3 = Wm4::Vector3<double>;
+    using Matrix2 = Wm4::Matrix2<double>;
+    using Matrix3 = Wm4::Matrix3<double>;
+
+    VertexCurvature(const MeshKernel& kernel, const MeshPointAdjacency& adjacency)
+        : points(kernel.GetPoints())
+        , facets(kernel.GetFacets())
+        , adjacency(adjacency)
+    {}
+
+    // compute normal vectors, the length of a facet normal provides a weighted sum
+    void ComputeNormals()
+    {
+        normals.resize(points.size());
+        parallel_for(points.size(), [this](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                Vector3 kNormal(0.0, 0.0, 0.0);
+                for (FacetIndex index : adjacency.GetFacets(i)) {
+                    const MeshFacet& facet = facets[index];
+                    Vector3 kEdge1 = Vertex(facet._aulPoints[1]) - Vertex(facet._aulPoints[0]);
+                    Vector3 kEdge2 = Vertex(facet._aulPoints[2]) - Vertex(facet._aulPoints[0]);
+                    Vector3 kCross = kEdge1.Cross(kEdge2);
+                    // a degenerated facet may reference the point several times
+                    for (PointIndex point : facet._aulPoints) {
+                        if (point == i) {
+                            kNormal += kCross;
+                        }
+                    }
+                }
+                kNormal.Normalize();
+                normals[i] = kNormal;
+            }
+        });
+    }
+
+    CurvatureInfo Compute(PointIndex index) const
+    {
+        // compute the matrix of normal derivatives
+        Matrix3 kWWTrn(true);
+        Matrix3 kDWTrn(true);
+        for (FacetIndex facet : adjacency.GetFacets(index)) {
+            const PointIndex* aiV = facets[facet]._aulPoints;
+            for (int j = 0; j < 3; j++) {
+                if (aiV[j] == index) {
+                    AddEdge(index, aiV[(j + 1) % 3], kWWTrn, kDWTrn);
+                    AddEdge(index, aiV[(j + 2) % 3], kWWTrn, kDWTrn);
                 }
             }
         }
@@ -184,164 +365,114 @@ void MeshCurvature::ComputePerVertex()
         // Add in N*N^T to W*W^T for numerical stability.  In theory 0*0^T gets
         // added to D*W^T, but of course no update needed in the implementation.
         // Compute the matrix of normal derivatives.
+        const Vector3& kN = normals[index];
         for (int iRow = 0; iRow < 3; iRow++) {
             for (int iCol = 0; iCol < 3; iCol++) {
-                akWWTrn(iRow, iCol) =
-                    0.5 * akWWTrn(iRow, iCol) + akNormal[i][iRow] * akNormal[i][iCol];
-                akDWTrn(iRow, iCol) *= 0.5;
+                kWWTrn[iRow][iCol] = 0.5 * kWWTrn[iRow][iCol] + kN[iRow] * kN[iCol];
+                kDWTrn[iRow][iCol] *= 0.5;
             }
         }
+        Matrix3 kDNormal = kDWTrn * kWWTrn.Inverse();
 
-        akDNormal = akDWTrn * akWWTrn.inverse();
-
-        // If N is a unit-length normal at a vertex, let U and V be unit-length
-        // tangents so that {U, V, N} is an orthonormal set.  Define the matrix
-        // J = [U | V], a 3-by-2 matrix whose columns are U and V.  Define J^T
-        // to be the transpose of J, a 2-by-3 matrix.  Let dN/dX denote the
-        // matrix of first-order derivatives of the normal vector field.  The
-        // shape matrix is
-        //   S = (J^T * J)^{-1} * J^T * dN/dX * J = J^T * dN/dX * J
-        // where the superscript of -1 denotes the inverse.  (The formula allows
-        // for J built from non-perpendicular vectors.) The matrix S is 2-by-2.
-        // The principal curvatures are the eigenvalues of S.  If k is a principal
-        // curvature and W is the 2-by-1 eigenvector corresponding to it, then
-        // S*W = k*W (by definition).  The corresponding 3-by-1 tangent vector at
-        // the vertex is called the principal direction for k, and is J*W.
-        // compute U and V given N
-        float minCurvature;
-        float maxCurvature;
-        Base::Vector3f minDirection;
-        Base::Vector3f maxDirection;
-
-        Eigen::Vector3f kU, kV;
-        Eigen::Vector3f kN = akNormal[i];
-        float len = kN.squaredNorm();
-        if (len == 0) {
-            continue;  // skip
-        }
-        MeshCore::GenerateComplementBasis(kU, kV, kN);
-
-        // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
-        // because we have estimated dN/dX, we must slightly adjust our
-        // calculations to make sure S is symmetric.
-        float fS01 = kU.dot(akDNormal * kV);
-        float fS10 = kV.dot(akDNormal * kU);
-        float fSAvr = 0.5 * (fS01 + fS10);
-        Eigen::Matrix2f kS;
-        kS(0, 0) = kU.dot(akDNormal * kU);
-        kS(0, 1) = fSAvr;
-        kS(1, 0) = fSAvr;
-        kS(1, 1) = kV.dot(akDNormal * kV);
+        // compute U and V given N, see Wm4::MeshCurvature for the shape matrix
+        // S = J^T * dN/dX * J with J = [U | V]
+        Vector3 kU, kV;
+        Vector3 kNormal = kN;
+        Vector3::GenerateComplementBasis(kU, kV, kNormal);
+
+        // In theory S is symmetric, but because we have estimated dN/dX, we must
+        // slightly adjust our calculations to make sure S is symmetric.
+        double fS01 = kU.Dot(kDNormal * kV);
+        double fS10 = kV.Dot(kDNormal * kU);
+        double fSAvr = 0.5 * (fS01 + fS10);
+        Matrix2 kS(kU.Dot(kDNormal * kU), fSAvr, fSAvr, kV.Dot(kDNormal * kV));
 
         // compute the eigenvalues of S (min and max curvatures)
-        float fTrace = kS(0, 0) + kS(1, 1);
-        float fDet = kS(0, 0) * kS(1, 1) - kS(0, 1) * kS(1, 0);
-        float fDiscr = fTrace * fTrace - (4.0) * fDet;
-        float fRootDiscr = sqrt(fabs(fDiscr));
-        minCurvature = (0.5) * (fTrace - fRootDiscr);
-        maxCurvature = (0.5) * (fTrace + fRootDiscr);
+        double fTrace = kS[0][0] + kS[1][1];
+        double fDet = kS[0][0] * kS[1][1] - kS[0][1] * kS[1][0];
+        double fDiscr = fTrace * fTrace - 4.0 * fDet;
+        double fRootDiscr = Wm4::Math<double>::Sqrt(Wm4::Math<double>::FAbs(fDiscr));
+        double fMinCurvature = 0.5 * (fTrace - fRootDiscr);
+        double fMaxCurvature = 0.5 * (fTrace + fRootDiscr);
 
         // compute the eigenvectors of S
-        Eigen::Vector2f kW0(kS(0, 1), minCurvature - kS(0, 0));
-        Eigen::Vector2f kW1(minCurvature - kS(1, 1), kS(1, 0));
-        if (kW0.squaredNorm() >= kW1.squaredNorm()) {
-            float len = kW0.squaredNorm();
-            if (len > 0 && len != 1) {
-                kW0.normalize();
-            }
-            Eigen::Vector3f v = kU * kW0[0] + kV * kW0[1];
-            minDirection.Set(v[0], v[1], v[2]);
-        }
-        else {
-            float len = kW1.squaredNorm();
-            if (len > 0 && len != 1) {
-                kW1.normalize();
-            }
-            Eigen::Vector3f v = kU * kW1[0] + kV * kW1[1];
-            minDirection.Set(v[0], v[1], v[2]);
-        }
-
-        kW0 = Eigen::Vector2f(kS(0, 1), maxCurvature - kS(0, 0));
-        kW1 = Eigen::Vector2f(maxCurvature - kS(1, 1), kS(1, 0));
-        if (kW0.squaredNorm() >= kW1.squaredNorm()) {
-            float len = kW0.squaredNorm();
-            if (len > 0 && len != 1) {
-                kW0.normalize();
-            }
-            Eigen::Vector3f v = kU * kW0[0] + kV * kW0[1];
-            maxDirection.Set(v[0], v[1], v[2]);
-        }
-        else {
-            float len = kW1.squaredNorm();
-            if (len > 0 && len != 1) {
-                kW1.normalize();
-            }
-            Eigen::Vector3f v = kU * kW1[0] + kV * kW1[1];
-            maxDirection.Set(v[0], v[1], v[2]);
-        }
+        Vector3 kMinDirection = Direction(kS, fMinCurvature, kU, kV);
+        Vector3 kMaxDirection = Direction(kS, fMaxCurvature, kU, kV);
 
         CurvatureInfo ci;
-        ci.fMaxCurvature = maxCurvature;
-        ci.cMaxCurvDir = maxDirection;
-        ci.fMinCurvature = minCurvature;
-        ci.cMinCurvDir = minDirection;
-        myCurvature.push_back(ci);
+        ci.cMaxCurvDir = Base::Vector3f((float)kMaxDirection.X(),
+                                        (float)kMaxDirection.Y(),
+                                        (float)kMaxDirection.Z());
+        ci.cMinCurvDir = Base::Vector3f((float)kMinDirection.X(),
+                                        (float)kMinDirection.Y(),
+                                        (float)kMinDirection.Z());
+        ci.fMaxCurvature = (float)fMaxCurvature;
+        ci.fMinCurvature = (float)fMinCurvature;
+        return ci;
     }
-}
-#else
-void MeshCurvature::ComputePerVertex()
-{
-    myCurvature.clear();
 
-    // get all points
-    std::vector<Wm4::Vector3<double>> aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
+private:
+    Vector3 Vertex(PointIndex index) const
+    {
+        const MeshPoint& p = points[index];
+        return {p.x, p.y, p.z};
     }
 
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3 * myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (const auto& it : raFts) {
-        for (PointIndex point : it._aulPoints) {
-            aIdx.push_back(int(point));
+    // Compute edge from V0 to V1, project to tangent plane of vertex,
+    // and compute difference of adjacent normals.
+    void AddEdge(PointIndex iV0, PointIndex iV1, Matrix3& kWWTrn, Matrix3& kDWTrn) const
+    {
+        Vector3 kE = Vertex(iV1) - Vertex(iV0);
+        Vector3 kW = kE - (kE.Dot(normals[iV0])) * normals[iV0];
+        Vector3 kD = normals[iV1] - normals[iV0];
+        for (int iRow = 0; iRow < 3; iRow++) {
+            for (int iCol = 0; iCol < 3; iCol++) {
+                kWWTrn[iRow][iCol] += kW[iRow] * kW[iCol];
+                kDWTrn[iRow][iCol] += kD[iRow] * kW[iCol];
+            }
         }
     }
 
+    static Vector3
+    Direction(const Matrix2& kS, double fCurvature, const Vector3& kU, const Vector3& kV)
+    {
+        Vector2 kW0(kS[0][1], fCurvature - kS[0][0]);
+        Vector2 kW1(fCurvature - kS[1][1], kS[1][0]);
+        if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+            kW0.Normalize();
+            return kW0.X() * kU + kW0.Y() * kV;
+        }
+        kW1.Normalize();
+        return kW1.X() * kU + kW1.Y() * kV;
+    }
+
+    const MeshPointArray& points;
+    const MeshFacetArray& facets;
+    const MeshPointAdjacency& adjacency;
+    std::vector<Vector3> normals;
+};
+}  // namespace
+
+void MeshCurvature::ComputePerVertex()
+{
+    myCurvature.clear();
+
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0) {
         return;
     }
 
     // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(),
-                                        &(aPnts[0]),
-                                        myKernel.CountFacets(),
-                                        &(aIdx[0]));
-
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
-
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i = 0; i < myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(),
-                                        (float)aMaxCurvDir[i].Y(),
-                                        (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(),
-                                        (float)aMinCurvDir[i].Y(),
-                                        (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
-    }
+    MeshPointAdjacency adjacency(myKernel);
+    VertexCurvature curvature(myKernel, adjacency);
+    curvature.ComputeNormals();
+
+    myCurvature.resize(myKernel.CountPoints());
+    parallel_for(myCurvature.size(), [this, &curvature](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            myCurvature[i] = curvature.Compute(i);
+        }
+    });
 }
 #endif  // OPTIMIZE_CURVATURE
 
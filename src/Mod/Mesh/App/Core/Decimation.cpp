@@ -22,13 +22,684 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <queue>
+#include <vector>
+#endif
+
+#include <Base/Converter.h>
+
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
+namespace
+{
+// Calls func(first, last) for chunks of the range [0, count) in parallel
+template<typename Func>
+void forEachChunk(std::size_t count, Func func)
+{
+    constexpr std::size_t chunkSize = 65536;
+    parallel_for(count, func, chunkSize);
+}
+
+// The quadric error metric as symmetric 4x4 matrix, only the upper triangle is stored
+struct Quadric
+{
+    std::array<double, 10> m {};
+
+    Quadric() = default;
+    // The squared distance to the plane n * x + d = 0 weighted with w
+    Quadric(const Base::Vector3d& n, double d, double w)
+        : m {w * n.x * n.x,
+             w * n.x * n.y,
+             w * n.x * n.z,
+             w * n.x * d,
+             w * n.y * n.y,
+             w * n.y * n.z,
+             w * n.y * d,
+             w * n.z * n.z,
+             w * n.z * d,
+             w * d * d}
+    {}
+    Quadric& operator+=(const Quadric& q)
+    {
+        for (std::size_t i = 0; i < m.size(); i++) {
+            m[i] += q.m[i];
+        }
+        return *this;
+    }
+    Quadric operator+(const Quadric& q) const
+    {
+        Quadric r(*this);
+        r += q;
+        return r;
+    }
+    double Error(const Base::Vector3d& p) const
+    {
+        double err = m[0] * p.x * p.x + 2.0 * m[1] * p.x * p.y + 2.0 * m[2] * p.x * p.z
+            + 2.0 * m[3] * p.x + m[4] * p.y * p.y + 2.0 * m[5] * p.y * p.z + 2.0 * m[6] * p.y
+            + m[7] * p.z * p.z + 2.0 * m[8] * p.z + m[9];
+        return std::max(err, 0.0);
+    }
+    // Computes the point of minimal error, returns false if the system is (nearly) singular
+    bool Minimum(Base::Vector3d& p) const
+    {
+        double c00 = m[4] * m[7] - m[5] * m[5];
+        double c01 = m[2] * m[5] - m[1] * m[7];
+        double c02 = m[1] * m[5] - m[2] * m[4];
+        double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+        double trace = m[0] + m[4] + m[7];
+        if (std::fabs(det) <= 1e-10 * trace * trace * trace) {
+            return false;
+        }
+        double c11 = m[0] * m[7] - m[2] * m[2];
+        double c12 = m[1] * m[2] - m[0] * m[5];
+        double c22 = m[0] * m[4] - m[1] * m[1];
+        p.x = -(c00 * m[3] + c01 * m[6] + c02 * m[8]) / det;
+        p.y = -(c01 * m[3] + c11 * m[6] + c12 * m[8]) / det;
+        p.z = -(c02 * m[3] + c12 * m[6] + c22 * m[8]) / det;
+        return true;
+    }
+};
+
+/*
+ * Edge collapse decimation with quadric error metrics that works on spatial blocks in
+ * parallel. A facet belongs to a block if all its points lie inside. A point is locked
+ * if one of its facets spans several blocks, so the neighbourhood of each edge between
+ * unlocked points is owned by a single block and can be modified without synchronization.
+ */
+class ParallelDecimation
+{
+public:
+    ParallelDecimation(const MeshKernel& kernel, const MeshSimplify::Settings& settings)
+        : settings(settings)
+        , box(kernel.GetBoundBox())
+    {
+        const MeshPointArray& rPoints = kernel.GetPoints();
+        const MeshFacetArray& rFacets = kernel.GetFacets();
+        points.resize(rPoints.size());
+        facets.resize(rFacets.size());
+        forEachChunk(rFacets.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                for (int j = 0; j < 3; j++) {
+                    facets[i][j] = rFacets[i]._aulPoints[j];
+                }
+            }
+        });
+        forEachChunk(rPoints.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                points[i] = rPoints[i];
+            }
+        });
+
+        facetDeleted.resize(facets.size(), 0);
+        pointRemoved.resize(points.size(), 0);
+        pointLocked.resize(points.size(), 0);
+        pointBlock.resize(points.size(), 0);
+        pointLocal.resize(points.size(), 0);
+        stamps.resize(points.size(), 0);
+        refs.resize(points.size());
+
+        BuildRefs();
+        InitQuadrics();
+        InitFixedPoints(rFacets);
+    }
+
+    MeshSimplify::Result Run()
+    {
+        MeshSimplify::Result result;
+        std::size_t numFacets = facets.size();
+        if (settings.targetSize > 0 || settings.maxError >= 0.0) {
+            for (int pass = 0; pass < settings.maxPasses; pass++) {
+                if (numFacets <= settings.targetSize) {
+                    break;
+                }
+                std::size_t removed = Pass(pass, numFacets, result);
+                result.numPasses++;
+                if (removed == 0) {
+                    break;
+                }
+                numFacets -= removed;
+            }
+        }
+
+        result.numFacets = numFacets;
+        return result;
+    }
+
+    void GetMesh(MeshPointArray& rPoints,
+                 MeshFacetArray& rFacets,
+                 std::vector<PointIndex>& pointMap) const
+    {
+        std::vector<PointIndex> index(points.size(), POINT_INDEX_MAX);
+        std::size_t numFacets = 0;
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            if (!facetDeleted[i]) {
+                numFacets++;
+                for (PointIndex p : facets[i]) {
+                    index[p] = 0;
+                }
+            }
+        }
+
+        pointMap.clear();
+        rPoints.clear();
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (index[i] == 0) {
+                index[i] = rPoints.size();
+                rPoints.push_back(points[i]);
+                pointMap.push_back(i);
+            }
+        }
+
+        rFacets.clear();
+        rFacets.reserve(numFacets);
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            if (!facetDeleted[i]) {
+                const auto& facet = facets[i];
+                rFacets.emplace_back(index[facet[0]], index[facet[1]], index[facet[2]]);
+            }
+        }
+    }
+
+private:
+    // The facets of a point are either in the common array or in the array of the block
+    // where they have been rewritten by a collapse
+    struct Refs
+    {
+        std::size_t start {0};
+        std::uint32_t count {0};
+        int block {-1};
+    };
+
+    struct Block
+    {
+        int index {0};
+        std::vector<PointIndex> points;
+        std::vector<FacetIndex> refs;
+        std::size_t numFacets {0};
+        std::size_t budget {0};
+        std::size_t removed {0};
+        std::size_t collapses {0};
+        double maxError {0.0};
+    };
+
+    // Kept small to make the queue cache friendly: the points are indices into the points
+    // of the block and the stamps of both points are summed up, as they only increase
+    struct Candidate
+    {
+        float cost;
+        std::uint32_t p0;
+        std::uint32_t p1;
+        std::uint32_t stamp;
+
+        bool operator>(const Candidate& c) const
+        {
+            return cost > c.cost;
+        }
+    };
+
+    std::pair<const FacetIndex*, const FacetIndex*> FacetsOf(PointIndex p,
+                                                              const Block& block) const
+    {
+        const Refs& ref = refs[p];
+        const FacetIndex* first =
+            ref.block < 0 ? facetRefs.data() + ref.start : block.refs.data() + ref.start;
+        return {first, first + ref.count};
+    }
+
+    void BuildRefs()
+    {
+        for (auto& ref : refs) {
+            ref = Refs();
+        }
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            if (!facetDeleted[i]) {
+                for (PointIndex p : facets[i]) {
+                    refs[p].count++;
+                }
+            }
+        }
+        std::size_t start = 0;
+        for (auto& ref : refs) {
+            ref.start = start;
+            start += ref.count;
+            ref.count = 0;
+        }
+        facetRefs.resize(start);
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            if (!facetDeleted[i]) {
+                for (PointIndex p : facets[i]) {
+                    facetRefs[refs[p].start + refs[p].count++] = i;
+                }
+            }
+        }
+    }
+
+    Base::Vector3f Normal(FacetIndex f) const
+    {
+        const auto& facet = facets[f];
+        return (points[facet[1]] - points[facet[0]]) % (points[facet[2]] - points[facet[0]]);
+    }
+
+    // Sums up the plane quadrics of the facets of each point weighted with their area
+    void InitQuadrics()
+    {
+        quadrics.resize(points.size());
+        Block none;
+        forEachChunk(points.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                auto range = FacetsOf(i, none);
+                for (auto it = range.first; it != range.second; ++it) {
+                    Base::Vector3d n = Base::convertTo<Base::Vector3d>(Normal(*it));
+                    double area = n.Length();
+                    if (area > 0.0) {
+                        n /= area;
+                        Base::Vector3d p = Base::convertTo<Base::Vector3d>(points[i]);
+                        quadrics[i] += Quadric(n, -(n * p), 0.5 * area);
+                    }
+                }
+            }
+        });
+    }
+
+    // The points of border and feature edges are never moved unless borders may be
+    // simplified, then the border points are only marked
+    void InitFixedPoints(const MeshFacetArray& rFacets)
+    {
+        pointFixed.resize(points.size(), 0);
+        pointBorder.resize(points.size(), 0);
+        float cosAngle = std::cos(settings.featureAngle);
+        bool features = settings.featureAngle < Mathf::PI;
+        for (std::size_t i = 0; i < rFacets.size(); i++) {
+            for (int j = 0; j < 3; j++) {
+                FacetIndex neighbour = rFacets[i]._aulNeighbours[j];
+                bool fixed = false;
+                if (neighbour == FACET_INDEX_MAX) {
+                    pointBorder[rFacets[i]._aulPoints[j]] = 1;
+                    pointBorder[rFacets[i]._aulPoints[(j + 1) % 3]] = 1;
+                    fixed = settings.keepBorders;
+                }
+                else if (features && i < neighbour) {
+                    Base::Vector3f n1 = Normal(i);
+                    Base::Vector3f n2 = Normal(neighbour);
+                    float len = n1.Length() * n2.Length();
+                    fixed = len > 0.0F && n1 * n2 < cosAngle * len;
+                }
+                if (fixed) {
+                    pointFixed[rFacets[i]._aulPoints[j]] = 1;
+                    pointFixed[rFacets[i]._aulPoints[(j + 1) % 3]] = 1;
+                }
+            }
+        }
+    }
+
+    // Divides the bounding box into blocks whose number depends on the number of threads
+    // and the number of facets, so that the queue of a block stays small enough to be
+    // cache friendly. For odd passes the blocks are shifted by half their size.
+    std::vector<Block> MakeBlocks(int pass, std::size_t numFacets)
+    {
+        float lengths[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+        float maxLength = std::max({lengths[0], lengths[1], lengths[2]});
+        int blocksPerAxis = settings.blocksPerAxis;
+        if (blocksPerAxis <= 0) {
+            int threads = MeshDefinitions::GetThreadCount();
+            int dims = 0;
+            for (float length : lengths) {
+                if (length > 0.01F * maxLength) {
+                    dims++;
+                }
+            }
+            constexpr std::size_t facetsPerBlock = 131072;
+            double numBlocks = std::max(4.0 * threads, double(numFacets / facetsPerBlock));
+            blocksPerAxis = int(std::lround(std::pow(numBlocks, 1.0 / std::max(dims, 1))));
+        }
+
+        float size = maxLength > 0.0F ? maxLength / float(std::max(blocksPerAxis, 1)) : 1.0F;
+        float shift = (pass % 2) * 0.5F * size;
+        int counts[3];
+        for (int i = 0; i < 3; i++) {
+            counts[i] = int(lengths[i] / size) + 2;
+        }
+
+        std::vector<Block> blocks(std::size_t(counts[0]) * counts[1] * counts[2]);
+        forEachChunk(points.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                const Base::Vector3f& p = points[i];
+                int x = std::clamp(int((p.x - box.MinX + shift) / size), 0, counts[0] - 1);
+                int y = std::clamp(int((p.y - box.MinY + shift) / size), 0, counts[1] - 1);
+                int z = std::clamp(int((p.z - box.MinZ + shift) / size), 0, counts[2] - 1);
+                pointBlock[i] = (x * counts[1] + y) * counts[2] + z;
+            }
+        });
+
+        Block none;
+        forEachChunk(points.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                bool locked = false;
+                auto range = FacetsOf(i, none);
+                for (auto it = range.first; it != range.second && !locked; ++it) {
+                    for (PointIndex p : facets[*it]) {
+                        locked = locked || pointBlock[p] != pointBlock[i];
+                    }
+                }
+                pointLocked[i] = locked ? 1 : 0;
+            }
+        });
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (!pointRemoved[i] && refs[i].count > 0) {
+                auto& block = blocks[pointBlock[i]];
+                pointLocal[i] = std::uint32_t(block.points.size());
+                block.points.push_back(i);
+            }
+        }
+        for (std::size_t i = 0; i < facets.size(); i++) {
+            const auto& facet = facets[i];
+            int block = pointBlock[facet[0]];
+            if (!facetDeleted[i] && pointBlock[facet[1]] == block
+                && pointBlock[facet[2]] == block) {
+                blocks[block].numFacets++;
+            }
+        }
+
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            blocks[i].index = int(i);
+        }
+        blocks.erase(std::remove_if(blocks.begin(),
+                                    blocks.end(),
+                                    [](const Block& block) {
+                                        return block.numFacets == 0;
+                                    }),
+                     blocks.end());
+        return blocks;
+    }
+
+    std::size_t Pass(int pass, std::size_t numFacets, MeshSimplify::Result& result)
+    {
+        if (pass > 0) {
+            BuildRefs();
+        }
+        std::vector<Block> blocks = MakeBlocks(pass, numFacets);
+
+        // Each block removes its share of the facets to reach the target size
+        double ratio = 1.0;
+        if (settings.targetSize > 0) {
+            ratio = double(numFacets - settings.targetSize) / double(numFacets);
+        }
+        for (auto& block : blocks) {
+            block.budget = settings.targetSize > 0
+                ? std::size_t(std::ceil(double(block.numFacets) * ratio))
+                : block.numFacets;
+        }
+
+        parallel_map(blocks, [this](Block& block) {
+            SimplifyBlock(block);
+        });
+
+        std::size_t removed = 0;
+        for (const auto& block : blocks) {
+            removed += block.removed;
+            result.numCollapses += block.collapses;
+            result.maxError = std::max(result.maxError, block.maxError);
+        }
+        return removed;
+    }
+
+    double CollapseCost(PointIndex p0, PointIndex p1, Base::Vector3f& pos) const
+    {
+        Quadric q = quadrics[p0] + quadrics[p1];
+        if (pointFixed[p0]) {
+            pos = points[p0];
+            return q.Error(Base::convertTo<Base::Vector3d>(pos));
+        }
+
+        Base::Vector3d v0 = Base::convertTo<Base::Vector3d>(points[p0]);
+        Base::Vector3d v1 = Base::convertTo<Base::Vector3d>(points[p1]);
+        Base::Vector3d mid = 0.5 * (v0 + v1);
+
+        // Take the optimal point unless it's far away from the edge, otherwise the best
+        // of the end points and the midpoint
+        Base::Vector3d opt;
+        if (q.Minimum(opt) && Base::DistanceP2(opt, mid) <= Base::DistanceP2(v0, v1)) {
+            pos = Base::convertTo<Base::Vector3f>(opt);
+            return q.Error(opt);
+        }
+
+        double cost = q.Error(mid);
+        pos = Base::convertTo<Base::Vector3f>(mid);
+        for (const auto& v : {v0, v1}) {
+            double err = q.Error(v);
+            if (err < cost) {
+                cost = err;
+                pos = Base::convertTo<Base::Vector3f>(v);
+            }
+        }
+        return cost;
+    }
+
+    // Checks the link condition to keep the mesh manifold and that no facet flips over
+    bool CanCollapse(const Block& block,
+                     PointIndex p0,
+                     PointIndex p1,
+                     const Base::Vector3f& pos,
+                     std::vector<PointIndex>& ring0,
+                     std::vector<PointIndex>& ring1) const
+    {
+        auto collectRing = [&](PointIndex p, std::vector<PointIndex>& ring) {
+            ring.clear();
+            auto range = FacetsOf(p, block);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (!facetDeleted[*it]) {
+                    for (PointIndex q : facets[*it]) {
+                        if (q != p0 && q != p1
+                            && std::find(ring.begin(), ring.end(), q) == ring.end()) {
+                            ring.push_back(q);
+                        }
+                    }
+                }
+            }
+        };
+
+        auto flips = [&](PointIndex p) {
+            auto range = FacetsOf(p, block);
+            for (auto it = range.first; it != range.second; ++it) {
+                const auto& facet = facets[*it];
+                if (facetDeleted[*it]) {
+                    continue;
+                }
+                if (std::find(facet.begin(), facet.end(), p0) != facet.end()
+                    && std::find(facet.begin(), facet.end(), p1) != facet.end()) {
+                    continue;
+                }
+                Base::Vector3f corners[3];
+                for (int i = 0; i < 3; i++) {
+                    corners[i] = points[facet[i]];
+                }
+                Base::Vector3f before = (corners[1] - corners[0]) % (corners[2] - corners[0]);
+                for (int i = 0; i < 3; i++) {
+                    if (facet[i] == p) {
+                        corners[i] = pos;
+                    }
+                }
+                Base::Vector3f after = (corners[1] - corners[0]) % (corners[2] - corners[0]);
+                float lenAfter = after.Length();
+                float lenBefore = before.Length();
+                if (lenAfter <= 0.0F
+                    || (lenBefore > 0.0F && after * before < 0.2F * lenAfter * lenBefore)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        // The number of common neighbours must match the number of facets at the edge
+        std::size_t shared = 0;
+        auto range = FacetsOf(p0, block);
+        for (auto it = range.first; it != range.second; ++it) {
+            const auto& facet = facets[*it];
+            if (!facetDeleted[*it] && std::find(facet.begin(), facet.end(), p1) != facet.end()) {
+                shared++;
+            }
+        }
+        if (shared == 0 || shared > 2) {
+            return false;
+        }
+        // An inner edge between two border points would pinch the mesh to a single point
+        if (shared == 2 && pointBorder[p0] && pointBorder[p1]) {
+            return false;
+        }
+
+        collectRing(p0, ring0);
+        collectRing(p1, ring1);
+        std::size_t common = 0;
+        for (PointIndex p : ring0) {
+            if (std::find(ring1.begin(), ring1.end(), p) != ring1.end()) {
+                common++;
+            }
+        }
+        if (common != shared) {
+            return false;
+        }
+
+        return !flips(p0) && !flips(p1);
+    }
+
+    // Moves p0 to pos and replaces p1 with p0
+    void Collapse(Block& block,
+                  PointIndex p0,
+                  PointIndex p1,
+                  const Base::Vector3f& pos,
+                  std::vector<FacetIndex>& merged)
+    {
+        std::size_t start = block.refs.size();
+        auto range0 = FacetsOf(p0, block);
+        merged.assign(range0.first, range0.second);
+        auto range1 = FacetsOf(p1, block);
+        for (auto it = range1.first; it != range1.second; ++it) {
+            auto& facet = facets[*it];
+            if (facetDeleted[*it]) {
+                continue;
+            }
+            if (std::find(facet.begin(), facet.end(), p0) != facet.end()) {
+                facetDeleted[*it] = 1;
+                block.removed++;
+            }
+            else {
+                std::replace(facet.begin(), facet.end(), p1, p0);
+                merged.push_back(*it);
+            }
+        }
+        for (FacetIndex f : merged) {
+            if (!facetDeleted[f]) {
+                block.refs.push_back(f);
+            }
+        }
+
+        refs[p0].start = start;
+        refs[p0].count = std::uint32_t(block.refs.size() - start);
+        refs[p0].block = block.index;
+        points[p0] = pos;
+        quadrics[p0] += quadrics[p1];
+        pointRemoved[p1] = 1;
+        pointBorder[p0] = pointBorder[p0] | pointBorder[p1];
+        stamps[p0]++;
+        stamps[p1]++;
+    }
+
+    void SimplifyBlock(Block& block)
+    {
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue;
+        std::vector<PointIndex> ring;
+        // Adds the edges from p to its unlocked neighbours, or only to those with a
+        // higher index to visit each edge once
+        Base::Vector3f pos;
+        auto addEdges = [&](PointIndex p, bool higherOnly) {
+            ring.clear();
+            auto range = FacetsOf(p, block);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (!facetDeleted[*it]) {
+                    for (PointIndex q : facets[*it]) {
+                        if (q != p && !pointLocked[q] && !(pointFixed[p] && pointFixed[q])
+                            && (!higherOnly || q > p)
+                            && std::find(ring.begin(), ring.end(), q) == ring.end()) {
+                            ring.push_back(q);
+                        }
+                    }
+                }
+            }
+            for (PointIndex q : ring) {
+                // A fixed point is always kept
+                PointIndex p0 = pointFixed[p] ? p : pointFixed[q] ? q : std::min(p, q);
+                PointIndex p1 = p0 == p ? q : p;
+                Candidate c;
+                c.cost = static_cast<float>(CollapseCost(p0, p1, pos));
+                c.p0 = pointLocal[p0];
+                c.p1 = pointLocal[p1];
+                c.stamp = stamps[p0] + stamps[p1];
+                queue.push(c);
+            }
+        };
+
+        for (PointIndex p : block.points) {
+            if (!pointLocked[p]) {
+                addEdges(p, true);
+            }
+        }
+
+        std::vector<PointIndex> ring0;
+        std::vector<PointIndex> ring1;
+        std::vector<FacetIndex> merged;
+        while (!queue.empty() && block.removed < block.budget) {
+            Candidate c = queue.top();
+            queue.pop();
+            PointIndex p0 = block.points[c.p0];
+            PointIndex p1 = block.points[c.p1];
+            if (pointRemoved[p0] || pointRemoved[p1] || stamps[p0] + stamps[p1] != c.stamp) {
+                continue;
+            }
+            double cost = CollapseCost(p0, p1, pos);
+            if (settings.maxError >= 0.0 && cost > settings.maxError) {
+                break;
+            }
+            if (!CanCollapse(block, p0, p1, pos, ring0, ring1)) {
+                continue;
+            }
+
+            Collapse(block, p0, p1, pos, merged);
+            block.collapses++;
+            block.maxError = std::max(block.maxError, cost);
+            addEdges(p0, false);
+        }
+    }
+
+private:
+    const MeshSimplify::Settings& settings;
+    Base::BoundBox3f box;
+    std::vector<Base::Vector3f> points;
+    std::vector<std::array<PointIndex, 3>> facets;
+    std::vector<Quadric> quadrics;
+    std::vector<Refs> refs;
+    std::vector<FacetIndex> facetRefs;
+    std::vector<char> facetDeleted;
+    std::vector<char> pointRemoved;
+    std::vector<char> pointFixed;
+    std::vector<char> pointBorder;
+    std::vector<char> pointLocked;
+    std::vector<int> pointBlock;
+    std::vector<std::uint32_t> pointLocal;
+    std::vector<std::uint32_t> stamps;
+};
+}  // namespace
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
     : myKernel(mesh)
 {}
@@ -152,3 +823,15 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+MeshSimplify::Result MeshSimplify::simplify(const Settings& settings)
+{
+    ParallelDecimation alg(myKernel, settings);
+    Result result = alg.Run();
+
+    MeshPointArray new_points;
+    MeshFacetArray new_facets;
+    alg.GetMesh(new_points, new_facets, myPointMap);
+    myKernel.Adopt(new_points, new_facets, true);
+    return result;
+}
@@ -24,7 +24,9 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
-#include <Mod/Mesh/MeshGlobal.h>
+#include <vector>
+
+#include "Definitions.h"
 
 namespace MeshCore
 {
@@ -33,12 +35,58 @@ class MeshKernel;
 class MeshExport MeshSimplify
 {
 public:
+    /** Settings of the parallel decimation. */
+    struct Settings
+    {
+        /** The number of facets to reach, zero for no limit. */
+        std::size_t targetSize {0};
+        /** The maximum quadric error of a collapse, a negative value for no limit. */
+        double maxError {-1.0};
+        /** Keeps the border edges of open meshes. */
+        bool keepBorders {true};
+        /** Keeps edges whose adjacent facets enclose a larger angle (in radian). */
+        float featureAngle {1.0F};
+        /** The number of blocks per axis, zero to choose it by the number of threads. */
+        int blocksPerAxis {0};
+        /** The maximum number of passes. */
+        int maxPasses {10};
+    };
+
+    /** Result of the parallel decimation. */
+    struct Result
+    {
+        std::size_t numFacets {0};    /**< The number of facets of the simplified mesh. */
+        std::size_t numCollapses {0}; /**< The number of collapsed edges. */
+        double maxError {0.0};        /**< The largest quadric error of a collapsed edge. */
+        int numPasses {0};            /**< The number of passes over the blocks. */
+    };
+
     MeshSimplify(MeshKernel&);  // explicit bombs
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /**
+     * Simplifies the mesh by collapsing the edges of lowest quadric error until the
+     * target size or the maximum error is reached.
+     * The mesh is partitioned into spatial blocks that are simplified in parallel.
+     * Vertices of facets spanning several blocks are locked during a pass and the
+     * blocks are shifted between the passes, so the borders are simplified later.
+     * Vertices on feature edges are never moved, neither are vertices on border edges
+     * unless Settings::keepBorders is false.
+     */
+    Result simplify(const Settings& settings);
+    /**
+     * Returns for each point of the mesh simplified by simplify(const Settings&) the
+     * index of the point of the original mesh it is derived from. It can be used to
+     * carry over per-vertex attributes like colors.
+     */
+    const std::vector<PointIndex>& GetPointMap() const
+    {
+        return myPointMap;
+    }
 
 private:
     MeshKernel& myKernel;
+    std::vector<PointIndex> myPointMap;
 };
 
 }  // namespace MeshCore
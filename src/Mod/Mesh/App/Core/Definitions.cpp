@@ -22,7 +22,9 @@
 
 #include "PreCompiled.h"
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 
 #include "Definitions.h"
 #include <Base/Tools.h>
@@ -42,6 +44,7 @@ float MeshDefinitions::_fMinPointDistanceD1 = _fMinPointDistance;
 float MeshDefinitions::_fMinEdgeLength = MESH_MIN_EDGE_LEN;
 bool MeshDefinitions::_bRemoveMinLength = MESH_REMOVE_MIN_LEN;
 float MeshDefinitions::_fMinEdgeAngle = Base::toRadians<float>(MESH_MIN_EDGE_ANGLE);
+std::atomic<int> MeshDefinitions::_iThreadCount {0};
 
 MeshDefinitions::MeshDefinitions() = default;
 
@@ -52,4 +55,18 @@ void MeshDefinitions::SetMinPointDistance(float fMin)
     _fMinPointDistanceD1 = float(sqrt((fMin * fMin) / 3.0f));
 }
 
+void MeshDefinitions::SetThreadCount(int count)
+{
+    _iThreadCount = count;
+}
+
+int MeshDefinitions::GetThreadCount()
+{
+    int count = _iThreadCount;
+    if (count <= 0) {
+        count = int(std::thread::hardware_concurrency());
+    }
+    return std::max(count, 1);
+}
+
 }  // namespace MeshCore
@@ -27,6 +27,7 @@
 #include <Mod/Mesh/MeshGlobal.h>
 #endif
 
+#include <atomic>
 #include <climits>
 
 // default values
@@ -93,6 +94,14 @@ public:
     static float _fMinEdgeAngle;
 
     static void SetMinPointDistance(float fMin);
+
+    /** Sets the number of threads of parallel algorithms, zero or less to use all cores. */
+    static void SetThreadCount(int count);
+    /** Returns the number of threads of parallel algorithms, at least one. */
+    static int GetThreadCount();
+
+private:
+    static std::atomic<int> _iThreadCount;
 };
 
 }  // namespace MeshCore
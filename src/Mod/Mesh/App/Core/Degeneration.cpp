@@ -209,6 +209,7 @@ bool MeshFixDuplicatePoints::Fixup()
     }
 
     // now set all facets to the correct index
+    MeshKernel::TopologyChange change(_rclMesh);
     MeshFacetArray& rFacets = _rclMesh._aclFacetArray;
     for (auto& it : rFacets) {
         for (PointIndex& point : it._aulPoints) {
@@ -829,8 +829,9 @@ private:
 class MeshExport MeshFacetModifier
 {
 public:
-    explicit MeshFacetModifier(MeshFacetArray& facets)
+    MeshFacetModifier(MeshFacetArray& facets, unsigned long& version)
         : rFacets(facets)
+        , rVersion(version)
     {}
     ~MeshFacetModifier() = default;
 
@@ -847,10 +848,12 @@ public:
     void Transpose(PointIndex pos, PointIndex old, PointIndex now)
     {
         rFacets[pos].Transpose(old, now);
+        rVersion++;
     }
 
 private:
     MeshFacetArray& rFacets;
+    unsigned long& rVersion;
 };
 
 inline MeshPoint::MeshPoint(float x, float y, float z)
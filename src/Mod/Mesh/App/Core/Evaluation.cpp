@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #endif
 
@@ -598,214 +599,232 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+namespace
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
+using FacetPairs = std::vector<std::pair<FacetIndex, FacetIndex>>;
+
+// Number of grid cells whose results are kept in memory at once
+constexpr unsigned long SelfIntersectionBatch = 4096;
+// Number of facet pairs handled by one task
+constexpr std::size_t FacetPairChunk = 4096;
+
+// If the facets share a common vertex we do not check for self-intersections
+// because they could but usually do not intersect each other and the algorithm
+// would detect false-positives, otherwise
+bool shareVertex(const MeshFacet& rface1, const MeshFacet& rface2)
+{
+    for (PointIndex p1 : rface1._aulPoints) {
+        for (PointIndex p2 : rface2._aulPoints) {
+            if (p1 == p2) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * Tests the facets of each grid cell pairwise for intersections. The cells are handled
+ * in batches and the cells of a batch are distributed over several threads. The results
+ * of a batch are appended in the order of the cells, so the pairs come out in the same
+ * order as with a serial loop over the grid.
+ * If stopAtFirst is true the search ends after the first intersecting pair.
+ */
+void findSelfIntersections(const MeshKernel& rclMesh,
+                           FacetPairs& intersection,
+                           bool stopAtFirst,
+                           bool canAbort)
+{
+    if (rclMesh.CountFacets() == 0) {
+        return;
+    }
 
     // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
+    MeshFacetGrid cMeshFacetGrid(rclMesh);
+    const MeshFacetArray& rFaces = rclMesh.GetFacets();
     unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
     cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    const unsigned long ulCtCells = ulGridX * ulGridY * ulGridZ;
 
-    MeshFacetIterator cMFI(_rclMesh);
+    // Contains bounding boxes for every facet
+    std::vector<Base::BoundBox3f> boxes;
+    boxes.reserve(rFaces.size());
+    MeshFacetIterator cMFI(rclMesh);
     for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
         boxes.push_back((*cMFI).GetBoundBox());
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
-        }
+    struct Cell
+    {
+        MeshGridCells::Range elements;
+        FacetPairs pairs;
+    };
 
-        MeshGeomFacet facet1, facet2;
+    std::atomic<bool> found {false};
+    auto intersect = [&](Cell& cell) {
         Base::Vector3f pt1, pt2;
-        for (std::vector<FacetIndex>::iterator it = aulGridElements.begin();
-             it != aulGridElements.end();
-             ++it) {
+        const ElementIndex* last = cell.elements.end();
+        for (const ElementIndex* it = cell.elements.begin(); it != last; ++it) {
+            if (stopAtFirst && found.load(std::memory_order_relaxed)) {
+                return;
+            }
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
             const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<FacetIndex>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
+            MeshGeomFacet facet1 = rclMesh.GetFacet(rface1);
+            for (const ElementIndex* jt = it + 1; jt != last; ++jt) {
                 const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+                if (shareVertex(rface1, rface2) || !(box1 && boxes[*jt])) {
+                    continue;
                 }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                int ret = facet1.IntersectWithFacet(rclMesh.GetFacet(rface2), pt1, pt2);
+                if (ret == 2) {
+                    cell.pairs.emplace_back(*it, *jt);
+                    if (stopAtFirst) {
+                        found = true;
+                        return;
                     }
                 }
             }
         }
+    };
+
+    // Calculates the intersections
+    Base::SequencerLauncher seq("Checking for self-intersections...", ulCtCells);
+    std::vector<Cell> cells;
+    for (unsigned long first = 0; first < ulCtCells; first += SelfIntersectionBatch) {
+        unsigned long last = std::min(first + SelfIntersectionBatch, ulCtCells);
+        cells.clear();
+        for (unsigned long index = first; index < last; index++) {
+            unsigned long ulX {}, ulY {}, ulZ {};
+            cMeshFacetGrid.GetPositionToIndex(index, ulX, ulY, ulZ);
+            MeshGridCells::Range elements = cMeshFacetGrid.Cell(ulX, ulY, ulZ);
+            // a single facet cannot intersect itself
+            if (elements.size() > 1) {
+                cells.push_back({elements, {}});
+            }
+        }
+
+        parallel_map(cells, intersect);
+
+        for (const auto& cell : cells) {
+            intersection.insert(intersection.end(), cell.pairs.begin(), cell.pairs.end());
+            if (stopAtFirst && !intersection.empty()) {
+                return;
+            }
+        }
+        for (unsigned long index = first; index < last; index++) {
+            seq.next(canAbort);
+        }
     }
+}
+}  // namespace
 
-    return true;
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    // abort after the first detected self-intersection
+    FacetPairs intersection;
+    findSelfIntersections(_rclMesh, intersection, true, false);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
     const std::vector<std::pair<FacetIndex, FacetIndex>>& indices,
     std::vector<std::pair<Base::Vector3f, Base::Vector3f>>& intersection) const
 {
-    intersection.reserve(indices.size());
-    MeshFacetIterator cMF1(_rclMesh);
-    MeshFacetIterator cMF2(_rclMesh);
-
-    Base::Vector3f pt1, pt2;
-    std::vector<std::pair<FacetIndex, FacetIndex>>::const_iterator it;
-    for (it = indices.begin(); it != indices.end(); ++it) {
-        cMF1.Set(it->first);
-        cMF2.Set(it->second);
-
-        Base::BoundBox3f box1 = cMF1->GetBoundBox();
-        Base::BoundBox3f box2 = cMF2->GetBoundBox();
-        if (box1 && box2) {
-            int ret = cMF1->IntersectWithFacet(*cMF2, pt1, pt2);
-            if (ret == 2) {
-                intersection.emplace_back(pt1, pt2);
+    struct Chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::vector<std::pair<Base::Vector3f, Base::Vector3f>> lines;
+    };
+
+    std::vector<Chunk> chunks;
+    for (std::size_t i = 0; i < indices.size(); i += FacetPairChunk) {
+        chunks.push_back({i, std::min(i + FacetPairChunk, indices.size()), {}});
+    }
+
+    parallel_map(chunks, [this, &indices](Chunk& chunk) {
+        Base::Vector3f pt1, pt2;
+        for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+            MeshGeomFacet facet1 = _rclMesh.GetFacet(indices[i].first);
+            MeshGeomFacet facet2 = _rclMesh.GetFacet(indices[i].second);
+            if (facet1.GetBoundBox() && facet2.GetBoundBox()) {
+                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
+                if (ret == 2) {
+                    chunk.lines.emplace_back(pt1, pt2);
+                }
             }
         }
+    });
+
+    intersection.reserve(intersection.size() + indices.size());
+    for (const auto& chunk : chunks) {
+        intersection.insert(intersection.end(), chunk.lines.begin(), chunk.lines.end());
     }
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    findSelfIntersections(_rclMesh, intersection, false, true);
+}
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
+{
+    struct Chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::vector<FacetIndex> indices;
+    };
+
+    std::vector<Chunk> chunks;
+    for (std::size_t i = 0; i < selfIntersectons.size(); i += FacetPairChunk) {
+        chunks.push_back({i, std::min(i + FacetPairChunk, selfIntersectons.size()), {}});
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
+    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
+    parallel_map(chunks, [this, &rFaces](Chunk& chunk) {
+        for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+            const auto& it = selfIntersectons[i];
+            unsigned short numOpenEdges1 = rFaces[it.first].CountOpenEdges();
+            unsigned short numOpenEdges2 = rFaces[it.second].CountOpenEdges();
+
+            // often we have only single or border facets that intersect other facets
+            // in this case remove only these facets and keep the other one
+            if (numOpenEdges1 == 0 && numOpenEdges2 > 0) {
+                chunk.indices.push_back(it.second);
+            }
+            else if (numOpenEdges1 > 0 && numOpenEdges2 == 0) {
+                chunk.indices.push_back(it.first);
+            }
+            else {
+                chunk.indices.push_back(it.first);
+                chunk.indices.push_back(it.second);
+            }
         }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<FacetIndex>::iterator it = aulGridElements.begin();
-             it != aulGridElements.end();
-             ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<FacetIndex>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
+    });
+
+    // remove duplicates by marking the facets instead of sorting the indices
+    std::vector<bool> marked(rFaces.size());
+    std::size_t count = 0;
+    for (const auto& chunk : chunks) {
+        for (FacetIndex index : chunk.indices) {
+            if (!marked[index]) {
+                marked[index] = true;
+                count++;
             }
         }
     }
-}
 
-std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
-{
     std::vector<FacetIndex> indices;
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    for (const auto& it : selfIntersectons) {
-        unsigned short numOpenEdges1 = rFaces[it.first].CountOpenEdges();
-        unsigned short numOpenEdges2 = rFaces[it.second].CountOpenEdges();
-
-        // often we have only single or border facets that intersect other facets
-        // in this case remove only these facets and keep the other one
-        if (numOpenEdges1 == 0 && numOpenEdges2 > 0) {
-            indices.push_back(it.second);
-        }
-        else if (numOpenEdges1 > 0 && numOpenEdges2 == 0) {
-            indices.push_back(it.first);
-        }
-        else {
-            indices.push_back(it.first);
-            indices.push_back(it.second);
+    indices.reserve(count);
+    for (std::size_t i = 0; i < marked.size(); i++) {
+        if (marked[i]) {
+            indices.push_back(i);
         }
     }
 
-    // remove duplicates
-    std::sort(indices.begin(), indices.end());
-    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
-
     return indices;
 }
 
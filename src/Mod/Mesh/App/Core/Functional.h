@@ -26,6 +26,10 @@
 #include <algorithm>
 #include <future>
 
+#include <Base/Parallel.h>
+
+#include "Definitions.h"
+
 
 namespace MeshCore
 {
@@ -62,6 +66,28 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Calls \a func(first, last) for consecutive ranges of [0, \a count) on the number of
+ * threads set with MeshDefinitions::SetThreadCount(). The ranges are handed out in
+ * blocks of \a grain elements to balance the load. As long as \a func only writes the
+ * elements of its range the result doesn't depend on the number of threads.
+ */
+template<class Func>
+static void parallel_for(std::size_t count, Func func, std::size_t grain = 1024)
+{
+    Base::parallelFor(count, MeshDefinitions::GetThreadCount(), func, grain);
+}
+
+/**
+ * Calls \a func for each element of the random access \a container on the number of
+ * threads set with MeshDefinitions::SetThreadCount().
+ */
+template<class Container, class Func>
+static void parallel_map(Container& container, Func func)
+{
+    Base::parallelForEach(container, MeshDefinitions::GetThreadCount(), func);
+}
+
 }  // namespace MeshCore
 
 
@@ -24,9 +24,11 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <numeric>
 #endif
 
 #include "Algorithm.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -34,6 +36,72 @@
 
 using namespace MeshCore;
 
+void MeshGridCells::Resize(std::size_t ulCtCells)
+{
+    _offsets.assign(ulCtCells + 1, 0);
+    _elements.clear();
+}
+
+void MeshGridCells::Clear()
+{
+    _offsets.clear();
+    _elements.clear();
+}
+
+void MeshGridCells::Build(std::size_t ulCtElements, const CellFunction& cellsOf)
+{
+    // Number of elements classified by one task
+    constexpr std::size_t ulChunkSize = 16384;
+
+    struct Chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::vector<std::pair<unsigned long, ElementIndex>> entries;
+    };
+
+    std::vector<Chunk> chunks;
+    for (std::size_t i = 0; i < ulCtElements; i += ulChunkSize) {
+        chunks.push_back({i, std::min(i + ulChunkSize, ulCtElements), {}});
+    }
+
+    // First pass: determine the cells of each element
+    auto classify = [&cellsOf](Chunk& chunk) {
+        std::vector<unsigned long> cells;
+        chunk.entries.reserve(chunk.end - chunk.begin);
+        for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+            cells.clear();
+            cellsOf(static_cast<ElementIndex>(i), cells);
+            for (unsigned long cell : cells) {
+                chunk.entries.emplace_back(cell, static_cast<ElementIndex>(i));
+            }
+        }
+    };
+    parallel_map(chunks, classify);
+
+    // Second pass: count the elements per cell, turn the counts into offsets and sort the
+    // elements into their cells. The chunks are processed in order, so the elements of a
+    // cell end up in ascending order.
+    std::fill(_offsets.begin(), _offsets.end(), 0);
+    for (const auto& chunk : chunks) {
+        for (const auto& entry : chunk.entries) {
+            _offsets[entry.first + 1]++;
+        }
+    }
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+    std::vector<std::size_t> pos(_offsets.begin(), _offsets.end() - 1);
+    _elements.resize(_offsets.back());
+    for (auto& chunk : chunks) {
+        for (const auto& entry : chunk.entries) {
+            _elements[pos[entry.first]++] = entry.second;
+        }
+        chunk.entries = {};
+    }
+}
+
+// ----------------------------------------------------------------
+
 MeshGrid::MeshGrid(const MeshKernel& rclM)
     : _pclMesh(&rclM)
     , _ulCtElements(0)
@@ -70,7 +138,7 @@ void MeshGrid::Attach(const MeshKernel& rclM)
 
 void MeshGrid::Clear()
 {
-    _aulGrid.clear();
+    _aulGrid.Clear();
     _pclMesh = nullptr;
 }
 
@@ -128,14 +196,7 @@ void MeshGrid::InitGrid()
     }
 
     // Create data structure
-    _aulGrid.clear();
-    _aulGrid.resize(_ulCtGridsX);
-    for (unsigned long i = 0; i < _ulCtGridsX; i++) {
-        _aulGrid[i].resize(_ulCtGridsY);
-        for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-            _aulGrid[i][j].resize(_ulCtGridsZ);
-        }
-    }
+    _aulGrid.Resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
 }
 
 unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
@@ -158,9 +219,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(raulElements.end(),
-                                    _aulGrid[i][j][k].begin(),
-                                    _aulGrid[i][j][k].end());
+                MeshGridCells::Range cell = Cell(i, j, k);
+                raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             }
         }
     }
@@ -200,9 +260,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
                 if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
-                    raulElements.insert(raulElements.end(),
-                                        _aulGrid[i][j][k].begin(),
-                                        _aulGrid[i][j][k].end());
+                    MeshGridCells::Range cell = Cell(i, j, k);
+                    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
                 }
             }
         }
@@ -237,7 +296,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                MeshGridCells::Range cell = Cell(i, j, k);
+                raulElements.insert(cell.begin(), cell.end());
             }
         }
     }
@@ -461,7 +521,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            MeshGridCells::Range cell = Cell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -473,7 +534,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            MeshGridCells::Range cell = Cell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -485,7 +547,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            MeshGridCells::Range cell = Cell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY++;
@@ -497,7 +560,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            MeshGridCells::Range cell = Cell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY--;
@@ -509,7 +573,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            MeshGridCells::Range cell = Cell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ++;
@@ -521,7 +586,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            MeshGridCells::Range cell = Cell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ--;
@@ -609,7 +675,7 @@ unsigned long MeshGrid::GetElements(unsigned long ulX,
                                     unsigned long ulZ,
                                     std::set<ElementIndex>& raclInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
+    MeshGridCells::Range rclSet = Cell(ulX, ulY, ulZ);
     if (!rclSet.empty()) {
         raclInd.insert(rclSet.begin(), rclSet.end());
         return rclSet.size();
@@ -628,9 +694,8 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f& rclPoint,
         return 0;
     }
 
-    aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-    std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+    MeshGridCells::Range cell = Cell(ulX, ulY, ulZ);
+    aulFacets.assign(cell.begin(), cell.end());
     return aulFacets.size();
 }
 
@@ -747,13 +812,11 @@ void MeshFacetGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-    MeshFacetIterator clFIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-        //    AddFacet(*clFIter, i++, 2.0f);
-        AddFacet(*clFIter, i++);
-    }
+    const MeshKernel& rclMesh = *_pclMesh;
+    _aulGrid.Build(_ulCtElements,
+                   [this, &rclMesh](ElementIndex ulIndex, std::vector<unsigned long>& cells) {
+                       GetFacetCells(rclMesh.GetFacet(ulIndex), cells);
+                   });
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
@@ -984,8 +1047,7 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX,
                                              float& rfMinDist,
                                              ElementIndex& rulFacetInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    for (ElementIndex pI : rclSet) {
+    for (ElementIndex pI : Cell(ulX, ulY, ulZ)) {
         float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
         if (fDist < rfMinDist) {
             rfMinDist = fDist;
@@ -1028,15 +1090,15 @@ MeshPointGrid::MeshPointGrid(const MeshKernel& rclM, float fGridLen)
             std::max<unsigned long>(static_cast<unsigned long>(clBBMesh.LengthZ() / fGridLen), 1));
 }
 
-void MeshPointGrid::AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon)
+void MeshPointGrid::GetPointCells(const MeshPoint& rclPt,
+                                  std::vector<unsigned long>& raulCells) const
 {
-    (void)fEpsilon;
     unsigned long ulX {};
     unsigned long ulY {};
     unsigned long ulZ {};
     Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
     if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
-        _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+        raulCells.push_back(CellIndex(ulX, ulY, ulZ));
     }
 }
 
@@ -1093,13 +1155,11 @@ void MeshPointGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-
-    MeshPointIterator cPIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (cPIter.Init(); cPIter.More(); cPIter.Next()) {
-        AddPoint(*cPIter, i++);
-    }
+    const MeshPointArray& rPoints = _pclMesh->GetPoints();
+    _aulGrid.Build(_ulCtElements,
+                   [this, &rPoints](ElementIndex ulIndex, std::vector<unsigned long>& cells) {
+                       GetPointCells(rPoints[ulIndex], cells);
+                   });
 }
 
 void MeshPointGrid::Pos(const Base::Vector3f& rclPoint,
@@ -1164,9 +1224,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
     // point lies within global BB
     if (_rclGrid.GetBoundBox().IsInBox(rclPt)) {  // Determine the voxel by the starting point
         _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGridCells::Range cell = _rclGrid.Cell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
         _bValidRay = true;
     }
     else {  // Start point outside
@@ -1181,9 +1240,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
                 _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
             }
 
-            raulElements.insert(raulElements.end(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+            MeshGridCells::Range cell = _rclGrid.Cell(_ulX, _ulY, _ulZ);
+            raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             _bValidRay = true;
         }
     }
@@ -1247,9 +1305,8 @@ bool MeshGridIterator::NextOnRay(std::vector<ElementIndex>& raulElements)
     if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ)) {
         GridElement pos(_ulX, _ulY, _ulZ);
         _cSearchPositions.insert(pos);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGridCells::Range cell = _rclGrid.Cell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     else {
         _bValidRay = false;  // Beam leaked
@@ -23,7 +23,9 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <functional>
 #include <set>
+#include <vector>
 
 #include <Base/BoundBox.h>
 
@@ -44,6 +46,85 @@ class MeshGrid;
 
 #define MESHGRID_BBOX_EXTENSION 10.0f
 
+/**
+ * The MeshGridCells class stores the element indices of all cells of a grid in
+ * one array, sorted by cell, and the offset of each cell into this array
+ * (compressed sparse row layout). Compared to a container per cell this needs
+ * two allocations only, regardless of the number of cells and elements.
+ */
+class MeshExport MeshGridCells
+{
+public:
+    /// The element indices of one cell in ascending order
+    class Range
+    {
+    public:
+        Range(const ElementIndex* first, const ElementIndex* last)
+            : _first(first)
+            , _last(last)
+        {}
+        const ElementIndex* begin() const
+        {
+            return _first;
+        }
+        const ElementIndex* end() const
+        {
+            return _last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(_last - _first);
+        }
+        bool empty() const
+        {
+            return _first == _last;
+        }
+
+    private:
+        const ElementIndex* _first;
+        const ElementIndex* _last;
+    };
+
+    /** Appends the indices of the cells the given element belongs to. */
+    using CellFunction = std::function<void(ElementIndex, std::vector<unsigned long>&)>;
+
+    /** Sets the number of cells and removes all elements. */
+    void Resize(std::size_t ulCtCells);
+    /** Removes all cells. */
+    void Clear();
+    /** Fills the cells with the elements 0 to \a ulCtElements - 1. The cells of an element
+     * are determined by \a cellsOf that must list each cell once. The elements are
+     * classified in parallel for large element counts, so \a cellsOf must be thread-safe.
+     */
+    void Build(std::size_t ulCtElements, const CellFunction& cellsOf);
+    /** Returns the elements of the given cell. */
+    Range operator[](std::size_t ulCell) const
+    {
+        const ElementIndex* data = _elements.data();
+        return Range(data + _offsets[ulCell], data + _offsets[ulCell + 1]);
+    }
+    /** Returns the number of cells. */
+    std::size_t CountCells() const
+    {
+        return _offsets.empty() ? 0 : _offsets.size() - 1;
+    }
+    /** Returns the number of stored element indices. */
+    std::size_t CountElements() const
+    {
+        return _elements.size();
+    }
+    /** Returns the allocated memory in bytes. */
+    std::size_t GetMemSize() const
+    {
+        return _offsets.capacity() * sizeof(std::size_t)
+            + _elements.capacity() * sizeof(ElementIndex);
+    }
+
+private:
+    std::vector<std::size_t> _offsets;   /**< Start of each cell in _elements, plus the end. */
+    std::vector<ElementIndex> _elements; /**< Element indices of all cells. */
+};
+
 /**
  * The MeshGrid allows to divide a global mesh object into smaller regions
  * of elements (e.g. facets, points or edges) depending on the resolution
@@ -151,7 +232,17 @@ public:
     /** Returns the number of elements in a given grid. */
     unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
     {
-        return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size());
+        return static_cast<unsigned long>(Cell(ulX, ulY, ulZ).size());
+    }
+    /** Returns the elements in a given grid. */
+    MeshGridCells::Range Cell(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return _aulGrid[CellIndex(ulX, ulY, ulZ)];
+    }
+    /** Returns the allocated memory of the grid structure in bytes. */
+    std::size_t GetMemSize() const
+    {
+        return _aulGrid.GetMemSize();
     }
     /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes.
      */
@@ -192,11 +283,16 @@ protected:
     virtual void RebuildGrid() = 0;
     /** Returns the number of stored elements. Must be implemented in sub-classes. */
     virtual unsigned long HasElements() const = 0;
+    /** Returns the position of a grid in the grid data structure, like GetIndexToPosition()
+     * but without a check. */
+    unsigned long CellIndex(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return (ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX;
+    }
 
 protected:
     // NOLINTBEGIN
-    std::vector<std::vector<std::vector<std::set<ElementIndex>>>>
-        _aulGrid;                /**< Grid data structure. */
+    MeshGridCells _aulGrid;      /**< Grid data structure. */
     const MeshKernel* _pclMesh;  /**< The mesh kernel. */
     unsigned long _ulCtElements; /**< Number of grid elements for validation issues. */
     unsigned long _ulCtGridsX;   /**< Number of grid elements in z. */
@@ -284,11 +380,10 @@ protected:
                              unsigned long& rulX,
                              unsigned long& rulY,
                              unsigned long& rulZ) const;
-    /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a
-     * ulFacetIndex the corresponding index in the mesh kernel. The facet is added to each grid
-     * element that intersects the facet. */
-    inline void
-    AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0F);
+    /** Appends the indices of the grid elements that intersect the facet \a rclFacet to
+     * \a raulCells. */
+    inline void GetFacetCells(const MeshGeomFacet& rclFacet,
+                              std::vector<unsigned long>& raulCells) const;
     /** Returns the number of stored elements. */
     unsigned long HasElements() const override
     {
@@ -336,9 +431,9 @@ public:
     bool Verify() const override;
 
 protected:
-    /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a
-     * ulPtIndex the corresponding index in the mesh kernel. */
-    void AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0F);
+    /** Appends the index of the grid element that contains the point \a rclPt to \a raulCells.
+     * Nothing is added if the point lies outside the grid. */
+    void GetPointCells(const MeshPoint& rclPt, std::vector<unsigned long>& raulCells) const;
     /** Returns the grid numbers to the given point \a rclPoint. */
     void Pos(const Base::Vector3f& rclPoint,
              unsigned long& rulX,
@@ -370,9 +465,8 @@ public:
     /** Returns indices of the elements in the current grid. */
     void GetElements(std::vector<ElementIndex>& raulElements) const
     {
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGridCells::Range cell = _rclGrid.Cell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     /** Returns the number of elements in the current grid. */
     unsigned long GetCtElements() const
@@ -560,9 +654,8 @@ inline void MeshFacetGrid::PosWithCheck(const Base::Vector3f& rclPoint,
     assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
-                                    ElementIndex ulFacetIndex,
-                                    float /*fEpsilon*/)
+inline void MeshFacetGrid::GetFacetCells(const MeshGeomFacet& rclFacet,
+                                         std::vector<unsigned long>& raulCells) const
 {
     unsigned long ulX {};
     unsigned long ulY {};
@@ -604,14 +697,14 @@ inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
             for (ulY = ulY1; ulY <= ulY2; ulY++) {
                 for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                     if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                        _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                        raulCells.push_back(CellIndex(ulX, ulY, ulZ));
                     }
                 }
             }
         }
     }
     else {
-        _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+        raulCells.push_back(CellIndex(ulX1, ulY1, ulZ1));
     }
 }
 
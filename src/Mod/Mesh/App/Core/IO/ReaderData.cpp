@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cstring>
+#endif
+
+#include <QFile>
+#include <QString>
+
+#include "ReaderData.h"
+
+
+using namespace MeshCore;
+
+struct MappedFile::Private
+{
+    QFile file;
+    uchar* data {nullptr};
+    qint64 size {0};
+};
+
+MappedFile::MappedFile(const std::string& filename)
+    : p(new Private)
+{
+    p->file.setFileName(QString::fromUtf8(filename.c_str()));
+    if (p->file.open(QIODevice::ReadOnly)) {
+        p->size = p->file.size();
+        if (p->size > 0) {
+            p->data = p->file.map(0, p->size);
+        }
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (p->data) {
+        p->file.unmap(p->data);
+    }
+}
+
+bool MappedFile::IsValid() const
+{
+    return p->data != nullptr;
+}
+
+const char* MappedFile::Data() const
+{
+    return reinterpret_cast<const char*>(p->data);  // NOLINT
+}
+
+std::size_t MappedFile::Size() const
+{
+    return p->data ? static_cast<std::size_t>(p->size) : 0;
+}
+
+// ----------------------------------------------------------------------------
+
+MemoryBuffer::MemoryBuffer(const char* data, std::size_t size)
+{
+    // the buffer is never written to
+    char* begin = const_cast<char*>(data);  // NOLINT
+    setg(begin, begin, begin + size);
+}
+
+MemoryBuffer::pos_type
+MemoryBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+
+    off_type pos = off;
+    if (dir == std::ios_base::cur) {
+        pos += gptr() - eback();
+    }
+    else if (dir == std::ios_base::end) {
+        pos += egptr() - eback();
+    }
+    if (pos < 0 || pos > egptr() - eback()) {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+}
+
+MemoryBuffer::pos_type MemoryBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<std::pair<const char*, std::size_t>>
+MeshCore::SplitLines(const char* data, std::size_t size, std::size_t blockSize)
+{
+    std::vector<std::pair<const char*, std::size_t>> blocks;
+    const char* last = data + size;
+    for (const char* block = data; block < last;) {
+        const char* end = last;
+        if (static_cast<std::size_t>(last - block) > blockSize) {
+            auto eol = static_cast<const char*>(
+                std::memchr(block + blockSize, '\n', last - block - blockSize));
+            if (eol) {
+                end = eol + 1;
+            }
+        }
+        blocks.emplace_back(block, static_cast<std::size_t>(end - block));
+        block = end;
+    }
+    return blocks;
+}
+
+std::size_t MeshCore::CountLines(const char* data, std::size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    auto count = static_cast<std::size_t>(std::count(data, data + size, '\n'));
+    if (data[size - 1] != '\n') {
+        count++;
+    }
+    return count;
+}
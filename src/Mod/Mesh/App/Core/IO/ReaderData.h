@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_IO_READER_DATA_H
+#define MESH_IO_READER_DATA_H
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+
+namespace MeshCore
+{
+
+/**
+ * Maps a file into memory for reading. The file is unmapped again on destruction.
+ */
+class MeshExport MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /// Returns true if the file could be mapped
+    bool IsValid() const;
+    const char* Data() const;
+    std::size_t Size() const;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+/**
+ * A read-only stream buffer on a block of memory. It allows to parse the header of
+ * a mapped file with stream based code and to continue with the data behind it.
+ */
+class MeshExport MemoryBuffer: public std::streambuf
+{
+public:
+    MemoryBuffer(const char* data, std::size_t size);
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+/*!
+ * \brief Splits the data into blocks of whole lines of at least \a blockSize bytes.
+ * Only the last block may end without a line break.
+ */
+MeshExport std::vector<std::pair<const char*, std::size_t>>
+SplitLines(const char* data, std::size_t size, std::size_t blockSize);
+
+/*!
+ * \brief Counts the lines of the data. A last line without a line break is counted, too.
+ */
+MeshExport std::size_t CountLines(const char* data, std::size_t size);
+
+/*!
+ * \brief Calls \a func(begin, end) for each line of the data without its line break.
+ * The character at \a end is always a line break or a null character, so functions
+ * like std::atof() stop there even for the last line of a mapped file.
+ */
+template<class Func>
+void ForEachLine(const char* data, std::size_t size, Func func)
+{
+    const char* last = data + size;
+    for (const char* line = data; line < last;) {
+        auto eol = static_cast<const char*>(std::memchr(line, '\n', last - line));
+        if (!eol) {
+            std::string copy(line, last);
+            func(copy.c_str(), copy.c_str() + copy.size());
+            break;
+        }
+        func(line, eol);
+        line = eol + 1;
+    }
+}
+
+/*!
+ * \brief Reads the stream in blocks of whole lines and calls \a func(data, size) for
+ * each of them. A block is only larger than \a blockSize if a single line is.
+ */
+template<class Func>
+void ReadLines(std::istream& str, std::size_t blockSize, Func func)
+{
+    std::vector<char> buffer(std::max<std::size_t>(blockSize, 1));
+    std::size_t used = 0;
+    while (str) {
+        if (used == buffer.size()) {
+            buffer.resize(2 * buffer.size());
+        }
+        str.read(buffer.data() + used, static_cast<std::streamsize>(buffer.size() - used));
+        used += static_cast<std::size_t>(str.gcount());
+
+        auto eol = std::find(buffer.rbegin() + (buffer.size() - used), buffer.rend(), '\n');
+        if (eol != buffer.rend()) {
+            auto size = static_cast<std::size_t>(buffer.rend() - eol);
+            func(buffer.data(), size);
+            std::copy(buffer.begin() + size, buffer.begin() + used, buffer.begin());
+            used -= size;
+        }
+    }
+    if (used > 0) {
+        func(buffer.data(), used);
+    }
+}
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_DATA_H
@@ -25,188 +25,392 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 #include <boost/tokenizer.hpp>
+#include <cctype>
 #include <istream>
 #endif
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Tools.h>
 
+#include "ReaderData.h"
 #include "ReaderOBJ.h"
 
 
 using namespace MeshCore;
 
-ReaderOBJ::ReaderOBJ(MeshKernel& kernel, Material* material)
-    : _kernel(kernel)
-    , _material(material)
-{}
-
-bool ReaderOBJ::Load(std::istream& str)
+namespace
 {
-    boost::regex rx_m("^mtllib\\s+(.+)\\s*$");
-    boost::regex rx_u(R"(^usemtl\s+([\x21-\x7E]+)\s*$)");
-    boost::regex rx_g(R"(^g\s+([\x21-\x7E]+)\s*$)");
-    boost::regex rx_p("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_c("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+(\\d{1,3})\\s+(\\d{1,3})\\s+(\\d{1,3})\\s*$");
-    boost::regex rx_t("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f3("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::regex rx_f4("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::cmatch what;
+// Number of bytes read from a stream at once
+constexpr std::size_t BlockSize = 1 << 24;
+// Number of bytes parsed by one task
+constexpr std::size_t ChunkSize = 1 << 20;
 
-    unsigned long segment = 0;
-    MeshPointArray meshPoints;
-    MeshFacetArray meshFacets;
-
-    std::string line;
-    float fX {}, fY {}, fZ {};
-    int i1 = 1, i2 = 1, i3 = 1, i4 = 1;
-    MeshFacet item;
+struct Expressions
+{
+    boost::regex rx_m {"^mtllib\\s+(.+)\\s*$"};
+    boost::regex rx_u {R"(^usemtl\s+([\x21-\x7E]+)\s*$)"};
+    boost::regex rx_g {R"(^g\s+([\x21-\x7E]+)\s*$)"};
+    boost::regex rx_p {"^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"};
+    boost::regex rx_c {"^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+(\\d{1,3})\\s+(\\d{1,3})\\s+(\\d{1,3})\\s*$"};
+    boost::regex rx_t {"^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
+                       "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$"};
+    boost::regex rx_f3 {"^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
+                        "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
+                        "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$"};
+    boost::regex rx_f4 {"^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
+                        "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
+                        "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
+                        "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$"};
+};
+}  // namespace
+
+struct ReaderOBJ::Private
+{
+    struct Face
+    {
+        int indices[4];
+        int points;  // number of points of the chunk before the face
+        bool quad;
+    };
 
-    if (!str || str.bad()) {
-        return false;
-    }
+    // A statement that changes the state of the reader before the given face
+    struct Statement
+    {
+        enum Kind
+        {
+            Group,
+            Library,
+            Material
+        };
+        Kind kind;
+        std::string name;
+        std::size_t face;
+        std::size_t triangles;
+    };
 
-    std::streambuf* buf = str.rdbuf();
-    if (!buf) {
-        return false;
-    }
+    struct Chunk
+    {
+        const char* data;
+        std::size_t size;
+        std::vector<MeshPoint> points;
+        std::vector<Face> faces;
+        std::vector<Statement> statements;
+        std::size_t triangles {0};
+        bool colors {false};
+        // the first face of each range of faces in the same segment
+        std::vector<std::pair<std::size_t, unsigned long>> segments;
+        std::size_t pointOffset {0};
+        std::size_t facetOffset {0};
+    };
 
+    const Expressions rx;
+    MeshPointArray meshPoints;
+    MeshFacetArray meshFacets;
     MeshIO::Binding rgb_value = MeshIO::OVERALL;
+    unsigned long segment = 0;
     bool new_segment = true;
     std::string groupName;
     std::string materialName;
     unsigned long countMaterialFacets = 0;
 
-    while (std::getline(str, line)) {
-        if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+    void Parse(Chunk& chunk) const
+    {
+        boost::cmatch what;
+        ForEachLine(chunk.data, chunk.size, [&](const char* begin, const char* end) {
+            // only try the expressions of the keyword, and for faces only the one with the
+            // right number of vertices as a failing match can backtrack a lot
+            switch (*begin) {
+                case 'v':
+                    ParseVertex(chunk, begin, end, what);
+                    break;
+                case 'f':
+                    ParseFace(chunk, begin, end, what);
+                    break;
+                default:
+                    ParseStatement(chunk, begin, end, what);
+                    break;
+            }
+        });
+    }
+
+    void ParseVertex(Chunk& chunk, const char* begin, const char* end, boost::cmatch& what) const
+    {
+        if (boost::regex_match(begin, end, what, rx.rx_p)) {
+            float fX = (float)std::atof(what[1].first);
+            float fY = (float)std::atof(what[4].first);
+            float fZ = (float)std::atof(what[7].first);
+            chunk.points.emplace_back(Base::Vector3f(fX, fY, fZ));
         }
-        else if (boost::regex_match(line.c_str(), what, rx_c)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
+        else if (boost::regex_match(begin, end, what, rx.rx_c)) {
+            float fX = (float)std::atof(what[1].first);
+            float fY = (float)std::atof(what[4].first);
+            float fZ = (float)std::atof(what[7].first);
             float r = std::min<int>(std::atof(what[10].first), 255) / 255.0f;
             float g = std::min<int>(std::atof(what[11].first), 255) / 255.0f;
             float b = std::min<int>(std::atof(what[12].first), 255) / 255.0f;
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+            chunk.points.emplace_back(Base::Vector3f(fX, fY, fZ));
 
             App::Color c(r, g, b);
             unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
-            rgb_value = MeshIO::PER_VERTEX;
+            chunk.points.back().SetProperty(prop);
+            chunk.colors = true;
         }
-        else if (boost::regex_match(line.c_str(), what, rx_t)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
+        else if (boost::regex_match(begin, end, what, rx.rx_t)) {
+            float fX = (float)std::atof(what[1].first);
+            float fY = (float)std::atof(what[4].first);
+            float fZ = (float)std::atof(what[7].first);
             float r = static_cast<float>(std::atof(what[10].first));
             float g = static_cast<float>(std::atof(what[13].first));
             float b = static_cast<float>(std::atof(what[16].first));
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+            chunk.points.emplace_back(Base::Vector3f(fX, fY, fZ));
 
             App::Color c(r, g, b);
             unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
-            rgb_value = MeshIO::PER_VERTEX;
+            chunk.points.back().SetProperty(prop);
+            chunk.colors = true;
         }
-        else if (boost::regex_match(line.c_str(), what, rx_g)) {
-            new_segment = true;
-            groupName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_m)) {
-            if (_material) {
-                _material->library = Base::Tools::escapedUnicodeToUtf8(what[1].first);
+    }
+
+    void ParseFace(Chunk& chunk, const char* begin, const char* end, boost::cmatch& what) const
+    {
+        int tokens = 0;
+        for (const char* it = begin; it != end;) {
+            it = std::find_if(it, end, [](char c) {
+                return !std::isspace(static_cast<unsigned char>(c));
+            });
+            if (it != end) {
+                tokens++;
+                it = std::find_if(it, end, [](char c) {
+                    return std::isspace(static_cast<unsigned char>(c));
+                });
             }
         }
-        else if (boost::regex_match(line.c_str(), what, rx_u)) {
-            if (!materialName.empty()) {
-                _materialNames.emplace_back(materialName, countMaterialFacets);
-            }
-            materialName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-            countMaterialFacets = 0;
+
+        if (tokens == 4 && boost::regex_match(begin, end, what, rx.rx_f3)) {
+            // 3-vertex face
+            Face face {{std::atoi(what[1].first),
+                        std::atoi(what[2].first),
+                        std::atoi(what[3].first),
+                        0},
+                       static_cast<int>(chunk.points.size()),
+                       false};
+            chunk.faces.push_back(face);
+            chunk.triangles++;
         }
-        else if (boost::regex_match(line.c_str(), what, rx_f3)) {
-            // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
-                }
-                new_segment = false;
-                segment++;
+        else if (tokens == 5 && boost::regex_match(begin, end, what, rx.rx_f4)) {
+            // 4-vertex face
+            Face face {{std::atoi(what[1].first),
+                        std::atoi(what[2].first),
+                        std::atoi(what[3].first),
+                        std::atoi(what[4].first)},
+                       static_cast<int>(chunk.points.size()),
+                       true};
+            chunk.faces.push_back(face);
+            chunk.triangles += 2;
+        }
+    }
+
+    void
+    ParseStatement(Chunk& chunk, const char* begin, const char* end, boost::cmatch& what) const
+    {
+        if (boost::regex_match(begin, end, what, rx.rx_g)) {
+            chunk.statements.push_back({Statement::Group,
+                                        Base::Tools::escapedUnicodeToUtf8(what[1].str()),
+                                        chunk.faces.size(),
+                                        chunk.triangles});
+        }
+        else if (boost::regex_match(begin, end, what, rx.rx_m)) {
+            chunk.statements.push_back({Statement::Library,
+                                        Base::Tools::escapedUnicodeToUtf8(what[1].str()),
+                                        chunk.faces.size(),
+                                        chunk.triangles});
+        }
+        else if (boost::regex_match(begin, end, what, rx.rx_u)) {
+            chunk.statements.push_back({Statement::Material,
+                                        Base::Tools::escapedUnicodeToUtf8(what[1].str()),
+                                        chunk.faces.size(),
+                                        chunk.triangles});
+        }
+    }
+
+    // Copies the points and facets of the chunk to their final position
+    void Store(Chunk& chunk)
+    {
+        std::copy(chunk.points.begin(),
+                  chunk.points.end(),
+                  meshPoints.begin() + static_cast<std::ptrdiff_t>(chunk.pointOffset));
+
+        MeshFacet item;
+        auto range = chunk.segments.begin();
+        std::size_t pos = chunk.facetOffset;
+        for (std::size_t i = 0; i < chunk.faces.size(); i++) {
+            while (range + 1 != chunk.segments.end() && (range + 1)->first <= i) {
+                ++range;
             }
 
-            // 3-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-            item.SetVertices(i1, i2, i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
+            // negative indices count backwards from the last point read
+            const Face& face = chunk.faces[i];
+            int count = static_cast<int>(chunk.pointOffset) + face.points;
+            int idx[4];
+            for (int j = 0; j < 4; j++) {
+                idx[j] = face.indices[j] > 0 ? face.indices[j] - 1 : face.indices[j] + count;
+            }
+
+            item.SetVertices(idx[0], idx[1], idx[2]);
+            item.SetProperty(range->second);
+            meshFacets[pos++] = item;
+            if (face.quad) {
+                item.SetVertices(idx[2], idx[3], idx[0]);
+                item.SetProperty(range->second);
+                meshFacets[pos++] = item;
+            }
         }
-        else if (boost::regex_match(line.c_str(), what, rx_f4)) {
+
+        chunk = Chunk();
+    }
+};
+
+ReaderOBJ::ReaderOBJ(MeshKernel& kernel, Material* material)
+    : _kernel(kernel)
+    , _material(material)
+    , p(new Private)
+{}
+
+ReaderOBJ::~ReaderOBJ() = default;
+
+bool ReaderOBJ::Load(std::istream& str)
+{
+    if (!str || str.bad()) {
+        return false;
+    }
+
+    std::streambuf* buf = str.rdbuf();
+    if (!buf) {
+        return false;
+    }
+
+    ReadLines(str, BlockSize, [this](const char* data, std::size_t size) {
+        AddLines(data, size);
+    });
+    Finish();
+
+    return true;
+}
+
+bool ReaderOBJ::Load(const std::string& filename)
+{
+    MappedFile file(filename);
+    if (!file.IsValid()) {
+        return false;
+    }
+
+    AddLines(file.Data(), file.Size());
+    Finish();
+
+    return true;
+}
+
+void ReaderOBJ::AddLines(const char* data, std::size_t size)
+{
+    std::vector<Private::Chunk> chunks;
+    for (const auto& it : SplitLines(data, size, ChunkSize)) {
+        Private::Chunk chunk;
+        chunk.data = it.first;
+        chunk.size = it.second;
+        chunks.push_back(std::move(chunk));
+    }
+
+    parallel_map(chunks, [this](Private::Chunk& chunk) {
+        p->Parse(chunk);
+    });
+
+    // the statements change the state of the reader, so they are applied in order
+    std::size_t ctPoints = p->meshPoints.size();
+    std::size_t ctFacets = p->meshFacets.size();
+    for (auto& chunk : chunks) {
+        std::size_t face = 0;
+        std::size_t triangles = 0;
+        auto addFaces = [&](std::size_t nextFace, std::size_t nextTriangles) {
+            if (nextFace == face) {
+                return;
+            }
             // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
+            if (p->new_segment) {
+                if (!p->groupName.empty()) {
+                    _groupNames.push_back(p->groupName);
+                    p->groupName.clear();
                 }
-                new_segment = false;
-                segment++;
+                p->new_segment = false;
+                p->segment++;
             }
+            chunk.segments.emplace_back(face, p->segment);
+            p->countMaterialFacets += nextTriangles - triangles;
+            face = nextFace;
+            triangles = nextTriangles;
+        };
+
+        for (const auto& it : chunk.statements) {
+            addFaces(it.face, it.triangles);
+            switch (it.kind) {
+                case Private::Statement::Group:
+                    p->new_segment = true;
+                    p->groupName = it.name;
+                    break;
+                case Private::Statement::Library:
+                    if (_material) {
+                        _material->library = it.name;
+                    }
+                    break;
+                case Private::Statement::Material:
+                    if (!p->materialName.empty()) {
+                        _materialNames.emplace_back(p->materialName, p->countMaterialFacets);
+                    }
+                    p->materialName = it.name;
+                    p->countMaterialFacets = 0;
+                    break;
+            }
+        }
+        addFaces(chunk.faces.size(), chunk.triangles);
 
-            // 4-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-            i4 = std::atoi(what[4].first);
-            i4 = i4 > 0 ? i4 - 1 : i4 + static_cast<int>(meshPoints.size());
-
-            item.SetVertices(i1, i2, i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
-
-            item.SetVertices(i3, i4, i1);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
+        if (chunk.colors) {
+            p->rgb_value = MeshIO::PER_VERTEX;
         }
+        chunk.pointOffset = ctPoints;
+        chunk.facetOffset = ctFacets;
+        ctPoints += chunk.points.size();
+        ctFacets += chunk.triangles;
     }
 
+    p->meshPoints.resize(ctPoints);
+    p->meshFacets.resize(ctFacets);
+    parallel_map(chunks, [this](Private::Chunk& chunk) {
+        p->Store(chunk);
+    });
+}
+
+void ReaderOBJ::Finish()
+{
+    MeshPointArray& meshPoints = p->meshPoints;
+    MeshFacetArray& meshFacets = p->meshFacets;
+
     // Add the last added material name
-    if (!materialName.empty()) {
-        _materialNames.emplace_back(materialName, countMaterialFacets);
+    if (!p->materialName.empty()) {
+        _materialNames.emplace_back(p->materialName, p->countMaterialFacets);
     }
 
     // now get back the colors from the vertex property
-    if (rgb_value == MeshIO::PER_VERTEX) {
+    if (p->rgb_value == MeshIO::PER_VERTEX) {
         if (_material) {
             _material->binding = MeshIO::PER_VERTEX;
             _material->diffuseColor.reserve(meshPoints.size());
@@ -219,7 +423,7 @@ bool ReaderOBJ::Load(std::istream& str)
             }
         }
     }
-    else if (!materialName.empty()) {
+    else if (!p->materialName.empty()) {
         // At this point the materials from the .mtl file are not known and will be read-in by the
         // calling instance but the color list is pre-filled with a default value
         if (_material) {
@@ -238,8 +442,6 @@ bool ReaderOBJ::Load(std::istream& str)
     MeshPointFacetAdjacency meshAdj(meshPoints.size(), meshFacets);
     meshAdj.SetFacetNeighbourhood();
     _kernel.Adopt(meshPoints, meshFacets);
-
-    return true;
 }
 
 bool ReaderOBJ::LoadMaterial(std::istream& str)
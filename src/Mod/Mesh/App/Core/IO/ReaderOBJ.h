@@ -27,6 +27,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/MeshGlobal.h>
 #include <iosfwd>
+#include <memory>
 
 namespace MeshCore
 {
@@ -34,7 +35,10 @@ namespace MeshCore
 class MeshKernel;
 struct Material;
 
-/** Loads the mesh object from data in OBJ format. */
+/** Loads the mesh object from data in OBJ format.
+ * The data is split into blocks of whole lines which are parsed in parallel. Only
+ * the group and material statements are applied in the order of the file.
+ */
 class MeshExport ReaderOBJ
 {
 public:
@@ -42,11 +46,23 @@ public:
      * \brief ReaderOBJ
      */
     explicit ReaderOBJ(MeshKernel& kernel, Material*);
+    ~ReaderOBJ();
+
+    ReaderOBJ(const ReaderOBJ&) = delete;
+    ReaderOBJ(ReaderOBJ&&) = delete;
+    ReaderOBJ& operator=(const ReaderOBJ&) = delete;
+    ReaderOBJ& operator=(ReaderOBJ&&) = delete;
+
     /*!
      * \brief Load the mesh from the input stream
      * \return true on success and false otherwise
      */
     bool Load(std::istream& str);
+    /*!
+     * \brief Maps the file into memory and loads the mesh from it
+     * \return true on success and false if the file cannot be mapped
+     */
+    bool Load(const std::string& filename);
     /*!
      * \brief Load the material file to the corresponding OBJ file.
      * This function must be called after \ref Load().
@@ -61,10 +77,16 @@ public:
     }
 
 private:
+    void AddLines(const char* data, std::size_t size);
+    void Finish();
+
+private:
+    struct Private;
     MeshKernel& _kernel;
     Material* _material;
     std::vector<std::string> _groupNames;
     std::vector<std::pair<std::string, unsigned long>> _materialNames;
+    std::unique_ptr<Private> p;
 };
 
 }  // namespace MeshCore
@@ -0,0 +1,779 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <istream>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/regex.hpp>
+#endif
+
+#include <Base/Swap.h>
+
+#include "Core/Functional.h"
+#include "Core/MeshIO.h"
+#include "Core/MeshKernel.h"
+
+#include "ReaderData.h"
+#include "ReaderPLY.h"
+
+
+using namespace MeshCore;
+
+// http://local.wasp.uwa.edu.au/~pbourke/dataformats/ply/
+
+namespace
+{
+// Number of bytes read from a stream at once
+constexpr std::size_t BlockSize = 1 << 24;
+// Number of bytes of ASCII data parsed by one task
+constexpr std::size_t ChunkSize = 1 << 20;
+// Number of binary records parsed by one task
+constexpr std::size_t RecordChunk = 65536;
+
+enum Number
+{
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    float32,
+    float64
+};
+
+bool toNumber(const std::string& type, Number& number)
+{
+    if (type == "char" || type == "int8") {
+        number = int8;
+    }
+    else if (type == "uchar" || type == "uint8") {
+        number = uint8;
+    }
+    else if (type == "short" || type == "int16") {
+        number = int16;
+    }
+    else if (type == "ushort" || type == "uint16") {
+        number = uint16;
+    }
+    else if (type == "int" || type == "int32") {
+        number = int32;
+    }
+    else if (type == "uint" || type == "uint32") {
+        number = uint32;
+    }
+    else if (type == "float" || type == "float32") {
+        number = float32;
+    }
+    else if (type == "double" || type == "float64") {
+        number = float64;
+    }
+    else {
+        // no valid number type
+        return false;
+    }
+    return true;
+}
+
+std::size_t sizeOf(Number number)
+{
+    switch (number) {
+        case int8:
+        case uint8:
+            return 1;
+        case int16:
+        case uint16:
+            return 2;
+        case int32:
+        case uint32:
+        case float32:
+            return 4;
+        case float64:
+            return 8;
+    }
+    return 0;
+}
+
+template<typename T>
+double readAs(const char* data, bool swap)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    if (swap) {
+        Base::SwapEndian(value);
+    }
+    return static_cast<double>(value);
+}
+
+double readNumber(const char* data, Number number, bool swap)
+{
+    switch (number) {
+        case int8:
+            return readAs<int8_t>(data, swap);
+        case uint8:
+            return readAs<uint8_t>(data, swap);
+        case int16:
+            return readAs<int16_t>(data, swap);
+        case uint16:
+            return readAs<uint16_t>(data, swap);
+        case int32:
+            return readAs<int32_t>(data, swap);
+        case uint32:
+            return readAs<uint32_t>(data, swap);
+        case float32:
+            return readAs<float>(data, swap);
+        case float64:
+            return readAs<double>(data, swap);
+    }
+    return 0.0;
+}
+
+bool readNumber(std::istream& str, Number number, bool swap, double& value)
+{
+    char data[8];
+    str.read(data, static_cast<std::streamsize>(sizeOf(number)));
+    value = readNumber(data, number, swap);
+    return static_cast<bool>(str);
+}
+
+// A property of the face element, only the vertex indices are used
+struct FaceProperty
+{
+    bool list;
+    Number count;
+    Number type;
+    bool indices;
+};
+}  // namespace
+
+struct ReaderPLY::Private
+{
+    enum
+    {
+        unknown,
+        ascii,
+        binary_little_endian,
+        binary_big_endian
+    } format = unknown;
+
+    std::size_t v_count = 0;
+    std::size_t f_count = 0;
+    std::vector<std::pair<std::string, Number>> vertex_props;
+    std::vector<FaceProperty> face_props;
+    // index of x, y, z, red, green and blue in vertex_props
+    std::array<std::size_t, 6> coords {};
+    bool colors = false;
+
+    MeshPointArray meshPoints;
+    MeshFacetArray meshFacets;
+    std::vector<App::Color> diffuseColor;
+    std::size_t lines = 0;
+
+    // the data of a file mapped into memory
+    const char* mapped = nullptr;
+    std::size_t mappedSize = 0;
+
+    const boost::regex rx_d {"(([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?))\\s*"};
+    const boost::regex rx_s {"\\b([-+]?[0-9]+)\\s*"};
+    const boost::regex rx_u {"\\b([0-9]+)\\s*"};
+    const boost::regex rx_f {R"(^\s*3\s+([0-9]+)\s+([0-9]+)\s+([0-9]+)\s*)"};
+
+    bool ParseVertex(const char* begin,
+                     const char* end,
+                     std::vector<float>& values,
+                     boost::cmatch& what) const
+    {
+        // go through the vertex properties
+        for (std::size_t i = 0; i < vertex_props.size(); i++) {
+            switch (vertex_props[i].second) {
+                case int8:
+                case int16:
+                case int32: {
+                    if (!boost::regex_search(begin, end, what, rx_s)) {
+                        return false;
+                    }
+                    int v = boost::lexical_cast<int>(what[1].str());
+                    values[i] = static_cast<float>(v);
+                } break;
+                case uint8:
+                case uint16:
+                case uint32: {
+                    if (!boost::regex_search(begin, end, what, rx_u)) {
+                        return false;
+                    }
+                    int v = boost::lexical_cast<int>(what[1].str());
+                    values[i] = static_cast<float>(v);
+                } break;
+                case float32:
+                case float64: {
+                    if (!boost::regex_search(begin, end, what, rx_d)) {
+                        return false;
+                    }
+                    double v = boost::lexical_cast<double>(what[1].str());
+                    values[i] = static_cast<float>(v);
+                } break;
+                default:
+                    return false;
+            }
+            begin = what[0].second;
+        }
+        return true;
+    }
+
+    void SetVertex(std::size_t index, const float* values)
+    {
+        meshPoints[index].Set(values[coords[0]], values[coords[1]], values[coords[2]]);
+        if (!diffuseColor.empty()) {
+            float r = values[coords[3]] / 255.0f;
+            float g = values[coords[4]] / 255.0f;
+            float b = values[coords[5]] / 255.0f;
+            diffuseColor[index] = App::Color(r, g, b);
+        }
+    }
+
+    // Passes blocks of records to func(data, first, count). A mapped file is passed at once.
+    template<class Func>
+    bool ReadRecords(std::istream& str, std::size_t count, std::size_t size, Func func)
+    {
+        if (mapped) {
+            auto pos = static_cast<std::size_t>(str.tellg());
+            if ((mappedSize - pos) / size < count) {
+                return false;
+            }
+            func(mapped + pos, std::size_t(0), count);
+            str.seekg(static_cast<std::streamoff>(pos + count * size));
+            return true;
+        }
+
+        std::size_t blockRecords = std::max<std::size_t>(BlockSize / size, 1);
+        std::vector<char> block(std::min(count, blockRecords) * size);
+        for (std::size_t i = 0; i < count; i += blockRecords) {
+            std::size_t records = std::min(blockRecords, count - i);
+            if (!str.read(block.data(), static_cast<std::streamsize>(records * size))) {
+                return false;
+            }
+            func(block.data(), i, records);
+        }
+        return true;
+    }
+
+    // Reads faces whose records have all the same size if they are triangles.
+    // Returns false if there is another face.
+    bool ReadTriangles(std::istream& str, std::size_t size)
+    {
+        bool swap = (format == binary_big_endian);
+        std::vector<std::vector<MeshFacet>> chunks;
+        bool triangles = true;
+        bool ok = ReadRecords(
+            str,
+            f_count,
+            size,
+            [&](const char* data, std::size_t, std::size_t count) {
+                std::size_t offset = chunks.size();
+                chunks.resize(offset + (count + RecordChunk - 1) / RecordChunk);
+                std::vector<std::size_t> indices(chunks.size() - offset);
+                std::iota(indices.begin(), indices.end(), offset);
+                std::vector<char> valid(indices.size(), 1);
+                parallel_map(indices, [&](std::size_t index) {
+                    std::size_t first = (index - offset) * RecordChunk;
+                    std::size_t last = std::min(first + RecordChunk, count);
+                    auto& facets = chunks[index];
+                    facets.reserve(last - first);
+                    for (std::size_t i = first; i < last; i++) {
+                        const char* record = data + i * size;
+                        for (const auto& prop : face_props) {
+                            if (prop.indices) {
+                                if (readNumber(record, prop.count, swap) != 3.0) {
+                                    valid[index - offset] = 0;
+                                    return;
+                                }
+                                record += sizeOf(prop.count);
+                                double f[3];
+                                for (double& it : f) {
+                                    it = readNumber(record, prop.type, swap);
+                                    record += sizeOf(prop.type);
+                                }
+                                if (f[0] >= 0 && f[1] >= 0 && f[2] >= 0 && f[0] < v_count
+                                    && f[1] < v_count && f[2] < v_count) {
+                                    facets.emplace_back(static_cast<PointIndex>(f[0]),
+                                                        static_cast<PointIndex>(f[1]),
+                                                        static_cast<PointIndex>(f[2]));
+                                }
+                            }
+                            else {
+                                record += sizeOf(prop.type);
+                            }
+                        }
+                    }
+                });
+                triangles = triangles
+                    && std::all_of(valid.begin(), valid.end(), [](char value) {
+                                return value != 0;
+                            });
+            });
+        if (!ok || !triangles) {
+            return false;
+        }
+
+        std::size_t count = 0;
+        for (const auto& it : chunks) {
+            count += it.size();
+        }
+        meshFacets.reserve(count);
+        for (auto& it : chunks) {
+            meshFacets.insert(meshFacets.end(), it.begin(), it.end());
+            std::vector<MeshFacet>().swap(it);
+        }
+        return true;
+    }
+
+    // Reads the faces one after another, only triangles are kept
+    void ReadFaces(std::istream& str)
+    {
+        bool swap = (format == binary_big_endian);
+        std::vector<double> indices;
+        for (std::size_t i = 0; i < f_count && str; i++) {
+            indices.clear();
+            for (const auto& prop : face_props) {
+                double count = 1.0;
+                if (prop.list && !readNumber(str, prop.count, swap, count)) {
+                    return;
+                }
+                for (double j = 0; j < count; j++) {
+                    double value {};
+                    if (!readNumber(str, prop.type, swap, value)) {
+                        return;
+                    }
+                    if (prop.indices) {
+                        indices.push_back(value);
+                    }
+                }
+            }
+
+            if (indices.size() == 3 && indices[0] >= 0 && indices[1] >= 0 && indices[2] >= 0
+                && indices[0] < v_count && indices[1] < v_count && indices[2] < v_count) {
+                meshFacets.push_back(MeshFacet(static_cast<PointIndex>(indices[0]),
+                                               static_cast<PointIndex>(indices[1]),
+                                               static_cast<PointIndex>(indices[2])));
+            }
+        }
+    }
+};
+
+ReaderPLY::ReaderPLY(MeshKernel& kernel, Material* material)
+    : _kernel(kernel)
+    , _material(material)
+    , p(new Private)
+{}
+
+ReaderPLY::~ReaderPLY() = default;
+
+bool ReaderPLY::Load(const std::string& filename)
+{
+    MappedFile file(filename);
+    if (!file.IsValid()) {
+        return false;
+    }
+
+    MemoryBuffer buf(file.Data(), file.Size());
+    std::istream str(&buf);
+    p->mapped = file.Data();
+    p->mappedSize = file.Size();
+    bool ok = Load(str);
+    p->mapped = nullptr;
+    p->mappedSize = 0;
+    return ok;
+}
+
+bool ReaderPLY::Load(std::istream& inp)
+{
+    if (!inp || inp.bad()) {
+        return false;
+    }
+
+    std::streambuf* buf = inp.rdbuf();
+    if (!buf) {
+        return false;
+    }
+
+    if (!ReadHeader(inp)) {
+        return false;
+    }
+
+    bool ok = (p->format == Private::ascii) ? ReadAscii(inp) : ReadBinary(inp);
+    if (!ok) {
+        return false;
+    }
+
+    Finish();
+    return true;
+}
+
+bool ReaderPLY::ReadHeader(std::istream& inp)
+{
+    // read in the first three characters
+    char ply[3];
+    inp.read(ply, 3);
+    inp.ignore(1);
+    if (!inp) {
+        return false;
+    }
+    if ((ply[0] != 'p') || (ply[1] != 'l') || (ply[2] != 'y')) {
+        return false;  // wrong header
+    }
+
+    std::vector<std::pair<std::string, Number>>& vertex_props = p->vertex_props;
+    std::string line, element;
+
+    while (std::getline(inp, line)) {
+        std::istringstream str(line);
+        str.unsetf(std::ios_base::skipws);
+        str >> std::ws;
+        if (str.eof()) {
+            continue;  // empty line
+        }
+        std::string kw;
+        str >> kw;
+        if (kw == "format") {
+            std::string format_string, version;
+            char space_format_string {}, space_format_version {};
+            str >> space_format_string >> std::ws >> format_string >> space_format_version
+                >> std::ws >> version;
+            if (/*!str || !str.eof() ||*/
+                !std::isspace(space_format_string) || !std::isspace(space_format_version)) {
+                return false;
+            }
+            if (format_string == "ascii") {
+                p->format = Private::ascii;
+            }
+            else if (format_string == "binary_big_endian") {
+                p->format = Private::binary_big_endian;
+            }
+            else if (format_string == "binary_little_endian") {
+                p->format = Private::binary_little_endian;
+            }
+            else {
+                // wrong format version
+                return false;
+            }
+            if (version != "1.0") {
+                // wrong version
+                return false;
+            }
+        }
+        else if (kw == "element") {
+            std::string name;
+            std::size_t count {};
+            char space_element_name {}, space_name_count {};
+            str >> space_element_name >> std::ws >> name >> space_name_count >> std::ws >> count;
+            if (/*!str || !str.eof() ||*/
+                !std::isspace(space_element_name) || !std::isspace(space_name_count)) {
+                return false;
+            }
+            else if (name == "vertex") {
+                element = name;
+                p->v_count = count;
+            }
+            else if (name == "face") {
+                element = name;
+                p->f_count = count;
+            }
+            else {
+                element.clear();
+            }
+        }
+        else if (kw == "property") {
+            std::string type, name;
+            char space {};
+            if (element == "vertex") {
+                str >> space >> std::ws >> type >> space >> std::ws >> name >> std::ws;
+
+                Number number {};
+                if (!toNumber(type, number)) {
+                    return false;
+                }
+
+                // store the property name and type
+                vertex_props.emplace_back(name, number);
+            }
+            else if (element == "face") {
+                FaceProperty prop {false, uint8, uint8, false};
+                std::string list, count;
+                str >> space >> std::ws >> list >> std::ws;
+                if (list == "list") {
+                    prop.list = true;
+                    str >> count >> std::ws >> type >> std::ws >> name >> std::ws;
+                    if (!toNumber(count, prop.count)) {
+                        return false;
+                    }
+                }
+                else {
+                    // not a 'list'
+                    type = list;
+                    str >> name;
+                }
+                if (!toNumber(type, prop.type)) {
+                    return false;
+                }
+                prop.indices = prop.list && (name == "vertex_indices" || name == "vertex_index");
+
+                // store the property
+                p->face_props.push_back(prop);
+            }
+        }
+        else if (kw == "end_header") {
+            break;  // end of the header, now read the data
+        }
+    }
+
+    // check if valid 3d points
+    auto indexOf = [&vertex_props](const char* name, std::size_t& index) {
+        auto count = std::count_if(vertex_props.begin(),
+                                   vertex_props.end(),
+                                   [name](const std::pair<std::string, Number>& prop) {
+                                       return prop.first == name;
+                                   });
+        auto it = std::find_if(vertex_props.begin(),
+                               vertex_props.end(),
+                               [name](const std::pair<std::string, Number>& prop) {
+                                   return prop.first == name;
+                               });
+        index = static_cast<std::size_t>(it - vertex_props.begin());
+        return count;
+    };
+
+    if (indexOf("x", p->coords[0]) != 1 || indexOf("y", p->coords[1]) != 1
+        || indexOf("z", p->coords[2]) != 1) {
+        return false;
+    }
+
+    for (auto& it : vertex_props) {
+        if (it.first == "diffuse_red") {
+            it.first = "red";
+        }
+        else if (it.first == "diffuse_green") {
+            it.first = "green";
+        }
+        else if (it.first == "diffuse_blue") {
+            it.first = "blue";
+        }
+    }
+
+    // check if valid colors are set
+    auto rgb_colors = indexOf("red", p->coords[3]) + indexOf("green", p->coords[4])
+        + indexOf("blue", p->coords[5]);
+    if (rgb_colors != 0 && rgb_colors != 3) {
+        return false;
+    }
+
+    // only if set per vertex
+    p->colors = (rgb_colors == 3);
+    return true;
+}
+
+bool ReaderPLY::ReadAscii(std::istream& str)
+{
+    p->meshPoints.resize(p->v_count);
+    if (_material && p->colors) {
+        p->diffuseColor.resize(p->v_count);
+    }
+
+    bool ok = true;
+    if (p->mapped) {
+        auto pos = static_cast<std::size_t>(str.tellg());
+        ok = AddAscii(p->mapped + pos, p->mappedSize - pos);
+    }
+    else {
+        ReadLines(str, BlockSize, [this, &ok](const char* data, std::size_t size) {
+            ok = ok && AddAscii(data, size);
+        });
+    }
+
+    // the file may end early
+    if (p->lines < p->v_count) {
+        p->meshPoints.resize(p->lines);
+        if (!p->diffuseColor.empty()) {
+            p->diffuseColor.resize(p->lines);
+        }
+    }
+    return ok;
+}
+
+bool ReaderPLY::AddAscii(const char* data, std::size_t size)
+{
+    struct Chunk
+    {
+        const char* data;
+        std::size_t size;
+        std::size_t line;
+        std::vector<MeshFacet> facets;
+        bool ok;
+    };
+
+    std::vector<Chunk> chunks;
+    for (const auto& it : SplitLines(data, size, ChunkSize)) {
+        chunks.push_back({it.first, it.second, 0, {}, true});
+    }
+
+    // the index of a line decides whether it's a vertex or a face
+    parallel_map(chunks, [](Chunk& chunk) {
+        chunk.line = CountLines(chunk.data, chunk.size);
+    });
+    std::size_t lines = p->lines;
+    for (auto& chunk : chunks) {
+        std::size_t count = chunk.line;
+        chunk.line = lines;
+        lines += count;
+    }
+    p->lines = lines;
+
+    std::size_t v_count = p->v_count;
+    std::size_t f_count = p->f_count;
+    parallel_map(chunks, [this, v_count, f_count](Chunk& chunk) {
+        std::vector<float> values(p->vertex_props.size());
+        boost::cmatch what;
+        std::size_t line = chunk.line;
+        ForEachLine(chunk.data, chunk.size, [&](const char* begin, const char* end) {
+            if (!chunk.ok) {
+                return;
+            }
+            if (line < v_count) {
+                chunk.ok = p->ParseVertex(begin, end, values, what);
+                if (chunk.ok) {
+                    p->SetVertex(line, values.data());
+                }
+            }
+            else if (line < v_count + f_count) {
+                if (boost::regex_search(begin, end, what, p->rx_f)) {
+                    int f1 = boost::lexical_cast<int>(what[1].str());
+                    int f2 = boost::lexical_cast<int>(what[2].str());
+                    int f3 = boost::lexical_cast<int>(what[3].str());
+                    chunk.facets.emplace_back(f1, f2, f3);
+                }
+            }
+            line++;
+        });
+    });
+
+    for (auto& chunk : chunks) {
+        if (!chunk.ok) {
+            return false;
+        }
+        p->meshFacets.insert(p->meshFacets.end(), chunk.facets.begin(), chunk.facets.end());
+    }
+    return true;
+}
+
+bool ReaderPLY::ReadBinary(std::istream& str)
+{
+    bool swap = (p->format == Private::binary_big_endian);
+
+    std::size_t recordSize = 0;
+    std::vector<std::size_t> offsets;
+    for (const auto& it : p->vertex_props) {
+        offsets.push_back(recordSize);
+        recordSize += sizeOf(it.second);
+    }
+
+    p->meshPoints.resize(p->v_count);
+    if (_material && p->colors) {
+        p->diffuseColor.resize(p->v_count);
+    }
+
+    auto parseVertices = [&](const char* data, std::size_t first, std::size_t count) {
+        parallel_for(
+            count,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<float> values(p->vertex_props.size());
+                for (std::size_t i = begin; i < end; i++) {
+                    const char* record = data + i * recordSize;
+                    for (std::size_t j = 0; j < values.size(); j++) {
+                        values[j] = static_cast<float>(
+                            readNumber(record + offsets[j], p->vertex_props[j].second, swap));
+                    }
+                    p->SetVertex(first + i, values.data());
+                }
+            },
+            RecordChunk);
+    };
+    if (!p->ReadRecords(str, p->v_count, recordSize, parseVertices)) {
+        return false;
+    }
+
+    // if all faces are triangles the records have the same size
+    std::size_t triangleSize = 0;
+    bool fixedSize = true;
+    for (const auto& it : p->face_props) {
+        if (it.indices) {
+            triangleSize += sizeOf(it.count) + 3 * sizeOf(it.type);
+        }
+        else if (it.list) {
+            fixedSize = false;
+        }
+        else {
+            triangleSize += sizeOf(it.type);
+        }
+    }
+
+    if (p->mapped && fixedSize && triangleSize > 0) {
+        auto pos = str.tellg();
+        if (p->ReadTriangles(str, triangleSize)) {
+            return true;
+        }
+        str.clear();
+        str.seekg(pos);
+    }
+
+    p->ReadFaces(str);
+    return true;
+}
+
+void ReaderPLY::Finish()
+{
+    MeshPointArray& meshPoints = p->meshPoints;
+    MeshFacetArray& meshFacets = p->meshFacets;
+
+    if (_material && p->colors) {
+        _material->binding = MeshIO::PER_VERTEX;
+        _material->diffuseColor.swap(p->diffuseColor);
+    }
+
+    _kernel.Clear();  // remove all data before
+
+    MeshCleanup meshCleanup(meshPoints, meshFacets);
+    if (_material) {
+        meshCleanup.SetMaterial(_material);
+    }
+    meshCleanup.RemoveInvalids();
+    MeshPointFacetAdjacency meshAdj(meshPoints.size(), meshFacets);
+    meshAdj.SetFacetNeighbourhood();
+    _kernel.Adopt(meshPoints, meshFacets);
+}
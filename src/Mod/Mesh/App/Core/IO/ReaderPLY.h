@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_IO_READER_PLY_H
+#define MESH_IO_READER_PLY_H
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+struct Material;
+
+/**
+ * Loads the mesh object from data in PLY format.
+ *
+ * ASCII data is split into blocks of whole lines and binary vertex data into blocks
+ * of records, which are parsed in parallel. Binary faces are parsed in parallel if
+ * all of them are triangles with fixed size records, otherwise one after another.
+ * A file mapped into memory is parsed in place.
+ */
+class MeshExport ReaderPLY
+{
+public:
+    ReaderPLY(MeshKernel& kernel, Material*);
+    ~ReaderPLY();
+
+    ReaderPLY(const ReaderPLY&) = delete;
+    ReaderPLY(ReaderPLY&&) = delete;
+    ReaderPLY& operator=(const ReaderPLY&) = delete;
+    ReaderPLY& operator=(ReaderPLY&&) = delete;
+
+    /*!
+     * \brief Load the mesh from the input stream
+     * \return true on success and false otherwise
+     */
+    bool Load(std::istream& str);
+    /*!
+     * \brief Maps the file into memory and loads the mesh from it
+     * \return true on success and false if the file cannot be mapped or isn't
+     * a valid PLY file
+     */
+    bool Load(const std::string& filename);
+
+private:
+    bool ReadHeader(std::istream& str);
+    bool ReadAscii(std::istream& str);
+    bool AddAscii(const char* data, std::size_t size);
+    bool ReadBinary(std::istream& str);
+    void Finish();
+
+private:
+    struct Private;
+    MeshKernel& _kernel;
+    Material* _material;
+    std::unique_ptr<Private> p;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_PLY_H
@@ -0,0 +1,393 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#endif
+
+#include "Core/Functional.h"
+#include "Core/MeshKernel.h"
+
+#include "ReaderData.h"
+#include "ReaderSTL.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+// Number of facet records parsed by one task
+constexpr std::size_t ChunkSize = 65536;
+// Number of shards of the hash table that merges the points of all chunks
+constexpr std::size_t ShardCount = 64;
+
+// Identifies a point, either by the bits of its coordinates or by its grid cell
+struct PointKey
+{
+    std::uint32_t x;
+    std::uint32_t y;
+    std::uint32_t z;
+
+    bool operator==(const PointKey& other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+std::uint64_t hashKey(const PointKey& key)
+{
+    std::uint64_t hash = key.x;
+    hash = hash * 0x9E3779B97F4A7C15ULL + key.y;
+    hash = hash * 0x9E3779B97F4A7C15ULL + key.z;
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// The upper bits select the shard, the lower bits the slot in the table
+std::uint8_t shardOf(std::uint64_t hash)
+{
+    return static_cast<std::uint8_t>(hash >> 58);
+}
+static_assert(ShardCount == 64, "shardOf() uses six bits");
+
+// Open addressing hash table that assigns consecutive indices to the keys
+class PointTable
+{
+public:
+    void Reserve(std::size_t count)
+    {
+        std::size_t capacity = 16;
+        while (capacity < 2 * count) {
+            capacity *= 2;
+        }
+        _slots.assign(capacity, Empty);
+        _keys.reserve(count);
+    }
+    // Returns the index of the key and adds it if needed
+    std::uint32_t Insert(const PointKey& key, std::uint64_t hash)
+    {
+        if (2 * (_keys.size() + 1) > _slots.size()) {
+            Grow();
+        }
+        std::size_t mask = _slots.size() - 1;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+            std::uint32_t index = _slots[i];
+            if (index == Empty) {
+                index = static_cast<std::uint32_t>(_keys.size());
+                _slots[i] = index;
+                _keys.push_back(key);
+                return index;
+            }
+            if (_keys[index] == key) {
+                return index;
+            }
+        }
+    }
+    std::size_t Size() const
+    {
+        return _keys.size();
+    }
+    // Returns the keys in the order of their indices and clears the table
+    std::vector<PointKey> TakeKeys()
+    {
+        std::vector<uint32_t>().swap(_slots);
+        return std::move(_keys);
+    }
+
+private:
+    void Grow()
+    {
+        std::vector<std::uint32_t> slots(std::max<std::size_t>(16, 2 * _slots.size()), Empty);
+        std::size_t mask = slots.size() - 1;
+        for (std::uint32_t index = 0; index < _keys.size(); index++) {
+            std::size_t i = hashKey(_keys[index]) & mask;
+            while (slots[i] != Empty) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = index;
+        }
+        _slots.swap(slots);
+    }
+
+    static constexpr std::uint32_t Empty = UINT32_MAX;
+    std::vector<std::uint32_t> _slots;
+    std::vector<PointKey> _keys;
+};
+
+std::uint32_t cellOf(float coord, float size)
+{
+    float cell = std::clamp(std::floor(coord / size), -2147483648.0F, 2147483520.0F);
+    return static_cast<std::uint32_t>(static_cast<std::int32_t>(cell));
+}
+}  // namespace
+
+struct ReaderSTL::Private
+{
+    struct Chunk
+    {
+        const char* data;
+        std::size_t count;
+        std::vector<PointKey> keys;            // keys of the points in order of first use
+        std::vector<Base::Vector3f> points;    // first point of each key
+        std::vector<std::uint32_t> facets;     // three point indices per kept facet
+        std::vector<std::uint8_t> shards;      // shard of each point
+        std::vector<std::uint32_t> shardOrder; // point indices grouped by shard
+        std::array<std::uint32_t, ShardCount + 1> shardStart {};
+        std::vector<std::uint32_t> remap;      // point index within the shard
+    };
+
+    struct Shard
+    {
+        std::size_t index;
+        std::size_t offset;
+        std::vector<Base::Vector3f> points;
+    };
+
+    std::vector<Chunk> chunks;
+    Base::BoundBox3f boundBox;
+    float clusterSize {0.0F};
+
+    PointKey MakeKey(const Base::Vector3f& pnt) const
+    {
+        PointKey key {};
+        if (clusterSize > 0.0F) {
+            key.x = cellOf(pnt.x, clusterSize);
+            key.y = cellOf(pnt.y, clusterSize);
+            key.z = cellOf(pnt.z, clusterSize);
+        }
+        else {
+            // adding zero turns -0 into +0
+            float coords[3] = {pnt.x + 0.0F, pnt.y + 0.0F, pnt.z + 0.0F};
+            std::memcpy(&key, coords, sizeof(key));
+        }
+        return key;
+    }
+
+    void Parse(Chunk& chunk) const
+    {
+        bool crop = boundBox.IsValid();
+        bool cluster = clusterSize > 0.0F;
+
+        PointTable table;
+        table.Reserve(chunk.count / 2);
+        chunk.facets.reserve(3 * chunk.count);
+        for (std::size_t i = 0; i < chunk.count; i++) {
+            // skip the normal at the beginning of the record
+            const char* record = chunk.data + i * RecordSize + 3 * sizeof(float);
+            float coords[9];
+            std::memcpy(coords, record, sizeof(coords));
+            Base::Vector3f pnts[3] = {Base::Vector3f(coords[0], coords[1], coords[2]),
+                                      Base::Vector3f(coords[3], coords[4], coords[5]),
+                                      Base::Vector3f(coords[6], coords[7], coords[8])};
+            if (crop) {
+                Base::BoundBox3f box(pnts, 3);
+                if (!(box && boundBox)) {
+                    continue;
+                }
+            }
+
+            std::uint32_t indices[3];
+            for (int j = 0; j < 3; j++) {
+                PointKey key = MakeKey(pnts[j]);
+                indices[j] = table.Insert(key, hashKey(key));
+                if (indices[j] == chunk.points.size()) {
+                    chunk.points.push_back(pnts[j]);
+                }
+            }
+            // points of different cells never end up in the same cell later
+            if (cluster
+                && (indices[0] == indices[1] || indices[1] == indices[2]
+                    || indices[2] == indices[0])) {
+                continue;
+            }
+            chunk.facets.insert(chunk.facets.end(), indices, indices + 3);
+        }
+        chunk.keys = table.TakeKeys();
+        chunk.facets.shrink_to_fit();
+
+        // sort the points by shard with a counting sort
+        std::size_t ctPoints = chunk.keys.size();
+        chunk.shards.resize(ctPoints);
+        std::array<std::uint32_t, ShardCount + 1> counts {};
+        for (std::size_t j = 0; j < ctPoints; j++) {
+            chunk.shards[j] = shardOf(hashKey(chunk.keys[j]));
+            counts[chunk.shards[j] + 1]++;
+        }
+        std::partial_sum(counts.begin(), counts.end(), chunk.shardStart.begin());
+        std::array<std::uint32_t, ShardCount + 1> pos = chunk.shardStart;
+        chunk.shardOrder.resize(ctPoints);
+        for (std::size_t j = 0; j < ctPoints; j++) {
+            chunk.shardOrder[pos[chunk.shards[j]]++] = static_cast<std::uint32_t>(j);
+        }
+        chunk.remap.resize(ctPoints);
+    }
+
+    // Merges the points of all chunks that fall into the shard
+    void Merge(Shard& shard)
+    {
+        std::size_t count = 0;
+        for (const auto& chunk : chunks) {
+            count += chunk.shardStart[shard.index + 1] - chunk.shardStart[shard.index];
+        }
+
+        PointTable table;
+        table.Reserve(count / 2);
+        for (auto& chunk : chunks) {
+            for (std::uint32_t j = chunk.shardStart[shard.index];
+                 j < chunk.shardStart[shard.index + 1];
+                 j++) {
+                std::uint32_t point = chunk.shardOrder[j];
+                const PointKey& key = chunk.keys[point];
+                std::uint32_t index = table.Insert(key, hashKey(key));
+                if (index == shard.points.size()) {
+                    shard.points.push_back(chunk.points[point]);
+                }
+                chunk.remap[point] = index;
+            }
+        }
+    }
+};
+
+ReaderSTL::ReaderSTL(MeshKernel& kernel)
+    : _kernel(kernel)
+    , p(new Private)
+{}
+
+ReaderSTL::~ReaderSTL() = default;
+
+void ReaderSTL::SetBoundBox(const Base::BoundBox3f& box)
+{
+    p->boundBox = box;
+}
+
+void ReaderSTL::SetClusterSize(float size)
+{
+    p->clusterSize = std::max(size, 0.0F);
+}
+
+bool ReaderSTL::LoadBinary(const std::string& filename)
+{
+    MappedFile file(filename);
+    if (!file.IsValid()) {
+        return false;
+    }
+
+    return LoadBinary(file.Data(), file.Size());
+}
+
+bool ReaderSTL::LoadBinary(const char* data, std::size_t size)
+{
+    if (size < HeaderSize) {
+        return false;
+    }
+
+    // skip the 80 bytes of the header
+    std::uint32_t count {};
+    std::memcpy(&count, data + HeaderSize - sizeof(count), sizeof(count));
+    if (count > (size - HeaderSize) / RecordSize) {
+        return false;  // not a valid STL file
+    }
+
+    AddRecords(data + HeaderSize, count);
+    Finish();
+    return true;
+}
+
+void ReaderSTL::AddRecords(const char* data, std::size_t count)
+{
+    std::vector<Private::Chunk> added;
+    for (std::size_t i = 0; i < count; i += ChunkSize) {
+        Private::Chunk chunk;
+        chunk.data = data + i * RecordSize;
+        chunk.count = std::min(ChunkSize, count - i);
+        added.push_back(std::move(chunk));
+    }
+
+    parallel_map(added, [this](Private::Chunk& chunk) {
+        p->Parse(chunk);
+    });
+    for (auto& chunk : added) {
+        chunk.data = nullptr;
+        p->chunks.push_back(std::move(chunk));
+    }
+}
+
+void ReaderSTL::Finish()
+{
+    std::vector<Private::Shard> shards(ShardCount);
+    for (std::size_t i = 0; i < ShardCount; i++) {
+        shards[i].index = i;
+    }
+    parallel_map(shards, [this](Private::Shard& shard) {
+        p->Merge(shard);
+    });
+
+    std::size_t ctPoints = 0;
+    for (auto& shard : shards) {
+        shard.offset = ctPoints;
+        ctPoints += shard.points.size();
+    }
+
+    MeshPointArray points(ctPoints);
+    parallel_map(shards, [&points](Private::Shard& shard) {
+        std::copy(shard.points.begin(),
+                  shard.points.end(),
+                  points.begin() + static_cast<std::ptrdiff_t>(shard.offset));
+        std::vector<Base::Vector3f>().swap(shard.points);
+    });
+
+    // the facets are stored in the order of the chunks
+    std::vector<std::size_t> offsets(p->chunks.size() + 1);
+    for (std::size_t i = 0; i < p->chunks.size(); i++) {
+        offsets[i + 1] = offsets[i] + p->chunks[i].facets.size() / 3;
+    }
+
+    MeshFacetArray facets(offsets.back());
+    std::vector<std::size_t> indices(p->chunks.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    parallel_map(indices, [this, &shards, &offsets, &facets](std::size_t index) {
+        Private::Chunk& chunk = p->chunks[index];
+        std::vector<PointIndex> global(chunk.keys.size());
+        for (std::size_t j = 0; j < global.size(); j++) {
+            global[j] = shards[chunk.shards[j]].offset + chunk.remap[j];
+        }
+        std::size_t pos = offsets[index];
+        for (std::size_t j = 0; j < chunk.facets.size(); j += 3) {
+            facets[pos++] = MeshFacet(global[chunk.facets[j]],
+                                      global[chunk.facets[j + 1]],
+                                      global[chunk.facets[j + 2]]);
+        }
+        chunk = Private::Chunk();
+    });
+    p->chunks.clear();
+
+    _kernel.Adopt(points, facets, true);
+}
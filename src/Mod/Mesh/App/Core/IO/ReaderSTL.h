@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2024 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_IO_READER_STL_H
+#define MESH_IO_READER_STL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <Base/BoundBox.h>
+#include <Mod/Mesh/MeshGlobal.h>
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * Loads the mesh object from binary STL data.
+ *
+ * Unlike MeshFastBuilder the triangles are not collected before the points are
+ * merged. The records are parsed in chunks in parallel, and every chunk merges its
+ * own points right away. Afterwards the points of all chunks are merged with a hash
+ * table that is split into shards, which are filled in parallel without locking.
+ * So a file mapped into memory is never copied as a whole.
+ *
+ * Optionally only the facets whose bounding box intersects a given box are kept.
+ * And with a cluster size all points within a cell of a regular grid are merged
+ * into the first of them, which decimates the mesh while loading. Facets that
+ * degenerate by this are removed.
+ */
+class MeshExport ReaderSTL
+{
+public:
+    /// Size of a facet record in a binary STL file
+    static constexpr std::size_t RecordSize = 50;
+    /// Size of the header and the number of facets in a binary STL file
+    static constexpr std::size_t HeaderSize = 84;
+
+    explicit ReaderSTL(MeshKernel& kernel);
+    ~ReaderSTL();
+
+    ReaderSTL(const ReaderSTL&) = delete;
+    ReaderSTL(ReaderSTL&&) = delete;
+    ReaderSTL& operator=(const ReaderSTL&) = delete;
+    ReaderSTL& operator=(ReaderSTL&&) = delete;
+
+    /*!
+     * \brief Keep only the facets whose bounding box intersects \a box.
+     */
+    void SetBoundBox(const Base::BoundBox3f& box);
+    /*!
+     * \brief Merge all points within a cell of size \a size.
+     * With a size of zero (the default) only identical points are merged.
+     */
+    void SetClusterSize(float size);
+
+    /*!
+     * \brief Maps the binary STL file into memory and loads it.
+     * \return true on success and false if the file cannot be mapped or isn't
+     * a valid binary STL file
+     */
+    bool LoadBinary(const std::string& filename);
+    /*!
+     * \brief Loads a binary STL file including its header from memory.
+     * \return true on success and false otherwise
+     */
+    bool LoadBinary(const char* data, std::size_t size);
+
+    /** @name Incremental loading */
+    //@{
+    /*!
+     * \brief Parses \a count facet records. The data can be released afterwards.
+     */
+    void AddRecords(const char* data, std::size_t count);
+    /*!
+     * \brief Merges the points of all parsed records and assigns the mesh to the kernel.
+     */
+    void Finish();
+    //@}
+
+private:
+    struct Private;
+    MeshKernel& _kernel;
+    std::unique_ptr<Private> p;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_STL_H
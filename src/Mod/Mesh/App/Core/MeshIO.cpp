@@ -25,9 +25,16 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
+#include <unordered_map>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MESH_IO_USE_SSE
 #endif
 
 #include <boost/algorithm/string.hpp>
@@ -38,6 +45,8 @@
 
 #include "IO/Reader3MF.h"
 #include "IO/ReaderOBJ.h"
+#include "IO/ReaderPLY.h"
+#include "IO/ReaderSTL.h"
 #include "IO/Writer3MF.h"
 #include "IO/WriterInventor.h"
 #include "IO/WriterOBJ.h"
@@ -49,6 +58,7 @@
 #include <Base/Reader.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/Tools.h>
 #include <Base/Writer.h>
 #include <zipios++/gzipoutputstream.h>
@@ -57,6 +67,7 @@
 #include "Builder.h"
 #include "Definitions.h"
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -110,6 +121,62 @@ struct QUAD
 
 }  // namespace MeshCore
 
+namespace
+{
+
+// Cell of a regular grid, see MeshInput::CropAndCluster()
+struct CellKey
+{
+    std::int32_t x, y, z;
+    bool operator==(const CellKey& other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+struct CellHash
+{
+    std::size_t operator()(const CellKey& key) const
+    {
+        return (static_cast<std::uint32_t>(key.x) * 73856093U)
+            ^ (static_cast<std::uint32_t>(key.y) * 19349663U)
+            ^ (static_cast<std::uint32_t>(key.z) * 83492791U);
+    }
+};
+
+std::int32_t cellOf(float coord, float size)
+{
+    float cell = std::clamp(std::floor(coord / size), -2147483648.0F, 2147483520.0F);
+    return static_cast<std::int32_t>(cell);
+}
+
+// Keeps the values of the given elements if there is one value per element
+template<typename T>
+void keepValues(std::vector<T>& values, const std::vector<ElementIndex>& indices, std::size_t count)
+{
+    if (values.size() != count) {
+        return;
+    }
+    std::vector<T> kept;
+    kept.reserve(indices.size());
+    for (ElementIndex index : indices) {
+        kept.push_back(values[index]);
+    }
+    values.swap(kept);
+}
+
+void keepMaterial(Material& mat, const std::vector<ElementIndex>& indices, std::size_t count)
+{
+    keepValues(mat.ambientColor, indices, count);
+    keepValues(mat.diffuseColor, indices, count);
+    keepValues(mat.specularColor, indices, count);
+    keepValues(mat.emissiveColor, indices, count);
+    keepValues(mat.shininess, indices, count);
+    keepValues(mat.transparency, indices, count);
+}
+
+}  // namespace
+
 // --------------------------------------------------------------
 
 bool Material::operator==(const Material& mat) const
@@ -202,15 +269,17 @@ bool MeshInput::LoadAny(const char* FileName)
 
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
+    _reduced = false;
     if (fi.hasExtension("bms")) {
         _rclMesh.Read(str);
+        CropAndCluster();
         return true;
     }
     else {
         // read file
         bool ok = false;
         if (fi.hasExtension({"stl", "ast"})) {
-            ok = LoadSTL(str);
+            ok = LoadSTL(str, FileName);
         }
         else if (fi.hasExtension("iv")) {
             ok = LoadInventor(str);
@@ -234,52 +303,193 @@ bool MeshInput::LoadAny(const char* FileName)
             ok = LoadOFF(str);
         }
         else if (fi.hasExtension("ply")) {
-            ok = LoadPLY(str);
+            ok = LoadPLY(str, FileName);
         }
         else {
             throw Base::FileException("File extension not supported", FileName);
         }
 
+        if (ok) {
+            CropAndCluster();
+        }
         return ok;
     }
 }
 
 bool MeshInput::LoadFormat(std::istream& str, MeshIO::Format fmt)
 {
+    bool ok = false;
+    _reduced = false;
     switch (fmt) {
         case MeshIO::BMS:
             _rclMesh.Read(str);
-            return true;
+            ok = true;
+            break;
         case MeshIO::APLY:
         case MeshIO::PLY:
-            return LoadPLY(str);
+            ok = LoadPLY(str);
+            break;
         case MeshIO::ASTL:
-            return LoadAsciiSTL(str);
+            ok = LoadAsciiSTL(str);
+            break;
         case MeshIO::BSTL:
-            return LoadBinarySTL(str);
+            ok = LoadBinarySTL(str);
+            break;
         case MeshIO::STL:
-            return LoadSTL(str);
+            ok = LoadSTL(str);
+            break;
         case MeshIO::OBJ:
-            return LoadOBJ(str);
+            ok = LoadOBJ(str);
+            break;
         case MeshIO::SMF:
-            return LoadSMF(str);
+            ok = LoadSMF(str);
+            break;
         case MeshIO::ThreeMF:
-            return Load3MF(str);
+            ok = Load3MF(str);
+            break;
         case MeshIO::OFF:
-            return LoadOFF(str);
+            ok = LoadOFF(str);
+            break;
         case MeshIO::IV:
-            return LoadInventor(str);
+            ok = LoadInventor(str);
+            break;
         case MeshIO::NAS:
-            return LoadNastran(str);
+            ok = LoadNastran(str);
+            break;
         default:
             throw Base::FileException("Unsupported file format");
     }
+
+    if (ok) {
+        CropAndCluster();
+    }
+    return ok;
+}
+
+/** Keeps only the facets whose bounding box intersects the bounding box and merges all points
+ * within a cell of the cluster size into the first of them. Facets that degenerate by this are
+ * removed. The per vertex or per face material and the group names are updated accordingly.
+ * This gives the same result for all formats as ReaderSTL does while parsing a binary STL file.
+ */
+void MeshInput::CropAndCluster()
+{
+    bool crop = _boundBox.IsValid();
+    bool cluster = _clusterSize > 0.0F;
+    if (_reduced || (!crop && !cluster)) {
+        return;
+    }
+
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+
+    // the new index of the used points, in order of first use
+    std::vector<PointIndex> pointMap(points.size(), POINT_INDEX_MAX);
+    std::vector<ElementIndex> keptPoints;
+    std::vector<ElementIndex> keptFacets;
+    std::unordered_map<CellKey, PointIndex, CellHash> cells;
+    MeshFacetArray newFacets;
+    newFacets.reserve(facets.size());
+
+    for (FacetIndex index = 0; index < facets.size(); index++) {
+        const MeshFacet& face = facets[index];
+        if (crop) {
+            Base::BoundBox3f box;
+            for (PointIndex point : face._aulPoints) {
+                box.Add(points[point]);
+            }
+            if (!(box && _boundBox)) {
+                continue;
+            }
+        }
+
+        PointIndex indices[3];
+        for (int i = 0; i < 3; i++) {
+            PointIndex point = face._aulPoints[i];
+            if (pointMap[point] == POINT_INDEX_MAX) {
+                if (cluster) {
+                    const Base::Vector3f& pnt = points[point];
+                    CellKey key {cellOf(pnt.x, _clusterSize),
+                                 cellOf(pnt.y, _clusterSize),
+                                 cellOf(pnt.z, _clusterSize)};
+                    auto res = cells.emplace(key, keptPoints.size());
+                    if (res.second) {
+                        keptPoints.push_back(point);
+                    }
+                    pointMap[point] = res.first->second;
+                }
+                else {
+                    pointMap[point] = keptPoints.size();
+                    keptPoints.push_back(point);
+                }
+            }
+            indices[i] = pointMap[point];
+        }
+        if (indices[0] == indices[1] || indices[1] == indices[2] || indices[2] == indices[0]) {
+            continue;
+        }
+
+        MeshFacet newFacet(indices[0], indices[1], indices[2]);
+        newFacet._ulProp = face._ulProp;
+        newFacets.push_back(newFacet);
+        keptFacets.push_back(index);
+    }
+
+    if (_material) {
+        if (_material->binding == MeshIO::PER_VERTEX) {
+            keepMaterial(*_material, keptPoints, points.size());
+        }
+        else if (_material->binding == MeshIO::PER_FACE) {
+            keepMaterial(*_material, keptFacets, facets.size());
+        }
+    }
+
+    // The groups are numbered in order of their facets, see MeshObject::swapKernel()
+    if (!_groupNames.empty()) {
+        std::vector<unsigned long> groups;
+        for (const auto& face : facets) {
+            if (groups.empty() || groups.back() < face._ulProp) {
+                groups.push_back(face._ulProp);
+            }
+        }
+        if (groups.size() == _groupNames.size()) {
+            // keep the names of the groups with facets left
+            std::vector<std::string> names;
+            std::size_t group = 0;
+            bool named = false;
+            for (const auto& face : newFacets) {
+                while (groups[group] < face._ulProp) {
+                    group++;
+                    named = false;
+                }
+                if (!named) {
+                    names.push_back(_groupNames[group]);
+                    named = true;
+                }
+            }
+            _groupNames.swap(names);
+        }
+    }
+
+    MeshPointArray newPoints;
+    newPoints.reserve(keptPoints.size());
+    for (ElementIndex point : keptPoints) {
+        newPoints.push_back(points[point]);
+    }
+    _rclMesh.Adopt(newPoints, newFacets, true);
 }
 
 /** Loads an STL file either in binary or ASCII format.
  * Therefore the file header gets checked to decide if the file is binary or not.
  */
 bool MeshInput::LoadSTL(std::istream& rstrIn)
+{
+    return LoadSTL(rstrIn, nullptr);
+}
+
+/** Loads an STL file either in binary or ASCII format.
+ * A binary file is mapped into memory if its name is given.
+ */
+bool MeshInput::LoadSTL(std::istream& rstrIn, const char* filename)
 {
     char szBuf[200];
 
@@ -316,6 +526,15 @@ bool MeshInput::LoadSTL(std::istream& rstrIn)
             && !strstr(szBuf, "VERTEX") && !strstr(szBuf, "ENDFACET")
             && !strstr(szBuf, "ENDLOOP")) {
             // probably binary STL
+            if (filename) {
+                ReaderSTL reader(_rclMesh);
+                reader.SetBoundBox(_boundBox);
+                reader.SetClusterSize(_clusterSize);
+                if (reader.LoadBinary(filename)) {
+                    _reduced = true;
+                    return true;
+                }
+            }
             buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadBinarySTL(rstrIn);
         }
@@ -359,8 +578,9 @@ bool MeshInput::LoadOBJ(std::istream& rstrIn)
 
 bool MeshInput::LoadOBJ(std::istream& str, const char* filename)
 {
+    // the file is mapped into memory, the stream is only used if this fails
     ReaderOBJ reader(this->_rclMesh, this->_material);
-    if (reader.Load(str)) {
+    if (reader.Load(std::string(filename)) || reader.Load(str)) {
         _groupNames = reader.GetGroupNames();
         if (this->_material && this->_material->binding == MeshCore::MeshIO::PER_FACE) {
             Base::FileInfo fi(filename);
@@ -623,519 +843,24 @@ bool MeshInput::LoadOFF(std::istream& rstrIn)
     return true;
 }
 
-namespace MeshCore
-{
-namespace Ply
-{
-enum Number
-{
-    int8,
-    uint8,
-    int16,
-    uint16,
-    int32,
-    uint32,
-    float32,
-    float64
-};
-struct Property
-{
-    using first_argument_type = std::pair<std::string, int>;
-    using second_argument_type = std::string;
-    using result_type = bool;
-
-    bool operator()(const std::pair<std::string, int>& x, const std::string& y) const
-    {
-        return x.first == y;
-    }
-};
-}  // namespace Ply
-using namespace Ply;
-}  // namespace MeshCore
-
+/** Loads a PLY file. */
 bool MeshInput::LoadPLY(std::istream& inp)
 {
-    // http://local.wasp.uwa.edu.au/~pbourke/dataformats/ply/
-    std::size_t v_count = 0, f_count = 0;
-    MeshPointArray meshPoints;
-    MeshFacetArray meshFacets;
-
-    enum
-    {
-        unknown,
-        ascii,
-        binary_little_endian,
-        binary_big_endian
-    } format = unknown;
-
-    if (!inp || inp.bad()) {
-        return false;
-    }
-
-    std::streambuf* buf = inp.rdbuf();
-    if (!buf) {
-        return false;
-    }
-
-    // read in the first three characters
-    char ply[3];
-    inp.read(ply, 3);
-    inp.ignore(1);
-    if (!inp) {
-        return false;
-    }
-    if ((ply[0] != 'p') || (ply[1] != 'l') || (ply[2] != 'y')) {
-        return false;  // wrong header
-    }
-
-    std::vector<std::pair<std::string, Ply::Number>> vertex_props;
-    std::vector<Ply::Number> face_props;
-    std::string line, element;
-
-    MeshIO::Binding rgb_value = MeshIO::OVERALL;
-    while (std::getline(inp, line)) {
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof()) {
-            continue;  // empty line
-        }
-        std::string kw;
-        str >> kw;
-        if (kw == "format") {
-            std::string format_string, version;
-            char space_format_string {}, space_format_version {};
-            str >> space_format_string >> std::ws >> format_string >> space_format_version
-                >> std::ws >> version;
-            if (/*!str || !str.eof() ||*/
-                !std::isspace(space_format_string) || !std::isspace(space_format_version)) {
-                return false;
-            }
-            if (format_string == "ascii") {
-                format = ascii;
-            }
-            else if (format_string == "binary_big_endian") {
-                format = binary_big_endian;
-            }
-            else if (format_string == "binary_little_endian") {
-                format = binary_little_endian;
-            }
-            else {
-                // wrong format version
-                return false;
-            }
-            if (version != "1.0") {
-                // wrong version
-                return false;
-            }
-        }
-        else if (kw == "element") {
-            std::string name;
-            std::size_t count {};
-            char space_element_name {}, space_name_count {};
-            str >> space_element_name >> std::ws >> name >> space_name_count >> std::ws >> count;
-            if (/*!str || !str.eof() ||*/
-                !std::isspace(space_element_name) || !std::isspace(space_name_count)) {
-                return false;
-            }
-            else if (name == "vertex") {
-                element = name;
-                v_count = count;
-                meshPoints.reserve(count);
-            }
-            else if (name == "face") {
-                element = name;
-                f_count = count;
-                meshFacets.reserve(count);
-            }
-            else {
-                element.clear();
-            }
-        }
-        else if (kw == "property") {
-            std::string type, name;
-            char space {};
-            if (element == "vertex") {
-                str >> space >> std::ws >> type >> space >> std::ws >> name >> std::ws;
-
-                Ply::Number number {};
-                if (type == "char" || type == "int8") {
-                    number = int8;
-                }
-                else if (type == "uchar" || type == "uint8") {
-                    number = uint8;
-                }
-                else if (type == "short" || type == "int16") {
-                    number = int16;
-                }
-                else if (type == "ushort" || type == "uint16") {
-                    number = uint16;
-                }
-                else if (type == "int" || type == "int32") {
-                    number = int32;
-                }
-                else if (type == "uint" || type == "uint32") {
-                    number = uint32;
-                }
-                else if (type == "float" || type == "float32") {
-                    number = float32;
-                }
-                else if (type == "double" || type == "float64") {
-                    number = float64;
-                }
-                else {
-                    // no valid number type
-                    return false;
-                }
-
-                // store the property name and type
-                vertex_props.emplace_back(name, number);
-            }
-            else if (element == "face") {
-                std::string list, uchr;
-                str >> space >> std::ws >> list >> std::ws;
-                if (list == "list") {
-                    str >> uchr >> std::ws >> type >> std::ws >> name >> std::ws;
-                }
-                else {
-                    // not a 'list'
-                    type = list;
-                    str >> name;
-                }
-                if (name != "vertex_indices" && name != "vertex_index") {
-                    Number number {};
-                    if (type == "char" || type == "int8") {
-                        number = int8;
-                    }
-                    else if (type == "uchar" || type == "uint8") {
-                        number = uint8;
-                    }
-                    else if (type == "short" || type == "int16") {
-                        number = int16;
-                    }
-                    else if (type == "ushort" || type == "uint16") {
-                        number = uint16;
-                    }
-                    else if (type == "int" || type == "int32") {
-                        number = int32;
-                    }
-                    else if (type == "uint" || type == "uint32") {
-                        number = uint32;
-                    }
-                    else if (type == "float" || type == "float32") {
-                        number = float32;
-                    }
-                    else if (type == "double" || type == "float64") {
-                        number = float64;
-                    }
-                    else {
-                        // no valid number type
-                        return false;
-                    }
-
-                    // store the property name and type
-                    face_props.push_back(number);
-                }
-            }
-        }
-        else if (kw == "end_header") {
-            break;  // end of the header, now read the data
-        }
-    }
-
-    // check if valid 3d points
-    Property property;
-    std::size_t num_x = std::count_if(vertex_props.begin(),
-                                      vertex_props.end(),
-                                      [&property](const std::pair<std::string, int>& p) {
-                                          return property(p, "x");
-                                      });
-    if (num_x != 1) {
-        return false;
-    }
-
-    std::size_t num_y = std::count_if(vertex_props.begin(),
-                                      vertex_props.end(),
-                                      [&property](const std::pair<std::string, int>& p) {
-                                          return property(p, "y");
-                                      });
-    if (num_y != 1) {
-        return false;
-    }
-
-    std::size_t num_z = std::count_if(vertex_props.begin(),
-                                      vertex_props.end(),
-                                      [&property](const std::pair<std::string, int>& p) {
-                                          return property(p, "z");
-                                      });
-    if (num_z != 1) {
-        return false;
-    }
-
-    for (auto& it : vertex_props) {
-        if (it.first == "diffuse_red") {
-            it.first = "red";
-        }
-        else if (it.first == "diffuse_green") {
-            it.first = "green";
-        }
-        else if (it.first == "diffuse_blue") {
-            it.first = "blue";
-        }
-    }
-
-    // check if valid colors are set
-    std::size_t num_r = std::count_if(vertex_props.begin(),
-                                      vertex_props.end(),
-                                      [&property](const std::pair<std::string, int>& p) {
-                                          return property(p, "red");
-                                      });
-    std::size_t num_g = std::count_if(vertex_props.begin(),
-                                      vertex_props.end(),
-                                      [&property](const std::pair<std::string, int>& p) {
-                                          return property(p, "green");
-                                      });
-    std::size_t num_b = std::count_if(vertex_props.begin(),
-                                      vertex_props.end(),
-                                      [&property](const std::pair<std::string, int>& p) {
-                                          return property(p, "blue");
-                                      });
-    std::size_t rgb_colors = num_r + num_g + num_b;
-    if (rgb_colors != 0 && rgb_colors != 3) {
-        return false;
-    }
-
-    // only if set per vertex
-    if (rgb_colors == 3) {
-        rgb_value = MeshIO::PER_VERTEX;
-        if (_material) {
-            _material->binding = MeshIO::PER_VERTEX;
-            _material->diffuseColor.reserve(v_count);
-        }
-    }
-
-    if (format == ascii) {
-        boost::regex rx_d("(([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?))\\s*");
-        boost::regex rx_s("\\b([-+]?[0-9]+)\\s*");
-        boost::regex rx_u("\\b([0-9]+)\\s*");
-        boost::regex rx_f(R"(^\s*3\s+([0-9]+)\s+([0-9]+)\s+([0-9]+)\s*)");
-        boost::smatch what;
-
-        for (std::size_t i = 0; i < v_count && std::getline(inp, line); i++) {
-            // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (const auto& it : vertex_props) {
-                switch (it.second) {
-                    case int8:
-                    case int16:
-                    case int32: {
-                        if (boost::regex_search(line, what, rx_s)) {
-                            int v {};
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it.first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                    case uint8:
-                    case uint16:
-                    case uint32: {
-                        if (boost::regex_search(line, what, rx_u)) {
-                            int v {};
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it.first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                    case float32:
-                    case float64: {
-                        if (boost::regex_search(line, what, rx_d)) {
-                            double v {};
-                            v = boost::lexical_cast<double>(what[1]);
-                            prop_values[it.first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                    default:
-                        return false;
-                }
-            }
-
-            Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
-            meshPoints.push_back(pt);
-
-            if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
-                _material->diffuseColor.emplace_back(r, g, b);
-            }
-        }
-
-        int f1 {}, f2 {}, f3 {};
-        for (std::size_t i = 0; i < f_count && std::getline(inp, line); i++) {
-            if (boost::regex_search(line, what, rx_f)) {
-                f1 = boost::lexical_cast<int>(what[1]);
-                f2 = boost::lexical_cast<int>(what[2]);
-                f3 = boost::lexical_cast<int>(what[3]);
-                meshFacets.push_back(MeshFacet(f1, f2, f3));
-            }
-        }
-    }
-    // binary
-    else {
-        Base::InputStream is(inp);
-        if (format == binary_little_endian) {
-            is.setByteOrder(Base::Stream::LittleEndian);
-        }
-        else {
-            is.setByteOrder(Base::Stream::BigEndian);
-        }
-
-        for (std::size_t i = 0; i < v_count; i++) {
-            // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (const auto& it : vertex_props) {
-                switch (it.second) {
-                    case int8: {
-                        int8_t v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    case uint8: {
-                        uint8_t v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    case int16: {
-                        int16_t v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    case uint16: {
-                        uint16_t v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    case int32: {
-                        int32_t v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    case uint32: {
-                        uint32_t v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    case float32: {
-                        float v {};
-                        is >> v;
-                        prop_values[it.first] = v;
-                    } break;
-                    case float64: {
-                        double v {};
-                        is >> v;
-                        prop_values[it.first] = static_cast<float>(v);
-                    } break;
-                    default:
-                        return false;
-                }
-            }
-
-            Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
-            meshPoints.push_back(pt);
-
-            if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
-                _material->diffuseColor.emplace_back(r, g, b);
-            }
-        }
+    ReaderPLY reader(this->_rclMesh, this->_material);
+    return reader.Load(inp);
+}
 
-        unsigned char n {};
-        uint32_t f1 {}, f2 {}, f3 {};
-        for (std::size_t i = 0; i < f_count; i++) {
-            is >> n;
-            if (n == 3) {
-                is >> f1 >> f2 >> f3;
-                if (f1 < v_count && f2 < v_count && f3 < v_count) {
-                    meshFacets.push_back(MeshFacet(f1, f2, f3));
-                }
-                for (auto it : face_props) {
-                    switch (it) {
-                        case int8: {
-                            int8_t v {};
-                            is >> v;
-                        } break;
-                        case uint8: {
-                            uint8_t v {};
-                            is >> v;
-                        } break;
-                        case int16: {
-                            int16_t v {};
-                            is >> v;
-                        } break;
-                        case uint16: {
-                            uint16_t v {};
-                            is >> v;
-                        } break;
-                        case int32: {
-                            int32_t v {};
-                            is >> v;
-                        } break;
-                        case uint32: {
-                            uint32_t v {};
-                            is >> v;
-                        } break;
-                        case float32: {
-                            is >> n;
-                            float v {};
-                            for (unsigned char j = 0; j < n; j++) {
-                                is >> v;
-                            }
-                        } break;
-                        case float64: {
-                            is >> n;
-                            double v {};
-                            for (unsigned char j = 0; j < n; j++) {
-                                is >> v;
-                            }
-                        } break;
-                        default:
-                            return false;
-                    }
-                }
-            }
+/** Loads a PLY file. The file is mapped into memory if its name is given. */
+bool MeshInput::LoadPLY(std::istream& inp, const char* filename)
+{
+    if (filename) {
+        ReaderPLY reader(this->_rclMesh, this->_material);
+        if (reader.Load(std::string(filename))) {
+            return true;
         }
     }
 
-    this->_rclMesh.Clear();  // remove all data before
-
-    MeshCleanup meshCleanup(meshPoints, meshFacets);
-    if (_material) {
-        meshCleanup.SetMaterial(_material);
-    }
-    meshCleanup.RemoveInvalids();
-    MeshPointFacetAdjacency meshAdj(meshPoints.size(), meshFacets);
-    meshAdj.SetFacetNeighbourhood();
-    this->_rclMesh.Adopt(meshPoints, meshFacets);
-
-    return true;
+    return LoadPLY(inp);
 }
 
 bool MeshInput::LoadMeshNode(std::istream& rstrIn)
@@ -1275,8 +1000,6 @@ bool MeshInput::LoadAsciiSTL(std::istream& rstrIn)
 bool MeshInput::LoadBinarySTL(std::istream& rstrIn)
 {
     char szInfo[80];
-    Base::Vector3f clVects[4];
-    uint16_t usAtt = 0;
     uint32_t ulCt = 0;
 
     if (!rstrIn || rstrIn.bad()) {
@@ -1309,25 +1032,24 @@ bool MeshInput::LoadBinarySTL(std::istream& rstrIn)
         return false;  // not a valid STL file
     }
 
-#if 0
-    MeshBuilder builder(this->_rclMesh);
-#else
-    MeshFastBuilder builder(this->_rclMesh);
-#endif
-    builder.Initialize(ulCt);
-
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        rstrIn.read((char*)&clVects, sizeof(clVects));
-
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
-
-        // overread 2 bytes attribute
-        rstrIn.read((char*)&usAtt, sizeof(usAtt));
+    // read the facets in blocks which are parsed in parallel
+    constexpr uint32_t ulBlock = 1 << 20;
+    std::vector<char> block(static_cast<std::size_t>(std::min(ulCt, ulBlock))
+                            * ReaderSTL::RecordSize);
+    ReaderSTL reader(this->_rclMesh);
+    reader.SetBoundBox(_boundBox);
+    reader.SetClusterSize(_clusterSize);
+    for (uint32_t i = 0; i < ulCt; i += ulBlock) {
+        uint32_t ulRecords = std::min(ulBlock, ulCt - i);
+        if (!rstrIn.read(block.data(),
+                         static_cast<std::streamsize>(ulRecords * ReaderSTL::RecordSize))) {
+            throw Base::BadFormatError("Unexpected end of binary STL file");
+        }
+        reader.AddRecords(block.data(), ulRecords);
     }
 
-    builder.Finish();
+    reader.Finish();
+    _reduced = true;
 
     return true;
 }
@@ -2099,53 +1821,161 @@ bool MeshOutput::SaveAsciiSTL(std::ostream& rstrOut) const
     return true;
 }
 
+namespace
+{
+// Number of facets or points whose data are written with one call
+constexpr std::size_t WriteBlockSize = 1 << 20;
+// Number of facets or points converted by one task
+constexpr std::size_t WriteChunkSize = 16384;
+
+// Calls func(first, last) for chunks of [begin, end) in parallel
+template<class Func>
+void forEachChunk(std::size_t begin, std::size_t end, Func func)
+{
+    parallel_for(
+        end - begin,
+        [begin, &func](std::size_t first, std::size_t last) {
+            func(begin + first, begin + last);
+        },
+        WriteChunkSize);
+}
+
+// Writes count records of the given size in blocks. The records of a block are
+// filled in parallel by fill(first, last, data) and written with one call.
+template<class Func>
+void writeRecords(std::ostream& out,
+                  std::size_t count,
+                  std::size_t recordSize,
+                  Func fill,
+                  Base::SequencerLauncher* seq = nullptr)
+{
+    std::vector<char> block(std::min(count, WriteBlockSize) * recordSize);
+    for (std::size_t begin = 0; begin < count; begin += WriteBlockSize) {
+        std::size_t end = std::min(begin + WriteBlockSize, count);
+        forEachChunk(begin, end, [&](std::size_t first, std::size_t last) {
+            fill(first, last, block.data() + (first - begin) * recordSize);
+        });
+        out.write(block.data(), static_cast<std::streamsize>((end - begin) * recordSize));
+        if (seq) {
+            seq->next(true);  // allow to cancel
+        }
+    }
+}
+
+// Calculates the normals of four facets the same way as MeshGeomFacet::CalcNormal()
+void calcNormals(const Base::Vector3f (*corners)[3], Base::Vector3f* normals)
+{
+#if defined(MESH_IO_USE_SSE)
+    auto load = [corners](int corner, float Base::Vector3f::*coord) {
+        return _mm_setr_ps(corners[0][corner].*coord,
+                           corners[1][corner].*coord,
+                           corners[2][corner].*coord,
+                           corners[3][corner].*coord);
+    };
+    using Vec = Base::Vector3f;
+    __m128 ux = _mm_sub_ps(load(1, &Vec::x), load(0, &Vec::x));
+    __m128 uy = _mm_sub_ps(load(1, &Vec::y), load(0, &Vec::y));
+    __m128 uz = _mm_sub_ps(load(1, &Vec::z), load(0, &Vec::z));
+    __m128 vx = _mm_sub_ps(load(2, &Vec::x), load(0, &Vec::x));
+    __m128 vy = _mm_sub_ps(load(2, &Vec::y), load(0, &Vec::y));
+    __m128 vz = _mm_sub_ps(load(2, &Vec::z), load(0, &Vec::z));
+    __m128 nx = _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy));
+    __m128 ny = _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz));
+    __m128 nz = _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx));
+    __m128 len = _mm_sqrt_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz)));
+    // like Vector3::Normalize() keep null vectors
+    __m128 null = _mm_cmpeq_ps(len, _mm_setzero_ps());
+    len = _mm_or_ps(_mm_and_ps(null, _mm_set1_ps(1.0F)), _mm_andnot_ps(null, len));
+    float x[4], y[4], z[4];
+    _mm_storeu_ps(x, _mm_div_ps(nx, len));
+    _mm_storeu_ps(y, _mm_div_ps(ny, len));
+    _mm_storeu_ps(z, _mm_div_ps(nz, len));
+    for (int i = 0; i < 4; i++) {
+        normals[i].Set(x[i], y[i], z[i]);
+    }
+#else
+    for (int i = 0; i < 4; i++) {
+        normals[i] = (corners[i][1] - corners[i][0]) % (corners[i][2] - corners[i][0]);
+        normals[i].Normalize();
+    }
+#endif
+}
+
+// Returns the coordinates of the points, transformed if needed
+std::vector<Base::Vector3f>
+pointCoordinates(const MeshPointArray& rPoints, const Base::Matrix4D& mat, bool apply)
+{
+    std::vector<Base::Vector3f> coords(rPoints.size());
+    forEachChunk(0, rPoints.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            coords[i] = apply ? mat * rPoints[i] : static_cast<Base::Vector3f>(rPoints[i]);
+        }
+    });
+    return coords;
+}
+}  // namespace
+
 /** Saves the mesh object into a binary file. */
 bool MeshOutput::SaveBinarySTL(std::ostream& rstrOut) const
 {
-    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
-    clIter.Transform(this->_transform);
-    const MeshGeomFacet* pclFacet {};
-    uint32_t i {};
-    uint16_t usAtt {};
     char szInfo[81];
 
     if (!rstrOut || rstrOut.bad() /*|| _rclMesh.CountFacets() == 0*/) {
         return false;
     }
 
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t numFacets = rFacets.size();
+    Base::SequencerLauncher seq("saving...", numFacets / WriteBlockSize + 2);
 
     // stl_header has a length of 80
     strcpy(szInfo, stl_header.c_str());
     rstrOut.write(szInfo, std::strlen(szInfo));
 
-    uint32_t uCtFts = (uint32_t)_rclMesh.CountFacets();
+    uint32_t uCtFts = (uint32_t)numFacets;
     rstrOut.write((const char*)&uCtFts, sizeof(uCtFts));
 
-    usAtt = 0;
-    clIter.Begin();
-    clEnd.End();
-    while (clIter < clEnd) {
-        pclFacet = &(*clIter);
-        // normal
-        Base::Vector3f normal = pclFacet->GetNormal();
-        rstrOut.write((const char*)&(normal.x), sizeof(float));
-        rstrOut.write((const char*)&(normal.y), sizeof(float));
-        rstrOut.write((const char*)&(normal.z), sizeof(float));
-
-        // vertices
-        for (i = 0; i < 3; i++) {
-            rstrOut.write((const char*)&(pclFacet->_aclPoints[i].x), sizeof(float));
-            rstrOut.write((const char*)&(pclFacet->_aclPoints[i].y), sizeof(float));
-            rstrOut.write((const char*)&(pclFacet->_aclPoints[i].z), sizeof(float));
+    // like MeshFacetIterator apply the transformation unless it's the identity
+    bool apply = _transform != Base::Matrix4D();
+    std::vector<Base::Vector3f> points = pointCoordinates(_rclMesh.GetPoints(), _transform, apply);
+
+    // Each record consists of the normal, the three points and a two byte attribute.
+    // The records of a block are filled in parallel and written at once.
+    constexpr std::size_t recordSize = 12 * sizeof(float) + sizeof(uint16_t);
+    auto fill = [&](std::size_t first, std::size_t last, char* record) {
+        Base::Vector3f corners[4][3];
+        Base::Vector3f normals[4];
+        for (std::size_t i = first; i < last; i += 4) {
+            // repeat the last facet to fill up the group of four
+            for (std::size_t j = 0; j < 4; j++) {
+                const MeshFacet& facet = rFacets[std::min(i + j, last - 1)];
+                for (int k = 0; k < 3; k++) {
+                    corners[j][k] = points[facet._aulPoints[k]];
+                }
+            }
+            calcNormals(corners, normals);
+
+            for (std::size_t j = 0; j < 4 && i + j < last; j++) {
+                float data[12] = {normals[j].x,
+                                  normals[j].y,
+                                  normals[j].z,
+                                  corners[j][0].x,
+                                  corners[j][0].y,
+                                  corners[j][0].z,
+                                  corners[j][1].x,
+                                  corners[j][1].y,
+                                  corners[j][1].z,
+                                  corners[j][2].x,
+                                  corners[j][2].y,
+                                  corners[j][2].z};
+                std::memcpy(record, data, sizeof(data));
+                std::memset(record + sizeof(data), 0, sizeof(uint16_t));
+                record += recordSize;
+            }
         }
-
-        // attribute
-        rstrOut.write((const char*)&usAtt, sizeof(usAtt));
-
-        ++clIter;
-        seq.next(true);  // allow to cancel
-    }
+    };
+    writeRecords(rstrOut, numFacets, recordSize, fill, &seq);
 
     return true;
 }
@@ -2447,6 +2277,42 @@ bool MeshOutput::SaveBinaryPLY(std::ostream& out) const
         << "property list uchar int vertex_index\n"
         << "end_header\n";
 
+    // On little endian machines the records are filled in parallel and written in blocks
+    if (Base::SwapOrder() == LOW_ENDIAN) {
+        std::vector<Base::Vector3f> points =
+            pointCoordinates(rPoints, this->_transform, this->apply_transform);
+        std::size_t vertexSize = 3 * sizeof(float) + (saveVertexColor ? 3 : 0);
+        auto fillVertices = [&](std::size_t first, std::size_t last, char* record) {
+            for (std::size_t i = first; i < last; i++) {
+                std::memcpy(record, &points[i].x, 3 * sizeof(float));
+                if (saveVertexColor) {
+                    const App::Color& c = _material->diffuseColor[i];
+                    record[12] = static_cast<char>(uint8_t(255.0f * c.r));
+                    record[13] = static_cast<char>(uint8_t(255.0f * c.g));
+                    record[14] = static_cast<char>(uint8_t(255.0f * c.b));
+                }
+                record += vertexSize;
+            }
+        };
+        writeRecords(out, v_count, vertexSize, fillVertices);
+
+        constexpr std::size_t faceSize = 1 + 3 * sizeof(int);
+        auto fillFaces = [&](std::size_t first, std::size_t last, char* record) {
+            for (std::size_t i = first; i < last; i++) {
+                const MeshFacet& f = rFacets[i];
+                int indices[3] = {(int)f._aulPoints[0],
+                                  (int)f._aulPoints[1],
+                                  (int)f._aulPoints[2]};
+                record[0] = 3;
+                std::memcpy(record + 1, indices, sizeof(indices));
+                record += faceSize;
+            }
+        };
+        writeRecords(out, f_count, faceSize, fillFaces);
+
+        return true;
+    }
+
     Base::OutputStream os(out);
     os.setByteOrder(Base::Stream::LittleEndian);
 
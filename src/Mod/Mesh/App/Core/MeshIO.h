@@ -24,6 +24,7 @@
 #define MESH_IO_H
 
 #include <App/Material.h>
+#include <Base/BoundBox.h>
 #include <Base/Matrix.h>
 
 #include "MeshKernel.h"
@@ -109,15 +110,35 @@ public:
     explicit MeshInput(MeshKernel& rclM)
         : _rclMesh(rclM)
         , _material(nullptr)
+        , _clusterSize(0.0F)
+        , _reduced(false)
     {}
     MeshInput(MeshKernel& rclM, Material* m)
         : _rclMesh(rclM)
         , _material(m)
+        , _clusterSize(0.0F)
+        , _reduced(false)
     {}
     const std::vector<std::string>& GetGroupNames() const
     {
         return _groupNames;
     }
+    /** Keeps only the facets whose bounding box intersects \a box when loading with
+     * LoadAny() or LoadFormat(). A binary STL file drops the other facets while it's parsed,
+     * the other formats after they have been loaded.
+     */
+    void SetBoundBox(const Base::BoundBox3f& box)
+    {
+        _boundBox = box;
+    }
+    /** Merges all points that lie within a cell of size \a size when loading with LoadAny()
+     * or LoadFormat(). This decimates the mesh, facets that degenerate by this are removed.
+     * A size of zero (the default) disables the decimation.
+     */
+    void SetClusterSize(float size)
+    {
+        _clusterSize = size;
+    }
 
     /// Loads the file, decided by extension
     bool LoadAny(const char* FileName);
@@ -127,6 +148,10 @@ public:
      * Therefore the file header gets checked to decide if the file is binary or not.
      */
     bool LoadSTL(std::istream& rstrIn);
+    /** Loads an STL file either in binary or ASCII format.
+     * A binary file is mapped into memory and loaded in parallel.
+     */
+    bool LoadSTL(std::istream& rstrIn, const char* filename);
     /** Loads an ASCII STL file. */
     bool LoadAsciiSTL(std::istream& rstrIn);
     /** Loads a binary STL file. */
@@ -141,6 +166,8 @@ public:
     bool LoadOFF(std::istream& rstrIn);
     /** Loads a PLY Mesh file. */
     bool LoadPLY(std::istream& rstrIn);
+    /** Loads a PLY Mesh file. The file is mapped into memory and loaded in parallel. */
+    bool LoadPLY(std::istream& rstrIn, const char* filename);
     /** Loads the mesh object from an XML file. */
     void LoadXML(Base::XMLReader& reader);
     /** Loads the mesh object from a 3MF file. */
@@ -157,10 +184,16 @@ public:
     static std::vector<std::string> supportedMeshFormats();
     static MeshIO::Format getFormat(const char* FileName);
 
+private:
+    void CropAndCluster();
+
 private:
     MeshKernel& _rclMesh; /**< reference to mesh data structure */
     Material* _material;
     std::vector<std::string> _groupNames;
+    Base::BoundBox3f _boundBox;
+    float _clusterSize;
+    bool _reduced; /**< if the file was already cropped and clustered while it was parsed */
 };
 
 /**
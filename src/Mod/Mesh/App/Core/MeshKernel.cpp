@@ -24,11 +24,18 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <queue>
 #include <stdexcept>
 #endif
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #include <Base/Exception.h>
 #include <Base/Stream.h>
 #include <Base/Swap.h>
@@ -36,6 +43,7 @@
 #include "Algorithm.h"
 #include "Builder.h"
 #include "Evaluation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -44,6 +52,106 @@
 
 using namespace MeshCore;
 
+namespace
+{
+// Number of elements handled by one task of the parallel loops. Smaller arrays are
+// processed in the calling thread because spawning the tasks costs more than it saves.
+constexpr std::size_t ChunkSize = 32768;
+
+struct Chunk
+{
+    std::size_t begin;
+    std::size_t end;
+    Base::BoundBox3f box;
+};
+
+std::vector<Chunk> makeChunks(std::size_t count)
+{
+    std::vector<Chunk> chunks;
+    chunks.reserve(count / ChunkSize + 1);
+    for (std::size_t i = 0; i < count; i += ChunkSize) {
+        chunks.push_back({i, std::min(i + ChunkSize, count), Base::BoundBox3f()});
+    }
+    return chunks;
+}
+
+// Calls func for each chunk of [0, count) and returns the united boxes of the chunks
+template<typename Func>
+Base::BoundBox3f forEachChunk(std::size_t count, Func func)
+{
+    std::vector<Chunk> chunks = makeChunks(count);
+    parallel_map(chunks, func);
+
+    Base::BoundBox3f box;
+    for (const auto& chunk : chunks) {
+        box.Add(chunk.box);
+    }
+    return box;
+}
+
+Base::BoundBox3f pointBox(const MeshPoint* first, const MeshPoint* last)
+{
+    // Plain min/max over the components instead of BoundBox3f::Add() so that the
+    // compiler keeps the six values in registers
+    constexpr float maxValue = std::numeric_limits<float>::max();
+    float minX = maxValue, minY = maxValue, minZ = maxValue;
+    float maxX = -maxValue, maxY = -maxValue, maxZ = -maxValue;
+    for (const MeshPoint* it = first; it != last; ++it) {
+        minX = std::min(minX, it->x);
+        minY = std::min(minY, it->y);
+        minZ = std::min(minZ, it->z);
+        maxX = std::max(maxX, it->x);
+        maxY = std::max(maxY, it->y);
+        maxZ = std::max(maxZ, it->z);
+    }
+    return Base::BoundBox3f(minX, minY, minZ, maxX, maxY, maxZ);
+}
+
+// Transforms the points like Base::Matrix4D::operator*() does, i.e. in double
+// precision, and returns their bounding box
+Base::BoundBox3f transformPoints(MeshPoint* first, MeshPoint* last, const Base::Matrix4D& mat)
+{
+#if defined(__AVX__)
+    // One column of the matrix per register, the rows x, y, z in the lanes
+    const __m256d col0 = _mm256_set_pd(0.0, mat[2][0], mat[1][0], mat[0][0]);
+    const __m256d col1 = _mm256_set_pd(0.0, mat[2][1], mat[1][1], mat[0][1]);
+    const __m256d col2 = _mm256_set_pd(0.0, mat[2][2], mat[1][2], mat[0][2]);
+    const __m256d col3 = _mm256_set_pd(0.0, mat[2][3], mat[1][3], mat[0][3]);
+    alignas(16) float res[4];
+    for (MeshPoint* it = first; it != last; ++it) {
+        __m256d sum = _mm256_add_pd(_mm256_mul_pd(col0, _mm256_set1_pd(it->x)),
+                                    _mm256_mul_pd(col1, _mm256_set1_pd(it->y)));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(col2, _mm256_set1_pd(it->z)));
+        sum = _mm256_add_pd(sum, col3);
+        _mm_store_ps(res, _mm256_cvtpd_ps(sum));
+        it->Set(res[0], res[1], res[2]);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // The rows x and y in one register, z in scalar math
+    const __m128d col0 = _mm_set_pd(mat[1][0], mat[0][0]);
+    const __m128d col1 = _mm_set_pd(mat[1][1], mat[0][1]);
+    const __m128d col2 = _mm_set_pd(mat[1][2], mat[0][2]);
+    const __m128d col3 = _mm_set_pd(mat[1][3], mat[0][3]);
+    const double m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2], m23 = mat[2][3];
+    alignas(16) float res[4];
+    for (MeshPoint* it = first; it != last; ++it) {
+        double x = it->x, y = it->y, z = it->z;
+        __m128d sum =
+            _mm_add_pd(_mm_mul_pd(col0, _mm_set1_pd(x)), _mm_mul_pd(col1, _mm_set1_pd(y)));
+        sum = _mm_add_pd(sum, _mm_mul_pd(col2, _mm_set1_pd(z)));
+        sum = _mm_add_pd(sum, col3);
+        _mm_store_ps(res, _mm_cvtpd_ps(sum));
+        it->Set(res[0], res[1], static_cast<float>(m20 * x + m21 * y + m22 * z + m23));
+    }
+#else
+    for (MeshPoint* it = first; it != last; ++it) {
+        *it *= mat;
+    }
+#endif
+    return pointBox(first, last);
+}
+}// namespace
+
 MeshKernel::MeshKernel()
 {
     _clBoundBox.SetVoid();
@@ -62,6 +170,7 @@ MeshKernel::MeshKernel(MeshKernel&& rclMesh)
 MeshKernel& MeshKernel::operator=(const MeshKernel& rclMesh)
 {
     if (this != &rclMesh) {  // must be a different instance
+        TopologyChange change(*this);
         this->_aclPointArray = rclMesh._aclPointArray;
         this->_aclFacetArray = rclMesh._aclFacetArray;
         this->_clBoundBox = rclMesh._clBoundBox;
@@ -73,6 +182,8 @@ MeshKernel& MeshKernel::operator=(const MeshKernel& rclMesh)
 MeshKernel& MeshKernel::operator=(MeshKernel&& rclMesh)
 {
     if (this != &rclMesh) {  // must be a different instance
+        TopologyChange change(*this);
+        TopologyChange changeOther(rclMesh);
         this->_aclPointArray = std::move(rclMesh._aclPointArray);
         this->_aclFacetArray = std::move(rclMesh._aclFacetArray);
         this->_clBoundBox = rclMesh._clBoundBox;
@@ -99,6 +210,7 @@ void MeshKernel::Assign(const MeshPointArray& rPoints,
                         const MeshFacetArray& rFacets,
                         bool checkNeighbourHood)
 {
+    TopologyChange change(*this);
     _aclPointArray = rPoints;
     _aclFacetArray = rFacets;
     RecalcBoundBox();
@@ -109,6 +221,7 @@ void MeshKernel::Assign(const MeshPointArray& rPoints,
 
 void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool checkNeighbourHood)
 {
+    TopologyChange change(*this);
     _aclPointArray.swap(rPoints);
     _aclFacetArray.swap(rFacets);
     RecalcBoundBox();
@@ -119,6 +232,8 @@ void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool ch
 
 void MeshKernel::Swap(MeshKernel& mesh)
 {
+    TopologyChange change(*this);
+    TopologyChange changeOther(mesh);
     this->_aclPointArray.swap(mesh._aclPointArray);
     this->_aclFacetArray.swap(mesh._aclFacetArray);
     this->_clBoundBox = mesh._clBoundBox;
@@ -132,6 +247,7 @@ MeshKernel& MeshKernel::operator+=(const MeshGeomFacet& rclSFacet)
 
 void MeshKernel::AddFacet(const MeshGeomFacet& rclSFacet)
 {
+    TopologyChange change(*this);
     MeshFacet clFacet;
 
     // set corner points
@@ -192,6 +308,8 @@ void MeshKernel::AddFacets(const std::vector<MeshGeomFacet>& rclFAry)
 
 unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry, bool checkManifolds)
 {
+    TopologyChange change(*this);
+
     // Build map of edges of the referencing facets we want to append
 #ifdef FC_DEBUG
     unsigned long countPoints = CountPoints();
@@ -385,6 +503,7 @@ void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFac
     if (rPoints.empty() || rFaces.empty()) {
         return;  // nothing to do
     }
+    TopologyChange change(*this);
     std::vector<PointIndex> increments(rPoints.size());
 
     FacetIndex countFacets = this->_aclFacetArray.size();
@@ -439,12 +558,14 @@ void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFac
 
 void MeshKernel::Cleanup()
 {
+    TopologyChange change(*this);
     MeshCleanup meshCleanup(_aclPointArray, _aclFacetArray);
     meshCleanup.RemoveInvalids();
 }
 
 void MeshKernel::Clear()
 {
+    TopologyChange change(*this);
     _aclPointArray.clear();
     _aclFacetArray.clear();
 
@@ -489,6 +610,7 @@ bool MeshKernel::DeleteFacet(const MeshFacetIterator& rclIter)
     }
 
     // remove facet from array
+    TopologyChange change(*this);
     _aclFacetArray.Erase(_aclFacetArray.begin() + rclIter.Position());
 
     return true;
@@ -651,6 +773,7 @@ void MeshKernel::ErasePoint(PointIndex ulIndex, FacetIndex ulFacetIndex, bool bO
 
     if (!bOnlySetInvalid) {
         // completely remove point
+        TopologyChange change(*this);
         _aclPointArray.erase(_aclPointArray.begin() + ulIndex);
 
         // correct point indices of the facets
@@ -677,6 +800,8 @@ void MeshKernel::RemoveInvalids()
     MeshPointArray::_TIterator pPIter, pPEnd;
     MeshFacetArray::_TIterator pFIter, pFEnd;
 
+    TopologyChange change(*this);
+
     // generate array of decrements
     aulDecrements.resize(_aclPointArray.size());
     pDIter = aulDecrements.begin();
@@ -1023,6 +1148,7 @@ void MeshKernel::Read(std::istream& rclIn)
             str >> _clBoundBox.MinZ >> _clBoundBox.MaxZ;
 
             // If we reach this block no exception occurred and we can safely assign the mesh
+            TopologyChange change(*this);
             _aclPointArray.swap(pointArray);
             _aclFacetArray.swap(facetArray);
         }
@@ -1097,6 +1223,7 @@ void MeshKernel::Read(std::istream& rclIn)
             }
         }
 
+        TopologyChange change(*this);
         _aclPointArray.swap(pointArray);
         _aclFacetArray.swap(facetArray);
     }
@@ -1109,15 +1236,10 @@ void MeshKernel::operator*=(const Base::Matrix4D& rclMat)
 
 void MeshKernel::Transform(const Base::Matrix4D& rclMat)
 {
-    MeshPointArray::_TIterator clPIter = _aclPointArray.begin(), clPEIter = _aclPointArray.end();
-    Base::Matrix4D clMatrix(rclMat);
-
-    _clBoundBox.SetVoid();
-    while (clPIter < clPEIter) {
-        *clPIter *= clMatrix;
-        _clBoundBox.Add(*clPIter);
-        clPIter++;
-    }
+    MeshPoint* points = _aclPointArray.data();
+    _clBoundBox = forEachChunk(_aclPointArray.size(), [points, &rclMat](Chunk& chunk) {
+        chunk.box = transformPoints(points + chunk.begin, points + chunk.end, rclMat);
+    });
 }
 
 void MeshKernel::Smooth(int iterations, float stepsize)
@@ -1128,27 +1250,34 @@ void MeshKernel::Smooth(int iterations, float stepsize)
 
 void MeshKernel::RecalcBoundBox() const
 {
-    _clBoundBox.SetVoid();
-    for (const auto& pI : _aclPointArray) {
-        _clBoundBox.Add(pI);
-    }
+    const MeshPoint* points = _aclPointArray.data();
+    _clBoundBox = forEachChunk(_aclPointArray.size(), [points](Chunk& chunk) {
+        chunk.box = pointBox(points + chunk.begin, points + chunk.end);
+    });
 }
 
 std::vector<Base::Vector3f> MeshKernel::CalcVertexNormals() const
 {
-    std::vector<Base::Vector3f> normals;
-
-    normals.resize(CountPoints());
-
-    PointIndex p1 {}, p2 {}, p3 {};
-    unsigned int ct = CountFacets();
-    for (unsigned int pFIter = 0; pFIter < ct; pFIter++) {
-        GetFacetPoints(pFIter, p1, p2, p3);
-        Base::Vector3f Norm = (GetPoint(p2) - GetPoint(p1)) % (GetPoint(p3) - GetPoint(p1));
-
-        normals[p1] += Norm;
-        normals[p2] += Norm;
-        normals[p3] += Norm;
+    // The facet normals are independent of each other and computed in parallel while
+    // they are summed up in facet order to get the same result as a serial loop
+    const MeshPoint* points = _aclPointArray.data();
+    const MeshFacet* facets = _aclFacetArray.data();
+    std::vector<Base::Vector3f> facetNormals(_aclFacetArray.size());
+    Base::Vector3f* facetNormal = facetNormals.data();
+    forEachChunk(_aclFacetArray.size(), [points, facets, facetNormal](Chunk& chunk) {
+        for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+            const PointIndex* poly = facets[i]._aulPoints;
+            const Base::Vector3f& p1 = points[poly[0]];
+            facetNormal[i] = (points[poly[1]] - p1) % (points[poly[2]] - p1);
+        }
+    });
+
+    std::vector<Base::Vector3f> normals(CountPoints());
+    for (std::size_t i = 0; i < facetNormals.size(); i++) {
+        const PointIndex* poly = facets[i]._aulPoints;
+        normals[poly[0]] += facetNormals[i];
+        normals[poly[1]] += facetNormals[i];
+        normals[poly[2]] += facetNormals[i];
     }
 
     return normals;
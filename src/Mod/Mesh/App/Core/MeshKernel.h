@@ -190,9 +190,40 @@ public:
     /** Returns a modifier for the facet array */
     MeshFacetModifier ModifyFacets()
     {
-        return MeshFacetModifier(_aclFacetArray);
+        return MeshFacetModifier(_aclFacetArray, _ulTopologyVersion);
     }
 
+    /** Returns a counter that is increased whenever the facets or the number of points
+     * change. Structures built from the topology compare it to decide if they are outdated.
+     */
+    unsigned long GetTopologyVersion() const
+    {
+        return _ulTopologyVersion;
+    }
+    /** Increases the topology counter of a mesh kernel when it goes out of scope, i.e.
+     * after the modification. Algorithms that directly change the facets or the number of
+     * points must create one for the scope of the change.
+     */
+    class TopologyChange
+    {
+    public:
+        explicit TopologyChange(MeshKernel& mesh)
+            : rMesh(mesh)
+        {}
+        ~TopologyChange()
+        {
+            rMesh._ulTopologyVersion++;
+        }
+
+        TopologyChange(const TopologyChange&) = delete;
+        TopologyChange(TopologyChange&&) = delete;
+        TopologyChange& operator=(const TopologyChange&) = delete;
+        TopologyChange& operator=(TopologyChange&&) = delete;
+
+    private:
+        MeshKernel& rMesh;
+    };
+
     /** Returns the array of all edges.
      *  Notice: The Edgelist will be temporary generated. Changes on the mesh
      * structure does not affect the Edgelist
@@ -486,6 +517,7 @@ private:
     MeshFacetArray _aclFacetArray;        /**< Holds the array of facets. */
     mutable Base::BoundBox3f _clBoundBox; /**< The current calculated bounding box. */
     bool _bValid {true};                  /**< Current state of validality. */
+    unsigned long _ulTopologyVersion {0}; /**< Counts the changes of the topology. */
 
     // friends
     friend class MeshPointIterator;
@@ -40,6 +40,7 @@ namespace MeshCore
 {
 
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshKernel;
 class MeshGeomFacet;
 
@@ -55,8 +56,22 @@ public:
                            FacetIndex f2,
                            const Base::Vector3f& view,
                            std::vector<Base::Vector3f>& polyline);
+    bool projectLineOnMesh(const MeshFacetBVH& bvh,
+                           const Base::Vector3f& p1,
+                           FacetIndex f1,
+                           const Base::Vector3f& p2,
+                           FacetIndex f2,
+                           const Base::Vector3f& view,
+                           std::vector<Base::Vector3f>& polyline);
 
 protected:
+    bool projectLineOnFacets(std::vector<FacetIndex>& facets,
+                             const Base::Vector3f& p1,
+                             FacetIndex f1,
+                             const Base::Vector3f& p2,
+                             FacetIndex f2,
+                             const Base::Vector3f& view,
+                             std::vector<Base::Vector3f>& polyline);
     bool bboxInsideRectangle(const Base::BoundBox3f& bbox,
                              const Base::Vector3f& p1,
                              const Base::Vector3f& p2,
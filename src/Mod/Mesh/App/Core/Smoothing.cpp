@@ -22,11 +22,17 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#endif
+
 #include <Base/Tools.h>
 
 #include "Algorithm.h"
 #include "Approximation.h"
-#include "Iterator.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
 
@@ -46,119 +52,112 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
-PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
-    : AbstractSmoothing(m)
-{}
-
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
+const MeshPointAdjacency& AbstractSmoothing::GetAdjacency()
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0f / (static_cast<float>(cv.size()) + 1.0f);
-            center.Scale(scale, scale, scale);
+    if (!adjacency) {
+        adjacency = std::make_unique<MeshPointAdjacency>(kernel);
+    }
+    else {
+        adjacency->Validate();
+    }
+    return *adjacency;
+}
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+void AbstractSmoothing::SetPoints(const std::vector<PointIndex>& indices,
+                                  const std::vector<Base::Vector3f>& points)
+{
+    // A point given several times would be written by several threads. Strictly
+    // increasing indices, e.g. of all points, don't need to be sorted to check this.
+    auto end = indices.end();
+    bool unique = std::adjacent_find(indices.begin(), end, std::greater_equal<>()) == end;
+    if (!unique) {
+        std::vector<PointIndex> sorted(indices);
+        std::sort(sorted.begin(), sorted.end());
+        unique = std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+    }
+    if (!unique) {
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            kernel.SetPoint(indices[i], points[i]);
+        }
+        return;
+    }
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0f) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+    parallel_for(indices.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            kernel.SetPoint(indices[i], points[i]);
+        }
+    });
+}
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+namespace
+{
+std::vector<PointIndex> allPoints(const MeshKernel& kernel)
+{
+    std::vector<PointIndex> indices(kernel.CountPoints());
+    std::iota(indices.begin(), indices.end(), 0);
+    return indices;
+}
+}  // namespace
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
+    : AbstractSmoothing(m)
+{}
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
                                      const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    const MeshPointAdjacency& vv_it = GetAdjacency();
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    std::vector<Base::Vector3f> PointArray(point_indices.size());
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (PointIndex it : point_indices) {
-            v_it.Set(it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+        parallel_for(point_indices.size(), [&](std::size_t first, std::size_t last) {
+            for (std::size_t index = first; index < last; index++) {
+                PointIndex it = point_indices[index];
+                const MeshCore::MeshPoint& pnt = points[it];
+                PointArray[index] = pnt;
+
+                MeshPointAdjacency::Range cv = vv_it.GetPoints(it);
+                if (cv.size() < 3) {
+                    continue;
+                }
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+                MeshCore::PlaneFit pf;
+                pf.AddPoint(pnt);
+                Base::Vector3f center = pnt;
+                for (PointIndex cv_it : cv) {
+                    pf.AddPoint(points[cv_it]);
+                    center += points[cv_it];
+                }
 
-            float scale = 1.0f / (static_cast<float>(cv.size()) + 1.0f);
-            center.Scale(scale, scale, scale);
+                float scale = 1.0f / (static_cast<float>(cv.size()) + 1.0f);
+                center.Scale(scale, scale, scale);
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+                // get the mean plane of the current vertex with the surrounding vertices
+                pf.Fit();
+                Base::Vector3f N = pf.GetNormal();
+                N.Normalize();
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0f) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+                // look in which direction we should move the vertex
+                Base::Vector3f L(pnt.x - center.x, pnt.y - center.y, pnt.z - center.z);
+                if (N * L < 0.0f) {
+                    N.Scale(-1.0, -1.0, -1.0);
+                }
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+                // maximum value to move is distance to mean plane
+                float d = std::min<float>(fabs(this->maximum), fabs(N * L));
+                N.Scale(d, d, d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+                PointArray[index].Set(pnt.x - N.x, pnt.y - N.y, pnt.z - N.z);
+            }
+        });
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+        SetPoints(point_indices, PointArray);
     }
 }
 
@@ -166,22 +165,20 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize)
+void LaplaceSmoothing::Umbrella(const MeshPointAdjacency& vv_it,
+                                double stepsize,
+                                const std::vector<PointIndex>& point_indices)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
+    auto umbrella = [&](PointIndex it) -> Base::Vector3f {
+        const MeshCore::MeshPoint& pnt = points[it];
+        MeshPointAdjacency::Range cv = vv_it.GetPoints(it);
         if (cv.size() < 3) {
-            continue;
+            return pnt;
         }
-        if (cv.size() != vf_it[pos].size()) {
+        if (vv_it.IsBorder(it)) {
             // do nothing for border points
-            continue;
+            return pnt;
         }
 
         size_t n_count = cv.size();
@@ -189,75 +186,47 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
         w = 1.0 / double(n_count);
 
         double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
+        for (PointIndex cv_it : cv) {
+            delx += w * static_cast<double>(points[cv_it].x - pnt.x);
+            dely += w * static_cast<double>(points[cv_it].y - pnt.y);
+            delz += w * static_cast<double>(points[cv_it].z - pnt.z);
         }
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
-}
-
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize,
-                                const std::vector<PointIndex>& point_indices)
-{
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+        float x = static_cast<float>(static_cast<double>(pnt.x) + stepsize * delx);
+        float y = static_cast<float>(static_cast<double>(pnt.y) + stepsize * dely);
+        float z = static_cast<float>(static_cast<double>(pnt.z) + stepsize * delz);
+        return Base::Vector3f(x, y, z);
+    };
 
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
+    if (!IsJacobi()) {
+        for (PointIndex it : point_indices) {
+            kernel.SetPoint(it, umbrella(it));
         }
+        return;
+    }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
+    positions.resize(point_indices.size());
+    parallel_for(point_indices.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; index++) {
+            positions[index] = umbrella(point_indices[index]);
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
-    }
+    SetPoints(point_indices, positions);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    const MeshPointAdjacency& vv_it = GetAdjacency();
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(vv_it, lambda, point_indices);
     }
 }
 
@@ -267,28 +236,19 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    // Theoretically Taubin does not shrink the surface
-    iterations = (iterations + 1) / 2;  // two steps per iteration
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
-    }
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    const MeshPointAdjacency& vv_it = GetAdjacency();
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
+        Umbrella(vv_it, GetLambda(), point_indices);
+        Umbrella(vv_it, -(GetLambda() + micro), point_indices);
     }
 }
 
@@ -326,94 +286,111 @@ MedianFilterSmoothing::MedianFilterSmoothing(MeshKernel& m)
 
 void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
-    std::vector<unsigned long> point_indices(kernel.CountPoints());
-    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
-    }
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    const MeshPointAdjacency& vf_it = GetAdjacency();
 
     for (unsigned int i = 0; i < iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
+        UpdatePoints(vf_it, point_indices);
     }
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
+void MedianFilterSmoothing::UpdatePoints(const MeshPointAdjacency& vf_it,
                                          const std::vector<PointIndex>& point_indices)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
     const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
 
     // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
+    facetNormals.resize(facets.size());
+    parallel_for(facets.size(), [&](std::size_t first, std::size_t last) {
+        for (FacetIndex pos = first; pos < last; pos++) {
+            facetNormals[pos] = Base::toVector<double>(kernel.GetFacet(pos).GetNormal());
+        }
+    });
 
     // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
+    medianNormals.resize(facets.size());
+    parallel_for(facets.size(), [&](std::size_t first, std::size_t last) {
+        std::vector<FacetIndex> cv;
         std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
+        for (FacetIndex pos = first; pos < last; pos++) {
+            const Base::Vector3d& refNormal = facetNormals[pos];
+            const MeshCore::MeshFacet& facet = facets[pos];
+
+            // the facets sharing a point with this facet
+            cv.clear();
+            for (PointIndex point : facet._aulPoints) {
+                MeshPointAdjacency::Range range = vf_it.GetFacets(point);
+                cv.insert(cv.end(), range.begin(), range.end());
+            }
+            std::sort(cv.begin(), cv.end());
+            cv.erase(std::unique(cv.begin(), cv.end()), cv.end());
+
+            anglesWithFaces.clear();
+            for (auto fi : cv) {
+                const Base::Vector3d& faceNormal = facetNormals[fi];
+                double angle = refNormal.GetAngle(faceNormal);
+
+                int absWeight = std::abs(weights);
+                if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                    if (weights < 0) {
+                        angle = -angle;
+                    }
+                    for (int i = 0; i < absWeight; i++) {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
                 }
-                for (int i = 0; i < absWeight; i++) {
+                else {
                     anglesWithFaces.emplace_back(angle, faceNormal);
                 }
             }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
 
-        faceNormals[pos] = find_median(anglesWithFaces);
-    }
+            medianNormals[pos] = find_median(anglesWithFaces);
+        }
+    });
 
     // Step 2: move vertices
-    for (auto pos : point_indices) {
+    auto move = [&](PointIndex pos) -> Base::Vector3f {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
-        for (auto it : cv) {
-            iter.Set(it);
+        for (auto it : vf_it.GetFacets(pos)) {
+            MeshCore::MeshGeomFacet face = kernel.GetFacet(it);
 
-            double faceArea = iter->Area();
+            double faceArea = face.Area();
             totalArea += faceArea;
 
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
+            Base::Vector3d C = Base::toVector<double>(face.GetGravityPoint());
 
             Base::Vector3d PC = C - P;
-            Base::Vector3d mT = faceNormals[it];
+            Base::Vector3d mT = medianNormals[it];
             Base::Vector3d vT = (PC * mT) * mT;
             totalvT += vT * faceArea;
         }
 
         P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
+        return Base::toVector<float>(P);
+    };
+
+    if (!IsJacobi()) {
+        for (PointIndex pos : point_indices) {
+            kernel.SetPoint(pos, move(pos));
+        }
+        return;
     }
+
+    positions.resize(point_indices.size());
+    parallel_for(point_indices.size(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t index = first; index < last; index++) {
+            positions[index] = move(point_indices[index]);
+        }
+    });
+
+    SetPoints(point_indices, positions);
 }
@@ -24,19 +24,26 @@
 #define MESH_SMOOTHING_H
 
 #include <cfloat>
+#include <memory>
 #include <vector>
 
+#include <Base/Vector3D.h>
+
 #include "Definitions.h"
 
 
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
-
-/** Base class for smoothing algorithms. */
+class MeshPointAdjacency;
+
+/**
+ * Base class for smoothing algorithms.
+ * By default the points are moved one after the other and each point already uses the new
+ * positions of the points moved before (Gauss-Seidel). With SetJacobi() each iteration only
+ * uses the positions of the previous iteration, so the points are moved in parallel and the
+ * result doesn't depend on the point order or the number of threads.
+ */
 class MeshExport AbstractSmoothing
 {
 public:
@@ -62,18 +69,42 @@ public:
     AbstractSmoothing& operator=(AbstractSmoothing&&) = delete;
 
     void initialize(Component comp, Continuity cont);
+    /** Computes all positions of an iteration from the previous ones and in parallel.
+     * Plane fit smoothing always does so.
+     */
+    void SetJacobi(bool on)
+    {
+        jacobi = on;
+    }
+    bool IsJacobi() const
+    {
+        return jacobi;
+    }
 
     /** Smooth the triangle mesh. */
     virtual void Smooth(unsigned int) = 0;
     virtual void SmoothPoints(unsigned int, const std::vector<PointIndex>&) = 0;
 
+protected:
+    /** Returns the adjacency of the points that is kept as long as the topology is unchanged. */
+    const MeshPointAdjacency& GetAdjacency();
+    /** Sets the points with the given indices to the new positions.
+     * Only unique indices are set in parallel.
+     */
+    void SetPoints(const std::vector<PointIndex>& indices,
+                   const std::vector<Base::Vector3f>& points);
+
 protected:
     // NOLINTBEGIN
     MeshKernel& kernel;
 
     Component component {Normal};
     Continuity continuity {C0};
+    bool jacobi {false};
     // NOLINTEND
+
+private:
+    std::unique_ptr<MeshPointAdjacency> adjacency;
 };
 
 class MeshExport PlaneFitSmoothing: public AbstractSmoothing
@@ -107,14 +138,11 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
-                  double,
-                  const std::vector<PointIndex>&);
+    void Umbrella(const MeshPointAdjacency&, double, const std::vector<PointIndex>&);
 
 private:
     double lambda {0.6307};
+    std::vector<Base::Vector3f> positions;
 };
 
 class MeshExport TaubinSmoothing: public LaplaceSmoothing
@@ -149,12 +177,13 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
-                      const std::vector<PointIndex>&);
+    void UpdatePoints(const MeshPointAdjacency&, const std::vector<PointIndex>&);
 
 private:
     int weights {1};
+    std::vector<Base::Vector3d> facetNormals;
+    std::vector<Base::Vector3d> medianNormals;
+    std::vector<Base::Vector3f> positions;
 };
 
 }  // namespace MeshCore
@@ -124,6 +124,7 @@ bool MeshTopoAlgorithm::SnapVertex(FacetIndex ulFacetPos, const Base::Vector3f&
                 return SplitOpenEdge(ulFacetPos, i, rP);
             }
             else if ((rP - rPt1) * cNo2 > 0.0f && fD2 >= fTV && fTV >= 0.0f) {
+                MeshKernel::TopologyChange change(_rclMesh);
                 MeshFacet cTria;
                 cTria._aulPoints[0] = this->GetOrAddIndex(rP);
                 cTria._aulPoints[1] = rFace._aulPoints[(i + 1) % 3];
@@ -704,6 +705,7 @@ void MeshTopoAlgorithm::SwapEdge(FacetIndex ulFacetPos, FacetIndex ulNeighbour)
     }
 
     // swap the point and neighbour indices
+    MeshKernel::TopologyChange change(_rclMesh);
     rclF._aulPoints[(uFSide + 1) % 3] = rclN._aulPoints[(uNSide + 2) % 3];
     rclN._aulPoints[(uNSide + 1) % 3] = rclF._aulPoints[(uFSide + 2) % 3];
     rclF._aulNeighbours[uFSide] = rclN._aulNeighbours[(uNSide + 1) % 3];
@@ -853,13 +855,20 @@ void MeshTopoAlgorithm::EndCache()
 
 PointIndex MeshTopoAlgorithm::GetOrAddIndex(const MeshPoint& rclPoint)
 {
+    unsigned long sz = _rclMesh._aclPointArray.size();
     if (!_cache) {
-        return _rclMesh._aclPointArray.GetOrAddIndex(rclPoint);
+        PointIndex index = _rclMesh._aclPointArray.Get(rclPoint);
+        if (index == POINT_INDEX_MAX) {
+            MeshKernel::TopologyChange change(_rclMesh);
+            _rclMesh._aclPointArray.push_back(rclPoint);
+            index = sz;
+        }
+        return index;
     }
 
-    unsigned long sz = _rclMesh._aclPointArray.size();
     std::pair<tCache::iterator, bool> retval = _cache->insert(std::make_pair(rclPoint, sz));
     if (retval.second) {
+        MeshKernel::TopologyChange change(_rclMesh);
         _rclMesh._aclPointArray.push_back(rclPoint);
     }
     return retval.first->second;
@@ -953,6 +962,7 @@ bool MeshTopoAlgorithm::CollapseVertex(const VertexCollapse& vc)
     }
 
     // adjust point and neighbour indices
+    MeshKernel::TopologyChange change(_rclMesh);
     rFace1.Transpose(vc._point, ptIndex);
     rFace1.ReplaceNeighbour(vc._circumFacets[1], neighbour1);
     rFace1.ReplaceNeighbour(vc._circumFacets[2], neighbour2);
@@ -997,6 +1007,7 @@ bool MeshTopoAlgorithm::CollapseEdge(FacetIndex ulFacetPos, FacetIndex ulNeighbo
     PointIndex ulPointNew = rclN._aulPoints[uNSide];
 
     // get all facets this point is referenced by
+    MeshKernel::TopologyChange change(_rclMesh);
     std::vector<FacetIndex> aRefs = GetFacetsToPoint(ulFacetPos, ulPointPos);
     for (FacetIndex it : aRefs) {
         MeshFacet& rFace = _rclMesh._aclFacetArray[it];
@@ -1129,6 +1140,7 @@ bool MeshTopoAlgorithm::CollapseEdge(const EdgeCollapse& ec)
         }
     }
 
+    MeshKernel::TopologyChange change(_rclMesh);
     for (it = ec._changeFacets.begin(); it != ec._changeFacets.end(); ++it) {
         MeshFacet& f = _rclMesh._aclFacetArray[*it];
         f.Transpose(ec._fromPoint, ec._toPoint);
@@ -1157,6 +1169,7 @@ bool MeshTopoAlgorithm::CollapseFacet(FacetIndex ulFacetPos)
     _rclMesh._aclPointArray[ulPointInd0] = cCenter;
 
     // set the new point indices for all facets that share one of the points to be deleted
+    MeshKernel::TopologyChange change(_rclMesh);
     std::vector<FacetIndex> aRefs = GetFacetsToPoint(ulFacetPos, ulPointInd1);
     for (FacetIndex it : aRefs) {
         MeshFacet& rFace = _rclMesh._aclFacetArray[it];
@@ -1338,6 +1351,7 @@ void MeshTopoAlgorithm::SplitFacetOnTwoEdges(FacetIndex ulFacetPos,
 
     // Modify and add facets
     //
+    MeshKernel::TopologyChange change(_rclMesh);
     rFace._aulPoints[v0] = cntPts2;
     rFace._aulPoints[v1] = cntPts1;
     rFace._aulNeighbours[v0] = cntFts + 1;
@@ -1402,6 +1416,7 @@ void MeshTopoAlgorithm::SplitFacet(FacetIndex ulFacetPos,
         PointIndex V2 = rFace._aulPoints[(side + 2) % 3];
         FacetIndex size = _rclMesh._aclFacetArray.size();
 
+        MeshKernel::TopologyChange change(_rclMesh);
         rFace._aulPoints[(side + 1) % 3] = Pn;
         FacetIndex N1 = rFace._aulNeighbours[(side + 1) % 3];
         if (N1 != FACET_INDEX_MAX) {
@@ -1420,6 +1435,7 @@ void MeshTopoAlgorithm::AddFacet(PointIndex P1, PointIndex P2, PointIndex P3)
     facet._aulPoints[1] = P2;
     facet._aulPoints[2] = P3;
 
+    MeshKernel::TopologyChange change(_rclMesh);
     _rclMesh._aclFacetArray.push_back(facet);
 }
 
@@ -1438,6 +1454,7 @@ void MeshTopoAlgorithm::AddFacet(PointIndex P1,
     facet._aulNeighbours[1] = N2;
     facet._aulNeighbours[2] = N3;
 
+    MeshKernel::TopologyChange change(_rclMesh);
     _rclMesh._aclFacetArray.push_back(facet);
 }
 
@@ -1578,6 +1595,7 @@ bool MeshTopoAlgorithm::RemoveDegeneratedFacet(FacetIndex index)
                 unsigned short side = rNb.Side(index);
 
                 // bend the point indices
+                MeshKernel::TopologyChange change(_rclMesh);
                 rFace._aulPoints[(j + 2) % 3] = rNb._aulPoints[(side + 2) % 3];
                 rNb._aulPoints[(side + 1) % 3] = rFace._aulPoints[j];
 
@@ -1712,6 +1730,7 @@ void MeshTopoAlgorithm::FillupHoles(int level,
     }
 
     // insert new points and faces into the mesh structure
+    MeshKernel::TopologyChange change(_rclMesh);
     _rclMesh._aclPointArray.insert(_rclMesh._aclPointArray.end(),
                                    newPoints.begin(),
                                    newPoints.end());
@@ -1778,6 +1797,7 @@ void MeshTopoAlgorithm::RemoveComponents(unsigned long count)
 void MeshTopoAlgorithm::HarmonizeNormals()
 {
     std::vector<FacetIndex> uIndices = MeshEvalOrientation(_rclMesh).GetIndices();
+    MeshKernel::TopologyChange change(_rclMesh);
     for (FacetIndex index : uIndices) {
         _rclMesh._aclFacetArray[index].FlipNormal();
     }
@@ -1785,6 +1805,7 @@ void MeshTopoAlgorithm::HarmonizeNormals()
 
 void MeshTopoAlgorithm::FlipNormals()
 {
+    MeshKernel::TopologyChange change(_rclMesh);
     for (MeshFacetArray::_TIterator i = _rclMesh._aclFacetArray.begin();
          i < _rclMesh._aclFacetArray.end();
          ++i) {
@@ -346,6 +346,7 @@ bool MeshTrimming::GetIntersectionPointsOfPolygonAndFacet(
 
 void MeshTrimming::AdjustFacet(MeshFacet& facet, int iInd)
 {
+    MeshKernel::TopologyChange change(myMesh);
     unsigned long tmp {};
 
     if (iInd == 1) {
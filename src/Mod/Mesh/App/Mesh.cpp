@@ -451,9 +451,19 @@ void MeshObject::save(std::ostream& str,
 }
 
 bool MeshObject::load(const char* file, MeshCore::Material* mat)
+{
+    return load(file, Base::BoundBox3f(), 0.0F, mat);
+}
+
+bool MeshObject::load(const char* file,
+                      const Base::BoundBox3f& box,
+                      float clusterSize,
+                      MeshCore::Material* mat)
 {
     MeshCore::MeshKernel kernel;
     MeshCore::MeshInput aReader(kernel, mat);
+    aReader.SetBoundBox(box);
+    aReader.SetClusterSize(clusterSize);
     if (!aReader.LoadAny(file)) {
         return false;
     }
@@ -1092,6 +1102,18 @@ void MeshObject::decimate(int targetSize)
     dm.simplify(targetSize);
 }
 
+MeshCore::MeshSimplify::Result
+MeshObject::decimate(const MeshCore::MeshSimplify::Settings& settings,
+                     std::vector<PointIndex>* pointMap)
+{
+    MeshCore::MeshSimplify dm(this->_kernel);
+    MeshCore::MeshSimplify::Result result = dm.simplify(settings);
+    if (pointMap) {
+        *pointMap = dm.GetPointMap();
+    }
+    return result;
+}
+
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 {
     std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
@@ -35,6 +35,7 @@
 #include <Base/Matrix.h>
 #include <Base/Tools3D.h>
 
+#include "Core/Decimation.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
@@ -205,6 +206,13 @@ public:
               const MeshCore::Material* mat = nullptr,
               const char* objectname = nullptr) const;
     bool load(const char* file, MeshCore::Material* mat = nullptr);
+    /** Loads a mesh file. The mesh is cropped to \a box if it's valid, and decimated by
+     * merging all points within a cell of size \a clusterSize.
+     */
+    bool load(const char* file,
+              const Base::BoundBox3f& box,
+              float clusterSize,
+              MeshCore::Material* mat = nullptr);
     bool load(std::istream&, MeshCore::MeshIO::Format f, MeshCore::Material* mat = nullptr);
     // Save and load in internal format
     void save(std::ostream&) const;
@@ -264,6 +272,11 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    /** Runs the parallel decimation. If \a pointMap is given it is filled with the index of
+     * the original point for each point of the simplified mesh.
+     */
+    MeshCore::MeshSimplify::Result decimate(const MeshCore::MeshSimplify::Settings& settings,
+                                            std::vector<PointIndex>* pointMap = nullptr);
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&,
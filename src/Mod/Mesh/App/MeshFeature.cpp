@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #include <App/FeaturePythonPyImp.h>
+#include <App/PropertyStandard.h>
 
 #include "MeshFeature.h"
 #include "MeshFeaturePy.h"
@@ -30,6 +31,24 @@
 
 using namespace Mesh;
 
+namespace
+{
+template<typename T>
+void mapPerVertex(std::vector<T>& values,
+                  std::size_t numPoints,
+                  const std::vector<PointIndex>& pointMap)
+{
+    if (values.size() != numPoints) {
+        return;
+    }
+    std::vector<T> mapped;
+    mapped.reserve(pointMap.size());
+    for (PointIndex index : pointMap) {
+        mapped.push_back(values[index]);
+    }
+    values.swap(mapped);
+}
+}  // namespace
 
 //===========================================================================
 // Feature
@@ -48,6 +67,41 @@ App::DocumentObjectExecReturn* Feature::execute()
     return App::DocumentObject::StdReturn;
 }
 
+MeshCore::MeshSimplify::Result Feature::decimate(const MeshCore::MeshSimplify::Settings& settings)
+{
+    std::size_t numPoints = this->Mesh.getValue().countPoints();
+    std::vector<PointIndex> pointMap;
+    MeshObject* mesh = this->Mesh.startEditing();
+    MeshCore::MeshSimplify::Result result = mesh->decimate(settings, &pointMap);
+    this->Mesh.finishEditing();
+
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    for (auto prop : props) {
+        if (auto colors = dynamic_cast<App::PropertyColorList*>(prop)) {
+            std::vector<App::Color> values = colors->getValues();
+            if (values.size() == numPoints) {
+                mapPerVertex(values, numPoints, pointMap);
+                colors->setValues(values);
+            }
+        }
+        else if (auto material = dynamic_cast<PropertyMaterial*>(prop)) {
+            if (material->getBinding() == MeshCore::MeshIO::PER_VERTEX) {
+                MeshCore::Material mat = material->getValue();
+                mapPerVertex(mat.ambientColor, numPoints, pointMap);
+                mapPerVertex(mat.diffuseColor, numPoints, pointMap);
+                mapPerVertex(mat.specularColor, numPoints, pointMap);
+                mapPerVertex(mat.emissiveColor, numPoints, pointMap);
+                mapPerVertex(mat.shininess, numPoints, pointMap);
+                mapPerVertex(mat.transparency, numPoints, pointMap);
+                material->setValue(mat);
+            }
+        }
+    }
+
+    return result;
+}
+
 PyObject* Feature::getPyObject()
 {
     if (PythonObject.is(Py::_None())) {
@@ -75,6 +75,11 @@ public:
     void onChanged(const App::Property* prop) override;
     //@}
 
+    /** Decimates the mesh with the parallel decimation. Per-vertex colors of a color list
+     * or a material property are carried over to the points of the simplified mesh.
+     */
+    MeshCore::MeshSimplify::Result decimate(const MeshCore::MeshSimplify::Settings& settings);
+
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override
     {
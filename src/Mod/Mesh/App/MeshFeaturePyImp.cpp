@@ -90,8 +90,25 @@ PyObject* MeshFeaturePy::smooth(PyObject* args)
     Py_Return;
 }
 
-PyObject* MeshFeaturePy::decimate(PyObject* args)
+PyObject* MeshFeaturePy::decimate(PyObject* args, PyObject* kwds)
 {
+    // with keywords the parallel decimation by quadric error is used
+    if (kwds && PyDict_Size(kwds) > 0) {
+        MeshCore::MeshSimplify::Settings settings;
+        if (!MeshPy::getDecimateSettings(args, kwds, settings)) {
+            return nullptr;
+        }
+
+        MeshCore::MeshSimplify::Result result;
+        PY_TRY
+        {
+            result = getFeaturePtr()->decimate(settings);
+        }
+        PY_CATCH;
+
+        return MeshPy::getDecimateResult(result);
+    }
+
     float fTol {};
     float fRed {};
     if (PyArg_ParseTuple(args, "ff", &fTol, &fRed)) {
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 
+#include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -29,6 +30,9 @@
 #include <Base/VectorPy.h>
 #include <Base/Writer.h>
 
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/MeshIO.h"
@@ -744,6 +748,7 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
+    clearDeferred();
     _meshObject = mesh;
     hasSetValue();
 }
@@ -751,6 +756,7 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
+    clearDeferred();
     *_meshObject = mesh;
     hasSetValue();
 }
@@ -758,12 +764,14 @@ void PropertyMeshKernel::setValue(const MeshObject& mesh)
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
+    clearDeferred();
     _meshObject->setKernel(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
+    restoreDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -771,6 +779,7 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
+    restoreDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -778,26 +787,37 @@ void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 
 const MeshObject& PropertyMeshKernel::getValue() const
 {
+    restoreDeferred();
     return *_meshObject;
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr() const
 {
+    restoreDeferred();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
+    restoreDeferred();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
+    restoreDeferred();
     return _meshObject->getBoundBox();
 }
 
 unsigned int PropertyMeshKernel::getMemSize() const
 {
+    if (_isDeferred) {
+        std::lock_guard<std::mutex> lock(_deferredMutex);
+        if (_deferred) {
+            return static_cast<unsigned int>(_deferred->getDataSize());
+        }
+    }
+
     unsigned int size = 0;
     size += _meshObject->getMemSize();
 
@@ -806,6 +826,7 @@ unsigned int PropertyMeshKernel::getMemSize() const
 
 MeshObject* PropertyMeshKernel::startEditing()
 {
+    restoreDeferred();
     aboutToSetValue();
     return static_cast<MeshObject*>(_meshObject);
 }
@@ -817,6 +838,7 @@ void PropertyMeshKernel::finishEditing()
 
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    restoreDeferred();
     aboutToSetValue();
     _meshObject->transformGeometry(rclMat);
     hasSetValue();
@@ -825,6 +847,7 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 void PropertyMeshKernel::setPointIndices(
     const std::vector<std::pair<PointIndex, Base::Vector3f>>& inds)
 {
+    restoreDeferred();
     aboutToSetValue();
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (const auto& it : inds) {
@@ -835,16 +858,19 @@ void PropertyMeshKernel::setPointIndices(
 
 void PropertyMeshKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
+    restoreDeferred();
     _meshObject->setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyMeshKernel::getTransform() const
 {
+    restoreDeferred();
     return _meshObject->getTransform();
 }
 
 PyObject* PropertyMeshKernel::getPyObject()
 {
+    restoreDeferred();
     if (!meshPyObject) {
         meshPyObject = new MeshPy(
             &*_meshObject);  // Lgtm[cpp/resource-not-released-in-destructor] ** Not destroyed in
@@ -883,6 +909,7 @@ void PropertyMeshKernel::setPyObject(PyObject* value)
 void PropertyMeshKernel::Save(Base::Writer& writer) const
 {
     if (writer.isForceXML()) {
+        restoreDeferred();
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
         MeshCore::MeshOutput saver(_meshObject->getKernel());
         saver.SaveXML(writer);
@@ -921,9 +948,27 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
+    if (_isDeferred) {
+        std::shared_ptr<Base::DeferredFile> file;
+        {
+            std::lock_guard<std::mutex> lock(_deferredMutex);
+            file = _deferred;
+        }
+        // unchanged since restore, so write back the original data
+        if (file) {
+            writer.Stream() << file->inflate();
+            return;
+        }
+    }
+
     _meshObject->save(writer.Stream());
 }
 
+bool PropertyMeshKernel::canSaveDocFileConcurrently(const Base::Writer& /*writer*/) const
+{
+    return true;
+}
+
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
 {
     aboutToSetValue();
@@ -931,19 +976,85 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::canDeferRestoreDocFile() const
+{
+    return true;
+}
+
+void PropertyMeshKernel::deferRestoreDocFile(const std::shared_ptr<Base::DeferredFile>& file)
+{
+    std::lock_guard<std::mutex> lock(_deferredMutex);
+    _deferred = file;
+    _isDeferred = true;
+}
+
+void PropertyMeshKernel::clearDeferred()
+{
+    if (_isDeferred) {
+        std::lock_guard<std::mutex> lock(_deferredMutex);
+        _deferred.reset();
+        _isDeferred = false;
+    }
+}
+
+void PropertyMeshKernel::restoreDeferred() const
+{
+    if (!_isDeferred) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_deferredMutex);
+    if (!_deferred) {
+        return;
+    }
+
+    // the mesh is logically unchanged, so load it without notification
+    try {
+        std::string data = _deferred->inflate();
+        boost::iostreams::stream<boost::iostreams::array_source> str(data.data(), data.size());
+        _meshObject->load(str);
+    }
+    catch (const Base::Exception& e) {
+        e.ReportException();
+    }
+    catch (const std::exception& e) {
+        Base::Console().Error("Failed to restore mesh of %s: %s\n",
+                              getFullName().c_str(),
+                              e.what());
+    }
+
+    auto self = const_cast<PropertyMeshKernel*>(this);  // NOLINT
+    self->_deferred.reset();
+    _isDeferred = false;
+}
+
 App::Property* PropertyMeshKernel::Copy() const
 {
     // Note: Copy the content, do NOT reference the same mesh object
     PropertyMeshKernel* prop = new PropertyMeshKernel();
+    {
+        // the stored data is immutable and can be shared
+        std::lock_guard<std::mutex> lock(_deferredMutex);
+        if (_deferred) {
+            prop->_deferred = _deferred;
+            prop->_isDeferred = true;
+        }
+    }
     *(prop->_meshObject) = *(this->_meshObject);
     return prop;
 }
 
+bool PropertyMeshKernel::canCompressUndo() const
+{
+    return true;
+}
+
 void PropertyMeshKernel::Paste(const App::Property& from)
 {
     // Note: Copy the content, do NOT reference the same mesh object
-    aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
+    prop.restoreDeferred();
+    aboutToSetValue();
+    clearDeferred();
     *(this->_meshObject) = *(prop._meshObject);
     hasSetValue();
 }
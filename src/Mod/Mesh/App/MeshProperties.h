@@ -23,8 +23,11 @@
 #ifndef MESH_MESHPROPERTIES_H
 #define MESH_MESHPROPERTIES_H
 
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -314,15 +317,27 @@ public:
     void Restore(Base::XMLReader& reader) override;
 
     void SaveDocFile(Base::Writer& writer) const override;
+    bool canSaveDocFileConcurrently(const Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canDeferRestoreDocFile() const override;
+    void deferRestoreDocFile(const std::shared_ptr<Base::DeferredFile>& file) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
+    bool canCompressUndo() const override;
     //@}
 
+private:
+    /// Loads the mesh kept by deferRestoreDocFile() on first access
+    void restoreDeferred() const;
+    void clearDeferred();
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject {nullptr};
+    std::shared_ptr<Base::DeferredFile> _deferred;
+    mutable std::atomic<bool> _isDeferred {false};
+    mutable std::mutex _deferredMutex;
 };
 
 }  // namespace Mesh
@@ -150,9 +150,32 @@ PyObject* MeshPy::copy(PyObject* args)
 PyObject* MeshPy::read(PyObject* args, PyObject* kwds)
 {
     char* Name {};
-    static const std::array<const char*, 2> keywords_path {"Filename", nullptr};
-    if (Base::Wrapped_ParseTupleAndKeywords(args, kwds, "et", keywords_path, "utf-8", &Name)) {
-        getMeshObjectPtr()->load(Name);
+    PyObject* box = nullptr;
+    float clusterSize = 0.0F;
+    static const std::array<const char*, 4> keywords_path {"Filename",
+                                                           "BoundBox",
+                                                           "ClusterSize",
+                                                           nullptr};
+    if (Base::Wrapped_ParseTupleAndKeywords(args,
+                                            kwds,
+                                            "et|O!f",
+                                            keywords_path,
+                                            "utf-8",
+                                            &Name,
+                                            &Base::BoundBoxPy::Type,
+                                            &box,
+                                            &clusterSize)) {
+        Base::BoundBox3f bbox;
+        if (box) {
+            Base::BoundBox3d bound = Py::BoundingBox(box, false).getValue();
+            bbox = Base::BoundBox3f(float(bound.MinX),
+                                    float(bound.MinY),
+                                    float(bound.MinZ),
+                                    float(bound.MaxX),
+                                    float(bound.MaxY),
+                                    float(bound.MaxZ));
+        }
+        getMeshObjectPtr()->load(Name, bbox, clusterSize);
         PyMem_Free(Name);
         Py_Return;
     }
@@ -2010,18 +2033,27 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds)
     double micro = 0;
     double maximum = 1000;
     int weight = 1;
-    static const std::array<const char*, 7>
-        keywords_smooth {"Method", "Iteration", "Lambda", "Micro", "Maximum", "Weight", nullptr};
+    PyObject* jacobi = Py_False;
+    static const std::array<const char*, 8> keywords_smooth {"Method",
+                                                             "Iteration",
+                                                             "Lambda",
+                                                             "Micro",
+                                                             "Maximum",
+                                                             "Weight",
+                                                             "Jacobi",
+                                                             nullptr};
     if (!Base::Wrapped_ParseTupleAndKeywords(args,
                                              kwds,
-                                             "|sidddi",
+                                             "|sidddiO!",
                                              keywords_smooth,
                                              &method,
                                              &iter,
                                              &lambda,
                                              &micro,
                                              &maximum,
-                                             &weight)) {
+                                             &weight,
+                                             &PyBool_Type,
+                                             &jacobi)) {
         return nullptr;
     }
 
@@ -2031,6 +2063,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds)
         MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
         if (strcmp(method, "Laplace") == 0) {
             MeshCore::LaplaceSmoothing smooth(kernel);
+            smooth.SetJacobi(Base::asBoolean(jacobi));
             if (lambda > 0) {
                 smooth.SetLambda(lambda);
             }
@@ -2038,6 +2071,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds)
         }
         else if (strcmp(method, "Taubin") == 0) {
             MeshCore::TaubinSmoothing smooth(kernel);
+            smooth.SetJacobi(Base::asBoolean(jacobi));
             if (lambda > 0) {
                 smooth.SetLambda(lambda);
             }
@@ -2053,6 +2087,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds)
         }
         else if (strcmp(method, "MedianFilter") == 0) {
             MeshCore::MedianFilterSmoothing smooth(kernel);
+            smooth.SetJacobi(Base::asBoolean(jacobi));
             smooth.SetWeight(weight);
             smooth.Smooth(iter);
         }
@@ -2065,8 +2100,68 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds)
     Py_Return;
 }
 
-PyObject* MeshPy::decimate(PyObject* args)
+bool MeshPy::getDecimateSettings(PyObject* args,
+                                 PyObject* kwds,
+                                 MeshCore::MeshSimplify::Settings& settings)
+{
+    int targetSize = 0;
+    double maxError = -1.0;
+    PyObject* keepBorders = Py_True;
+    double featureAngle = 1.0;
+    static const std::array<const char*, 5> keywords_decimate {"TargetSize",
+                                                                "MaxError",
+                                                                "KeepBorders",
+                                                                "FeatureAngle",
+                                                                nullptr};
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "|idO!d",
+                                             keywords_decimate,
+                                             &targetSize,
+                                             &maxError,
+                                             &PyBool_Type,
+                                             &keepBorders,
+                                             &featureAngle)) {
+        return false;
+    }
+
+    settings.targetSize = static_cast<std::size_t>(std::max(targetSize, 0));
+    settings.maxError = maxError;
+    settings.keepBorders = Base::asBoolean(keepBorders);
+    settings.featureAngle = static_cast<float>(featureAngle);
+    return true;
+}
+
+PyObject* MeshPy::getDecimateResult(const MeshCore::MeshSimplify::Result& result)
+{
+    Py::Dict dict;
+    dict.setItem(Py::String("NumFacets"), Py::Long(static_cast<long>(result.numFacets)));
+    dict.setItem(Py::String("NumCollapses"), Py::Long(static_cast<long>(result.numCollapses)));
+    dict.setItem(Py::String("MaxError"), Py::Float(result.maxError));
+    dict.setItem(Py::String("NumPasses"), Py::Long(result.numPasses));
+    return Py::new_reference_to(dict);
+}
+
+PyObject* MeshPy::decimate(PyObject* args, PyObject* kwds)
 {
+    // with keywords the parallel decimation by quadric error is used
+    if (kwds && PyDict_Size(kwds) > 0) {
+        MeshCore::MeshSimplify::Settings settings;
+        if (!getDecimateSettings(args, kwds, settings)) {
+            return nullptr;
+        }
+
+        MeshCore::MeshSimplify::Result result;
+        PY_TRY
+        {
+            MeshPropertyLock lock(this->parentProperty);
+            result = getMeshObjectPtr()->decimate(settings);
+        }
+        PY_CATCH;
+
+        return getDecimateResult(result);
+    }
+
     float fTol {};
     float fRed {};
     if (PyArg_ParseTuple(args, "ff", &fTol, &fRed)) {
@@ -580,6 +580,31 @@ class LoadMeshInThreadsCases(unittest.TestCase):
         pass
 
 
+class LoadMeshWithOptionsCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createSphere(10.0, 50)
+        self.name = tempfile.gettempdir() + os.sep + "options.stl"
+        self.mesh.write(self.name)
+
+    def testCropToBoundBox(self):
+        box = FreeCAD.BoundBox(-20.0, -20.0, 5.0, 20.0, 20.0, 20.0)
+        mesh = Mesh.Mesh()
+        mesh.read(self.name, BoundBox=box)
+        self.assertGreater(mesh.CountFacets, 0)
+        self.assertLess(mesh.CountFacets, self.mesh.CountFacets)
+        for facet in mesh.Facets:
+            self.assertGreaterEqual(max(p[2] for p in facet.Points), 5.0)
+
+    def testDecimateByClusters(self):
+        mesh = Mesh.Mesh()
+        mesh.read(Filename=self.name, ClusterSize=2.0)
+        self.assertGreater(mesh.CountFacets, 0)
+        self.assertLess(mesh.CountPoints, self.mesh.CountPoints)
+
+    def tearDown(self):
+        os.remove(self.name)
+
+
 class PolynomialFitCases(unittest.TestCase):
     def setUp(self):
         pass
@@ -747,3 +772,22 @@ class MeshProperty(unittest.TestCase):
         self.assertEqual(len(material2["emissiveColor"]), len1 + len2)
         self.assertEqual(len(material2["shininess"]), len1 + len2)
         self.assertEqual(len(material2["transparency"]), len1 + len2)
+
+    def testDecimateKeepsVertexColors(self):
+        mesh = self.doc.addObject("Mesh::Feature", "Sphere")
+        mesh.Mesh = Mesh.createSphere(1.0, 50)
+        count = mesh.Mesh.CountPoints
+        mesh.addProperty("App::PropertyColorList", "VertexColors")
+        mesh.VertexColors = [(1.0, 0.0, 0.0)] * count
+        mesh.addProperty("Mesh::PropertyMaterial", "Material")
+        material = {"binding": MeshEnums.Binding.PER_VERTEX}
+        material["diffuseColor"] = [(0.0, 1.0, 0.0)] * count
+        mesh.Material = material
+
+        result = mesh.decimate(TargetSize=int(mesh.Mesh.CountFacets / 4))
+
+        self.assertEqual(result["NumFacets"], mesh.Mesh.CountFacets)
+        self.assertLess(mesh.Mesh.CountPoints, count)
+        self.assertEqual(len(mesh.VertexColors), mesh.Mesh.CountPoints)
+        self.assertEqual(len(mesh.Material["diffuseColor"]), mesh.Mesh.CountPoints)
+        self.assertEqual(mesh.Material["diffuseColor"][0], (0.0, 1.0, 0.0))
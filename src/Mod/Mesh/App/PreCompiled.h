@@ -51,10 +51,12 @@
 #endif
 // STL
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <iostream>
 #include <list>
 #include <map>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -44,6 +44,7 @@ DlgDecimating::DlgDecimating(QWidget* parent, Qt::WindowFlags fl)
             &QCheckBox::toggled,
             this,
             &DlgDecimating::onCheckAbsoluteNumberToggled);
+    connect(ui->checkParallel, &QCheckBox::toggled, this, &DlgDecimating::updateTolerance);
     ui->spinBoxReduction->setMinimumWidth(60);
     ui->checkAbsoluteNumber->setEnabled(false);
     onCheckAbsoluteNumberToggled(false);
@@ -56,6 +57,15 @@ bool DlgDecimating::isAbsoluteNumber() const
     return ui->checkAbsoluteNumber->isChecked();
 }
 
+/**
+ * Returns true if the parallel decimation by quadric error is used. It only takes the
+ * number of triangles to reach and keeps the borders and sharp edges.
+ */
+bool DlgDecimating::isParallel() const
+{
+    return ui->checkParallel->isChecked();
+}
+
 int DlgDecimating::targetNumberOfTriangles() const
 {
     if (ui->checkAbsoluteNumber->isChecked()) {
@@ -77,7 +87,7 @@ void DlgDecimating::setNumberOfTriangles(int num)
 void DlgDecimating::onCheckAbsoluteNumberToggled(bool on)
 {
     ui->sliderReduction->setDisabled(on);
-    ui->groupBoxTolerance->setDisabled(on);
+    updateTolerance();
 
     if (on) {
         disconnect(ui->sliderReduction,
@@ -110,6 +120,11 @@ void DlgDecimating::onCheckAbsoluteNumberToggled(bool on)
     }
 }
 
+void DlgDecimating::updateTolerance()
+{
+    ui->groupBoxTolerance->setDisabled(isAbsoluteNumber() || isParallel());
+}
+
 double DlgDecimating::tolerance() const
 {
     return ui->spinBoxTolerance->value();
@@ -163,7 +178,12 @@ bool TaskDecimating::accept()
         targetSize = widget->targetNumberOfTriangles();
     }
     for (auto mesh : meshes) {
-        if (absolute) {
+        if (widget->isParallel()) {
+            int numFacets = static_cast<int>(mesh->Mesh.getValue().countFacets());
+            int target = absolute ? targetSize : int(numFacets * (1.0 - reduction));
+            Gui::cmdAppObjectArgs(mesh, "decimate(TargetSize=%i)", std::max(target, 1));
+        }
+        else if (absolute) {
             Gui::cmdAppObjectArgs(mesh, "decimate(%i)", targetSize);
         }
         else {
@@ -43,10 +43,12 @@ public:
     double tolerance() const;
     double reduction() const;
     bool isAbsoluteNumber() const;
+    bool isParallel() const;
     int targetNumberOfTriangles() const;
 
 private:
     void onCheckAbsoluteNumberToggled(bool);
+    void updateTolerance();
 
 private:
     int numberOfTriangles {0};
@@ -119,6 +119,11 @@ bool DlgSmoothing::smoothSelection() const
     return ui->checkBoxSelection->isChecked();
 }
 
+bool DlgSmoothing::parallel() const
+{
+    return ui->checkBoxParallel->isChecked();
+}
+
 void DlgSmoothing::onCheckBoxSelectionToggled(bool on)
 {
     Q_EMIT toggledSelection(on);
@@ -193,6 +198,7 @@ bool TaskSmoothing::accept()
         switch (widget->method()) {
             case MeshGui::DlgSmoothing::Taubin: {
                 MeshCore::TaubinSmoothing s(mm->getKernel());
+                s.SetJacobi(widget->parallel());
                 s.SetLambda(widget->lambdaStep());
                 s.SetMicro(widget->microStep());
                 if (widget->smoothSelection()) {
@@ -204,6 +210,7 @@ bool TaskSmoothing::accept()
             } break;
             case MeshGui::DlgSmoothing::Laplace: {
                 MeshCore::LaplaceSmoothing s(mm->getKernel());
+                s.SetJacobi(widget->parallel());
                 s.SetLambda(widget->lambdaStep());
                 if (widget->smoothSelection()) {
                     s.SmoothPoints(widget->iterations(), selection);
@@ -214,6 +221,7 @@ bool TaskSmoothing::accept()
             } break;
             case MeshGui::DlgSmoothing::MedianFilter: {
                 MeshCore::MedianFilterSmoothing s(mm->getKernel());
+                s.SetJacobi(widget->parallel());
                 if (widget->smoothSelection()) {
                     s.SmoothPoints(widget->iterations(), selection);
                 }
@@ -58,6 +58,7 @@ public:
     double microStep() const;
     Smooth method() const;
     bool smoothSelection() const;
+    bool parallel() const;
 
 private:
     void methodClicked(int);
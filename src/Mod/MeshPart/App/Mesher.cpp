@@ -225,7 +225,11 @@ Mesh::MeshObject* Mesher::createStandard() const
 {
     if (!shape.IsNull()) {
         BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        BRepMesh_IncrementalMesh aMesh(shape,
+                                       deflection,
+                                       relative,
+                                       angularDeflection,
+                                       /*isInParallel*/ true);
     }
 
     std::vector<Part::TopoShape::Domain> domains;
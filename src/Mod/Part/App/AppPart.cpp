@@ -115,6 +115,7 @@
 #include "SpherePy.h"
 #include "SurfaceOfExtrusionPy.h"
 #include "SurfaceOfRevolutionPy.h"
+#include "TessellationCache.h"
 #include "TopoShapeCompoundPy.h"
 #include "TopoShapeCompSolidPy.h"
 #include "TopoShapeEdgePy.h"
@@ -557,5 +558,8 @@ PyMOD_INIT_FUNC(Part)
 
     OCAF::ImportExportSettings::initialize();
 
+    // read the parameters of the tessellation cache in the main thread
+    Part::TessellationCache::instance();
+
     PyMOD_Return(partModule);
 }
@@ -28,44 +28,120 @@
 #include <Precision.hxx>
 #endif
 
+#include <atomic>
+#include <limits>
+#include <boost/functional/hash.hpp>
+
 #include "BRepMesh.h"
+#include <Base/Parallel.h>
 #include <Base/Tools.h>
 
 using namespace Part;
 
 namespace {
-struct MeshVertex
+/**
+ * A hash set of points that can be filled by several threads without locks. It uses open
+ * addressing with linear probing. A slot stores the index of a point plus one, 0 marks an
+ * empty slot. If equal points are inserted the slot keeps the lowest index, so the result
+ * doesn't depend on the order of insertion.
+ */
+class ConcurrentPointSet
 {
-    Base::Vector3d p;
-    std::size_t i = 0;
-
-    explicit MeshVertex(const Base::Vector3d& p)
-        : p(p)
+public:
+    explicit ConcurrentPointSet(const std::vector<Base::Vector3d>& points)
+        : points {points}
     {
+        std::size_t size = 16;
+        while (size < 2 * points.size()) {
+            size *= 2;
+        }
+        mask = size - 1;
+        slots = std::make_unique<std::atomic<std::size_t>[]>(size);
+        for (std::size_t i = 0; i < size; i++) {
+            slots[i].store(0, std::memory_order_relaxed);
+        }
     }
 
-    Base::Vector3d toPoint() const
+    void insert(std::size_t index)
     {
-        return p;
+        const Base::Vector3d& pnt = points[index];
+        std::size_t value = index + 1;
+        for (std::size_t pos = hash(pnt) & mask;; pos = (pos + 1) & mask) {
+            std::size_t current = slots[pos].load(std::memory_order_acquire);
+            if (current == 0) {
+                if (slots[pos].compare_exchange_strong(current, value,
+                                                       std::memory_order_acq_rel)) {
+                    return;
+                }
+            }
+            // a slot is only replaced by an equal point, so 'current' can be compared
+            if (isEqual(points[current - 1], pnt)) {
+                while (value < current
+                       && !slots[pos].compare_exchange_weak(current, value,
+                                                            std::memory_order_acq_rel)) {
+                }
+                return;
+            }
+        }
     }
 
-    bool operator < (const MeshVertex &v) const
+    std::size_t find(std::size_t index) const
     {
-        if (p.x != v.p.x) {
-            return p.x < v.p.x;
-        }
-        if (p.y != v.p.y) {
-            return p.y < v.p.y;
-        }
-        if (p.z != v.p.z) {
-            return p.z < v.p.z;
+        const Base::Vector3d& pnt = points[index];
+        for (std::size_t pos = hash(pnt) & mask;; pos = (pos + 1) & mask) {
+            std::size_t current = slots[pos].load(std::memory_order_acquire);
+            if (current == 0) {
+                return index;
+            }
+            if (isEqual(points[current - 1], pnt)) {
+                return current - 1;
+            }
         }
+    }
 
-        // points are equal
-        return false;
+private:
+    static bool isEqual(const Base::Vector3d& p1, const Base::Vector3d& p2)
+    {
+        return p1.x == p2.x && p1.y == p2.y && p1.z == p2.z;
     }
+
+    static std::size_t hash(const Base::Vector3d& pnt)
+    {
+        // adding 0.0 maps -0.0 to 0.0 so that equal points have the same hash
+        std::size_t seed = 0;
+        boost::hash_combine(seed, pnt.x + 0.0);
+        boost::hash_combine(seed, pnt.y + 0.0);
+        boost::hash_combine(seed, pnt.z + 0.0);
+        return seed;
+    }
+
+private:
+    const std::vector<Base::Vector3d>& points;
+    std::unique_ptr<std::atomic<std::size_t>[]> slots;
+    std::size_t mask = 0;
 };
 
+/**
+ * Returns for each point the index of the first point with exactly the same coordinates.
+ */
+std::vector<std::size_t> mergeEqualPoints(const std::vector<Base::Vector3d>& points)
+{
+    ConcurrentPointSet pointSet(points);
+    Base::parallelFor(points.size(), 0, [&pointSet](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            pointSet.insert(i);
+        }
+    });
+
+    std::vector<std::size_t> firstPoint(points.size());
+    Base::parallelFor(points.size(), 0, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            firstPoint[i] = pointSet.find(i);
+        }
+    });
+    return firstPoint;
+}
+
 class MergeVertex
 {
 public:
@@ -252,53 +328,86 @@ void BRepMesh::getFacesFromDomains(const std::vector<Domain>& domains,
                                    std::vector<Base::Vector3d>& points,
                                    std::vector<Facet>& faces)
 {
-    std::size_t numFaces = 0;
-    for (const auto& it : domains) {
-        numFaces += it.facets.size();
+    std::vector<std::size_t> pointOffsets(domains.size() + 1);
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        pointOffsets[i + 1] = pointOffsets[i] + domains[i].points.size();
     }
-    faces.reserve(numFaces);
-
-    std::set<MeshVertex> vertices;
-    auto addVertex = [&vertices](const Base::Vector3d& pnt, uint32_t& pointIndex) {
-        MeshVertex vertex(pnt);
-        vertex.i = vertices.size();
-        auto it = vertices.insert(vertex);
-        pointIndex = it.first->i;
-    };
-
-    for (const auto & domain : domains) {
-        std::size_t numDomainFaces = 0;
-        for (const Facet& df : domain.facets) {
-            Facet face;
-
-            // 1st vertex
-            addVertex(domain.points[df.I1], face.I1);
-
-            // 2nd vertex
-            addVertex(domain.points[df.I2], face.I2);
-
-            // 3rd vertex
-            addVertex(domain.points[df.I3], face.I3);
-
-            // make sure that we don't insert invalid facets
-            if (face.I1 != face.I2 &&
-                face.I2 != face.I3 &&
-                face.I3 != face.I1) {
-                faces.push_back(face);
-                numDomainFaces++;
+
+    // Points on shared edges occur in several domains. Map each point to the first one
+    // with the same coordinates.
+    std::size_t numPoints = pointOffsets.back();
+    std::vector<Base::Vector3d> allPoints(numPoints);
+    Base::parallelFor(domains.size(), 0, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            std::copy(domains[i].points.begin(),
+                      domains[i].points.end(),
+                      allPoints.begin() + std::ptrdiff_t(pointOffsets[i]));
+        }
+    }, 1);
+
+    std::vector<std::size_t> firstPoint = mergeEqualPoints(allPoints);
+
+    // The points are numbered in the order they are used by the facets
+    const std::size_t unused = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> pointIndex(numPoints, unused);
+    std::size_t numMeshPoints = 0;
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        std::size_t offset = pointOffsets[i];
+        for (const Facet& df : domains[i].facets) {
+            for (uint32_t index : {df.I1, df.I2, df.I3}) {
+                std::size_t& pos = pointIndex[firstPoint[offset + index]];
+                if (pos == unused) {
+                    pos = numMeshPoints++;
+                }
             }
         }
-
-        domainSizes.push_back(numDomainFaces);
     }
 
-    std::vector<Base::Vector3d> meshPoints;
-    meshPoints.resize(vertices.size());
-    for (const auto & vertex : vertices) {
-        meshPoints[vertex.i] = vertex.toPoint();
-    }
+    std::vector<Base::Vector3d> meshPoints(numMeshPoints);
+    Base::parallelFor(numPoints, 0, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            if (firstPoint[i] == i && pointIndex[i] != unused) {
+                meshPoints[pointIndex[i]] = allPoints[i];
+            }
+        }
+    });
     points.swap(meshPoints);
 
+    // make sure that we don't insert invalid facets
+    std::vector<std::vector<Facet>> domainFaces(domains.size());
+    Base::parallelFor(domains.size(), 0, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            std::size_t offset = pointOffsets[i];
+            auto meshIndex = [&](uint32_t index) {
+                return uint32_t(pointIndex[firstPoint[offset + index]]);
+            };
+
+            std::vector<Facet>& domainFacets = domainFaces[i];
+            domainFacets.reserve(domains[i].facets.size());
+            for (const Facet& df : domains[i].facets) {
+                Facet face;
+                face.I1 = meshIndex(df.I1);
+                face.I2 = meshIndex(df.I2);
+                face.I3 = meshIndex(df.I3);
+                if (face.I1 != face.I2 &&
+                    face.I2 != face.I3 &&
+                    face.I3 != face.I1) {
+                    domainFacets.push_back(face);
+                }
+            }
+        }
+    }, 1);
+
+    std::size_t numFaces = 0;
+    for (const auto& it : domainFaces) {
+        numFaces += it.size();
+        domainSizes.push_back(it.size());
+    }
+    faces.reserve(faces.size() + numFaces);
+    for (const auto& it : domainFaces) {
+        faces.insert(faces.end(), it.begin(), it.end());
+    }
+
     MergeVertex merge(points, faces, Precision::Confusion());
     if (merge.hasDuplicatedPoints()) {
         merge.mergeDuplicatedPoints();
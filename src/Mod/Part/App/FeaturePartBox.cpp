@@ -52,12 +52,37 @@ short Box::mustExecute() const
     return Primitive::mustExecute();
 }
 
+void Box::executeConcurrent()
+{
+    double L = Length.getValue();
+    double W = Width.getValue();
+    double H = Height.getValue();
+
+    concurrentShape.Nullify();
+    if (L < Precision::Confusion() || W < Precision::Confusion() || H < Precision::Confusion())
+        return;
+
+    try {
+        BRepPrimAPI_MakeBox mkBox(L, W, H);
+        concurrentShape = mkBox.Shape();
+        concurrentSize.Set(L, W, H);
+    }
+    catch (Standard_Failure&) {
+        // execute() builds it again and reports the error
+    }
+}
+
 App::DocumentObjectExecReturn *Box::execute()
 {
     double L = Length.getValue();
     double W = Width.getValue();
     double H = Height.getValue();
 
+    TopoDS_Shape prebuilt;
+    if (concurrentSize == Base::Vector3d(L, W, H))
+        prebuilt = concurrentShape;
+    concurrentShape.Nullify();
+
     if (L < Precision::Confusion())
         return new App::DocumentObjectExecReturn("Length of box too small");
 
@@ -69,8 +94,11 @@ App::DocumentObjectExecReturn *Box::execute()
 
     try {
         // Build a box using the dimension attributes
-        BRepPrimAPI_MakeBox mkBox(L, W, H);
-        TopoDS_Shape ResultShape = mkBox.Shape();
+        TopoDS_Shape ResultShape = prebuilt;
+        if (ResultShape.IsNull()) {
+            BRepPrimAPI_MakeBox mkBox(L, W, H);
+            ResultShape = mkBox.Shape();
+        }
         this->Shape.setValue(ResultShape, false);
         return Primitive::execute();
     }
@@ -46,6 +46,12 @@ public:
     /// recalculate the Feature
     App::DocumentObjectExecReturn *execute() override;
     short mustExecute() const override;
+    /// a box only depends on its own dimensions
+    bool canExecuteConcurrently() const override {
+        return true;
+    }
+    /// build the box shape ahead of execute()
+    void executeConcurrent() override;
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override {
         return "PartGui::ViewProviderBox";
@@ -55,6 +61,11 @@ protected:
     /// get called by the container when a property has changed
     void onChanged (const App::Property* prop) override;
     //@}
+
+private:
+    /// shape built by executeConcurrent() for the given size, used by execute()
+    TopoDS_Shape concurrentShape;
+    Base::Vector3d concurrentSize;
 };
 
 } //namespace Part
@@ -46,6 +46,9 @@
 #include <Base/Stream.h>
 #include <Base/Writer.h>
 
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "PropertyTopoShape.h"
@@ -66,6 +69,24 @@ PropertyPartShape::~PropertyPartShape() = default;
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    clearDeferred();
+    assignShape(sh);
+    hasSetValue();
+    _Ver.clear();
+}
+
+void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
+{
+    aboutToSetValue();
+    clearDeferred();
+    assignShape(sh, resetElementMap);
+    hasSetValue();
+    _Ver.clear();
+}
+
+/// Assign the shape without notifying the container
+void PropertyPartShape::assignShape(const TopoShape& sh)
+{
     _Shape = sh;
     auto obj = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer());
     if(obj) {
@@ -80,28 +101,25 @@ void PropertyPartShape::setValue(const TopoShape& sh)
             _Shape.hashChildMaps();
         }
     }
-    hasSetValue();
-    _Ver.clear();
 }
 
-void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
+void PropertyPartShape::assignShape(const TopoDS_Shape& sh, bool resetElementMap)
 {
-    aboutToSetValue();
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj)
         _Shape.Tag = obj->getID();
     _Shape.setShape(sh,resetElementMap);
-    hasSetValue();
-    _Ver.clear();
 }
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    restoreDeferred();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    restoreDeferred();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -118,12 +136,14 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    restoreDeferred();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    restoreDeferred();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -150,16 +170,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
 {
+    restoreDeferred();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    restoreDeferred();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    restoreDeferred();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -167,6 +190,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject()
 {
+    restoreDeferred();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -212,6 +236,14 @@ App::Property *PropertyPartShape::Copy() const
 //        prop->_Shape = this->_Shape.makeElementCopy();
 //    } else
 //        prop->_Shape = this->_Shape;
+    {
+        // no need to restore the shape for a copy, e.g. for undo
+        std::lock_guard<std::mutex> lock(_DeferredMutex);
+        if (_Deferred) {
+            prop->_Deferred = _Deferred;
+            prop->_IsDeferred = true;
+        }
+    }
     prop->_Shape = this->_Shape;
     prop->_Ver = this->_Ver;
     return prop;
@@ -221,6 +253,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = Base::freecad_dynamic_cast<const PropertyPartShape>(&from);
     if(prop) {
+        prop->restoreDeferred();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -228,6 +261,11 @@ void PropertyPartShape::Paste(const App::Property &from)
 
 unsigned int PropertyPartShape::getMemSize () const
 {
+    if (_IsDeferred) {
+        std::lock_guard<std::mutex> lock(_DeferredMutex);
+        if (_Deferred)
+            return static_cast<unsigned int>(_Deferred->getDataSize());
+    }
     return _Shape.getMemSize();
 }
 
@@ -591,28 +629,136 @@ void PropertyPartShape::loadFromStream(Base::Reader &reader)
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
+    if (_IsDeferred) {
+        std::shared_ptr<Base::DeferredFile> file;
+        {
+            std::lock_guard<std::mutex> lock(_DeferredMutex);
+            file = _Deferred;
+        }
+        // Unchanged since restore, write the data back if the format matches
+        if (file
+            && Base::FileInfo(file->getFileName()).hasExtension("bin")
+                == writer.getMode("BinaryBrep")) {
+            writer.Stream() << file->inflate();
+            return;
+        }
+        restoreDeferred();
+    }
+
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull())
         return;
     TopoDS_Shape myShape = _Shape.getShape();
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General");
+    // Storing the triangulation makes the file bigger but avoids meshing the shape again
+    // when the document is opened
+    bool withTriangles = hGrp->GetBool("SaveTessellation", false);
     if (writer.getMode("BinaryBrep")) {
         TopoShape shape;
         shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+        shape.exportBinary(writer.Stream(), withTriangles);
     }
     else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+        bool direct = hGrp->GetBool("DirectAccess", true);
         if (!direct) {
             saveToFile(writer);
         }
         else {
             TopoShape shape;
             shape.setShape(myShape);
-            shape.exportBrep(writer.Stream());
+            shape.exportBrep(writer.Stream(), withTriangles);
+        }
+    }
+}
+
+bool PropertyPartShape::canSaveDocFileConcurrently(const Base::Writer &writer) const
+{
+    // ASCII export is not reentrant, see also Gui::AutoSaver
+    if (!writer.getMode("BinaryBrep"))
+        return false;
+    // A deferred shape stored in another format is read in again by
+    // SaveDocFile(), and BRepTools::Read() is not reentrant either
+    if (_IsDeferred) {
+        std::lock_guard<std::mutex> lock(_DeferredMutex);
+        if (_Deferred && !Base::FileInfo(_Deferred->getFileName()).hasExtension("bin"))
+            return false;
+    }
+    return true;
+}
+
+bool PropertyPartShape::canCompressUndo() const
+{
+    // SaveDocFile() only writes the geometry, Copy() keeps the element map in
+    // memory, so only shapes without element map survive the round trip
+    return !_Shape.getElementMapSize();
+}
+
+bool PropertyPartShape::canDeferRestoreDocFile() const
+{
+    return true;
+}
+
+void PropertyPartShape::deferRestoreDocFile(const std::shared_ptr<Base::DeferredFile> &file)
+{
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    _Deferred = file;
+    _IsDeferred = true;
+}
+
+void PropertyPartShape::clearDeferred()
+{
+    if (_IsDeferred) {
+        std::lock_guard<std::mutex> lock(_DeferredMutex);
+        _Deferred.reset();
+        _IsDeferred = false;
+    }
+}
+
+/**
+ * Restore the shape kept by deferRestoreDocFile() the same way as
+ * RestoreDocFile() does, but silently, i.e. without notifying the container,
+ * as the value is logically unchanged.
+ */
+void PropertyPartShape::restoreDeferred() const
+{
+    // _IsDeferred is only cleared once _Shape is assigned, so the shape can be
+    // used without locking when it is false
+    if (!_IsDeferred.load(std::memory_order_acquire))
+        return;
+    std::lock_guard<std::mutex> lock(_DeferredMutex);
+    if (!_IsDeferred.load(std::memory_order_relaxed))
+        return;
+
+    auto self = const_cast<PropertyPartShape*>(this);
+    try {
+        std::string data = _Deferred->inflate();
+        boost::iostreams::stream<boost::iostreams::array_source> str(data.data(), data.size());
+        if (Base::FileInfo(_Deferred->getFileName()).hasExtension("bin")) {
+            TopoShape shape;
+            if (!data.empty())
+                shape.importBinary(str);
+            self->assignShape(shape);
+        }
+        else {
+            TopoDS_Shape shape;
+            if (!data.empty()) {
+                str.exceptions(std::istream::failbit | std::istream::badbit);
+                BRep_Builder builder;
+                BRepTools::Read(shape, str, builder);
+            }
+            self->assignShape(shape, true);
         }
     }
+    catch (...) {
+        Base::Console().Error("Failed to restore shape of %s from %s\n",
+            getFullName().c_str(), _Deferred->getFileName().c_str());
+    }
+    self->_Ver.clear();
+
+    self->_Deferred.reset();
+    _IsDeferred.store(false, std::memory_order_release);
 }
 
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
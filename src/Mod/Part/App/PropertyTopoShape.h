@@ -23,7 +23,10 @@
 #ifndef PART_PROPERTYTOPOSHAPE_H
 #define PART_PROPERTYTOPOSHAPE_H
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <App/PropertyGeo.h>
@@ -89,7 +92,11 @@ public:
     virtual void beforeSave() const override;
 
     void SaveDocFile (Base::Writer &writer) const override;
+    bool canSaveDocFileConcurrently(const Base::Writer &writer) const override;
+    bool canCompressUndo() const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canDeferRestoreDocFile() const override;
+    void deferRestoreDocFile(const std::shared_ptr<Base::DeferredFile> &file) override;
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
@@ -110,12 +117,20 @@ private:
     void saveToFile(Base::Writer &writer) const;
     void loadFromFile(Base::Reader &reader);
     void loadFromStream(Base::Reader &reader);
+    void restoreDeferred() const;
+    void clearDeferred();
+    void assignShape(const TopoShape& sh);
+    void assignShape(const TopoDS_Shape& sh, bool resetElementMap);
 
 private:
     TopoShape _Shape;
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+    /// Shape data not yet restored, see deferRestoreDocFile()
+    std::shared_ptr<Base::DeferredFile> _Deferred;
+    mutable std::atomic<bool> _IsDeferred {false};
+    mutable std::mutex _DeferredMutex;
 };
 
 struct PartExport ShapeHistory {
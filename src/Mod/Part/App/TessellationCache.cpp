@@ -0,0 +1,727 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <sstream>
+#include <vector>
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
+#include <Standard_Version.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iterator>
+#include <QCryptographicHash>
+#include <TColStd_HArray1OfReal.hxx>
+
+#include <App/Application.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Base/Stream.h>
+
+#include "TessellationCache.h"
+#include "TopoShape.h"
+
+
+using namespace Part;
+
+namespace
+{
+
+constexpr uint32_t tessellationMagic = 0x53544346;  // FCTS
+constexpr uint32_t tessellationVersion = 1;
+constexpr std::size_t maxContentHashes = 1024;
+
+template<typename T>
+void put(std::ostream& out, T value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));  // NOLINT
+}
+
+template<typename T>
+bool get(std::istream& in, T& value)
+{
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));  // NOLINT
+    return static_cast<bool>(in);
+}
+
+std::string sha1(const std::string& data)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+#if QT_VERSION < QT_VERSION_CHECK(6, 3, 0)
+    hash.addData(data.c_str(), static_cast<int>(data.size()));
+#else
+    hash.addData(QByteArrayView(data.c_str(), data.size()));
+#endif
+    return hash.result().toHex().constData();
+}
+
+ParameterGrp::handle getParameter()
+{
+    return App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+}
+
+void writeTriangulation(std::ostream& out, const Handle(Poly_Triangulation) & tria)
+{
+    int nbNodes = tria->NbNodes();
+    int nbTriangles = tria->NbTriangles();
+    bool hasUV = tria->HasUVNodes();
+    put<int32_t>(out, nbNodes);
+    put<int32_t>(out, nbTriangles);
+    put<uint8_t>(out, hasUV ? 1 : 0);
+    put<double>(out, tria->Deflection());
+
+#if OCC_VERSION_HEX < 0x070600
+    const TColgp_Array1OfPnt& nodes = tria->Nodes();
+    const Poly_Array1OfTriangle& triangles = tria->Triangles();
+#endif
+    for (int i = 1; i <= nbNodes; i++) {
+#if OCC_VERSION_HEX < 0x070600
+        const gp_Pnt& p = nodes(i);
+#else
+        gp_Pnt p = tria->Node(i);
+#endif
+        put<double>(out, p.X());
+        put<double>(out, p.Y());
+        put<double>(out, p.Z());
+    }
+    if (hasUV) {
+        for (int i = 1; i <= nbNodes; i++) {
+#if OCC_VERSION_HEX < 0x070600
+            const gp_Pnt2d& uv = tria->UVNodes()(i);
+#else
+            gp_Pnt2d uv = tria->UVNode(i);
+#endif
+            put<double>(out, uv.X());
+            put<double>(out, uv.Y());
+        }
+    }
+    for (int i = 1; i <= nbTriangles; i++) {
+        Standard_Integer n1 {}, n2 {}, n3 {};
+#if OCC_VERSION_HEX < 0x070600
+        triangles(i).Get(n1, n2, n3);
+#else
+        tria->Triangle(i).Get(n1, n2, n3);
+#endif
+        put<int32_t>(out, n1);
+        put<int32_t>(out, n2);
+        put<int32_t>(out, n3);
+    }
+}
+
+Handle(Poly_Triangulation) readTriangulation(std::istream& in)
+{
+    int32_t nbNodes {}, nbTriangles {};
+    uint8_t hasUV {};
+    double deflection {};
+    if (!get(in, nbNodes) || !get(in, nbTriangles) || !get(in, hasUV) || !get(in, deflection)
+        || nbNodes < 0 || nbTriangles < 0) {
+        return {};
+    }
+
+    Handle(Poly_Triangulation) tria = new Poly_Triangulation(nbNodes, nbTriangles, hasUV != 0);
+    tria->Deflection(deflection);
+    for (int i = 1; i <= nbNodes; i++) {
+        double x {}, y {}, z {};
+        if (!get(in, x) || !get(in, y) || !get(in, z)) {
+            return {};
+        }
+#if OCC_VERSION_HEX < 0x070600
+        tria->ChangeNodes()(i).SetCoord(x, y, z);
+#else
+        tria->SetNode(i, gp_Pnt(x, y, z));
+#endif
+    }
+    if (hasUV != 0) {
+        for (int i = 1; i <= nbNodes; i++) {
+            double u {}, v {};
+            if (!get(in, u) || !get(in, v)) {
+                return {};
+            }
+#if OCC_VERSION_HEX < 0x070600
+            tria->ChangeUVNodes()(i).SetCoord(u, v);
+#else
+            tria->SetUVNode(i, gp_Pnt2d(u, v));
+#endif
+        }
+    }
+    for (int i = 1; i <= nbTriangles; i++) {
+        int32_t n1 {}, n2 {}, n3 {};
+        if (!get(in, n1) || !get(in, n2) || !get(in, n3)) {
+            return {};
+        }
+        if (std::min({n1, n2, n3}) < 1 || std::max({n1, n2, n3}) > nbNodes) {
+            return {};
+        }
+#if OCC_VERSION_HEX < 0x070600
+        tria->ChangeTriangles()(i).Set(n1, n2, n3);
+#else
+        tria->SetTriangle(i, Poly_Triangle(n1, n2, n3));
+#endif
+    }
+    return tria;
+}
+
+void writePolygon(std::ostream& out, const Handle(Poly_PolygonOnTriangulation) & poly)
+{
+    // a polygon has at least two nodes, so zero marks a missing polygon
+    if (poly.IsNull()) {
+        put<int32_t>(out, 0);
+        return;
+    }
+
+    const TColStd_Array1OfInteger& nodes = poly->Nodes();
+    put<int32_t>(out, nodes.Length());
+    put<double>(out, poly->Deflection());
+    for (Standard_Integer i = nodes.Lower(); i <= nodes.Upper(); i++) {
+        put<int32_t>(out, nodes(i));
+    }
+
+    bool hasParameters = poly->HasParameters();
+    put<uint8_t>(out, hasParameters ? 1 : 0);
+    if (hasParameters) {
+        const TColStd_Array1OfReal& params = poly->Parameters()->Array1();
+        for (Standard_Integer i = params.Lower(); i <= params.Upper(); i++) {
+            put<double>(out, params(i));
+        }
+    }
+}
+
+bool readPolygon(std::istream& in, int nbNodes, Handle(Poly_PolygonOnTriangulation) & poly)
+{
+    int32_t length {};
+    if (!get(in, length) || length < 0) {
+        return false;
+    }
+    if (length == 0) {
+        poly.Nullify();
+        return true;
+    }
+
+    double deflection {};
+    if (!get(in, deflection)) {
+        return false;
+    }
+    TColStd_Array1OfInteger nodes(1, length);
+    for (int i = 1; i <= length; i++) {
+        int32_t node {};
+        if (!get(in, node) || node < 1 || node > nbNodes) {
+            return false;
+        }
+        nodes(i) = node;
+    }
+
+    uint8_t hasParameters {};
+    if (!get(in, hasParameters)) {
+        return false;
+    }
+    if (hasParameters != 0) {
+        TColStd_Array1OfReal params(1, length);
+        for (int i = 1; i <= length; i++) {
+            double value {};
+            if (!get(in, value)) {
+                return false;
+            }
+            params(i) = value;
+        }
+        poly = new Poly_PolygonOnTriangulation(nodes, params);
+    }
+    else {
+        poly = new Poly_PolygonOnTriangulation(nodes);
+    }
+    poly->Deflection(deflection);
+    return true;
+}
+
+// Checks if all faces have a triangulation at least as fine as the deflection
+bool isMeshed(const TopTools_IndexedMapOfShape& faceMap, double deflection)
+{
+    for (int i = 1; i <= faceMap.Extent(); i++) {
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) tria = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), loc);
+        if (tria.IsNull() || tria->Deflection() > deflection) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+class TessellationCache::ParameterObserver: public ParameterGrp::ObserverType
+{
+public:
+    explicit ParameterObserver(TessellationCache& cache)
+        : cache(cache)
+        , handle(getParameter())
+    {
+        handle->Attach(this);
+    }
+    ~ParameterObserver() override
+    {
+        handle->Detach(this);
+    }
+
+    void OnChange(Base::Subject<const char*>& /*caller*/, const char* /*reason*/) override
+    {
+        cache.readParameters();
+    }
+
+    ParameterObserver(const ParameterObserver&) = delete;
+    ParameterObserver(ParameterObserver&&) = delete;
+    ParameterObserver& operator=(const ParameterObserver&) = delete;
+    ParameterObserver& operator=(ParameterObserver&&) = delete;
+
+private:
+    TessellationCache& cache;
+    ParameterGrp::handle handle;
+};
+
+TessellationCache& TessellationCache::instance()
+{
+    static TessellationCache cache;
+    return cache;
+}
+
+TessellationCache::TessellationCache()
+    : observer(std::make_unique<ParameterObserver>(*this))
+{
+    readParameters();
+}
+
+TessellationCache::~TessellationCache() = default;
+
+void TessellationCache::readParameters()
+{
+    ParameterGrp::handle hGrp = getParameter();
+    enabled = hGrp->GetBool("TessellationCache", false);
+    minFaces = static_cast<int>(hGrp->GetInt("TessellationCacheMinFaces", 20));
+    std::size_t megabytes = hGrp->GetUnsigned("TessellationCacheMemory", 256);
+    memoryLimit = megabytes * 1024 * 1024;
+    long disk = hGrp->GetInt("TessellationCacheDisk", 1024);
+    diskLimit = disk > 0 ? static_cast<std::size_t>(disk) * 1024 * 1024 : 0;
+}
+
+std::string TessellationCache::getDirectory() const
+{
+    if (diskLimit == 0) {
+        return {};
+    }
+    return App::Application::getUserCachePath() + "Tessellation/";
+}
+
+std::string TessellationCache::getKey(const TopoDS_Shape& shape,
+                                      double deflection,
+                                      double angle) const
+{
+    if (shape.IsNull() || !enabled) {
+        return {};
+    }
+
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    if (faceMap.Extent() < minFaces || isMeshed(faceMap, deflection)) {
+        return {};
+    }
+
+    std::string content = getContentHash(shape);
+    if (content.empty()) {
+        return {};
+    }
+
+    std::ostringstream str;
+    str << content << ' ' << std::setprecision(12) << deflection << ' ' << angle;
+    return sha1(str.str());
+}
+
+std::string TessellationCache::getContentHash(const TopoDS_Shape& shape) const
+{
+    // The placement is not part of the hash because the triangulation is independent of it
+    TopoDS_Shape unlocated = shape.Located(TopLoc_Location());
+    const TopoDS_TShape* tshape = unlocated.TShape().get();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = contentHashes.find(tshape);
+        if (it != contentHashes.end()) {
+            return it->second.second;
+        }
+    }
+
+    std::ostringstream str;
+    try {
+        TopoShape(unlocated).exportBinary(str);
+    }
+    catch (const Standard_Failure&) {
+        return {};
+    }
+    std::string hash = sha1(str.str());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // forget the shapes which are only referenced by this cache
+    for (auto it = contentHashes.begin(); it != contentHashes.end();) {
+        if (it->second.first.TShape()->GetRefCount() == 1) {
+            it = contentHashes.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    if (contentHashes.size() >= maxContentHashes) {
+        contentHashes.clear();
+    }
+    contentHashes.emplace(tshape, std::make_pair(unlocated, hash));
+    return hash;
+}
+
+bool TessellationCache::restore(const std::string& key, const TopoDS_Shape& shape)
+{
+    if (key.empty()) {
+        return false;
+    }
+
+    std::string data = find(key);
+    if (data.empty()) {
+        return false;
+    }
+
+    std::istringstream str(data);
+    try {
+        return read(shape, str);
+    }
+    catch (const Standard_Failure&) {
+        return false;
+    }
+}
+
+void TessellationCache::store(const std::string& key, const TopoDS_Shape& shape)
+{
+    if (key.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (index.find(key) != index.end()) {
+            return;
+        }
+    }
+
+    std::ostringstream str;
+    try {
+        write(shape, str);
+    }
+    catch (const Standard_Failure&) {
+        return;
+    }
+
+    std::string data = str.str();
+    insert(key, data);
+    writeFile(key, data);
+}
+
+void TessellationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    memoryUsage = 0;
+
+    std::string dir = getDirectory();
+    if (!dir.empty()) {
+        Base::FileInfo(dir).deleteDirectoryRecursive();
+    }
+    diskUsage = 0;
+    diskScanned = false;
+}
+
+std::string TessellationCache::find(const std::string& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+    }
+
+    std::string dir = getDirectory();
+    if (dir.empty()) {
+        return {};
+    }
+
+    Base::FileInfo fi(dir + key);
+    if (!fi.isReadable()) {
+        return {};
+    }
+
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!data.empty()) {
+        insert(key, data);
+    }
+    return data;
+}
+
+void TessellationCache::insert(const std::string& key, const std::string& data)
+{
+    std::size_t limit = memoryLimit;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.find(key) != index.end()) {
+        return;
+    }
+
+    entries.emplace_front(key, data);
+    index[key] = entries.begin();
+    memoryUsage += key.size() + data.size();
+
+    // remove the least recently used entries but keep the new one
+    while (memoryUsage > limit && entries.size() > 1) {
+        const Entry& last = entries.back();
+        memoryUsage -= last.first.size() + last.second.size();
+        index.erase(last.first);
+        entries.pop_back();
+    }
+}
+
+void TessellationCache::writeFile(const std::string& key, const std::string& data)
+{
+    std::string dir = getDirectory();
+    if (dir.empty()) {
+        return;
+    }
+
+    Base::FileInfo di(dir);
+    if (!di.exists() && !di.createDirectories()) {
+        return;
+    }
+
+    Base::FileInfo fi(dir + key);
+    if (fi.exists()) {
+        return;
+    }
+
+    // Write to a temporary file first so that no other process reads a partial file
+    Base::FileInfo tmp(Base::FileInfo::getTempFileName(key.c_str(), dir.c_str()));
+    {
+        Base::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(data.c_str(), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            file.close();
+            tmp.deleteFile();
+            return;
+        }
+    }
+    if (!tmp.renameFile(fi.filePath().c_str())) {
+        tmp.deleteFile();
+        return;
+    }
+
+    std::size_t limit = diskLimit;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!diskScanned) {
+        diskUsage = 0;
+        for (const auto& it : di.getDirectoryContent()) {
+            diskUsage += it.size();
+        }
+        diskScanned = true;
+    }
+    else {
+        diskUsage += data.size();
+    }
+
+    if (diskUsage > limit) {
+        pruneDirectory(limit);
+    }
+}
+
+void TessellationCache::pruneDirectory(std::size_t limit)
+{
+    // remove the oldest files until 90% of the limit is reached
+    std::vector<Base::FileInfo> files = Base::FileInfo(getDirectory()).getDirectoryContent();
+    std::vector<std::pair<Base::TimeInfo, Base::FileInfo>> sorted;
+    sorted.reserve(files.size());
+    diskUsage = 0;
+    for (const auto& it : files) {
+        sorted.emplace_back(it.lastModified(), it);
+        diskUsage += it.size();
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    std::size_t target = limit / 10 * 9;
+    for (const auto& it : sorted) {
+        if (diskUsage <= target) {
+            break;
+        }
+        std::size_t size = it.second.size();
+        if (it.second.deleteFile()) {
+            diskUsage -= size;
+        }
+    }
+}
+
+void TessellationCache::write(const TopoDS_Shape& shape, std::ostream& out)
+{
+    put<uint32_t>(out, tessellationMagic);
+    put<uint32_t>(out, tessellationVersion);
+
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    put<int32_t>(out, faceMap.Extent());
+    for (int i = 1; i <= faceMap.Extent(); i++) {
+        const TopoDS_Face& face = TopoDS::Face(faceMap(i));
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) tria = BRep_Tool::Triangulation(face, loc);
+        put<uint8_t>(out, tria.IsNull() ? 0 : 1);
+        if (tria.IsNull()) {
+            continue;
+        }
+
+        writeTriangulation(out, tria);
+
+        // the polygons of the edges on the triangulation
+        int numEdges = 0;
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            numEdges++;
+        }
+        put<int32_t>(out, numEdges);
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+            writePolygon(out, BRep_Tool::PolygonOnTriangulation(edge, tria, loc));
+        }
+    }
+}
+
+bool TessellationCache::read(const TopoDS_Shape& shape, std::istream& in)
+{
+    uint32_t magic {}, version {};
+    if (!get(in, magic) || !get(in, version) || magic != tessellationMagic
+        || version != tessellationVersion) {
+        return false;
+    }
+
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    int32_t numFaces {};
+    if (!get(in, numFaces) || numFaces != faceMap.Extent()) {
+        return false;
+    }
+
+    struct FaceData
+    {
+        Handle(Poly_Triangulation) tria;
+        std::vector<Handle(Poly_PolygonOnTriangulation)> polygons;
+    };
+
+    // Read everything first so that the shape is unchanged if the data is invalid
+    std::vector<FaceData> faces(numFaces);
+    for (int i = 1; i <= numFaces; i++) {
+        uint8_t hasTria {};
+        if (!get(in, hasTria)) {
+            return false;
+        }
+        if (hasTria == 0) {
+            continue;
+        }
+
+        FaceData& data = faces[i - 1];
+        data.tria = readTriangulation(in);
+        if (data.tria.IsNull()) {
+            return false;
+        }
+
+        int numEdges = 0;
+        for (TopExp_Explorer xp(faceMap(i), TopAbs_EDGE); xp.More(); xp.Next()) {
+            numEdges++;
+        }
+        int32_t count {};
+        if (!get(in, count) || count != numEdges) {
+            return false;
+        }
+        data.polygons.resize(numEdges);
+        for (auto& poly : data.polygons) {
+            if (!readPolygon(in, data.tria->NbNodes(), poly)) {
+                return false;
+            }
+        }
+    }
+
+    BRep_Builder builder;
+    for (int i = 1; i <= numFaces; i++) {
+        const FaceData& data = faces[i - 1];
+        if (data.tria.IsNull()) {
+            continue;
+        }
+
+        const TopoDS_Face& face = TopoDS::Face(faceMap(i));
+        builder.UpdateFace(face, data.tria);
+
+        // A seam edge appears twice in a face and has a polygon for each orientation
+        std::vector<std::pair<TopoDS_Edge, Handle(Poly_PolygonOnTriangulation)>> seams;
+        std::size_t index = 0;
+        for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next(), index++) {
+            const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+            const Handle(Poly_PolygonOnTriangulation)& poly = data.polygons[index];
+            if (poly.IsNull()) {
+                continue;
+            }
+            if (!BRep_Tool::IsClosed(edge, face)) {
+                builder.UpdateEdge(edge, poly, data.tria, face.Location());
+                continue;
+            }
+
+            auto it = std::find_if(seams.begin(), seams.end(), [&edge](const auto& seam) {
+                return seam.first.IsSame(edge);
+            });
+            if (it == seams.end()) {
+                seams.emplace_back(edge, poly);
+            }
+            else if (edge.Orientation() == TopAbs_REVERSED) {
+                builder.UpdateEdge(it->first, it->second, poly, data.tria, face.Location());
+            }
+            else {
+                builder.UpdateEdge(edge, poly, it->second, data.tria, face.Location());
+            }
+        }
+    }
+
+    return true;
+}
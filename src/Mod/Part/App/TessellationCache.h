@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_TESSELLATIONCACHE_H
+#define PART_TESSELLATIONCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+
+namespace Part
+{
+
+/**
+ * The TessellationCache keeps the triangulations of the faces of shapes so that a shape with
+ * the same geometry doesn't need to be meshed again, e.g. after a recompute or when a document
+ * is opened. The key is a hash of the BRep data of the shape without its placement and the
+ * deflection parameters. The hash of the BRep data is computed once per TShape, FreeCAD doesn't
+ * modify the geometry of a shape after it has been built.
+ *
+ * The triangulations are kept in memory and in the directory 'Tessellation' of the user cache
+ * path. Restoring them attaches them to the faces of a shape with the same content, so a
+ * following BRepMesh_IncrementalMesh reuses them and does nothing.
+ *
+ * The cache is configured in the parameter group Mod/Part/General:
+ * - TessellationCache: enables the cache (default: false)
+ * - TessellationCacheMinFaces: shapes with fewer faces are meshed without the cache, as
+ *   hashing them costs more than meshing them (default: 20)
+ * - TessellationCacheMemory: the memory limit in MB (default: 256)
+ * - TessellationCacheDisk: the disk limit in MB, 0 disables the disk cache (default: 1024)
+ *
+ * The parameters are read when the cache is created, on module initialization, and then
+ * whenever they change. So the meshing threads never access the parameter groups.
+ *
+ * All methods are thread safe.
+ */
+class PartExport TessellationCache
+{
+public:
+    static TessellationCache& instance();
+
+    /**
+     * Returns the key of \a shape for the given deflection parameters. The key is empty if the
+     * cache is disabled, if the shape has too few faces or if all faces of the shape already
+     * have a triangulation that is fine enough.
+     */
+    std::string getKey(const TopoDS_Shape& shape, double deflection, double angle) const;
+    /**
+     * Attaches the cached triangulation to the faces and edges of \a shape.
+     * Returns false if \a key is empty or not in the cache.
+     */
+    bool restore(const std::string& key, const TopoDS_Shape& shape);
+    /** Adds the triangulation of the faces of \a shape to the cache. */
+    void store(const std::string& key, const TopoDS_Shape& shape);
+    /** Removes all entries from memory and from disk. */
+    void clear();
+
+    /** Writes the triangulation of the faces and edges of \a shape to \a out. */
+    static void write(const TopoDS_Shape& shape, std::ostream& out);
+    /** Reads the triangulation written by write() and attaches it to \a shape.
+     * Returns false if the data doesn't fit to the shape.
+     */
+    static bool read(const TopoDS_Shape& shape, std::istream& in);
+
+    ~TessellationCache();
+
+    TessellationCache(const TessellationCache&) = delete;
+    TessellationCache(TessellationCache&&) = delete;
+    TessellationCache& operator=(const TessellationCache&) = delete;
+    TessellationCache& operator=(TessellationCache&&) = delete;
+
+private:
+    TessellationCache();
+
+    void readParameters();
+    std::string getDirectory() const;
+    std::string getContentHash(const TopoDS_Shape& shape) const;
+    std::string find(const std::string& key);
+    void insert(const std::string& key, const std::string& data);
+    void writeFile(const std::string& key, const std::string& data);
+    void pruneDirectory(std::size_t limit);
+
+private:
+    class ParameterObserver;
+    using Entry = std::pair<std::string, std::string>;
+
+    std::unique_ptr<ParameterObserver> observer;
+    std::atomic<bool> enabled {false};
+    std::atomic<int> minFaces {0};
+    std::atomic<std::size_t> memoryLimit {0};  // in bytes
+    std::atomic<std::size_t> diskLimit {0};    // in bytes, 0 disables the disk cache
+
+    mutable std::mutex mutex;
+    std::list<Entry> entries;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::size_t memoryUsage {0};
+    std::size_t diskUsage {0};
+    bool diskScanned {false};
+    // The hash of the BRep data of the shapes by their TShape. The unlocated shape is kept
+    // with the hash so that the address of its TShape isn't reused by another one.
+    mutable std::unordered_map<const TopoDS_TShape*, std::pair<TopoDS_Shape, std::string>>
+        contentHashes;
+};
+
+}  // namespace Part
+
+#endif  // PART_TESSELLATIONCACHE_H
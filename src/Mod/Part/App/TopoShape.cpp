@@ -166,6 +166,7 @@
 #include <Base/Builder3D.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/Parallel.h>
 #include <Base/Placement.h>
 #include <Base/Tools.h>
 #include <Base/Reader.h>
@@ -181,6 +182,7 @@
 #include "modelRefine.h"
 #include "PartPyCXX.h"
 #include "ProgressIndicator.h"
+#include "TessellationCache.h"
 #include "Tools.h"
 #include "TopoShapeCompoundPy.h"
 #include "TopoShapeCompSolidPy.h"
@@ -232,6 +234,24 @@ inline double defaultAngularDeflection(double linearTolerance) {
     return std::min(0.1, linearTolerance * 5 + 0.005);
 }
 
+/**
+ * Meshes the faces of \a shape with the default angular deflection. The triangulation is
+ * taken from the TessellationCache if the same shape has been meshed before.
+ */
+static void meshShape(const TopoDS_Shape& shape, double deflection)
+{
+    double angle = defaultAngularDeflection(deflection);
+    TessellationCache& cache = TessellationCache::instance();
+    std::string key = cache.getKey(shape, deflection, angle);
+    if (!cache.restore(key, shape)) {
+        BRepMesh_IncrementalMesh aMesh(shape, deflection,
+                                       /*isRelative*/ Standard_False,
+                                       /*theAngDeflection*/ angle,
+                                       /*isInParallel*/ true);
+        cache.store(key, shape);
+    }
+}
+
 // ------------------------------------------------
 
 NullShapeException::NullShapeException()
@@ -942,7 +962,7 @@ void TopoShape::exportBrep(const char *filename) const
 #endif
 }
 
-void TopoShape::exportBrep(std::ostream& out) const
+void TopoShape::exportBrep(std::ostream& out, bool withTriangles) const
 {
     // See TopTools_FormatVersion of OCCT 7.6
     enum {
@@ -950,14 +970,14 @@ void TopoShape::exportBrep(std::ostream& out) const
         VERSION_2 = 2,
         VERSION_3 = 3
     };
-    BRepTools_ShapeSet SS(Standard_False);
+    BRepTools_ShapeSet SS(withTriangles ? Standard_True : Standard_False);
     SS.SetFormatNb(VERSION_1);
     SS.Add(this->_Shape);
     SS.Write(out);
     SS.Write(this->_Shape, out);
 }
 
-void TopoShape::exportBinary(std::ostream& out) const
+void TopoShape::exportBinary(std::ostream& out, bool withTriangles) const
 {
     // See BinTools_FormatVersion of OCCT 7.6
     enum {
@@ -968,7 +988,12 @@ void TopoShape::exportBinary(std::ostream& out) const
     };
 
     // An example how to use BinTools_ShapeSet can be found in BinMNaming_NamedShapeDriver.cxx
+#if OCC_VERSION_HEX < 0x070600
+    BinTools_ShapeSet theShapeSet(withTriangles ? Standard_True : Standard_False);
+#else
     BinTools_ShapeSet theShapeSet;
+    theShapeSet.SetWithTriangles(withTriangles ? Standard_True : Standard_False);
+#endif
     theShapeSet.SetFormatNb(VERSION_3);
     if (this->_Shape.IsNull()) {
         theShapeSet.Add(this->_Shape);
@@ -997,11 +1022,7 @@ void TopoShape::dump(std::ostream& out) const
 void TopoShape::exportStl(const char *filename, double deflection) const
 {
     StlAPI_Writer writer;
-    BRepMesh_IncrementalMesh aMesh(this->_Shape, deflection,
-                                   /*isRelative*/ Standard_False,
-                                   /*theAngDeflection*/
-                                   defaultAngularDeflection(deflection),
-                                   /*isInParallel*/ true);
+    meshShape(this->_Shape, deflection);
     writer.Write(this->_Shape,encodeFilename(filename).c_str());
 }
 
@@ -3292,26 +3313,27 @@ TopoDS_Shape TopoShape::removeSplitter() const
 
 void TopoShape::getDomains(std::vector<Domain>& domains) const
 {
-    std::size_t countFaces = 0;
+    std::vector<TopoDS_Face> faces;
     for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
-        ++countFaces;
+        faces.push_back(TopoDS::Face(xp.Current()));
     }
-    domains.reserve(countFaces);
 
-    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
-        TopoDS_Face face = TopoDS::Face(xp.Current());
+    // For a face that cannot be meshed an empty domain is appended.
+    // It's important for some algorithms (e.g. color mapping) that the numbers of
+    // faces and domains match
+    std::size_t offset = domains.size();
+    domains.resize(offset + faces.size());
 
-        std::vector<gp_Pnt> points;
-        std::vector<Poly_Triangle> facets;
-        if (!Tools::getTriangulation(face, points, facets)) {
-            // For a face that cannot be meshed append an empty domain.
-            // It's important for some algorithms (e.g. color mapping) that the numbers of
-            // faces and domains match
-            Domain domain;
-            domains.push_back(domain);
-        }
-        else {
-            Domain domain;
+    // The triangulations are only read, so the faces can be handled in parallel
+    Base::parallelFor(faces.size(), 0, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            std::vector<gp_Pnt> points;
+            std::vector<Poly_Triangle> facets;
+            if (!Tools::getTriangulation(faces[i], points, facets)) {
+                continue;
+            }
+
+            Domain& domain = domains[offset + i];
             // copy the points
             domain.points.reserve(points.size());
             for (const auto& it : points) {
@@ -3332,10 +3354,8 @@ void TopoShape::getDomains(std::vector<Domain>& domains) const
                 tria.I3 = N3;
                 domain.facets.push_back(tria);
             }
-
-            domains.push_back(domain);
         }
-    }
+    }, 1);
 }
 
 void TopoShape::getFacesFromDomains(const std::vector<Domain>& domains,
@@ -3363,11 +3383,7 @@ void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
         return;
 
     // get the meshes of all faces and then merge them
-    BRepMesh_IncrementalMesh aMesh(this->_Shape, accuracy,
-                                   /*isRelative*/ Standard_False,
-                                   /*theAngDeflection*/
-                                   defaultAngularDeflection(accuracy),
-                                   /*isInParallel*/ true);
+    meshShape(this->_Shape, accuracy);
     std::vector<Domain> domains;
     getDomains(domains);
     getFacesFromDomains(domains, aPoints, aTopo);
@@ -26,6 +26,7 @@
 # include <Bnd_Box.hxx>
 # include <BRep_Tool.hxx>
 # include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeVertex.hxx>
 # include <BRepExtrema_DistShapeShape.hxx>
 # include <BRepMesh_IncrementalMesh.hxx>
@@ -49,7 +50,10 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 
 # include <QAction>
+# include <QApplication>
 # include <QMenu>
+# include <QThread>
+# include <QThreadPool>
 # include <sstream>
 
 # include <Inventor/SoPickedPoint.h>
@@ -70,6 +74,14 @@
 # include <boost/algorithm/string/predicate.hpp>
 #endif
 
+#include <atomic>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+#if OCC_VERSION_HEX >= 0x070500
+# include <Message_ProgressIndicator.hxx>
+# include <Message_ProgressScope.hxx>
+#endif
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Console.h>
@@ -83,6 +95,7 @@
 #include <Gui/SoFCUnifiedSelection.h>
 #include <Gui/ViewParams.h>
 #include <Mod/Part/App/ShapeMapHasher.h>
+#include <Mod/Part/App/TessellationCache.h>
 #include <Mod/Part/App/Tools.h>
 
 #include "ViewProviderExt.h"
@@ -247,6 +260,7 @@ ViewProviderPartExt::ViewProviderPartExt()
 
 ViewProviderPartExt::~ViewProviderPartExt()
 {
+    tessellationJob.reset();
     pcFaceBind->unref();
     pcLineBind->unref();
     pcPointBind->unref();
@@ -923,63 +937,149 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
     }
 }
 
-void ViewProviderPartExt::updateVisual()
+namespace PartGui {
+
+/// The parameters to tessellate a shape
+struct TessellationParams
 {
-    Gui::SoUpdateVBOAction action;
-    action.apply(this->faceset);
+    double deviation;
+    double angularDeflection;
+    bool normalsFromUV;
+};
 
-    // Clear selection
-    Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
-    saction.apply(this->faceset);
-    saction.apply(this->lineset);
-    saction.apply(this->nodeset);
+/// The tessellation of a shape in the layout of the Coin nodes
+struct ShapeVisual
+{
+    std::vector<SbVec3f> points;
+    std::vector<SbVec3f> normals;
+    std::vector<int32_t> faceIndex;
+    std::vector<int32_t> partIndex;
+    std::vector<int32_t> lineIndex;
+    int nodeIndex {0};
+    std::string error;
+
+    // book keeping
+    double time {0.0};
+    int numFaces {0};
+    int numEdges {0};
+};
+
+/// A tessellation running in the background
+class TessellationJob
+{
+public:
+    using Watcher = QFutureWatcher<std::shared_ptr<ShapeVisual>>;
+
+    TessellationJob()
+        : canceled(std::make_shared<std::atomic<bool>>(false))
+        , watcher(new Watcher())
+    {}
+    ~TessellationJob()
+    {
+        // the job may be deleted by the watcher's finished signal
+        canceled->store(true);
+        watcher->disconnect();
+        watcher->deleteLater();
+    }
 
-    // Clear highlighting
-    Gui::SoHighlightElementAction haction;
-    haction.apply(this->faceset);
-    haction.apply(this->lineset);
-    haction.apply(this->nodeset);
+    TessellationJob(const TessellationJob&) = delete;
+    TessellationJob(TessellationJob&&) = delete;
+    TessellationJob& operator=(const TessellationJob&) = delete;
+    TessellationJob& operator=(TessellationJob&&) = delete;
 
-    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
-    if (cShape.IsNull()) {
-        coords  ->point      .setNum(0);
-        norm    ->vector     .setNum(0);
-        faceset ->coordIndex .setNum(0);
-        faceset ->partIndex  .setNum(0);
-        lineset ->coordIndex .setNum(0);
-        nodeset ->startIndex .setValue(0);
-        VisualTouched = false;
-        return;
+    std::shared_ptr<std::atomic<bool>> canceled;
+    Watcher* watcher;
+};
+
+}
+
+namespace {
+
+#if OCC_VERSION_HEX >= 0x070500
+// Stops BRepMesh_IncrementalMesh when the tessellation has been canceled
+class CancelIndicator : public Message_ProgressIndicator
+{
+public:
+    explicit CancelIndicator(const std::atomic<bool>& canceled)
+        : canceled(canceled)
+    {}
+    Standard_Boolean UserBreak() override
+    {
+        return canceled.load();
     }
 
+protected:
+    void Show(const Message_ProgressScope&, const Standard_Boolean) override
+    {}
+
+private:
+    const std::atomic<bool>& canceled;
+};
+#endif
+
+// The jobs are queued in their own pool, BRepMesh itself uses further threads
+QThreadPool* tessellationPool()
+{
+    static QThreadPool* pool = []() {
+        auto pool = new QThreadPool(qApp);
+        pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+        return pool;
+    }();
+    return pool;
+}
+
+// A copy shares the geometry and an existing triangulation with the shape. Meshing it
+// doesn't write to the shape that is owned by the document and possibly read elsewhere.
+TopoDS_Shape copyForTessellation(const TopoDS_Shape& shape)
+{
+    return BRepBuilderAPI_Copy(shape, Standard_False, Standard_True).Shape();
+}
+
+bool isCanceled(const std::atomic<bool>* canceled)
+{
+    return canceled && canceled->load();
+}
+
+/*!
+ * Tessellates the shape and fills \a visual. It doesn't access any Coin node and can
+ * run in a worker thread. Returns false if \a canceled has been set in the meantime.
+ */
+bool computeVisual(TopoDS_Shape cShape,
+                   const PartGui::TessellationParams& params,
+                   PartGui::ShapeVisual& visual,
+                   const std::atomic<bool>* canceled)
+{
     // time measurement and book keeping
     Base::TimeElapsed start_time;
-    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
+    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0;
     std::set<int> faceEdges;
 
-    try {
-        // calculating the deflection value
-        Bnd_Box bounds;
-        BRepBndLib::Add(cShape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * Deviation.getValue();
-
-        // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
-        // should be displayed.
-        if (deflection < gp::Resolution()) {
-            deflection = Precision::Confusion();
-        }
+    // calculating the deflection value
+    Bnd_Box bounds;
+    BRepBndLib::Add(cShape, bounds);
+    bounds.SetGap(0.0);
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * params.deviation;
+
+    // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
+    // should be displayed.
+    if (deflection < gp::Resolution()) {
+        deflection = Precision::Confusion();
+    }
 
-        // For very big objects the computed deflection can become very high and thus leads to a useless
-        // tessellation. To avoid this the upper limit is set to 20.0
-        // See also forum: https://forum.freecad.org/viewtopic.php?t=77521
-        deflection = std::min(deflection, 20.0);
+    // For very big objects the computed deflection can become very high and thus leads to a useless
+    // tessellation. To avoid this the upper limit is set to 20.0
+    // See also forum: https://forum.freecad.org/viewtopic.php?t=77521
+    deflection = std::min(deflection, 20.0);
 
-        // create or use the mesh on the data structure
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+    // create or use the mesh on the data structure
+    Standard_Real AngDeflectionRads = params.angularDeflection;
 
+    // reuse the triangulation of a shape with the same geometry if there is one
+    Part::TessellationCache& cache = Part::TessellationCache::instance();
+    std::string cacheKey = cache.getKey(cShape, deflection, AngDeflectionRads);
+    if (!cache.restore(cacheKey, cShape)) {
 #if OCC_VERSION_HEX >= 0x070500
         IMeshTools_Parameters meshParams;
         meshParams.Deflection = deflection;
@@ -988,313 +1088,454 @@ void ViewProviderPartExt::updateVisual()
         meshParams.InParallel = Standard_True;
         meshParams.AllowQualityDecrease = Standard_True;
 
-        BRepMesh_IncrementalMesh(cShape, meshParams);
+        if (canceled) {
+            Handle(Message_ProgressIndicator) indicator = new CancelIndicator(*canceled);
+            BRepMesh_IncrementalMesh(cShape, meshParams, indicator->Start());
+        }
+        else {
+            BRepMesh_IncrementalMesh(cShape, meshParams);
+        }
 #else
         BRepMesh_IncrementalMesh(cShape, deflection, Standard_False, AngDeflectionRads, Standard_True);
 #endif
 
-        // We must reset the location here because the transformation data
-        // are set in the placement property
-        TopLoc_Location aLoc;
-        cShape.Location(aLoc);
+        if (isCanceled(canceled)) {
+            return false;
+        }
+        cache.store(cacheKey, cShape);
+    }
 
-        // count triangles and nodes in the mesh
-        TopTools_IndexedMapOfShape faceMap;
-        TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
-        for (int i=1; i <= faceMap.Extent(); i++) {
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
-            if (mesh.IsNull()) {
-                mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
-            }
-            // Note: we must also count empty faces
-            if (!mesh.IsNull()) {
-                numTriangles += mesh->NbTriangles();
-                numNodes     += mesh->NbNodes();
-                numNorms     += mesh->NbNodes();
-            }
+    // We must reset the location here because the transformation data
+    // are set in the placement property
+    TopLoc_Location aLoc;
+    cShape.Location(aLoc);
+
+    // count triangles and nodes in the mesh
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
+    for (int i=1; i <= faceMap.Extent(); i++) {
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
+        if (mesh.IsNull()) {
+            mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
+        }
+        // Note: we must also count empty faces
+        if (!mesh.IsNull()) {
+            numTriangles += mesh->NbTriangles();
+            numNodes     += mesh->NbNodes();
+            numNorms     += mesh->NbNodes();
+        }
 
-            TopExp_Explorer xp;
-            for (xp.Init(faceMap(i),TopAbs_EDGE);xp.More();xp.Next()) {
-                faceEdges.insert(Part::ShapeMapHasher{}(xp.Current()));
-            }
-            numFaces++;
+        TopExp_Explorer xp;
+        for (xp.Init(faceMap(i),TopAbs_EDGE);xp.More();xp.Next()) {
+            faceEdges.insert(Part::ShapeMapHasher{}(xp.Current()));
         }
+        numFaces++;
+    }
 
-        // get an indexed map of edges
-        TopTools_IndexedMapOfShape edgeMap;
-        TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
-
-         // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
-        std::map<int, std::vector<int32_t> > lineSetMap;
-        std::set<int>          edgeIdxSet;
-        std::vector<int32_t>   edgeVector;
-
-        // count and index the edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            edgeIdxSet.insert(i);
-            numEdges++;
-
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            // Note: The assumption that if for an edge BRep_Tool::Polygon3D
-            // returns a valid object is wrong. This e.g. happens for ruled
-            // surfaces which gets created by two edges or wires.
-            // So, we have to store the hashes of the edges associated to a face.
-            // If the hash of a given edge is not in this list we know it's really
-            // a free edge.
-            int hash = Part::ShapeMapHasher{}(aEdge);
-            if (faceEdges.find(hash) == faceEdges.end()) {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    int nbNodesInEdge = aPoly->NbNodes();
-                    numNodes += nbNodesInEdge;
-                }
+    // get an indexed map of edges
+    TopTools_IndexedMapOfShape edgeMap;
+    TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
+
+     // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
+    std::map<int, std::vector<int32_t> > lineSetMap;
+    std::set<int>          edgeIdxSet;
+    std::vector<int32_t>   edgeVector;
+
+    // count and index the edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        edgeIdxSet.insert(i);
+        numEdges++;
+
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        // Note: The assumption that if for an edge BRep_Tool::Polygon3D
+        // returns a valid object is wrong. This e.g. happens for ruled
+        // surfaces which gets created by two edges or wires.
+        // So, we have to store the hashes of the edges associated to a face.
+        // If the hash of a given edge is not in this list we know it's really
+        // a free edge.
+        int hash = Part::ShapeMapHasher{}(aEdge);
+        if (faceEdges.find(hash) == faceEdges.end()) {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                int nbNodesInEdge = aPoly->NbNodes();
+                numNodes += nbNodesInEdge;
             }
         }
+    }
 
-        // handling of the vertices
-        TopTools_IndexedMapOfShape vertexMap;
-        TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
-        numNodes += vertexMap.Extent();
-
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
-        // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
-
-        int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
-        for (int i=1; i <= faceMap.Extent(); i++, ii++) {
-            TopLoc_Location aLoc;
-            const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
-            // get the mesh of the shape
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
-            if (mesh.IsNull()) {
-                mesh = Part::Tools::triangulationOfFace(actFace);
-            }
-            if (mesh.IsNull()) {
-                parts[ii] = 0;
-                continue;
-            }
+    // handling of the vertices
+    TopTools_IndexedMapOfShape vertexMap;
+    TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
+    numNodes += vertexMap.Extent();
+
+    // create memory for the nodes and indexes, the normal vectors are preset with null vector
+    visual.points.resize(numNodes);
+    visual.normals.assign(numNorms, SbVec3f(0.0,0.0,0.0));
+    visual.faceIndex.resize(numTriangles*4);
+    visual.partIndex.resize(numFaces);
+    SbVec3f* verts = visual.points.data();
+    SbVec3f* norms = visual.normals.data();
+    int32_t* index = visual.faceIndex.data();
+    int32_t* parts = visual.partIndex.data();
+
+    int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
+    for (int i=1; i <= faceMap.Extent(); i++, ii++) {
+        if (isCanceled(canceled)) {
+            return false;
+        }
 
-            // getting the transformation of the shape/face
-            gp_Trsf myTransf;
-            Standard_Boolean identity = true;
-            if (!aLoc.IsIdentity()) {
-                identity = false;
-                myTransf = aLoc.Transformation();
-            }
+        TopLoc_Location aLoc;
+        const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
+        // get the mesh of the shape
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
+        if (mesh.IsNull()) {
+            mesh = Part::Tools::triangulationOfFace(actFace);
+        }
+        if (mesh.IsNull()) {
+            parts[ii] = 0;
+            continue;
+        }
 
-            // getting size of node and triangle array of this face
-            int nbNodesInFace = mesh->NbNodes();
-            int nbTriInFace   = mesh->NbTriangles();
-            // check orientation
-            TopAbs_Orientation orient = actFace.Orientation();
+        // getting the transformation of the shape/face
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!aLoc.IsIdentity()) {
+            identity = false;
+            myTransf = aLoc.Transformation();
+        }
 
+        // getting size of node and triangle array of this face
+        int nbNodesInFace = mesh->NbNodes();
+        int nbTriInFace   = mesh->NbTriangles();
+        // check orientation
+        TopAbs_Orientation orient = actFace.Orientation();
 
-            // cycling through the poly mesh
+
+        // cycling through the poly mesh
 #if OCC_VERSION_HEX < 0x070600
-            const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
-            const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
-            TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
+        const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
+        const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
+        TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
 #else
-            int numNodes =  mesh->NbNodes();
-            TColgp_Array1OfDir Normals (1, numNodes);
+        int numNodes =  mesh->NbNodes();
+        TColgp_Array1OfDir Normals (1, numNodes);
 #endif
-            if (NormalsFromUV)
-                Part::Tools::getPointNormals(actFace, mesh, Normals);
+        if (params.normalsFromUV)
+            Part::Tools::getPointNormals(actFace, mesh, Normals);
 
-            for (int g=1;g<=nbTriInFace;g++) {
-                // Get the triangle
-                Standard_Integer N1,N2,N3;
+        for (int g=1;g<=nbTriInFace;g++) {
+            // Get the triangle
+            Standard_Integer N1,N2,N3;
 #if OCC_VERSION_HEX < 0x070600
-                Triangles(g).Get(N1,N2,N3);
+            Triangles(g).Get(N1,N2,N3);
 #else
-                mesh->Triangle(g).Get(N1,N2,N3);
+            mesh->Triangle(g).Get(N1,N2,N3);
 #endif
 
-                // change orientation of the triangle if the face is reversed
-                if ( orient != TopAbs_FORWARD ) {
-                    Standard_Integer tmp = N1;
-                    N1 = N2;
-                    N2 = tmp;
-                }
+            // change orientation of the triangle if the face is reversed
+            if ( orient != TopAbs_FORWARD ) {
+                Standard_Integer tmp = N1;
+                N1 = N2;
+                N2 = tmp;
+            }
 
-                // get the 3 points of this triangle
+            // get the 3 points of this triangle
 #if OCC_VERSION_HEX < 0x070600
-                gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
+            gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
 #else
-                gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
+            gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
 #endif
 
-                // get the 3 normals of this triangle
-                gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
-                    NV1.SetXYZ(Normals(N1).XYZ());
-                    NV2.SetXYZ(Normals(N2).XYZ());
-                    NV3.SetXYZ(Normals(N3).XYZ());
-                }
-                else {
-                    gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
-                           v2(V2.X(),V2.Y(),V2.Z()),
-                           v3(V3.X(),V3.Y(),V3.Z());
-                    gp_Vec normal = (v2-v1)^(v3-v1);
-                    NV1 = normal;
-                    NV2 = normal;
-                    NV3 = normal;
-                }
+            // get the 3 normals of this triangle
+            gp_Vec NV1, NV2, NV3;
+            if (params.normalsFromUV) {
+                NV1.SetXYZ(Normals(N1).XYZ());
+                NV2.SetXYZ(Normals(N2).XYZ());
+                NV3.SetXYZ(Normals(N3).XYZ());
+            }
+            else {
+                gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
+                       v2(V2.X(),V2.Y(),V2.Z()),
+                       v3(V3.X(),V3.Y(),V3.Z());
+                gp_Vec normal = (v2-v1)^(v3-v1);
+                NV1 = normal;
+                NV2 = normal;
+                NV3 = normal;
+            }
 
-                // transform the vertices and normals to the place of the face
-                if (!identity) {
-                    V1.Transform(myTransf);
-                    V2.Transform(myTransf);
-                    V3.Transform(myTransf);
-                    if (NormalsFromUV) {
-                        NV1.Transform(myTransf);
-                        NV2.Transform(myTransf);
-                        NV3.Transform(myTransf);
-                    }
+            // transform the vertices and normals to the place of the face
+            if (!identity) {
+                V1.Transform(myTransf);
+                V2.Transform(myTransf);
+                V3.Transform(myTransf);
+                if (params.normalsFromUV) {
+                    NV1.Transform(myTransf);
+                    NV2.Transform(myTransf);
+                    NV3.Transform(myTransf);
                 }
-
-                // add the normals for all points of this triangle
-                norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
-                norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
-                norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
-
-                // set the vertices
-                verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
-                verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
-                verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
-
-                // set the index vector with the 3 point indexes and the end delimiter
-                index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
-                index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
-                index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
-                index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
             }
 
-            parts[ii] = nbTriInFace; // new part
-
-            // handling the edges lying on this face
-            TopExp_Explorer Exp;
-            for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
-                const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
-                // get the overall index of this edge
-                int edgeIndex = edgeMap.FindIndex(curEdge);
-                edgeVector.push_back((int32_t)edgeIndex-1);
-                // already processed this index ?
-                if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
-
-                    // this holds the indices of the edge's triangulation to the current polygon
-                    Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                    if (aPoly.IsNull())
-                        continue; // polygon does not exist
-
-                    // getting the indexes of the edge polygon
-                    const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                    for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
-                        int nodeIndex = indices(i);
-                        int index = faceNodeOffset+nodeIndex-1;
-                        lineSetMap[edgeIndex].push_back(index);
-
-                        // usually the coordinates for this edge are already set by the
-                        // triangles of the face this edge belongs to. However, there are
-                        // rare cases where some points are only referenced by the polygon
-                        // but not by any triangle. Thus, we must apply the coordinates to
-                        // make sure that everything is properly set.
+            // add the normals for all points of this triangle
+            norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
+            norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
+            norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
+
+            // set the vertices
+            verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
+            verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
+            verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
+
+            // set the index vector with the 3 point indexes and the end delimiter
+            index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
+            index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
+            index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
+            index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
+        }
+
+        parts[ii] = nbTriInFace; // new part
+
+        // handling the edges lying on this face
+        TopExp_Explorer Exp;
+        for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
+            const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
+            // get the overall index of this edge
+            int edgeIndex = edgeMap.FindIndex(curEdge);
+            edgeVector.push_back((int32_t)edgeIndex-1);
+            // already processed this index ?
+            if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
+
+                // this holds the indices of the edge's triangulation to the current polygon
+                Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
+                if (aPoly.IsNull())
+                    continue; // polygon does not exist
+
+                // getting the indexes of the edge polygon
+                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
+                for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
+                    int nodeIndex = indices(i);
+                    int index = faceNodeOffset+nodeIndex-1;
+                    lineSetMap[edgeIndex].push_back(index);
+
+                    // usually the coordinates for this edge are already set by the
+                    // triangles of the face this edge belongs to. However, there are
+                    // rare cases where some points are only referenced by the polygon
+                    // but not by any triangle. Thus, we must apply the coordinates to
+                    // make sure that everything is properly set.
 #if OCC_VERSION_HEX < 0x070600
-                        gp_Pnt p(Nodes(nodeIndex));
+                    gp_Pnt p(Nodes(nodeIndex));
 #else
-                        gp_Pnt p(mesh->Node(nodeIndex));
+                    gp_Pnt p(mesh->Node(nodeIndex));
 #endif
-                        if (!identity)
-                            p.Transform(myTransf);
-                        verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
-                    }
-
-                    // remove the handled edge index from the set
-                    edgeIdxSet.erase(edgeIndex);
+                    if (!identity)
+                        p.Transform(myTransf);
+                    verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
                 }
+
+                // remove the handled edge index from the set
+                edgeIdxSet.erase(edgeIndex);
             }
+        }
 
-            edgeVector.push_back(-1);
+        edgeVector.push_back(-1);
 
-            // counting up the per Face offsets
-            faceNodeOffset += nbNodesInFace;
-            faceTriaOffset += nbTriInFace;
-        }
+        // counting up the per Face offsets
+        faceNodeOffset += nbNodesInFace;
+        faceTriaOffset += nbTriInFace;
+    }
 
-        // handling of the free edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            Standard_Boolean identity = true;
-            gp_Trsf myTransf;
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            int hash = Part::ShapeMapHasher{}(aEdge);
-            if (faceEdges.find(hash) == faceEdges.end()) {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    if (!aLoc.IsIdentity()) {
-                        identity = false;
-                        myTransf = aLoc.Transformation();
-                    }
-
-                    const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
-                    int nbNodesInEdge = aPoly->NbNodes();
-
-                    gp_Pnt pnt;
-                    for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
-                        pnt = aNodes(j);
-                        if (!identity)
-                            pnt.Transform(myTransf);
-                        int index = faceNodeOffset+j-1;
-                        verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-                        lineSetMap[i].push_back(index);
-                    }
-
-                    faceNodeOffset += nbNodesInEdge;
+    // handling of the free edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        Standard_Boolean identity = true;
+        gp_Trsf myTransf;
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        int hash = Part::ShapeMapHasher{}(aEdge);
+        if (faceEdges.find(hash) == faceEdges.end()) {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                if (!aLoc.IsIdentity()) {
+                    identity = false;
+                    myTransf = aLoc.Transformation();
                 }
+
+                const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
+                int nbNodesInEdge = aPoly->NbNodes();
+
+                gp_Pnt pnt;
+                for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
+                    pnt = aNodes(j);
+                    if (!identity)
+                        pnt.Transform(myTransf);
+                    int index = faceNodeOffset+j-1;
+                    verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+                    lineSetMap[i].push_back(index);
+                }
+
+                faceNodeOffset += nbNodesInEdge;
             }
         }
+    }
 
-        nodeset->startIndex.setValue(faceNodeOffset);
-        for (int i=0; i<vertexMap.Extent(); i++) {
-            const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
-            gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
-            verts[faceNodeOffset+i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-        }
+    visual.nodeIndex = faceNodeOffset;
+    for (int i=0; i<vertexMap.Extent(); i++) {
+        const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
+        gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
+        verts[faceNodeOffset+i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+    }
+
+    // normalize all normals
+    for (int i = 0; i< numNorms ;i++)
+        norms[i].normalize();
+
+    for (const auto & it : lineSetMap) {
+        visual.lineIndex.insert(visual.lineIndex.end(), it.second.begin(), it.second.end());
+        visual.lineIndex.push_back(-1);
+    }
+
+    visual.time = Base::TimeElapsed::diffTimeF(start_time, Base::TimeElapsed());
+    visual.numFaces = numFaces;
+    visual.numEdges = numEdges;
+    return true;
+}
+
+// Like computeVisual() but an exception is reported as error of the visual
+bool tessellate(const TopoDS_Shape& shape,
+                const PartGui::TessellationParams& params,
+                PartGui::ShapeVisual& visual,
+                const std::atomic<bool>* canceled)
+{
+    try {
+        return computeVisual(shape, params, visual, canceled);
+    }
+    catch (const Standard_Failure& e) {
+        visual.error = e.GetMessageString();
+    }
+    catch (...) {
+        visual.error = "Unknown exception";
+    }
+    return true;
+}
+
+}
+
+void ViewProviderPartExt::updateVisual()
+{
+    // a running tessellation is outdated now
+    tessellationJob.reset();
+
+    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
+    if (cShape.IsNull()) {
+        applyVisual(ShapeVisual());
+        return;
+    }
+
+    TessellationParams params {Deviation.getValue(),
+                               AngularDeflection.getValue() / 180.0 * M_PI,
+                               NormalsFromUV};
+
+    // Large shapes can be tessellated in the background. Until the job has finished a
+    // coarse preview is shown. If an update is forced the caller expects the result at once.
+    ParameterGrp::handle hPart = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part");
+    bool background = hPart->GetBool("BackgroundTessellation", false) && !isUpdateForced();
+    if (background) {
+        TopTools_IndexedMapOfShape faceMap;
+        TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
+        background = faceMap.Extent() >= hPart->GetInt("BackgroundTessellationFaces", 100);
+    }
 
-        // normalize all normals
-        for (int i = 0; i< numNorms ;i++)
-            norms[i].normalize();
+    if (!background) {
+        ShapeVisual visual;
+        tessellate(cShape, params, visual, nullptr);
+        applyVisual(visual);
+        return;
+    }
 
-        std::vector<int32_t> lineSetCoords;
-        for (const auto & it : lineSetMap) {
-            lineSetCoords.insert(lineSetCoords.end(), it.second.begin(), it.second.end());
-            lineSetCoords.push_back(-1);
+    double previewFactor = hPart->GetFloat("TessellationPreviewFactor", 10.0);
+    if (previewFactor > 1.0) {
+        TessellationParams preview {params.deviation * previewFactor,
+                                    std::min(params.angularDeflection * previewFactor, M_PI / 2.0),
+                                    false};
+        ShapeVisual visual;
+        tessellate(copyForTessellation(cShape), preview, visual, nullptr);
+        applyVisual(visual);
+    }
+    else {
+        // keep the current representation until the job has finished
+        VisualTouched = false;
+    }
+
+    tessellationJob = std::make_unique<TessellationJob>();
+    TopoDS_Shape shape = copyForTessellation(cShape);
+    std::shared_ptr<std::atomic<bool>> canceled = tessellationJob->canceled;
+    QObject::connect(tessellationJob->watcher, &TessellationJob::Watcher::finished,
+                     tessellationJob->watcher, [this]() {
+        finishTessellation();
+    });
+    tessellationJob->watcher->setFuture(QtConcurrent::run(tessellationPool(),
+                                                          [shape, params, canceled]() {
+        auto visual = std::make_shared<ShapeVisual>();
+        if (!tessellate(shape, params, *visual, canceled.get())) {
+            return std::shared_ptr<ShapeVisual>();
         }
+        return visual;
+    }));
+}
+
+void ViewProviderPartExt::finishTessellation()
+{
+    std::unique_ptr<TessellationJob> job = std::move(tessellationJob);
+    if (!job) {
+        return;
+    }
+
+    std::shared_ptr<ShapeVisual> visual = job->watcher->result();
+    if (visual) {
+        applyVisual(*visual);
+    }
+}
 
-        // preset the index vector size
-        numLines =  lineSetCoords.size();
+void ViewProviderPartExt::applyVisual(const ShapeVisual& visual)
+{
+    Gui::SoUpdateVBOAction action;
+    action.apply(this->faceset);
+
+    // Clear selection
+    Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
+    saction.apply(this->faceset);
+    saction.apply(this->lineset);
+    saction.apply(this->nodeset);
+
+    // Clear highlighting
+    Gui::SoHighlightElementAction haction;
+    haction.apply(this->faceset);
+    haction.apply(this->lineset);
+    haction.apply(this->nodeset);
+
+    if (!visual.error.empty()) {
+        FC_ERR("Cannot compute Inventor representation for the shape of "
+               << pcObject->getFullName() << ": " << visual.error);
+    }
+    else {
+        // All nodes are filled at once so that no inconsistent state gets rendered
+        int numLines = static_cast<int>(visual.lineIndex.size());
+        coords  ->point      .setNum(static_cast<int>(visual.points.size()));
+        norm    ->vector     .setNum(static_cast<int>(visual.normals.size()));
+        faceset ->coordIndex .setNum(static_cast<int>(visual.faceIndex.size()));
+        faceset ->partIndex  .setNum(static_cast<int>(visual.partIndex.size()));
         lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
+        nodeset ->startIndex .setValue(visual.nodeIndex);
 
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
+        std::copy(visual.points.begin(), visual.points.end(), coords->point.startEditing());
+        std::copy(visual.normals.begin(), visual.normals.end(), norm->vector.startEditing());
+        std::copy(visual.faceIndex.begin(), visual.faceIndex.end(), faceset->coordIndex.startEditing());
+        std::copy(visual.partIndex.begin(), visual.partIndex.end(), faceset->partIndex.startEditing());
+        std::copy(visual.lineIndex.begin(), visual.lineIndex.end(), lineset->coordIndex.startEditing());
 
         // end the editing of the nodes
         coords  ->point       .finishEditing();
@@ -1302,22 +1543,16 @@ void ViewProviderPartExt::updateVisual()
         faceset ->coordIndex  .finishEditing();
         faceset ->partIndex   .finishEditing();
         lineset ->coordIndex  .finishEditing();
-    }
-    catch (const Standard_Failure& e) {
-        FC_ERR("Cannot compute Inventor representation for the shape of "
-               << pcObject->getFullName() << ": " << e.GetMessageString());
-    }
-    catch (...) {
-        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
-    }
 
 #   ifdef FC_DEBUG
         // printing some information
-        Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeElapsed::diffTimeF(start_time,Base::TimeElapsed()));
-        Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",numFaces,numEdges,numNodes,numTriangles,numLines);
-#   else
-    (void)numEdges;
+        Base::Console().Log("ViewProvider update time: %f s\n",visual.time);
+        Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",
+                            visual.numFaces,visual.numEdges,static_cast<int>(visual.points.size()),
+                            static_cast<int>(visual.faceIndex.size()/4),numLines);
 #   endif
+    }
+
     VisualTouched = false;
 
     // The material has to be checked again
@@ -24,6 +24,7 @@
 #define PARTGUI_VIEWPROVIDERPARTEXT_H
 
 #include <map>
+#include <memory>
 
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
@@ -58,6 +59,8 @@ namespace PartGui {
 class SoBrepFaceSet;
 class SoBrepEdgeSet;
 class SoBrepPointSet;
+class TessellationJob;
+struct ShapeVisual;
 
 class PartGuiExport ViewProviderPartExt : public Gui::ViewProviderGeometryObject
 {
@@ -160,6 +163,9 @@ protected:
     /// get called by the container whenever a property has been changed
     void onChanged(const App::Property* prop) override;
     bool loadParameter();
+    /** Recomputes the representation of the shape. With the user parameter
+     * BackgroundTessellation set the tessellation of large shapes runs in the background.
+     */
     void updateVisual();
 
     // nodes for the data representation
@@ -182,9 +188,14 @@ protected:
     bool VisualTouched;
     bool NormalsFromUV;
 
+private:
+    void applyVisual(const ShapeVisual&);
+    void finishTessellation();
+
 private:
     // settings stuff
     int forceUpdateCount;
+    std::unique_ptr<TessellationJob> tessellationJob;
     static App::PropertyFloatConstraint::Constraints sizeRange;
     static App::PropertyFloatConstraint::Constraints tessRange;
     static App::PropertyQuantityConstraint::Constraints angDeflectionRange;
@@ -25,21 +25,29 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <numeric>
 #include <sstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
-#include <boost/regex.hpp>
 #endif
 
+#include <QFile>
+#include <QString>
+
 #include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
-#include <Base/Sequencer.h>
+#include <Base/Parallel.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
 #include "PointsAlgos.h"
 #include <E57Format.h>
@@ -47,6 +55,620 @@
 
 using namespace Points;
 
+namespace
+{
+
+// The text of ASCII files is split into chunks of about this size which are parsed in parallel
+constexpr std::size_t AsciiChunkSize = 1 << 20;
+
+/// Gives access to the content of a file. The file is mapped into memory, so that only the pages
+/// that are read are loaded, or read in if it cannot be mapped.
+class FileData
+{
+public:
+    explicit FileData(const std::string& filename)
+        : file(QString::fromUtf8(filename.c_str()))
+    {
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw Base::FileException("Failed to open file", filename.c_str());
+        }
+
+        qint64 fileSize = file.size();
+        if (fileSize > 0) {
+            mapped = file.map(0, fileSize);
+        }
+        if (mapped) {
+            bytes = reinterpret_cast<const char*>(mapped);  // NOLINT
+            length = static_cast<std::size_t>(fileSize);
+        }
+        else {
+            buffer = file.readAll();
+            bytes = buffer.constData();
+            length = static_cast<std::size_t>(buffer.size());
+        }
+    }
+    ~FileData()
+    {
+        if (mapped) {
+            file.unmap(mapped);
+        }
+    }
+
+    const char* data() const
+    {
+        return bytes;
+    }
+    std::size_t size() const
+    {
+        return length;
+    }
+
+    FileData(const FileData&) = delete;
+    FileData(FileData&&) = delete;
+    FileData& operator=(const FileData&) = delete;
+    FileData& operator=(FileData&&) = delete;
+
+private:
+    QFile file;
+    uchar* mapped {nullptr};
+    QByteArray buffer;
+    const char* bytes {nullptr};
+    std::size_t length {0};
+};
+
+/// Returns the offset of the data following the header that has been read from the stream
+std::size_t dataOffset(std::istream& inp, std::size_t fileSize)
+{
+    std::streamoff pos = inp.tellg();
+    if (pos < 0) {
+        return fileSize;
+    }
+    return std::min(static_cast<std::size_t>(pos), fileSize);
+}
+
+enum class FieldType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+/// Location of a field in binary data, the field of the point i starts at offset + i * stride
+struct BinaryField
+{
+    FieldType type;
+    std::size_t offset;
+    std::size_t stride;
+};
+
+std::size_t sizeOf(FieldType type)
+{
+    switch (type) {
+        case FieldType::Int8:
+        case FieldType::UInt8:
+            return 1;
+        case FieldType::Int16:
+        case FieldType::UInt16:
+            return 2;
+        case FieldType::Int32:
+        case FieldType::UInt32:
+        case FieldType::Float32:
+            return 4;
+        case FieldType::Float64:
+            return 8;
+    }
+    return 0;
+}
+
+template<typename T>
+double decodeValue(const char* data, bool swapByteOrder)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    if (swapByteOrder) {
+        Base::SwapEndian(value);
+    }
+    return static_cast<double>(value);
+}
+
+double decodeField(const char* data, FieldType type, bool swapByteOrder)
+{
+    switch (type) {
+        case FieldType::Int8:
+            return decodeValue<int8_t>(data, swapByteOrder);
+        case FieldType::UInt8:
+            return decodeValue<uint8_t>(data, swapByteOrder);
+        case FieldType::Int16:
+            return decodeValue<int16_t>(data, swapByteOrder);
+        case FieldType::UInt16:
+            return decodeValue<uint16_t>(data, swapByteOrder);
+        case FieldType::Int32:
+            return decodeValue<int32_t>(data, swapByteOrder);
+        case FieldType::UInt32:
+            return decodeValue<uint32_t>(data, swapByteOrder);
+        case FieldType::Float32:
+            return decodeValue<float>(data, swapByteOrder);
+        case FieldType::Float64:
+            return decodeValue<double>(data, swapByteOrder);
+    }
+    return 0.0;
+}
+
+/// Writes the fields of the points straight into the lists of a reader, without an intermediate
+/// copy of the whole data. Different points can be set from different threads.
+class PointSink
+{
+public:
+    enum class ColorFormat
+    {
+        None,
+        Uchar,        // red, green, blue and optional alpha in [0, 255]
+        Float,        // red, green, blue and optional alpha in [0, 1]
+        PackedUInt,   // ARGB packed into an unsigned integer
+        PackedFloat,  // ARGB packed into the bits of a float
+    };
+
+    explicit PointSink(const std::vector<std::string>& fields)
+        : fields(fields)
+        , x(find({"x"}))
+        , y(find({"y"}))
+        , z(find({"z"}))
+        , normalX(find({"normal_x", "nx"}))
+        , normalY(find({"normal_y", "ny"}))
+        , normalZ(find({"normal_z", "nz"}))
+        , greyValue(find({"intensity"}))
+    {}
+
+    /// Returns the index of the first of the names that is a field, or -1
+    int find(std::initializer_list<const char*> names) const
+    {
+        for (const char* name : names) {
+            auto it = std::find(fields.begin(), fields.end(), name);
+            if (it != fields.end()) {
+                return static_cast<int>(std::distance(fields.begin(), it));
+            }
+        }
+        return -1;
+    }
+
+    void setColors(ColorFormat format, int red, int green = -1, int blue = -1, int alpha = -1)
+    {
+        colorFormat = format;
+        colorFields = {red, green, blue, alpha};
+    }
+
+    std::size_t numFields() const
+    {
+        return fields.size();
+    }
+
+    /// Allocates the lists of the fields that are present, the lists of the others are left empty
+    void resize(std::size_t numPoints,
+                Points::PointKernel& points,
+                std::vector<Base::Vector3f>& normals,
+                std::vector<float>& intensity,
+                std::vector<App::Color>& colors)
+    {
+        if (x < 0 || y < 0 || z < 0) {
+            return;
+        }
+
+        points.resize(numPoints);
+        pointData = points.getBasicPoints().data();
+        if (normalX >= 0 && normalY >= 0 && normalZ >= 0) {
+            normals.resize(numPoints);
+            normalData = normals.data();
+        }
+        if (greyValue >= 0) {
+            intensity.resize(numPoints);
+            intensityData = intensity.data();
+        }
+        if (colorFormat != ColorFormat::None) {
+            colors.resize(numPoints);
+            colorData = colors.data();
+        }
+    }
+
+    /// Sets the point with the given index, \a value returns the value of a field
+    template<typename Value>
+    void set(std::size_t index, const Value& value) const
+    {
+        if (!pointData) {
+            return;
+        }
+
+        // NOLINTBEGIN
+        pointData[index].Set(static_cast<float>(value(x)),
+                             static_cast<float>(value(y)),
+                             static_cast<float>(value(z)));
+        if (normalData) {
+            normalData[index].Set(static_cast<float>(value(normalX)),
+                                  static_cast<float>(value(normalY)),
+                                  static_cast<float>(value(normalZ)));
+        }
+        if (intensityData) {
+            intensityData[index] = static_cast<float>(value(greyValue));
+        }
+        if (colorData) {
+            colorData[index] = color(value);
+        }
+        // NOLINTEND
+    }
+
+private:
+    template<typename Value>
+    App::Color color(const Value& value) const
+    {
+        switch (colorFormat) {
+            case ColorFormat::Uchar: {
+                float a = colorFields[3] >= 0 ? static_cast<float>(value(colorFields[3])) : 1.0F;
+                return App::Color(static_cast<float>(value(colorFields[0])) / 255.0F,
+                                  static_cast<float>(value(colorFields[1])) / 255.0F,
+                                  static_cast<float>(value(colorFields[2])) / 255.0F,
+                                  a / 255.0F);
+            }
+            case ColorFormat::Float: {
+                float a = colorFields[3] >= 0 ? static_cast<float>(value(colorFields[3])) : 1.0F;
+                return App::Color(static_cast<float>(value(colorFields[0])),
+                                  static_cast<float>(value(colorFields[1])),
+                                  static_cast<float>(value(colorFields[2])),
+                                  a);
+            }
+            case ColorFormat::PackedUInt: {
+                App::Color col;
+                col.setPackedARGB(static_cast<uint32_t>(value(colorFields[0])));
+                return col;
+            }
+            case ColorFormat::PackedFloat: {
+                static_assert(sizeof(float) == sizeof(uint32_t),
+                              "float and uint32_t have different sizes");
+                float f = static_cast<float>(value(colorFields[0]));
+                uint32_t packed {};
+                std::memcpy(&packed, &f, sizeof(packed));
+                App::Color col;
+                col.setPackedARGB(packed);
+                return col;
+            }
+            case ColorFormat::None:
+                break;
+        }
+        return App::Color();
+    }
+
+    const std::vector<std::string>& fields;
+    int x, y, z;
+    int normalX, normalY, normalZ;
+    int greyValue;
+    ColorFormat colorFormat {ColorFormat::None};
+    std::array<int, 4> colorFields {-1, -1, -1, -1};
+
+    Base::Vector3f* pointData {nullptr};
+    Base::Vector3f* normalData {nullptr};
+    float* intensityData {nullptr};
+    App::Color* colorData {nullptr};
+};
+
+/// Decodes the points of binary data in parallel blocks
+void decodeBinary(const char* data,
+                  std::size_t numPoints,
+                  const std::vector<BinaryField>& layout,
+                  bool swapByteOrder,
+                  const PointSink& sink)
+{
+    Base::parallelFor(numPoints, 0, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            sink.set(i, [&](int field) {
+                const BinaryField& f = layout[field];
+                return decodeField(data + f.offset + i * f.stride, f.type, swapByteOrder);
+            });
+        }
+    });
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isBlank(const char* first, const char* last)
+{
+    return std::all_of(first, last, isSpace);
+}
+
+/// Converts [first, last) into a number, the text must not contain anything else
+bool parseNumber(const char* first, const char* last, double& value)
+{
+    // strtod() needs a null-terminated string, which the mapped data is not
+    std::array<char, 64> buffer {};
+    auto length = static_cast<std::size_t>(last - first);
+    if (length >= buffer.size()) {
+        return boost::conversion::try_lexical_convert(first, length, value);
+    }
+
+    std::copy(first, last, buffer.begin());
+    char* end = nullptr;
+    value = std::strtod(buffer.data(), &end);
+    return length > 0 && end == buffer.data() + length;
+}
+
+/// Splits the text into chunks of about AsciiChunkSize bytes that end at line ends. The chunk c
+/// is [bounds[c], bounds[c + 1]).
+std::vector<const char*> splitLines(const char* begin, const char* end)
+{
+    std::size_t size = static_cast<std::size_t>(end - begin);
+    std::size_t numChunks = size / AsciiChunkSize + 1;
+    std::vector<const char*> bounds;
+    bounds.reserve(numChunks + 1);
+    bounds.push_back(begin);
+    for (std::size_t c = 1; c < numChunks; c++) {
+        const char* pos = std::max(bounds.back(), begin + c * (size / numChunks));
+        pos = std::find(pos, end, '\n');
+        if (pos == end) {
+            break;
+        }
+        bounds.push_back(pos + 1);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+/// Calls \a func(first, last) for each line of [begin, end)
+template<typename Func>
+void forEachLine(const char* begin, const char* end, Func func)
+{
+    while (begin < end) {
+        const char* eol = std::find(begin, end, '\n');
+        func(begin, eol);
+        begin = eol == end ? end : eol + 1;
+    }
+}
+
+/// Splits a line into the values of its fields, missing values are set to zero
+void parseFields(const char* first, const char* last, std::vector<double>& values)
+{
+    std::fill(values.begin(), values.end(), 0.0);
+    for (double& value : values) {
+        first = std::find_if_not(first, last, isSpace);
+        if (first == last) {
+            break;
+        }
+        const char* next = std::find_if(first, last, isSpace);
+        if (!parseNumber(first, next, value)) {
+            throw Base::BadFormatError("Invalid number");
+        }
+        first = next;
+    }
+}
+
+/// Parses the points of ASCII data in parallel chunks. Each non-empty line is a point, apart
+/// from the first \a skip lines.
+void parseAscii(const char* begin,
+                const char* end,
+                std::size_t skip,
+                std::size_t numPoints,
+                const PointSink& sink)
+{
+    std::vector<const char*> bounds = splitLines(begin, end);
+    std::size_t numChunks = bounds.size() - 1;
+
+    // count the lines of each chunk to know the index of the first point of the chunks
+    std::vector<std::size_t> firstLine(numChunks + 1, 0);
+    Base::parallelFor(
+        numChunks,
+        0,
+        [&](std::size_t first, std::size_t last) {
+            for (std::size_t c = first; c < last; c++) {
+                std::size_t count = 0;
+                forEachLine(bounds[c], bounds[c + 1], [&count](const char* bol, const char* eol) {
+                    if (!isBlank(bol, eol)) {
+                        count++;
+                    }
+                });
+                firstLine[c + 1] = count;
+            }
+        },
+        1);
+    std::partial_sum(firstLine.begin(), firstLine.end(), firstLine.begin());
+
+    Base::parallelFor(
+        numChunks,
+        0,
+        [&](std::size_t first, std::size_t last) {
+            std::vector<double> values(sink.numFields());
+            auto value = [&values](int field) {
+                return values[field];
+            };
+            for (std::size_t c = first; c < last; c++) {
+                std::size_t line = firstLine[c];
+                forEachLine(bounds[c], bounds[c + 1], [&](const char* bol, const char* eol) {
+                    if (isBlank(bol, eol)) {
+                        return;
+                    }
+                    if (line >= skip && line - skip < numPoints) {
+                        parseFields(bol, eol, values);
+                        sink.set(line - skip, value);
+                    }
+                    line++;
+                });
+            }
+        },
+        1);
+}
+
+std::vector<BinaryField> plyLayout(const std::vector<std::string>& types)
+{
+    std::vector<BinaryField> layout;
+    for (const auto& t : types) {
+        FieldType type {};
+        if (t == "char" || t == "int8") {
+            type = FieldType::Int8;
+        }
+        else if (t == "uchar" || t == "uint8") {
+            type = FieldType::UInt8;
+        }
+        else if (t == "short" || t == "int16") {
+            type = FieldType::Int16;
+        }
+        else if (t == "ushort" || t == "uint16") {
+            type = FieldType::UInt16;
+        }
+        else if (t == "int" || t == "int32") {
+            type = FieldType::Int32;
+        }
+        else if (t == "uint" || t == "uint32") {
+            type = FieldType::UInt32;
+        }
+        else if (t == "float" || t == "float32") {
+            type = FieldType::Float32;
+        }
+        else if (t == "double" || t == "float64") {
+            type = FieldType::Float64;
+        }
+        else {
+            throw Base::BadFormatError("Unexpected type");
+        }
+        layout.push_back({type, 0, 0});
+    }
+    return layout;
+}
+
+std::vector<BinaryField> pcdLayout(const std::vector<std::string>& types,
+                                   const std::vector<int>& sizes)
+{
+    std::vector<BinaryField> layout;
+    for (std::size_t j = 0; j < types.size(); j++) {
+        char t = types[j][0];
+        FieldType type {};
+        switch (sizes[j]) {
+            case 1:
+                if (t == 'I') {
+                    type = FieldType::Int8;
+                }
+                else if (t == 'U') {
+                    type = FieldType::UInt8;
+                }
+                else {
+                    throw Base::BadFormatError("Unexpected type");
+                }
+                break;
+            case 2:
+                if (t == 'I') {
+                    type = FieldType::Int16;
+                }
+                else if (t == 'U') {
+                    type = FieldType::UInt16;
+                }
+                else {
+                    throw Base::BadFormatError("Unexpected type");
+                }
+                break;
+            case 4:
+                if (t == 'I') {
+                    type = FieldType::Int32;
+                }
+                else if (t == 'U') {
+                    type = FieldType::UInt32;
+                }
+                else if (t == 'F') {
+                    type = FieldType::Float32;
+                }
+                else {
+                    throw Base::BadFormatError("Unexpected type");
+                }
+                break;
+            case 8:
+                if (t == 'F') {
+                    type = FieldType::Float64;
+                }
+                else {
+                    throw Base::BadFormatError("Unexpected type");
+                }
+                break;
+            default:
+                throw Base::BadFormatError("Unexpected type");
+        }
+        layout.push_back({type, 0, 0});
+    }
+    return layout;
+}
+
+/// Moves \a pos behind a number of the form [-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)? if there is one
+bool skipNumber(const char*& pos, const char* end)
+{
+    const char* p = pos;
+    if (p != end && (*p == '-' || *p == '+')) {
+        ++p;
+    }
+    const char* digits = p;
+    p = std::find_if_not(p, end, isDigit);
+    if (p != end && *p == '.') {
+        const char* fraction = ++p;
+        p = std::find_if_not(p, end, isDigit);
+        if (p == fraction) {
+            return false;
+        }
+    }
+    else if (p == digits) {
+        return false;
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        if (q != end && (*q == '-' || *q == '+')) {
+            ++q;
+        }
+        const char* exponent = q;
+        q = std::find_if_not(q, end, isDigit);
+        if (q != exponent) {
+            p = q;
+        }
+    }
+    pos = p;
+    return true;
+}
+
+/// Returns true if the line consists of three numbers separated by white space. If \a point
+/// isn't null the numbers are converted into it.
+bool parsePoint(const char* first, const char* last, Base::Vector3d* point)
+{
+    std::array<double, 3> coords {};
+    first = std::find_if_not(first, last, isSpace);
+    for (std::size_t i = 0; i < coords.size(); i++) {
+        if (i > 0) {
+            const char* next = std::find_if_not(first, last, isSpace);
+            if (next == first) {
+                return false;
+            }
+            first = next;
+        }
+        const char* number = first;
+        if (!skipNumber(first, last)) {
+            return false;
+        }
+        if (point && !parseNumber(number, first, coords[i])) {
+            return false;
+        }
+    }
+    if (std::find_if_not(first, last, isSpace) != last) {
+        return false;
+    }
+    if (point) {
+        point->Set(coords[0], coords[1], coords[2]);
+    }
+    return true;
+}
+
+}  // namespace
+
 void PointsAlgos::Load(PointKernel& points, const char* FileName)
 {
     Base::FileInfo File(FileName);
@@ -66,60 +688,51 @@ void PointsAlgos::Load(PointKernel& points, const char* FileName)
 
 void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                    "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                    "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    // boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    // boost::regex
-    // rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt = 0;
-    std::string line;
-    Base::FileInfo fi(FileName);
-
-    Base::ifstream tmp_str(fi, std::ios::in);
-
-    // estimating size
-    while (std::getline(tmp_str, line)) {
-        LineCnt++;
-    }
-
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq("Loading points...", LineCnt);
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+    // The file is mapped and split into chunks which are parsed in parallel. The first pass counts
+    // the points of each chunk (other lines like comments are skipped), so that the second pass
+    // can set them straight into the kernel.
+    FileData file(FileName);
+    std::vector<const char*> bounds = splitLines(file.data(), file.data() + file.size());
+    std::size_t numChunks = bounds.size() - 1;
 
     try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt, pt);
-                seq.next();
-                LineCnt++;
-            }
-        }
+        std::vector<std::size_t> offsets(numChunks + 1, 0);
+        Base::parallelFor(
+            numChunks,
+            0,
+            [&](std::size_t first, std::size_t last) {
+                for (std::size_t c = first; c < last; c++) {
+                    forEachLine(bounds[c], bounds[c + 1], [&](const char* bol, const char* eol) {
+                        if (parsePoint(bol, eol, nullptr)) {
+                            offsets[c + 1]++;
+                        }
+                    });
+                }
+            },
+            1);
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        points.resize(offsets.back());
+        Base::parallelFor(
+            numChunks,
+            0,
+            [&](std::size_t first, std::size_t last) {
+                Base::Vector3d pt;
+                for (std::size_t c = first; c < last; c++) {
+                    auto index = static_cast<int>(offsets[c]);
+                    forEachLine(bounds[c], bounds[c + 1], [&](const char* bol, const char* eol) {
+                        if (parsePoint(bol, eol, &pt)) {
+                            points.setPoint(index++, pt);
+                        }
+                    });
+                }
+            },
+            1);
     }
     catch (...) {
         points.clear();
         throw Base::BadFormatError("Reading in points failed.");
     }
-
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size()) {
-        points.erase(LineCnt, points.size());
-    }
 }
 
 // ----------------------------------------------------------------------------
@@ -246,90 +859,6 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(std::streambuf::off_type off,
-                     std::ios_base::seekdir way,
-                     std::ios_base::openmode mode = std::ios::in | std::ios::out) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(std::streambuf::pos_type pos,
-                     std::ios_base::openmode which = std::ios::in | std::ios::out) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int
@@ -543,177 +1072,67 @@ lzfDecompress(const void* const in_data, unsigned int in_len, void* out_data, un
 }  // namespace Points
 // NOLINTEND
 
-PlyReader::PlyReader() = default;
-
-void PlyReader::read(const std::string& filename)
-{
-    clear();
-
-    Base::FileInfo fi(filename);
-    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
-
-    std::string format;
-    std::vector<std::string> fields;
-    std::vector<std::string> types;
-    std::vector<int> sizes;
-    std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
-
-    this->width = numPoints;
-    this->height = 1;
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::find(fields.begin(), fields.end(), "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::find(fields.begin(), fields.end(), "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::find(fields.begin(), fields.end(), "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_x");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
+PlyReader::PlyReader() = default;
 
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_y");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
+void PlyReader::read(const std::string& filename)
+{
+    clear();
 
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_z");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
+    Base::FileInfo fi(filename);
+    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
 
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::find(fields.begin(), fields.end(), "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
+    std::string format;
+    std::vector<std::string> fields;
+    std::vector<std::string> types;
+    std::vector<int> sizes;
+    std::size_t offset = 0;
+    std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
 
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::find(fields.begin(), fields.end(), "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
-    }
+    this->width = static_cast<int>(numPoints);
+    this->height = 1;
 
-    it = std::find(fields.begin(), fields.end(), "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
+    PointSink sink(fields);
+    int red = sink.find({"red"});
+    int green = sink.find({"green"});
+    int blue = sink.find({"blue"});
+    int alpha = sink.find({"alpha"});
+    if (red >= 0 && green >= 0 && blue >= 0) {
+        if (types[red] == "uchar") {
+            sink.setColors(PointSink::ColorFormat::Uchar, red, green, blue, alpha);
+        }
+        else if (types[red] == "float") {
+            sink.setColors(PointSink::ColorFormat::Float, red, green, blue, alpha);
+        }
     }
 
-    it = std::find(fields.begin(), fields.end(), "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
-    }
+    // the data is parsed straight from the mapped file into the lists
+    FileData file(filename);
+    const char* begin = file.data() + dataOffset(inp, file.size());
+    const char* end = file.data() + file.size();
+    inp.close();
 
-    it = std::find(fields.begin(), fields.end(), "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
+    if (format == "ascii") {
+        sink.resize(numPoints, points, normals, intensity, colors);
+        parseAscii(begin, end, offset, numPoints, sink);
     }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    else if (format == "binary_little_endian" || format == "binary_big_endian") {
+        std::vector<BinaryField> layout = plyLayout(types);
+        std::size_t recordSize = 0;
+        for (auto& field : layout) {
+            field.offset = recordSize;
+            recordSize += sizeOf(field.type);
         }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        for (auto& field : layout) {
+            field.stride = recordSize;
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+        std::size_t available = static_cast<std::size_t>(end - begin);
+        if (offset > available || recordSize * numPoints > available - offset) {
+            throw Base::BadFormatError("File expects too many elements");
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
-            }
-        }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
-            }
-        }
+        sink.resize(numPoints, points, normals, intensity, colors);
+        decodeBinary(begin + offset, numPoints, layout, format == "binary_big_endian", sink);
     }
 }
 
@@ -887,136 +1306,6 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
-                           std::size_t offset,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1034,155 +1323,81 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
-
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
+    std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+    PointSink sink(fields);
+    int rgba = sink.find({"rgb", "rgba"});
+    if (rgba >= 0) {
+        if (types[rgba] == "U") {
+            sink.setColors(PointSink::ColorFormat::PackedUInt, rgba);
         }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
+        else if (types[rgba] == "F") {
+            sink.setColors(PointSink::ColorFormat::PackedFloat, rgba);
         }
     }
 
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::find(fields.begin(), fields.end(), "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::find(fields.begin(), fields.end(), "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::find(fields.begin(), fields.end(), "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_x");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_y");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
+    // the data is parsed straight from the mapped file into the lists
+    FileData file(filename);
+    const char* begin = file.data() + dataOffset(inp, file.size());
+    const char* end = file.data() + file.size();
+    inp.close();
 
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_z");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
+    if (format == "ascii") {
+        sink.resize(numPoints, points, normals, intensity, colors);
+        parseAscii(begin, end, 0, numPoints, sink);
     }
+    else if (format == "binary") {
+        // the fields of a point are stored together
+        std::vector<BinaryField> layout = pcdLayout(types, sizes);
+        std::size_t recordSize = 0;
+        for (auto& field : layout) {
+            field.offset = recordSize;
+            recordSize += sizeOf(field.type);
+        }
+        for (auto& field : layout) {
+            field.stride = recordSize;
+        }
 
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::find(fields.begin(), fields.end(), "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
+        if (recordSize * numPoints > static_cast<std::size_t>(end - begin)) {
+            throw Base::BadFormatError("File expects too many elements");
+        }
 
-    // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::find(fields.begin(), fields.end(), "rgb");
-    if (it == fields.end()) {
-        it = std::find(fields.begin(), fields.end(), "rgba");
+        sink.resize(numPoints, points, normals, intensity, colors);
+        decodeBinary(begin, numPoints, layout, false, sink);
     }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    else if (format == "binary_compressed") {
+        uint32_t c {};
+        uint32_t u {};
+        if (end - begin < static_cast<std::ptrdiff_t>(sizeof(c) + sizeof(u))) {
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        std::memcpy(&c, begin, sizeof(c));
+        std::memcpy(&u, begin + sizeof(c), sizeof(u));
+        begin += sizeof(c) + sizeof(u);
+        if (c > static_cast<std::size_t>(end - begin)) {
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
+        std::vector<char> uncompressed(u);
+        if (lzfDecompress(begin, c, uncompressed.data(), u) != u) {
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                App::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+        // all values of a field are stored together
+        std::vector<BinaryField> layout = pcdLayout(types, sizes);
+        std::size_t fieldOffset = 0;
+        for (auto& field : layout) {
+            field.offset = fieldOffset;
+            field.stride = sizeOf(field.type);
+            fieldOffset += field.stride * numPoints;
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                App::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+
+        if (fieldOffset > uncompressed.size()) {
+            throw Base::BadFormatError("File expects too many elements");
         }
+
+        sink.resize(numPoints, points, normals, intensity, colors);
+        decodeBinary(uncompressed.data(), numPoints, layout, false, sink);
     }
 }
 
@@ -1257,139 +1472,6 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 namespace
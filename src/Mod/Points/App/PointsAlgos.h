@@ -101,13 +101,6 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder,
-                    std::istream&,
-                    std::size_t offset,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport PcdReader: public Reader
@@ -122,12 +115,6 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose,
-                    std::istream&,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport E57Reader: public Reader
@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4251)
+#endif
+
+#include <cassert>
+#include <cmath>
+
+#include "ConstraintBlock.h"
+
+
+namespace GCS
+{
+
+namespace
+{
+
+// The kernels below follow the expressions of grad() of the constraints, so that a block gives
+// the same derivatives as the constraints evaluated one at a time.
+
+// Equal: p1, p2
+class EqualBlock: public ConstraintBlock
+{
+public:
+    EqualBlock()
+        : ConstraintBlock(2)
+    {}
+
+protected:
+    void derivativesKernel() override
+    {
+        derivatives[0] = scales;
+        derivatives[1] = -scales;
+    }
+};
+
+// Difference: p1, p2, difference
+class DifferenceBlock: public ConstraintBlock
+{
+public:
+    DifferenceBlock()
+        : ConstraintBlock(3)
+    {}
+
+protected:
+    void derivativesKernel() override
+    {
+        derivatives[0] = -scales;
+        derivatives[1] = scales;
+        derivatives[2] = -scales;
+    }
+};
+
+// P2PDistance: p1x, p1y, p2x, p2y, distance
+class P2PDistanceBlock: public ConstraintBlock
+{
+public:
+    P2PDistanceBlock()
+        : ConstraintBlock(5)
+    {}
+
+protected:
+    void derivativesKernel() override
+    {
+        Eigen::ArrayXd dx = values[0] - values[2];
+        Eigen::ArrayXd dy = values[1] - values[3];
+        Eigen::ArrayXd d = (dx * dx + dy * dy).sqrt();
+        derivatives[0] = scales * (dx / d);
+        derivatives[1] = scales * (dy / d);
+        derivatives[2] = scales * (-dx / d);
+        derivatives[3] = scales * (-dy / d);
+        derivatives[4] = -scales;
+    }
+};
+
+// P2PAngle: p1x, p1y, p2x, p2y, angle
+class P2PAngleBlock: public ConstraintBlock
+{
+public:
+    P2PAngleBlock()
+        : ConstraintBlock(5)
+    {}
+
+protected:
+    void addConstraintData(Constraint* constr) override
+    {
+        offsets.push_back(static_cast<ConstraintP2PAngle*>(constr)->getAngleOffset());
+    }
+
+    void derivativesKernel() override
+    {
+        Eigen::Map<const Eigen::ArrayXd> offset(offsets.data(), Eigen::Index(offsets.size()));
+        Eigen::ArrayXd dx = values[2] - values[0];
+        Eigen::ArrayXd dy = values[3] - values[1];
+        Eigen::ArrayXd a = values[4] + offset;
+        Eigen::ArrayXd ca = a.cos();
+        Eigen::ArrayXd sa = a.sin();
+        Eigen::ArrayXd x = dx * ca + dy * sa;
+        Eigen::ArrayXd y = -dx * sa + dy * ca;
+        Eigen::ArrayXd r2 = dx * dx + dy * dy;
+        Eigen::ArrayXd gx = -y / r2;
+        Eigen::ArrayXd gy = x / r2;
+        derivatives[0] = scales * (-ca * gx + sa * gy);
+        derivatives[1] = scales * (-sa * gx - ca * gy);
+        derivatives[2] = scales * (ca * gx - sa * gy);
+        derivatives[3] = scales * (sa * gx + ca * gy);
+        derivatives[4] = -scales;
+    }
+
+private:
+    VEC_D offsets;
+};
+
+// PointOnLine and P2LDistance: p0x, p0y, p1x, p1y, p2x, p2y[, distance]
+class PointLineBlock: public ConstraintBlock
+{
+public:
+    explicit PointLineBlock(bool withDistance)
+        : ConstraintBlock(withDistance ? 7 : 6)
+        , withDistance(withDistance)
+    {}
+
+protected:
+    void derivativesKernel() override
+    {
+        const Eigen::ArrayXd& x0 = values[0];
+        const Eigen::ArrayXd& y0 = values[1];
+        const Eigen::ArrayXd& x1 = values[2];
+        const Eigen::ArrayXd& y1 = values[3];
+        const Eigen::ArrayXd& x2 = values[4];
+        const Eigen::ArrayXd& y2 = values[5];
+        Eigen::ArrayXd dx = x2 - x1;
+        Eigen::ArrayXd dy = y2 - y1;
+        Eigen::ArrayXd d2 = dx * dx + dy * dy;
+        Eigen::ArrayXd d = d2.sqrt();
+        Eigen::ArrayXd area = -x0 * dy + y0 * dx + x1 * y2 - x2 * y1;
+        // the distance is the absolute value of the signed distance of the point on line
+        Eigen::ArrayXd signedScales = scales;
+        if (withDistance) {
+            signedScales = (area < 0).select(-scales, scales);
+            derivatives[6] = -scales;
+        }
+        derivatives[0] = signedScales * ((y1 - y2) / d);
+        derivatives[1] = signedScales * ((x2 - x1) / d);
+        derivatives[2] = signedScales * (((y2 - y0) * d + (dx / d) * area) / d2);
+        derivatives[3] = signedScales * (((x0 - x2) * d + (dy / d) * area) / d2);
+        derivatives[4] = signedScales * (((y0 - y1) * d - (dx / d) * area) / d2);
+        derivatives[5] = signedScales * (((x1 - x0) * d - (dy / d) * area) / d2);
+    }
+
+private:
+    bool withDistance;
+};
+
+// Parallel and Perpendicular: l1p1x, l1p1y, l1p2x, l1p2y, l2p1x, l2p1y, l2p2x, l2p2y
+class LineLineBlock: public ConstraintBlock
+{
+public:
+    explicit LineLineBlock(bool perpendicular)
+        : ConstraintBlock(8)
+        , perpendicular(perpendicular)
+    {}
+
+protected:
+    void derivativesKernel() override
+    {
+        Eigen::ArrayXd dx1 = values[0] - values[2];
+        Eigen::ArrayXd dy1 = values[1] - values[3];
+        Eigen::ArrayXd dx2 = values[4] - values[6];
+        Eigen::ArrayXd dy2 = values[5] - values[7];
+        if (perpendicular) {
+            derivatives[0] = scales * dx2;
+            derivatives[1] = scales * dy2;
+            derivatives[2] = scales * -dx2;
+            derivatives[3] = scales * -dy2;
+            derivatives[4] = scales * dx1;
+            derivatives[5] = scales * dy1;
+            derivatives[6] = scales * -dx1;
+            derivatives[7] = scales * -dy1;
+        }
+        else {
+            derivatives[0] = scales * dy2;
+            derivatives[1] = scales * -dx2;
+            derivatives[2] = scales * -dy2;
+            derivatives[3] = scales * dx2;
+            derivatives[4] = scales * -dy1;
+            derivatives[5] = scales * dx1;
+            derivatives[6] = scales * dy1;
+            derivatives[7] = scales * -dx1;
+        }
+    }
+
+private:
+    bool perpendicular;
+};
+
+// TangentCircumf: c1x, c1y, c2x, c2y, r1, r2
+class TangentCircumfBlock: public ConstraintBlock
+{
+public:
+    TangentCircumfBlock()
+        : ConstraintBlock(6)
+    {}
+
+protected:
+    void addConstraintData(Constraint* constr) override
+    {
+        bool internal = static_cast<ConstraintTangentCircumf*>(constr)->getInternal();
+        internals.push_back(internal ? 1. : 0.);
+    }
+
+    void derivativesKernel() override
+    {
+        Eigen::Map<const Eigen::ArrayXd> internal(internals.data(), Eigen::Index(internals.size()));
+        const Eigen::ArrayXd& r1 = values[4];
+        const Eigen::ArrayXd& r2 = values[5];
+        Eigen::ArrayXd dx = values[0] - values[2];
+        Eigen::ArrayXd dy = values[1] - values[3];
+        Eigen::ArrayXd d = (dx * dx + dy * dy).sqrt();
+        derivatives[0] = scales * (dx / d);
+        derivatives[1] = scales * (dy / d);
+        derivatives[2] = scales * (-dx / d);
+        derivatives[3] = scales * (-dy / d);
+        derivatives[4] = (internal != 0.).select((r1 > r2).select(-scales, scales), -scales);
+        derivatives[5] = (internal != 0.).select((r1 > r2).select(scales, -scales), -scales);
+    }
+
+private:
+    VEC_D internals;  // 1 for internal tangency, 0 for external tangency
+};
+
+}  // namespace
+
+std::unique_ptr<ConstraintBlock> ConstraintBlock::create(ConstraintType type)
+{
+    switch (type) {
+        case Equal:
+            return std::make_unique<EqualBlock>();
+        case Difference:
+            return std::make_unique<DifferenceBlock>();
+        case P2PDistance:
+            return std::make_unique<P2PDistanceBlock>();
+        case P2PAngle:
+            return std::make_unique<P2PAngleBlock>();
+        case P2LDistance:
+            return std::make_unique<PointLineBlock>(/*withDistance=*/true);
+        case PointOnLine:
+            return std::make_unique<PointLineBlock>(/*withDistance=*/false);
+        case Parallel:
+            return std::make_unique<LineLineBlock>(/*perpendicular=*/false);
+        case Perpendicular:
+            return std::make_unique<LineLineBlock>(/*perpendicular=*/true);
+        case TangentCircumf:
+            return std::make_unique<TangentCircumfBlock>();
+        default:
+            return nullptr;
+    }
+}
+
+ConstraintBlock::ConstraintBlock(int slots)
+    : values(slots)
+    , derivatives(slots)
+    , params(slots)
+    , columns(slots)
+{}
+
+void ConstraintBlock::add(Constraint* constr, int row, const VEC_pD& pvec, const VEC_I& pcolumns)
+{
+    assert(int(pvec.size()) == slotsNumber() && int(pcolumns.size()) == slotsNumber());
+
+    constraints.push_back(constr);
+    rows.push_back(row);
+    for (int slot = 0; slot < slotsNumber(); slot++) {
+        params[slot].push_back(pvec[slot]);
+        columns[slot].push_back(pcolumns[slot]);
+    }
+    addConstraintData(constr);
+}
+
+void ConstraintBlock::gather()
+{
+    Eigen::Index n = size();
+    // the scale of a constraint may be changed by rescale() at any time
+    scales.resize(n);
+    for (Eigen::Index i = 0; i < n; i++) {
+        scales[i] = constraints[i]->getScale();
+    }
+    for (int slot = 0; slot < slotsNumber(); slot++) {
+        const VEC_pD& slotParams = params[slot];
+        Eigen::ArrayXd& slotValues = values[slot];
+        slotValues.resize(n);
+        for (Eigen::Index i = 0; i < n; i++) {
+            slotValues[i] = *slotParams[i];
+        }
+    }
+}
+
+void ConstraintBlock::calcDerivatives()
+{
+    gather();
+    derivativesKernel();
+}
+
+}  // namespace GCS
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PLANEGCS_CONSTRAINTBLOCK_H
+#define PLANEGCS_CONSTRAINTBLOCK_H
+
+#include <memory>
+
+#include <Eigen/Core>
+
+#include "Constraints.h"
+
+
+namespace GCS
+{
+
+/// Computes the derivatives of the constraints of one type together.
+///
+/// The values of the parameters of the constraints are gathered into one array per parameter slot
+/// (structure of arrays), so that the derivatives of the whole block are computed by Eigen array
+/// expressions, which are vectorized, instead of one virtual grad() call per constraint and
+/// parameter, each comparing parameter pointers and recomputing the terms shared by all the
+/// derivatives. Derivatives are computed per slot, so a parameter occurring in several slots of a
+/// constraint has the sum of their derivatives.
+class ConstraintBlock
+{
+public:
+    virtual ~ConstraintBlock() = default;
+
+    /// Returns a new block for the constraints of the given type, or nullptr if constraints of
+    /// this type are only evaluated one at a time
+    static std::unique_ptr<ConstraintBlock> create(ConstraintType type);
+
+    int slotsNumber() const
+    {
+        return static_cast<int>(values.size());
+    }
+    int size() const
+    {
+        return static_cast<int>(rows.size());
+    }
+
+    /// Adds a constraint with `slotsNumber()` parameters. For each parameter, `pvec` holds the
+    /// address to read its value from and `pcolumns` its column in the Jacobian, or -1 if it is
+    /// not an unknown.
+    void add(Constraint* constr, int row, const VEC_pD& pvec, const VEC_I& pcolumns);
+
+    /// Computes the derivatives of all the constraints of the block
+    void calcDerivatives();
+
+    /// Rows of the constraints in the subsystem
+    const VEC_I& getRows() const
+    {
+        return rows;
+    }
+    const VEC_I& getColumns(int slot) const
+    {
+        return columns[slot];
+    }
+    const Eigen::ArrayXd& getDerivatives(int slot) const
+    {
+        return derivatives[slot];
+    }
+
+protected:
+    explicit ConstraintBlock(int slots);
+
+    /// Stores the data of the constraint which does not depend on the parameters
+    virtual void addConstraintData(Constraint* /*constr*/)
+    {}
+    virtual void derivativesKernel() = 0;
+
+    Eigen::ArrayXd scales;
+    std::vector<Eigen::ArrayXd> values;       // values[slot][i]
+    std::vector<Eigen::ArrayXd> derivatives;  // derivatives[slot][i]
+
+private:
+    void gather();
+
+    std::vector<Constraint*> constraints;
+    VEC_I rows;
+    std::vector<VEC_pD> params;  // params[slot][i]
+    std::vector<VEC_I> columns;  // columns[slot][i]
+};
+
+}  // namespace GCS
+
+#endif  // PLANEGCS_CONSTRAINTBLOCK_H
@@ -148,6 +148,10 @@ public:
     {
         return tag;
     }
+    double getScale() const
+    {
+        return scale;
+    }
 
     void setDriving(bool isdriving)
     {
@@ -452,6 +456,10 @@ public:
     inline ConstraintP2PAngle()
     {}
 #endif
+    inline double getAngleOffset() const
+    {
+        return da;
+    }
     ConstraintType getTypeId() override;
     void rescale(double coef = 1.) override;
     double error() override;
@@ -51,6 +51,7 @@
 #include <future>
 #include <iostream>
 #include <limits>
+#include <memory>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -96,6 +97,7 @@
 #endif
 
 #include <Base/Console.h>
+#include <Base/Parallel.h>
 #include <FCConfig.h>
 
 #include <boost/graph/connected_components.hpp>
@@ -468,6 +470,7 @@ System::System()
     , reference(0)
     , dofs(0)
     , hasUnknowns(false)
+    , hasBaseComponents(false)
     , hasDiagnosis(false)
     , isInit(false)
     , emptyDiagnoseMatrix(true)
@@ -524,7 +527,7 @@ void System::clear()
     partiallyRedundantTags.clear();
 
     reference.clear();
-    clearSubSystems();
+    clearBaseComponents();
     free(clist);
     c2p.clear();
     p2c.clear();
@@ -557,7 +560,8 @@ int System::addConstraint(Constraint* constr)
 {
     isInit = false;
     if (constr->getTag() >= 0) {  // negatively tagged constraints have no impact
-        hasDiagnosis = false;     // on the diagnosis
+        hasDiagnosis = false;     // on the diagnosis and the base components
+        hasBaseComponents = false;
     }
 
     clist.push_back(constr);
@@ -582,6 +586,7 @@ void System::removeConstraint(Constraint* constr)
     clist.erase(it);
     if (constr->getTag() >= 0) {
         hasDiagnosis = false;
+        hasBaseComponents = false;
     }
     clearSubSystems();
 
@@ -1796,6 +1801,7 @@ void System::declareUnknowns(VEC_pD& params)
         pIndex[plist[i]] = i;
     }
     hasUnknowns = true;
+    hasBaseComponents = false;
 }
 
 void System::declareDrivenParams(VEC_pD& params)
@@ -1816,6 +1822,13 @@ void System::initSolution(Algorithm alg)
     //   tag ids >=0 and < 0 respectively and applies the
     //   system reduction specified in the previous step
 
+    // nothing changed since the last call, only the reference is updated, e.g. to start a drag
+    // step from the solution of the previous step
+    if (isInit && hasDiagnosis && hasBaseComponents) {
+        setReference();
+        return;
+    }
+
     isInit = false;
     if (!hasUnknowns) {
         return;
@@ -1831,27 +1844,146 @@ void System::initSolution(Algorithm alg)
             return;
         }
     }
-    std::vector<Constraint*> clistR;
-    if (!redundant.empty()) {
-        for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-             ++constr) {
-            if (redundant.count(*constr) == 0) {
-                clistR.push_back(*constr);
+
+    // partitioning of the constraints with tag >= 0 into decoupled components and
+    // identification of equality constraints and parameter reduction
+    if (!hasBaseComponents) {
+        makeBaseComponents();
+    }
+
+    clearSubSystems();
+
+    // partitioning into decoupled components: the constraints with tag < 0 join the base
+    // components of their parameters
+    VEC_I joined(baseComponents.size(), -1);  // union-find forest of the joined base components
+    auto findRoot = [&joined](int baseId) {
+        while (joined[baseId] != baseId) {
+            baseId = joined[baseId] = joined[joined[baseId]];
+        }
+        return baseId;
+    };
+
+    std::vector<Constraint*> clistAux;  // constraints with tag < 0
+    VEC_I clistAuxBase;                 // one of the joined base components, or -1 if none
+    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
+         ++constr) {
+        if ((*constr)->getTag() >= 0 || redundant.count(*constr) != 0) {
+            continue;
+        }
+        int root = -1;
+        VEC_pD& cparams = c2p[*constr];
+        for (VEC_pD::const_iterator param = cparams.begin(); param != cparams.end(); ++param) {
+            MAP_pD_I::const_iterator it = pIndex.find(*param);
+            if (it == pIndex.end()) {
+                continue;
+            }
+            int baseId = paramsBase[it->second];
+            if (joined[baseId] < 0) {
+                joined[baseId] = baseId;
+            }
+            baseId = findRoot(baseId);
+            if (root < 0) {
+                root = baseId;
+            }
+            else if (baseId != root) {
+                joined[baseId] = root;
             }
         }
+        clistAux.push_back(*constr);
+        clistAuxBase.push_back(root);
     }
-    else {
-        clistR = clist;
+
+    std::map<int, VEC_I> joinedBases;  // joined base components by root, in order
+    std::map<int, std::vector<Constraint*>> joinedClists;  // constraints with tag < 0 by root
+    for (int baseId = 0; baseId < int(baseComponents.size()); baseId++) {
+        if (joined[baseId] >= 0) {
+            joinedBases[findRoot(baseId)].push_back(baseId);
+        }
+    }
+    for (std::size_t i = 0; i < clistAux.size(); i++) {
+        if (clistAuxBase[i] >= 0) {
+            joinedClists[findRoot(clistAuxBase[i])].push_back(clistAux[i]);
+        }
+    }
+
+    // calculates subSystems and subSystemsAux, the base components that are not joined keep
+    // their subsystem
+    for (int baseId = 0; baseId < int(baseComponents.size()); baseId++) {
+        if (joined[baseId] < 0) {
+            subSystems.push_back(getBaseSubSystem(baseId));
+            subSystemsAux.push_back(nullptr);
+            subSystemsBase.push_back(baseId);
+        }
+    }
+    for (auto& joinedBase : joinedBases) {
+        const VEC_I& bases = joinedBase.second;
+        std::vector<Constraint*>& clist1 = joinedClists[joinedBase.first];
+        if (bases.size() == 1) {
+            BaseComponent& base = baseComponents[bases.front()];
+            VEC_pD plist0 = getBaseParams(base.params);
+            subSystems.push_back(getBaseSubSystem(bases.front()));
+            subSystemsAux.push_back(new SubSystem(clist1, plist0, base.reductionmap));
+            subSystemsBase.push_back(bases.front());
+            continue;
+        }
+
+        // the parameters and constraints of the joined components keep their order in plist and
+        // clist
+        VEC_I params, constraints;
+        MAP_pD_pD reductionmap;
+        for (int baseId : bases) {
+            const BaseComponent& base = baseComponents[baseId];
+            params.insert(params.end(), base.params.begin(), base.params.end());
+            constraints.insert(constraints.end(), base.constraints.begin(), base.constraints.end());
+            reductionmap.insert(base.reductionmap.begin(), base.reductionmap.end());
+        }
+        std::sort(params.begin(), params.end());
+        std::sort(constraints.begin(), constraints.end());
+        VEC_pD plist0 = getBaseParams(params);
+        std::vector<Constraint*> clist0;
+        for (int i : constraints) {
+            clist0.push_back(baseConstraints[i]);
+        }
+        subSystems.push_back(clist0.empty() ? nullptr
+                                            : new SubSystem(clist0, plist0, reductionmap));
+        subSystemsAux.push_back(new SubSystem(clist1, plist0, reductionmap));
+        subSystemsBase.push_back(-1);
+    }
+    // constraints with tag < 0 without unknowns are components of their own
+    for (std::size_t i = 0; i < clistAux.size(); i++) {
+        if (clistAuxBase[i] < 0) {
+            std::vector<Constraint*> clist1(1, clistAux[i]);
+            VEC_pD plist0;
+            MAP_pD_pD reductionmap;
+            subSystems.push_back(nullptr);
+            subSystemsAux.push_back(new SubSystem(clist1, plist0, reductionmap));
+            subSystemsBase.push_back(-1);
+        }
+    }
+
+    isInit = true;
+}
+
+void System::makeBaseComponents()
+{
+    clearBaseComponents();
+
+    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
+         ++constr) {
+        if ((*constr)->getTag() >= 0 && redundant.count(*constr) == 0) {
+            baseConstraints.push_back(*constr);
+        }
     }
 
     // partitioning into decoupled components
     Graph g;
-    for (int i = 0; i < int(plist.size() + clistR.size()); i++) {
+    for (int i = 0; i < int(plist.size() + baseConstraints.size()); i++) {
         boost::add_vertex(g);
     }
 
     int cvtid = int(plist.size());
-    for (std::vector<Constraint*>::const_iterator constr = clistR.begin(); constr != clistR.end();
+    for (std::vector<Constraint*>::const_iterator constr = baseConstraints.begin();
+         constr != baseConstraints.end();
          ++constr, cvtid++) {
         VEC_pD& cparams = c2p[*constr];
         for (VEC_pD::const_iterator param = cparams.begin(); param != cparams.end(); ++param) {
@@ -1867,85 +1999,89 @@ void System::initSolution(Algorithm alg)
     if (!components.empty()) {
         componentsSize = boost::connected_components(g, &components[0]);
     }
+    baseComponents.resize(componentsSize);
 
-    // identification of equality constraints and parameter reduction
+    // identification of equality constraints and parameter reduction, the parameter i is
+    // replaced by the parameter reducedParams[i]
     std::set<Constraint*> reducedConstrs;  // constraints that will be eliminated through reduction
-    reductionmaps.clear();                 // destroy any maps
-    reductionmaps.resize(componentsSize);  // create empty maps to be filled in
     {
-        VEC_pD reducedParams = plist;
+        VEC_I reducedParams(plist.size());
+        std::vector<VEC_I> replacedParams(plist.size());  // parameters replaced by each parameter
+        for (int i = 0; i < int(plist.size()); ++i) {
+            reducedParams[i] = i;
+            replacedParams[i].push_back(i);
+        }
 
-        for (std::vector<Constraint*>::const_iterator constr = clistR.begin();
-             constr != clistR.end();
+        for (std::vector<Constraint*>::const_iterator constr = baseConstraints.begin();
+             constr != baseConstraints.end();
              ++constr) {
-            if ((*constr)->getTag() >= 0 && (*constr)->getTypeId() == Equal) {
+            if ((*constr)->getTypeId() == Equal) {
                 MAP_pD_I::const_iterator it1, it2;
                 it1 = pIndex.find((*constr)->params()[0]);
                 it2 = pIndex.find((*constr)->params()[1]);
                 if (it1 != pIndex.end() && it2 != pIndex.end()) {
                     reducedConstrs.insert(*constr);
-                    double* p_kept = reducedParams[it1->second];
-                    double* p_replaced = reducedParams[it2->second];
-                    for (int i = 0; i < int(plist.size()); ++i) {
-                        if (reducedParams[i] == p_replaced) {
+                    int p_kept = reducedParams[it1->second];
+                    int p_replaced = reducedParams[it2->second];
+                    if (p_kept != p_replaced) {
+                        for (int i : replacedParams[p_replaced]) {
                             reducedParams[i] = p_kept;
                         }
+                        replacedParams[p_kept].insert(replacedParams[p_kept].end(),
+                                                      replacedParams[p_replaced].begin(),
+                                                      replacedParams[p_replaced].end());
+                        replacedParams[p_replaced].clear();
                     }
                 }
             }
         }
         for (int i = 0; i < int(plist.size()); ++i) {
-            if (plist[i] != reducedParams[i]) {
+            if (reducedParams[i] != i) {
                 int cid = components[i];
-                reductionmaps[cid][plist[i]] = reducedParams[i];
+                baseComponents[cid].reductionmap[plist[i]] = plist[reducedParams[i]];
             }
         }
     }
 
-    clists.clear();                 // destroy any lists
-    clists.resize(componentsSize);  // create empty lists to be filled in
-    int i = int(plist.size());
-    for (std::vector<Constraint*>::const_iterator constr = clistR.begin(); constr != clistR.end();
-         ++constr, i++) {
-        if (reducedConstrs.count(*constr) == 0) {
-            int cid = components[i];
-            clists[cid].push_back(*constr);
+    for (int i = 0; i < int(baseConstraints.size()); i++) {
+        if (reducedConstrs.count(baseConstraints[i]) == 0) {
+            int cid = components[int(plist.size()) + i];
+            baseComponents[cid].constraints.push_back(i);
         }
     }
 
-    plists.clear();                 // destroy any lists
-    plists.resize(componentsSize);  // create empty lists to be filled in
+    paramsBase.resize(plist.size());
     for (int i = 0; i < int(plist.size()); ++i) {
         int cid = components[i];
-        plists[cid].push_back(plist[i]);
+        baseComponents[cid].params.push_back(i);
+        paramsBase[i] = cid;
     }
 
-    // calculates subSystems and subSystemsAux from clists, plists and reductionmaps
-    clearSubSystems();
-    for (std::size_t cid = 0; cid < clists.size(); cid++) {
-        std::vector<Constraint*> clist0, clist1;
-        for (std::vector<Constraint*>::const_iterator constr = clists[cid].begin();
-             constr != clists[cid].end();
-             ++constr) {
-            if ((*constr)->getTag() >= 0) {
-                clist0.push_back(*constr);
-            }
-            else {  // move or distance from reference constraints
-                clist1.push_back(*constr);
-            }
-        }
+    hasBaseComponents = true;
+}
 
-        subSystems.push_back(nullptr);
-        subSystemsAux.push_back(nullptr);
-        if (!clist0.empty()) {
-            subSystems[cid] = new SubSystem(clist0, plists[cid], reductionmaps[cid]);
-        }
-        if (!clist1.empty()) {
-            subSystemsAux[cid] = new SubSystem(clist1, plists[cid], reductionmaps[cid]);
+SubSystem* System::getBaseSubSystem(int baseId)
+{
+    BaseComponent& base = baseComponents[baseId];
+    if (!base.subSystem && !base.constraints.empty()) {
+        std::vector<Constraint*> clist0;
+        for (int i : base.constraints) {
+            clist0.push_back(baseConstraints[i]);
         }
+        VEC_pD plist0 = getBaseParams(base.params);
+        base.subSystem = new SubSystem(clist0, plist0, base.reductionmap);
     }
+    return base.subSystem;
+}
 
-    isInit = true;
+VEC_pD System::getBaseParams(const VEC_I& params) const
+{
+    VEC_pD plist0;
+    plist0.reserve(params.size());
+    for (int i : params) {
+        plist0.push_back(plist[i]);
+    }
+    return plist0;
 }
 
 void System::setReference()
@@ -1981,26 +2117,41 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
+        if (subSystems[cid] || subSystemsAux[cid]) {
             resetToReference();
-            isReset = true;
-        }
-        if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
-        }
-        else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
-        }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+            break;
         }
     }
+
+    // The decoupled components share neither constraints nor parameters, so they are solved
+    // concurrently
+    std::vector<int> results(subSystems.size(), Success);
+    Base::parallelFor(
+        subSystems.size(),
+        getNumberOfThreads(),
+        [&](std::size_t first, std::size_t last) {
+            for (std::size_t cid = first; cid < last; cid++) {
+                if (subSystems[cid] && subSystemsAux[cid]) {
+                    results[cid] =
+                        solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
+                }
+                else if (subSystems[cid]) {
+                    results[cid] = solve(subSystems[cid], isFine, alg, isRedundantsolving);
+                }
+                else if (subSystemsAux[cid]) {
+                    results[cid] = solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+                }
+            }
+        },
+        1);
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (int result : results) {
+        res = std::max(res, result);
+    }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
              constr != redundant.end();
@@ -2018,6 +2169,17 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
     return res;
 }
 
+int System::getNumberOfThreads() const
+{
+    // Base::Console is not thread-safe, so the output of each iteration needs a single thread.
+    // Small systems are solved faster than the threads are started.
+    const std::size_t minParallelConstraints = 64;
+    if (debugMode == IterationLevel || clist.size() < minParallelConstraints) {
+        return 1;
+    }
+    return 0;
+}
+
 int System::solve(SubSystem* subsys, bool isFine, Algorithm alg, bool isRedundantsolving)
 {
     if (alg == BFGS) {
@@ -2158,6 +2320,92 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     return Failed;
 }
 
+namespace
+{
+
+// solves the augmented normal equations A*h = g of the LevenbergMarquardt solver
+void solveAugmentedNormalEquations(const Eigen::MatrixXd& A,
+                                   const Eigen::VectorXd& g,
+                                   Eigen::VectorXd& h)
+{
+    h = A.fullPivLu().solve(g);
+}
+
+// solves Jx*h_gn = -fx for the gauss-newton step of the DogLeg solver
+void solveGaussNewtonStep(const Eigen::MatrixXd& Jx,
+                          const Eigen::VectorXd& fx,
+                          DogLegGaussStep dogLegGaussStep,
+                          Eigen::VectorXd& h_gn)
+{
+    // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
+    // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+    switch (dogLegGaussStep) {
+        case FullPivLU:
+            h_gn = Jx.fullPivLu().solve(-fx);
+            break;
+        case LeastNormFullPivLU:
+            h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
+            break;
+        case LeastNormLdlt:
+            h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
+            break;
+    }
+}
+
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+// The Jacobian of a sketch has only a few non zeros per row, so large subsystems are solved with
+// sparse matrices. Small ones are faster with the dense decompositions.
+const int SparseSolverMinParams = 100;
+
+bool isSparseSolving(SubSystem* subsys)
+{
+    return subsys->pSize() >= SparseSolverMinParams;
+}
+
+void solveAugmentedNormalEquations(const Eigen::SparseMatrix<double>& A,
+                                   const Eigen::VectorXd& g,
+                                   Eigen::VectorXd& h)
+{
+    // J^T J + uI is symmetric positive definite for u > 0
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(A);
+    h = ldlt.solve(g);
+}
+
+void solveGaussNewtonStep(const Eigen::SparseMatrix<double>& Jx,
+                          const Eigen::VectorXd& fx,
+                          DogLegGaussStep dogLegGaussStep,
+                          Eigen::VectorXd& h_gn)
+{
+    // The least norm solutions use a Cholesky decomposition of Jx*Jx^T, which fails if the
+    // constraints are dependent. Like FullPivLU the rank revealing QR decomposition gives a basic
+    // solution in any case.
+    if (dogLegGaussStep != FullPivLU) {
+        Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(JJt);
+        if (ldlt.info() == Eigen::Success) {
+            h_gn = Jx.transpose() * ldlt.solve(-fx);
+            return;
+        }
+    }
+
+    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> qr(Jx);
+    h_gn = qr.solve(-fx);
+}
+#endif
+
+}  // namespace
+
+int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
+{
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    if (isSparseSolving(subsys)) {
+        return solve_LM<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+    }
+#endif
+    return solve_LM<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename Jacobian>
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2173,8 +2421,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd e(csize),
         e_new(csize);  // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);  // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    Jacobian J(csize, xsize);  // Jacobi of the subsystem
+    Jacobian A(xsize, xsize);
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -2247,11 +2495,11 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         while (k < 50) {
             // augment normal equations A = A+uI
             for (int i = 0; i < xsize; ++i) {
-                A(i, i) += mu;
+                A.coeffRef(i, i) += mu;
             }
 
             // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
+            solveAugmentedNormalEquations(A, g, h);
             double rel_error = (A * h - g).norm() / g.norm();
 
             // check if solving works
@@ -2302,7 +2550,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
             mu *= nu;
             nu *= 2.0;
             for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
+                A.coeffRef(i, i) = diag_A(i);
             }
 
             k++;
@@ -2333,6 +2581,17 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 }
 
 
+int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
+{
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    if (isSparseSolving(subsys)) {
+        return solve_DL<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+    }
+#endif
+    return solve_DL<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename Jacobian>
 int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2373,7 +2632,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    Jacobian Jx(csize, xsize), Jx_new(csize, xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
     subsys->redirectParams();
@@ -2419,19 +2678,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
             h_sd = alpha * g;
 
             // get the gauss-newton step
-            // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
-            // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-            switch (dogLegGaussStep) {
-                case FullPivLU:
-                    h_gn = Jx.fullPivLu().solve(-fx);
-                    break;
-                case LeastNormFullPivLU:
-                    h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                    break;
-                case LeastNormLdlt:
-                    h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                    break;
-            }
+            solveGaussNewtonStep(Jx, fx, dogLegGaussStep, h_gn);
 
             double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
             if (rel_error > 1e15) {
@@ -4859,10 +5106,16 @@ void System::applySolution()
         if (subSystems[cid]) {
             subSystems[cid]->applySolution();
         }
-        for (MAP_pD_pD::const_iterator it = reductionmaps[cid].begin();
-             it != reductionmaps[cid].end();
-             ++it) {
-            *(it->first) = *(it->second);
+    }
+    // the reductions of the components are applied after the subsystems of all of them, as
+    // they only refer to parameters of the same component
+    if (!subSystems.empty()) {
+        for (const auto& base : baseComponents) {
+            for (MAP_pD_pD::const_iterator it = base.reductionmap.begin();
+                 it != base.reductionmap.end();
+                 ++it) {
+                *(it->first) = *(it->second);
+            }
         }
     }
 }
@@ -4872,10 +5125,25 @@ void System::undoSolution()
     resetToReference();
 }
 
-void System::makeReducedJacobian(Eigen::MatrixXd& J,
-                                 std::map<int, int>& jacobianconstraintmap,
-                                 GCS::VEC_pD& pdiagnoselist,
-                                 std::map<int, int>& tagmultiplicity)
+struct System::DiagnosisComponent
+{
+    VEC_pD params;                 // the diagnosed parameters of the component
+    std::vector<int> constraints;  // indices in clist of the driving constraints
+
+    int rank = 0;
+    int constrNum = 0;  // number of constraints in the reduced Jacobian, i.e. with tag >= 0
+    int nonredundantConstrNum = 0;
+    VEC_pD dependentParameters;
+    std::vector<VEC_pD> dependentParametersGroups;
+    std::vector<std::vector<Constraint*>> conflictGroups;
+    std::set<Constraint*> redundant;
+    bool hasRedundantSolving = false;
+    int redundantSolvingResult = Failed;
+};
+
+void System::makeDiagnosisComponents(GCS::VEC_pD& pdiagnoselist,
+                                     std::map<int, int>& tagmultiplicity,
+                                     std::vector<DiagnosisComponent>& components)
 {
     // construct specific parameter list for diagonose ignoring driven constraint parameters
     for (int j = 0; j < int(plist.size()); j++) {
@@ -4886,35 +5154,66 @@ void System::makeReducedJacobian(Eigen::MatrixXd& J,
         }
     }
 
+    MAP_pD_I pdiagnoseIndex;
+    for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+        pdiagnoseIndex[pdiagnoselist[j]] = j;
+    }
 
-    J = Eigen::MatrixXd::Zero(clist.size(), pdiagnoselist.size());
-
-    int jacobianconstraintcount = 0;
-    int allcount = 0;
-    for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end();
-         ++constr) {
-        (*constr)->revertParams();
-        ++allcount;
-        if ((*constr)->getTag() >= 0 && (*constr)->isDriving()) {
-            jacobianconstraintcount++;
-            for (int j = 0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount - 1, j) = (*constr)->grad(pdiagnoselist[j]);
-            }
+    std::vector<int> drivingconstraints;
+    for (int i = 0; i < int(clist.size()); i++) {
+        Constraint* constr = clist[i];
+        constr->revertParams();
+        if (!constr->isDriving()) {
+            continue;
+        }
+        drivingconstraints.push_back(i);
 
+        if (constr->getTag() >= 0) {
             // parallel processing: create tag multiplicity map
-            if (tagmultiplicity.find((*constr)->getTag()) == tagmultiplicity.end()) {
-                tagmultiplicity[(*constr)->getTag()] = 0;
+            if (tagmultiplicity.find(constr->getTag()) == tagmultiplicity.end()) {
+                tagmultiplicity[constr->getTag()] = 0;
             }
             else {
-                tagmultiplicity[(*constr)->getTag()]++;
+                tagmultiplicity[constr->getTag()]++;
             }
+        }
+    }
 
-            jacobianconstraintmap[jacobianconstraintcount - 1] = allcount - 1;
+    // partitioning into decoupled components, the vertices are the diagnosed parameters
+    // followed by the driving constraints. The constraints with tag < 0 are included, as they
+    // take part in the redundant solving.
+    Graph g;
+    int paramsNum = int(pdiagnoselist.size());
+    for (int i = 0; i < paramsNum + int(drivingconstraints.size()); i++) {
+        boost::add_vertex(g);
+    }
+
+    int cvtid = paramsNum;
+    for (int i : drivingconstraints) {
+        VEC_pD& cparams = c2p[clist[i]];
+        for (VEC_pD::const_iterator param = cparams.begin(); param != cparams.end(); ++param) {
+            MAP_pD_I::const_iterator it = pdiagnoseIndex.find(*param);
+            if (it != pdiagnoseIndex.end()) {
+                boost::add_edge(cvtid, it->second, g);
+            }
         }
+        cvtid++;
+    }
+
+    VEC_I vertexcomponents(boost::num_vertices(g));
+    int componentsSize = 0;
+    if (!vertexcomponents.empty()) {
+        componentsSize = boost::connected_components(g, &vertexcomponents[0]);
     }
 
-    if (jacobianconstraintcount == 0) {  // only driven constraints
-        J.resize(0, 0);
+    components.resize(componentsSize);
+    for (int j = 0; j < paramsNum; j++) {
+        components[vertexcomponents[j]].params.push_back(pdiagnoselist[j]);
+    }
+    cvtid = paramsNum;
+    for (int i : drivingconstraints) {
+        components[vertexcomponents[cvtid]].constraints.push_back(i);
+        cvtid++;
     }
 }
 
@@ -4931,6 +5230,7 @@ int System::diagnose(Algorithm alg)
     //         two high priority constraints. For this reason, tagging
     //         constraints with 0 should be used carefully.
     hasDiagnosis = false;
+    hasBaseComponents = false;  // the redundant constraints are not part of them
     if (!hasUnknowns) {
         dofs = -1;
         return dofs;
@@ -4967,13 +5267,12 @@ int System::diagnose(Algorithm alg)
     //
     // reduced Jacobian matrix
     // The Jacobian has been reduced to:
-    // 1. only contain driving constraints, but keep a full size (zero padded).
+    // 1. only contain driving constraints.
     // 2. remove the parameters of the values of driven constraints.
-    Eigen::MatrixXd J;
-
-    // maps the index of the rows of the reduced jacobian matrix (solver constraints) to
-    // the index those constraints would have in a full size Jacobian matrix
-    std::map<int, int> jacobianconstraintmap;
+    //
+    // The reduced Jacobian of a system made of decoupled components is block diagonal. Its rank
+    // is the sum of the ranks of the blocks and the dependencies only occur within a block. So
+    // each component is diagnosed on its own (and concurrently) and the results are merged.
 
     // list of parameters to be diagnosed in this routine (removes value parameters from driven
     // constraints)
@@ -4984,15 +5283,25 @@ int System::diagnose(Algorithm alg)
     // like 0 and -1.
     std::map<int, int> tagmultiplicity;
 
+    std::vector<DiagnosisComponent> components;
 
-    makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+    makeDiagnosisComponents(pdiagnoselist, tagmultiplicity, components);
 
     // this function will exit with a diagnosis and, unless overridden by functions below, with full
     // DoFs
     hasDiagnosis = true;
     dofs = pdiagnoselist.size();
 
-    if (J.rows() > 0) {
+    int constrNum = 0;
+    for (const auto& component : components) {
+        for (int i : component.constraints) {
+            if (clist[i]->getTag() >= 0) {
+                constrNum++;
+            }
+        }
+    }
+
+    if (constrNum > 0) {
         emptyDiagnoseMatrix = false;
     }
 
@@ -5050,153 +5359,285 @@ int System::diagnose(Algorithm alg)
     }
 #endif
 
-    if (qrAlgorithm == EigenDenseQR) {
+    if (constrNum == 0) {  // only driven constraints
+        return dofs;
+    }
+
 #ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed DenseQR_start_time;
+    Base::TimeElapsed QR_start_time;
 #endif
-        if (J.rows() > 0) {
-            int rank = 0;  // rank is not cheap to retrieve from qrJT in DenseQR
-            Eigen::MatrixXd R;
-            Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
-            // Here we give the system the possibility to run the two QR decompositions in parallel,
-            // depending on the load of the system so we are using the default std::launch::async |
-            // std::launch::deferred policy, as nobody better than the system nows if it can run the
-            // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
-            // future before any prospective detection of conflicting/redundant, because the
-            // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
-            // the thread with silent=true, unless the present thread does not use Base::Console, or
-            // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
-            // use them in both at the same time.
-            //
-            // identifyDependentParametersDenseQR(J, jacobianconstraintmap, pdiagnoselist, true)
-            //
-            auto fut = std::async(&System::identifyDependentParametersDenseQR,
-                                  this,
-                                  J,
-                                  jacobianconstraintmap,
-                                  pdiagnoselist,
-                                  true);
-
-            makeDenseQRDecomposition(J, jacobianconstraintmap, qrJT, rank, R);
-
-            int paramsNum = qrJT.rows();
-            int constrNum = qrJT.cols();
-
-            // This function is legacy code that was used to obtain partial geometry dependency
-            // information from a SINGLE Dense QR decomposition. I am reluctant to remove it from
-            // here until everything new is well tested.
-            // identifyDependentGeometryParametersInTransposedJacobianDenseQRDecomposition( qrJT,
-            // pdiagnoselist, paramsNum, rank);
-
-            fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
-
-            dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
-
-            // Detecting conflicting or redundant constraints
-            if (constrNum > rank) {  // conflicting or redundant constraints
-                int nonredundantconstrNum;
-                identifyConflictingRedundantConstraints(alg,
-                                                        qrJT,
-                                                        jacobianconstraintmap,
-                                                        tagmultiplicity,
-                                                        pdiagnoselist,
-                                                        R,
-                                                        constrNum,
-                                                        rank,
-                                                        nonredundantconstrNum);
-                if (paramsNum == rank && nonredundantconstrNum > rank) {  // over-constrained
-                    dofs = paramsNum - nonredundantconstrNum;
-                }
+
+    int threads = getNumberOfThreads();
+    bool concurrent = threads != 1 && components.size() > 1;
+    Base::parallelFor(
+        components.size(),
+        threads,
+        [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                diagnoseComponent(alg, tagmultiplicity, components[i], concurrent);
             }
-        }
+        },
+        1);
+
 #ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed DenseQR_end_time;
+    Base::TimeElapsed QR_end_time;
 
-        auto SolveTime = Base::TimeElapsed::diffTimeF(DenseQR_start_time, DenseQR_end_time);
+    auto SolveTime = Base::TimeElapsed::diffTimeF(QR_start_time, QR_end_time);
 
-        Base::Console().Log("\nDenseQR - Lapsed Time: %f seconds\n", SolveTime);
+    Base::Console().Log("\n%s - Lapsed Time: %f seconds\n",
+                        qrAlgorithm == EigenDenseQR ? "DenseQR" : "SparseQR",
+                        SolveTime);
 #endif
+
+    // merging of the results of the components
+    int rank = 0;
+    int nonredundantconstrNum = 0;
+    std::size_t groupsNum = 0;
+    std::vector<std::vector<Constraint*>> conflictGroups;
+    bool hasRedundantSolving = false;
+    bool hasRedundantSolution = false;
+    for (const auto& component : components) {
+        rank += component.rank;
+        nonredundantconstrNum += component.nonredundantConstrNum;
+        groupsNum += component.dependentParametersGroups.size();
+        pDependentParameters.insert(pDependentParameters.end(),
+                                    component.dependentParameters.begin(),
+                                    component.dependentParameters.end());
+        conflictGroups.insert(conflictGroups.end(),
+                              component.conflictGroups.begin(),
+                              component.conflictGroups.end());
+        redundant.insert(component.redundant.begin(), component.redundant.end());
+        if (component.hasRedundantSolving) {
+            hasRedundantSolving = true;
+            hasRedundantSolution |= component.redundantSolvingResult == Success;
+        }
     }
 
-#ifdef EIGEN_SPARSEQR_COMPATIBLE
-    else if (qrAlgorithm == EigenSparseQR) {
-#ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed SparseQR_start_time;
-#endif
-        if (J.rows() > 0) {
-            int rank = 0;
-            Eigen::MatrixXd R;
-            Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJT;
-            // Here we give the system the possibility to run the two QR decompositions in parallel,
-            // depending on the load of the system so we are using the default std::launch::async |
-            // std::launch::deferred policy, as nobody better than the system nows if it can run the
-            // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
-            // future before any prospective detection of conflicting/redundant, because the
-            // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
-            // the thread with silent=true, unless the present thread does not use Base::Console, or
-            // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
-            // use them in both at the same time.
-            //
-            // identifyDependentParametersSparseQR(J, jacobianconstraintmap, pdiagnoselist, true)
-            //
-            // Debug:
-            // auto fut =
-            // std::async(std::launch::deferred,&System::identifyDependentParametersSparseQR, this,
-            // J, jacobianconstraintmap, pdiagnoselist, false);
-            auto fut = std::async(&System::identifyDependentParametersSparseQR,
-                                  this,
-                                  J,
-                                  jacobianconstraintmap,
-                                  pdiagnoselist,
-                                  /*silent=*/true);
+    pDependentParametersGroups.resize(groupsNum);
+    std::size_t group = 0;
+    for (const auto& component : components) {
+        for (const auto& params : component.dependentParametersGroups) {
+            pDependentParametersGroups[group].insert(pDependentParametersGroups[group].end(),
+                                                     params.begin(),
+                                                     params.end());
+            group++;
+        }
+    }
+
+    int paramsNum = pdiagnoselist.size();
+    dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
+
+    // Detecting conflicting or redundant constraints
+    if (constrNum > rank) {
+        if (hasRedundantSolving && (debugMode == Minimal || debugMode == IterationLevel)) {
+            std::string solvername;
+            switch (alg) {
+                case 0:
+                    solvername = "BFGS";
+                    break;
+                case 1:  // solving with the LevenbergMarquardt solver
+                    solvername = "LevenbergMarquardt";
+                    break;
+                case 2:  // solving with the BFGS solver
+                    solvername = "DogLeg";
+                    break;
+            }
 
-            makeSparseQRDecomposition(J,
-                                      jacobianconstraintmap,
-                                      SqrJT,
-                                      rank,
-                                      R,
-                                      /*transposed=*/true,
-                                      /*silent=*/false);
+            Base::Console().Log("Sketcher::RedundantSolving-%s-\n", solvername.c_str());
 
-            int paramsNum = SqrJT.rows();
-            int constrNum = SqrJT.cols();
+            if (hasRedundantSolution) {
+                Base::Console().Log("Sketcher Redundant solving: %d redundants\n",
+                                    redundant.size());
+            }
+        }
 
-            fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
+        setConflictingRedundantTags(conflictGroups);
 
-            dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
+        if (paramsNum == rank && nonredundantconstrNum > rank) {  // over-constrained
+            dofs = paramsNum - nonredundantconstrNum;
+        }
+    }
 
-            // Detecting conflicting or redundant constraints
-            if (constrNum > rank) {
+    return dofs;
+}
 
-                int nonredundantconstrNum;
+void System::diagnoseComponent(Algorithm alg,
+                               const std::map<int, int>& tagmultiplicity,
+                               DiagnosisComponent& component,
+                               bool concurrent)
+{
+    // reduced Jacobian matrix of the component, only driving constraints with tag >= 0
+    std::map<int, int> jacobianconstraintmap;
+    for (int i : component.constraints) {
+        if (clist[i]->getTag() >= 0) {
+            int row = int(jacobianconstraintmap.size());
+            jacobianconstraintmap[row] = i;
+        }
+    }
 
-                identifyConflictingRedundantConstraints(alg,
-                                                        SqrJT,
-                                                        jacobianconstraintmap,
-                                                        tagmultiplicity,
-                                                        pdiagnoselist,
-                                                        R,
-                                                        constrNum,
-                                                        rank,
-                                                        nonredundantconstrNum);
+    int constrNum = int(jacobianconstraintmap.size());
+    int paramsNum = int(component.params.size());
+    component.constrNum = constrNum;
+    component.nonredundantConstrNum = constrNum;
 
-                if (paramsNum == rank && nonredundantconstrNum > rank) {  // over-constrained
-                    dofs = paramsNum - nonredundantconstrNum;
-                }
+    if (constrNum == 0) {
+        // nothing constrains the parameters, so each of them is a dependent parameter
+        for (auto param : component.params) {
+            component.dependentParameters.push_back(param);
+            component.dependentParametersGroups.push_back(VEC_pD(1, param));
+        }
+        return;
+    }
+
+    if (paramsNum == 0) {
+        // the constraints do not depend on any unknown, so each of them is either redundant or
+        // conflicting
+        for (const auto& row : jacobianconstraintmap) {
+            component.conflictGroups.push_back(std::vector<Constraint*>(1, clist[row.second]));
+        }
+        identifyConflictingRedundantConstraints(alg, tagmultiplicity, component);
+        return;
+    }
+
+    // The reduced Jacobian is assembled from the parameters of each constraint, the derivatives
+    // with respect to the other parameters are zero
+    MAP_pD_I paramindex;
+    for (int j = 0; j < paramsNum; j++) {
+        paramindex[component.params[j]] = j;
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (const auto& row : jacobianconstraintmap) {
+        Constraint* constr = clist[row.second];
+        VEC_I cols;
+        for (auto param : constr->params()) {
+            MAP_pD_I::const_iterator it = paramindex.find(param);
+            if (it != paramindex.end()) {
+                cols.push_back(it->second);
             }
         }
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
 
-#ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed SparseQR_end_time;
+        for (int j : cols) {
+            double value = constr->grad(component.params[j]);
+            if (value != 0.) {
+                triplets.emplace_back(row.first, j, value);
+            }
+        }
+    }
 
-        auto SolveTime = Base::TimeElapsed::diffTimeF(SparseQR_start_time, SparseQR_end_time);
+    Eigen::SparseMatrix<double> SJ(constrNum, paramsNum);
+    SJ.setFromTriplets(triplets.begin(), triplets.end());
 
-        Base::Console().Log("\nSparseQR - Lapsed Time: %f seconds\n", SolveTime);
-#endif
+    // Here we give the system the possibility to run the two QR decompositions in parallel,
+    // depending on the load of the system so we are using the default std::launch::async |
+    // std::launch::deferred policy, as nobody better than the system nows if it can run the
+    // task in parallel or is oversubscribed and should deferred it. If the components are
+    // already diagnosed concurrently, the task is deferred. Care to wait() for the future
+    // before any prospective detection of conflicting/redundant, because the redundant solve
+    // modifies the parameters and it would NOT be thread-safe. Care to call the thread with
+    // silent=true, unless the present thread does not use Base::Console, or the launch policy is
+    // set to std::launch::deferred policy, as it is not thread-safe to use them in both at the
+    // same time.
+    auto policy = concurrent ? std::launch::deferred : std::launch::async | std::launch::deferred;
+
+    int rank = 0;
+
+    if (qrAlgorithm == EigenDenseQR) {
+        Eigen::MatrixXd J = SJ;
+        Eigen::MatrixXd R;
+        Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
+
+        // identifyDependentParametersDenseQR(J, jacobianconstraintmap, params, ..., true)
+        auto fut = std::async(policy,
+                              &System::identifyDependentParametersDenseQR,
+                              this,
+                              std::cref(J),
+                              std::cref(jacobianconstraintmap),
+                              std::cref(component.params),
+                              std::ref(component.dependentParameters),
+                              std::ref(component.dependentParametersGroups),
+                              /*silent=*/true);
+
+        makeDenseQRDecomposition(J,
+                                 jacobianconstraintmap,
+                                 qrJT,
+                                 rank,
+                                 R,
+                                 /*transposed=*/true,
+                                 /*silent=*/concurrent);
+
+        // This function is legacy code that was used to obtain partial geometry dependency
+        // information from a SINGLE Dense QR decomposition. I am reluctant to remove it from
+        // here until everything new is well tested.
+        // identifyDependentGeometryParametersInTransposedJacobianDenseQRDecomposition( qrJT,
+        // pdiagnoselist, paramsNum, rank);
+
+        fut.wait();  // wait for the execution of identifyDependentParametersDenseQR to finish
+
+        component.rank = rank;
+
+        // Detecting conflicting or redundant constraints
+        if (constrNum > rank) {
+            Eigen::SparseMatrix<double> nonpivotcols;
+            makeNonPivotColumns(R, rank, nonpivotcols);
+            makeConflictGroups(qrJT,
+                               jacobianconstraintmap,
+                               nonpivotcols,
+                               constrNum,
+                               rank,
+                               component.conflictGroups);
+            identifyConflictingRedundantConstraints(alg, tagmultiplicity, component);
+        }
+    }
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    else if (qrAlgorithm == EigenSparseQR) {
+        Eigen::SparseMatrix<double> R;
+        Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJT;
+
+        // identifyDependentParametersSparseQR(SJ, jacobianconstraintmap, params, ..., true)
+        //
+        // Debug:
+        // auto fut =
+        // std::async(std::launch::deferred,&System::identifyDependentParametersSparseQR, this,
+        // SJ, jacobianconstraintmap, params, ..., false);
+        auto fut = std::async(policy,
+                              &System::identifyDependentParametersSparseQR,
+                              this,
+                              std::cref(SJ),
+                              std::cref(jacobianconstraintmap),
+                              std::cref(component.params),
+                              std::ref(component.dependentParameters),
+                              std::ref(component.dependentParametersGroups),
+                              /*silent=*/true);
+
+        makeSparseQRDecomposition(SJ,
+                                  jacobianconstraintmap,
+                                  SqrJT,
+                                  rank,
+                                  R,
+                                  /*transposed=*/true,
+                                  /*silent=*/concurrent);
+
+        fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
+
+        component.rank = rank;
+
+        // Detecting conflicting or redundant constraints
+        if (constrNum > rank) {
+            Eigen::SparseMatrix<double> nonpivotcols;
+            makeNonPivotColumns(R, rank, nonpivotcols);
+            makeConflictGroups(SqrJT,
+                               jacobianconstraintmap,
+                               nonpivotcols,
+                               constrNum,
+                               rank,
+                               component.conflictGroups);
+            identifyConflictingRedundantConstraints(alg, tagmultiplicity, component);
+        }
     }
 #endif
-
-    return dofs;
 }
 
 void System::makeDenseQRDecomposition(const Eigen::MatrixXd& J,
@@ -5279,26 +5720,18 @@ void System::makeDenseQRDecomposition(const Eigen::MatrixXd& J,
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
 void System::makeSparseQRDecomposition(
-    const Eigen::MatrixXd& J,
+    const Eigen::SparseMatrix<double>& SJ,
     const std::map<int, int>& jacobianconstraintmap,
     Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>& SqrJT,
     int& rank,
-    Eigen::MatrixXd& R,
+    Eigen::SparseMatrix<double>& R,
     bool transposeJ,
     bool silent)
 {
 
-    Eigen::SparseMatrix<double> SJ;
-
-    // this creation is not optimized (done using triplets)
-    // however the time this takes is negligible compared to the
-    // time the QR decomposition itself takes
-    SJ = J.sparseView();
-    SJ.makeCompressed();
-
 #ifdef _GCS_DEBUG
     if (!silent) {
-        SolverReportingManager::Manager().LogMatrix("J", J);
+        SolverReportingManager::Manager().LogMatrix("J", Eigen::MatrixXd(SJ));
     }
 #endif
 
@@ -5337,11 +5770,15 @@ void System::makeSparseQRDecomposition(
             SqrJT.setPivotThreshold(qrpivotThreshold);
             rank = SqrJT.rank();
 
+            // R is kept sparse, a dense copy would take most of the time and memory of large
+            // systems. SparseQR leaves the row indices of the columns of R unsorted, which the
+            // block and triangular views rely on, so they are sorted by a row major copy first.
+            Eigen::SparseMatrix<double, Eigen::RowMajor> sortedR = SqrJT.matrixR();
             if (colsNum >= rowsNum) {
-                R = SqrJT.matrixR().triangularView<Eigen::Upper>();
+                R = sortedR.triangularView<Eigen::Upper>();
             }
             else {
-                R = SqrJT.matrixR().topRows(colsNum).triangularView<Eigen::Upper>();
+                R = sortedR.topRows(colsNum).triangularView<Eigen::Upper>();
             }
 
 #ifdef _GCS_DEBUG_SOLVER_JACOBIAN_QR_DECOMPOSITION_TRIANGULAR_MATRIX
@@ -5359,9 +5796,9 @@ void System::makeSparseQRDecomposition(
     }
 
 #ifdef _GCS_DEBUG_SOLVER_JACOBIAN_QR_DECOMPOSITION_TRIANGULAR_MATRIX
-    if (J.rows() > 0 && !silent) {
+    if (SJ.rows() > 0 && !silent) {
 
-        SolverReportingManager::Manager().LogMatrix("R", R);
+        SolverReportingManager::Manager().LogMatrix("R", Eigen::MatrixXd(R));
 
         SolverReportingManager::Manager().LogMatrix("R2", R2);
 
@@ -5376,30 +5813,44 @@ void System::makeSparseQRDecomposition(
 void System::identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
                                                 const std::map<int, int>& jacobianconstraintmap,
                                                 const GCS::VEC_pD& pdiagnoselist,
+                                                GCS::VEC_pD& pdependentparameters,
+                                                std::vector<VEC_pD>& pdependentparametersgroups,
                                                 bool silent)
 {
     Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJ;
     Eigen::MatrixXd Rparams;
+    Eigen::SparseMatrix<double> nonpivotcols;
 
     int rank;
 
     makeDenseQRDecomposition(J, jacobianconstraintmap, qrJ, rank, Rparams, false, true);
 
-    identifyDependentParameters(qrJ, Rparams, rank, pdiagnoselist, silent);
+    makeNonPivotColumns(Rparams, rank, nonpivotcols);
+
+    identifyDependentParameters(qrJ,
+                                nonpivotcols,
+                                rank,
+                                pdiagnoselist,
+                                pdependentparameters,
+                                pdependentparametersgroups,
+                                silent);
 }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-void System::identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
+void System::identifyDependentParametersSparseQR(const Eigen::SparseMatrix<double>& SJ,
                                                  const std::map<int, int>& jacobianconstraintmap,
                                                  const GCS::VEC_pD& pdiagnoselist,
+                                                 GCS::VEC_pD& pdependentparameters,
+                                                 std::vector<VEC_pD>& pdependentparametersgroups,
                                                  bool silent)
 {
     Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJ;
-    Eigen::MatrixXd Rparams;
+    Eigen::SparseMatrix<double> Rparams;
+    Eigen::SparseMatrix<double> nonpivotcols;
 
     int nontransprank;
 
-    makeSparseQRDecomposition(J,
+    makeSparseQRDecomposition(SJ,
                               jacobianconstraintmap,
                               SqrJ,
                               nontransprank,
@@ -5407,15 +5858,25 @@ void System::identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
                               false,
                               true);  // do not transpose allow to diagnose parameters
 
-    identifyDependentParameters(SqrJ, Rparams, nontransprank, pdiagnoselist, silent);
+    makeNonPivotColumns(Rparams, nontransprank, nonpivotcols);
+
+    identifyDependentParameters(SqrJ,
+                                nonpivotcols,
+                                nontransprank,
+                                pdiagnoselist,
+                                pdependentparameters,
+                                pdependentparametersgroups,
+                                silent);
 }
 #endif
 
 template<typename T>
 void System::identifyDependentParameters(T& qrJ,
-                                         Eigen::MatrixXd& Rparams,
+                                         const Eigen::SparseMatrix<double>& nonpivotcols,
                                          int rank,
                                          const GCS::VEC_pD& pdiagnoselist,
+                                         GCS::VEC_pD& pdependentparameters,
+                                         std::vector<VEC_pD>& pdependentparametersgroups,
                                          bool silent)
 {
     (void)silent;  // silent is only used in debug code, but it is important as Base::Console is not
@@ -5424,28 +5885,27 @@ void System::identifyDependentParameters(T& qrJ,
     // int constrNum = SqrJ.rows(); // this is the other way around than for the transposed J
     // int paramsNum = SqrJ.cols();
 
-    eliminateNonZerosOverPivotInUpperTriangularMatrix(Rparams, rank);
-
 #ifdef _GCS_DEBUG
     if (!silent) {
-        SolverReportingManager::Manager().LogMatrix("Rparams_nonzeros_over_pilot", Rparams);
+        SolverReportingManager::Manager().LogMatrix("Rparams_nonzeros_over_pilot",
+                                                    Eigen::MatrixXd(nonpivotcols));
     }
 #endif
 
-    pDependentParametersGroups.resize(qrJ.cols() - rank);
+    pdependentparametersgroups.resize(qrJ.cols() - rank);
     for (int j = rank; j < qrJ.cols(); j++) {
-        for (int row = 0; row < rank; row++) {
-            if (fabs(Rparams(row, j)) > 1e-10) {
-                int origCol = qrJ.colsPermutation().indices()[row];
+        for (Eigen::SparseMatrix<double>::InnerIterator it(nonpivotcols, j - rank); it; ++it) {
+            if (fabs(it.value()) > 1e-10) {
+                int origCol = qrJ.colsPermutation().indices()[it.row()];
 
-                pDependentParametersGroups[j - rank].push_back(pdiagnoselist[origCol]);
-                pDependentParameters.push_back(pdiagnoselist[origCol]);
+                pdependentparametersgroups[j - rank].push_back(pdiagnoselist[origCol]);
+                pdependentparameters.push_back(pdiagnoselist[origCol]);
             }
         }
         int origCol = qrJ.colsPermutation().indices()[j];
 
-        pDependentParametersGroups[j - rank].push_back(pdiagnoselist[origCol]);
-        pDependentParameters.push_back(pdiagnoselist[origCol]);
+        pdependentparametersgroups[j - rank].push_back(pdiagnoselist[origCol]);
+        pdependentparameters.push_back(pdiagnoselist[origCol]);
     }
 
 #ifdef _GCS_DEBUG
@@ -5454,7 +5914,7 @@ void System::identifyDependentParameters(T& qrJ,
                                                     (Eigen::MatrixXd)qrJ.colsPermutation());
 
         SolverReportingManager::Manager().LogGroupOfParameters("ParameterGroups",
-                                                               pDependentParametersGroups);
+                                                               pdependentparametersgroups);
     }
 
 #endif
@@ -5549,6 +6009,28 @@ void System::identifyDependentGeometryParametersInTransposedJacobianDenseQRDecom
     }
 }
 
+void System::makeNonPivotColumns(Eigen::MatrixXd& R,
+                                 int rank,
+                                 Eigen::SparseMatrix<double>& nonpivotcols)
+{
+    eliminateNonZerosOverPivotInUpperTriangularMatrix(R, rank);
+
+    nonpivotcols = R.block(0, rank, rank, R.cols() - rank).sparseView();
+}
+
+void System::makeNonPivotColumns(const Eigen::SparseMatrix<double>& R,
+                                 int rank,
+                                 Eigen::SparseMatrix<double>& nonpivotcols)
+{
+    // Eliminating the non zeros over the pivots turns R = [R11 R12] into [D D*R11^-1*R12], where D
+    // is the diagonal of R11. So this is a sparse triangular solve instead of a dense elimination.
+    Eigen::SparseMatrix<double> R11 = R.topLeftCorner(rank, rank);
+    Eigen::SparseMatrix<double> R12 = R.block(0, rank, rank, R.cols() - rank);
+    R11.triangularView<Eigen::Upper>().solveInPlace(R12);
+    Eigen::VectorXd pivots = R11.diagonal();
+    nonpivotcols = pivots.asDiagonal() * R12;
+}
+
 void System::eliminateNonZerosOverPivotInUpperTriangularMatrix(Eigen::MatrixXd& R, int rank)
 {
     for (int i = 1; i < rank; i++) {
@@ -5566,24 +6048,18 @@ void System::eliminateNonZerosOverPivotInUpperTriangularMatrix(Eigen::MatrixXd&
 }
 
 template<typename T>
-void System::identifyConflictingRedundantConstraints(
-    Algorithm alg,
-    const T& qrJT,
-    const std::map<int, int>& jacobianconstraintmap,
-    const std::map<int, int>& tagmultiplicity,
-    GCS::VEC_pD& pdiagnoselist,
-    Eigen::MatrixXd& R,
-    int constrNum,
-    int rank,
-    int& nonredundantconstrNum)
-{
-    eliminateNonZerosOverPivotInUpperTriangularMatrix(R, rank);
-
-    std::vector<std::vector<Constraint*>> conflictGroups(constrNum - rank);
+void System::makeConflictGroups(const T& qrJT,
+                                const std::map<int, int>& jacobianconstraintmap,
+                                const Eigen::SparseMatrix<double>& nonpivotcols,
+                                int constrNum,
+                                int rank,
+                                std::vector<std::vector<Constraint*>>& conflictGroups)
+{
+    conflictGroups.resize(constrNum - rank);
     for (int j = rank; j < constrNum; j++) {
-        for (int row = 0; row < rank; row++) {
-            if (fabs(R(row, j)) > 1e-10) {
-                int origCol = qrJT.colsPermutation().indices()[row];
+        for (Eigen::SparseMatrix<double>::InnerIterator it(nonpivotcols, j - rank); it; ++it) {
+            if (fabs(it.value()) > 1e-10) {
+                int origCol = qrJT.colsPermutation().indices()[it.row()];
 
                 conflictGroups[j - rank].push_back(clist[jacobianconstraintmap.at(origCol)]);
             }
@@ -5592,6 +6068,13 @@ void System::identifyConflictingRedundantConstraints(
 
         conflictGroups[j - rank].push_back(clist[jacobianconstraintmap.at(origCol)]);
     }
+}
+
+void System::identifyConflictingRedundantConstraints(Algorithm alg,
+                                                     const std::map<int, int>& tagmultiplicity,
+                                                     DiagnosisComponent& component)
+{
+    std::vector<std::vector<Constraint*>>& conflictGroups = component.conflictGroups;
 
     // Augment the information regarding the group of constraints that are conflicting or redundant.
     if (debugMode == IterationLevel) {
@@ -5700,48 +6183,47 @@ void System::identifyConflictingRedundantConstraints(
     }
 
     std::vector<Constraint*> clistTmp;
-    clistTmp.reserve(clist.size());
-    for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end();
-         ++constr) {
-        if ((*constr)->isDriving() && skipped.count(*constr) == 0) {
-            clistTmp.push_back(*constr);
+    clistTmp.reserve(component.constraints.size());
+    for (int i : component.constraints) {
+        if (skipped.count(clist[i]) == 0) {
+            clistTmp.push_back(clist[i]);
         }
     }
 
-    SubSystem* subSysTmp = new SubSystem(clistTmp, pdiagnoselist);
-    int res = solve(subSysTmp, true, alg, true);
-
-    if (debugMode == Minimal || debugMode == IterationLevel) {
-        std::string solvername;
-        switch (alg) {
-            case 0:
-                solvername = "BFGS";
-                break;
-            case 1:  // solving with the LevenbergMarquardt solver
-                solvername = "LevenbergMarquardt";
-                break;
-            case 2:  // solving with the BFGS solver
-                solvername = "DogLeg";
-                break;
-        }
+    // The redundant solving only touches the parameters of the component, so the components can
+    // be solved concurrently. The values are restored afterwards instead of resetting the whole
+    // system to its reference.
+    int res = Success;
+    VEC_D values;
+    values.reserve(component.params.size());
+    for (auto param : component.params) {
+        values.push_back(*param);
+    }
 
-        Base::Console().Log("Sketcher::RedundantSolving-%s-\n", solvername.c_str());
+    std::unique_ptr<SubSystem> subSysTmp;
+    if (!component.params.empty()) {
+        subSysTmp = std::make_unique<SubSystem>(clistTmp, component.params);
+        res = solve(subSysTmp.get(), true, alg, true);
     }
 
+    component.hasRedundantSolving = true;
+    component.redundantSolvingResult = res;
+
+    int constrNum = component.constrNum;
     if (res == Success) {
-        subSysTmp->applySolution();
+        if (subSysTmp) {
+            subSysTmp->applySolution();
+        }
         for (std::set<Constraint*>::const_iterator constr = skipped.begin();
              constr != skipped.end();
              ++constr) {
             double err = (*constr)->error();
             if (err * err < convergenceRedundant) {
-                redundant.insert(*constr);
+                component.redundant.insert(*constr);
             }
         }
-        resetToReference();
-
-        if (debugMode == Minimal || debugMode == IterationLevel) {
-            Base::Console().Log("Sketcher Redundant solving: %d redundants\n", redundant.size());
+        for (std::size_t i = 0; i < component.params.size(); i++) {
+            *component.params[i] = values[i];
         }
 
         std::vector<std::vector<Constraint*>> conflictGroupsOrig = conflictGroups;
@@ -5749,7 +6231,7 @@ void System::identifyConflictingRedundantConstraints(
         for (int i = conflictGroupsOrig.size() - 1; i >= 0; i--) {
             bool isRedundant = false;
             for (std::size_t j = 0; j < conflictGroupsOrig[i].size(); j++) {
-                if (redundant.count(conflictGroupsOrig[i][j]) > 0) {
+                if (component.redundant.count(conflictGroupsOrig[i][j]) > 0) {
                     isRedundant = true;
 
                     if (debugMode == IterationLevel) {
@@ -5770,8 +6252,13 @@ void System::identifyConflictingRedundantConstraints(
             }
         }
     }
-    delete subSysTmp;
 
+    component.nonredundantConstrNum = constrNum;
+}
+
+void System::setConflictingRedundantTags(
+    const std::vector<std::vector<Constraint*>>& conflictGroups)
+{
     // simplified output of conflicting tags
     SET_I conflictingTagsSet;
     for (std::size_t i = 0; i < conflictGroups.size(); i++) {
@@ -5816,18 +6303,34 @@ void System::identifyConflictingRedundantConstraints(
     std::copy(partiallyRedundantTagsSet.begin(),
               partiallyRedundantTagsSet.end(),
               partiallyRedundantTags.begin());
-
-    nonredundantconstrNum = constrNum;
 }
 
 
 void System::clearSubSystems()
 {
     isInit = false;
-    free(subSystems);
+    // the subsystems of the base components are kept for the next initSolution()
+    for (std::size_t cid = 0; cid < subSystems.size(); cid++) {
+        if (subSystemsBase[cid] < 0) {
+            delete subSystems[cid];
+        }
+    }
     free(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    subSystemsBase.clear();
+}
+
+void System::clearBaseComponents()
+{
+    clearSubSystems();
+    for (auto& base : baseComponents) {
+        delete base.subSystem;
+    }
+    baseComponents.clear();
+    baseConstraints.clear();
+    paramsBase.clear();
+    hasBaseComponents = false;
 }
 
 double lineSearch(SubSystem* subsys, Eigen::VectorXd& xdir)
@@ -122,35 +122,69 @@ private:
     std::map<double*, std::vector<Constraint*>> p2c;  // parameter to constraint adjacency list
 
     std::vector<SubSystem*> subSystems, subSystemsAux;
+    VEC_I subSystemsBase;  // base component whose subsystem is in subSystems, or -1 if owned
     void clearSubSystems();
 
     VEC_D reference;
     void setReference();      // copies the current parameter values to reference
     void resetToReference();  // reverts all parameter values to the stored reference
 
-    std::vector<VEC_pD> plists;  // partitioned plist except equality constraints
-    // partitioned clist except equality constraints
-    std::vector<std::vector<Constraint*>> clists;
-    std::vector<MAP_pD_pD> reductionmaps;  // for simplification of equality constraints
+    // A decoupled component of the system without the constraints with tag < 0. The components
+    // of the system are unions of base components joined by the constraints with tag < 0, so as
+    // long as only constraints with tag < 0 (e.g. for dragging) are added or removed, the base
+    // components and their subsystems are kept and initSolution() only rebuilds the components
+    // that the constraints with tag < 0 join.
+    struct BaseComponent
+    {
+        VEC_I params;            // indices in plist
+        VEC_I constraints;       // indices in baseConstraints, except equality constraints
+        MAP_pD_pD reductionmap;  // for simplification of equality constraints
+        SubSystem* subSystem = nullptr;  // of the constraints, created when first needed
+    };
+    std::vector<BaseComponent> baseComponents;
+    std::vector<Constraint*> baseConstraints;  // constraints with tag >= 0 which are not redundant
+    VEC_I paramsBase;                          // base component of each parameter of plist
+    void makeBaseComponents();
+    void clearBaseComponents();
+    SubSystem* getBaseSubSystem(int baseId);
+    VEC_pD getBaseParams(const VEC_I& params) const;
 
     int dofs;
     std::set<Constraint*> redundant;
     VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
 
-    bool hasUnknowns;   // if plist is filled with the unknown parameters
-    bool hasDiagnosis;  // if dofs, conflictingTags, redundantTags are up to date
-    bool isInit;        // if plists, clists, reductionmaps are up to date
+    bool hasUnknowns;        // if plist is filled with the unknown parameters
+    bool hasBaseComponents;  // if baseComponents are up to date
+    bool hasDiagnosis;       // if dofs, conflictingTags, redundantTags are up to date
+    bool isInit;             // if subSystems, subSystemsAux are up to date
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
+    // Jacobian is either Eigen::MatrixXd or Eigen::SparseMatrix<double>
+    template<typename Jacobian>
+    int solve_LM(SubSystem* subsys, bool isRedundantsolving);
+    template<typename Jacobian>
+    int solve_DL(SubSystem* subsys, bool isRedundantsolving);
+
+    // The parameters and driving constraints of a decoupled part of the system together with
+    // the results of its diagnosis, see diagnose()
+    struct DiagnosisComponent;
+
+    // Returns the number of threads used for the decoupled parts of the system, 0 means one
+    // per core
+    int getNumberOfThreads() const;
+
+    void makeDiagnosisComponents(GCS::VEC_pD& pdiagnoselist,
+                                 std::map<int, int>& tagmultiplicity,
+                                 std::vector<DiagnosisComponent>& components);
 
-    void makeReducedJacobian(Eigen::MatrixXd& J,
-                             std::map<int, int>& jacobianconstraintmap,
-                             GCS::VEC_pD& pdiagnoselist,
-                             std::map<int, int>& tagmultiplicity);
+    void diagnoseComponent(Algorithm alg,
+                           const std::map<int, int>& tagmultiplicity,
+                           DiagnosisComponent& component,
+                           bool concurrent);
 
     void makeDenseQRDecomposition(const Eigen::MatrixXd& J,
                                   const std::map<int, int>& jacobianconstraintmap,
@@ -162,11 +196,11 @@ private:
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
     void makeSparseQRDecomposition(
-        const Eigen::MatrixXd& J,
+        const Eigen::SparseMatrix<double>& SJ,
         const std::map<int, int>& jacobianconstraintmap,
         Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>& SqrJT,
         int& rank,
-        Eigen::MatrixXd& R,
+        Eigen::SparseMatrix<double>& R,
         bool transposeJ = true,
         bool silent = false);
 #endif
@@ -180,35 +214,53 @@ private:
         int rank);
 
     template<typename T>
+    void makeConflictGroups(const T& qrJT,
+                            const std::map<int, int>& jacobianconstraintmap,
+                            const Eigen::SparseMatrix<double>& nonpivotcols,
+                            int constrNum,
+                            int rank,
+                            std::vector<std::vector<Constraint*>>& conflictGroups);
+
     void identifyConflictingRedundantConstraints(Algorithm alg,
-                                                 const T& qrJT,
-                                                 const std::map<int, int>& jacobianconstraintmap,
                                                  const std::map<int, int>& tagmultiplicity,
-                                                 GCS::VEC_pD& pdiagnoselist,
-                                                 Eigen::MatrixXd& R,
-                                                 int constrNum,
-                                                 int rank,
-                                                 int& nonredundantconstrNum);
+                                                 DiagnosisComponent& component);
+
+    void setConflictingRedundantTags(const std::vector<std::vector<Constraint*>>& conflictGroups);
 
     void eliminateNonZerosOverPivotInUpperTriangularMatrix(Eigen::MatrixXd& R, int rank);
 
+    // The columns of the upper trapezoidal R after the rank-th one, once the non zeros over the
+    // pivots are eliminated. A non zero in a row means a dependency on the pivot of the row.
+    void makeNonPivotColumns(Eigen::MatrixXd& R,
+                             int rank,
+                             Eigen::SparseMatrix<double>& nonpivotcols);
+    void makeNonPivotColumns(const Eigen::SparseMatrix<double>& R,
+                             int rank,
+                             Eigen::SparseMatrix<double>& nonpivotcols);
+
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
-    void identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
+    void identifyDependentParametersSparseQR(const Eigen::SparseMatrix<double>& SJ,
                                              const std::map<int, int>& jacobianconstraintmap,
                                              const GCS::VEC_pD& pdiagnoselist,
+                                             GCS::VEC_pD& pdependentparameters,
+                                             std::vector<VEC_pD>& pdependentparametersgroups,
                                              bool silent = true);
 #endif
 
     void identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
                                             const std::map<int, int>& jacobianconstraintmap,
                                             const GCS::VEC_pD& pdiagnoselist,
+                                            GCS::VEC_pD& pdependentparameters,
+                                            std::vector<VEC_pD>& pdependentparametersgroups,
                                             bool silent = true);
 
     template<typename T>
     void identifyDependentParameters(T& qrJ,
-                                     Eigen::MatrixXd& Rparams,
+                                     const Eigen::SparseMatrix<double>& nonpivotcols,
                                      int rank,
                                      const GCS::VEC_pD& pdiagnoselist,
+                                     GCS::VEC_pD& pdependentparameters,
+                                     std::vector<VEC_pD>& pdependentparametersgroups,
                                      bool silent = true);
 
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
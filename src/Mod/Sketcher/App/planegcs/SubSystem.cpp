@@ -24,6 +24,7 @@
 #pragma warning(disable : 4251)
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
@@ -33,6 +34,9 @@
 namespace GCS
 {
 
+// minimal number of constraints of a type in a subsystem to evaluate them in a ConstraintBlock
+const int ConstraintBlockMinSize = 16;
+
 // SubSystem
 SubSystem::SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params)
     : clist(clist_)
@@ -118,6 +122,8 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
 
     c2p.clear();
     p2c.clear();
+    c2i.clear();
+    c2i.reserve(csize);
     for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end();
          ++constr) {
         (*constr)->revertParams();  // ensure that the constraint points to the original parameters
@@ -130,13 +136,92 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
                 constr_params.insert(pmapfind->second);
             }
         }
+        VEC_I constr_indices;
         for (SET_pD::const_iterator p = constr_params.begin(); p != constr_params.end(); ++p) {
             //            jacobi.set(*constr, *p, 0.);
             c2p[*constr].push_back(*p);
             p2c[*p].push_back(*constr);
+            constr_indices.push_back(static_cast<int>(*p - pvals.data()));
         }
+        std::sort(constr_indices.begin(), constr_indices.end());
+        c2i.push_back(constr_indices);
         //        (*constr)->redirectParams(pmap); // redirect parameters to pvec
     }
+
+    // group the constraints of the same type into blocks, the blocks read the unknowns directly
+    // from pvals. Below ConstraintBlockMinSize constraints, the overhead of a block is larger than
+    // the virtual calls it saves.
+    std::map<ConstraintType, int> typecounts;
+    for (Constraint* constr : clist) {
+        typecounts[constr->getTypeId()]++;
+    }
+    blocks.clear();
+    unbatched.clear();
+    std::map<ConstraintType, ConstraintBlock*> typeblocks;
+    for (const auto& typecount : typecounts) {
+        std::unique_ptr<ConstraintBlock> block;
+        if (typecount.second >= ConstraintBlockMinSize) {
+            block = ConstraintBlock::create(typecount.first);
+        }
+        typeblocks[typecount.first] = block.get();
+        if (block) {
+            blocks.push_back(std::move(block));
+        }
+    }
+    for (int i = 0; i < csize; i++) {
+        VEC_pD constr_params = clist[i]->params();
+        ConstraintBlock* block = typeblocks[clist[i]->getTypeId()];
+        if (!block || int(constr_params.size()) != block->slotsNumber()) {
+            unbatched.push_back(i);
+            continue;
+        }
+
+        VEC_I columns;
+        for (auto& param : constr_params) {
+            MAP_pD_pD::const_iterator pmapfind = pmap.find(param);
+            if (pmapfind != pmap.end()) {
+                param = pmapfind->second;
+                columns.push_back(static_cast<int>(param - pvals.data()));
+            }
+            else {
+                columns.push_back(-1);
+            }
+        }
+        block->add(clist[i], i, constr_params, columns);
+    }
+
+    // the sparsity pattern of the jacobi matrix does not change, so the positions of the
+    // derivatives in its non zeros are found once here
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (const auto& block : blocks) {
+        const VEC_I& rows = block->getRows();
+        for (int slot = 0; slot < block->slotsNumber(); slot++) {
+            const VEC_I& columns = block->getColumns(slot);
+            for (int k = 0; k < block->size(); k++) {
+                if (columns[k] >= 0) {
+                    triplets.emplace_back(rows[k], columns[k], 0.);
+                }
+            }
+        }
+    }
+    for (int i : unbatched) {
+        for (int j : c2i[i]) {
+            triplets.emplace_back(i, j, 0.);
+        }
+    }
+    jacobiPattern.resize(csize, psize);
+    jacobiPattern.setFromTriplets(triplets.begin(), triplets.end());
+
+    jacobiEntries.clear();
+    jacobiEntries.reserve(triplets.size());
+    const int* outer = jacobiPattern.outerIndexPtr();
+    const int* inner = jacobiPattern.innerIndexPtr();
+    for (const auto& triplet : triplets) {
+        const int* begin = inner + outer[triplet.col()];
+        const int* end = inner + outer[triplet.col() + 1];
+        const int* entry = std::lower_bound(begin, end, triplet.row());
+        jacobiEntries.push_back(static_cast<int>(entry - inner));
+    }
 }
 
 void SubSystem::redirectParams()
@@ -273,7 +358,51 @@ void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
 
 void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
 {
-    calcJacobi(plist, jacobi);
+    // only the parameters of a constraint can have a non zero derivative
+    jacobi.setZero(csize, psize);
+    for (const auto& block : blocks) {
+        block->calcDerivatives();
+        const VEC_I& rows = block->getRows();
+        for (int slot = 0; slot < block->slotsNumber(); slot++) {
+            const VEC_I& columns = block->getColumns(slot);
+            const Eigen::ArrayXd& derivatives = block->getDerivatives(slot);
+            for (int k = 0; k < block->size(); k++) {
+                if (columns[k] >= 0) {
+                    jacobi(rows[k], columns[k]) += derivatives[k];
+                }
+            }
+        }
+    }
+    for (int i : unbatched) {
+        for (int j : c2i[i]) {
+            jacobi(i, j) = clist[i]->grad(&pvals[j]);
+        }
+    }
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double>& jacobi)
+{
+    // duplicated entries are summed as setFromTriplets would do
+    jacobi = jacobiPattern;
+    double* values = jacobi.valuePtr();
+    VEC_I::const_iterator entry = jacobiEntries.begin();
+    for (const auto& block : blocks) {
+        block->calcDerivatives();
+        for (int slot = 0; slot < block->slotsNumber(); slot++) {
+            const VEC_I& columns = block->getColumns(slot);
+            const Eigen::ArrayXd& derivatives = block->getDerivatives(slot);
+            for (int k = 0; k < block->size(); k++) {
+                if (columns[k] >= 0) {
+                    values[*entry++] += derivatives[k];
+                }
+            }
+        }
+    }
+    for (int i : unbatched) {
+        for (int j : c2i[i]) {
+            values[*entry++] += clist[i]->grad(&pvals[j]);
+        }
+    }
 }
 
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
@@ -296,7 +425,26 @@ void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
 
 void SubSystem::calcGrad(Eigen::VectorXd& grad)
 {
-    calcGrad(plist, grad);
+    assert(grad.size() == psize);
+
+    if (blocks.empty()) {
+        grad.setZero();
+        for (int i = 0; i < csize; i++) {
+            double error = clist[i]->error();
+            for (int j : c2i[i]) {
+                grad[j] += error * clist[i]->grad(&pvals[j]);
+            }
+        }
+        return;
+    }
+
+    // the gradient of the error is J^T*r, the sum over the rows of each column adds the
+    // contributions of the constraints in the order of clist
+    Eigen::VectorXd r(csize);
+    calcResidual(r);
+    Eigen::SparseMatrix<double> jacobi;
+    calcJacobi(jacobi);
+    grad = jacobi.transpose() * r;
 }
 
 double SubSystem::maxStep(VEC_pD& params, Eigen::VectorXd& xdir)
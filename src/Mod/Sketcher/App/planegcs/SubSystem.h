@@ -26,8 +26,12 @@
 #undef min
 #undef max
 
+#include <memory>
+
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
+#include "ConstraintBlock.h"
 #include "Constraints.h"
 
 
@@ -45,6 +49,11 @@ private:
                      //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
     std::map<Constraint*, VEC_pD> c2p;                // constraint to parameter adjacency list
     std::map<double*, std::vector<Constraint*>> p2c;  // parameter to constraint adjacency list
+    std::vector<VEC_I> c2i;  // indices in pvals of the parameters of each constraint of clist
+    std::vector<std::unique_ptr<ConstraintBlock>> blocks;  // constraints evaluated by type
+    VEC_I unbatched;  // indices in clist of the constraints evaluated one at a time
+    Eigen::SparseMatrix<double> jacobiPattern;  // non zeros of the jacobi matrix, all set to 0
+    VEC_I jacobiEntries;  // position in the non zeros of each derivative, in evaluation order
     void initialize(VEC_pD& params, MAP_pD_pD& reductionmap);  // called by the constructors
 public:
     SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params);
@@ -78,6 +87,7 @@ public:
     void calcResidual(Eigen::VectorXd& r, double& err);
     void calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi);
     void calcJacobi(Eigen::MatrixXd& jacobi);
+    void calcJacobi(Eigen::SparseMatrix<double>& jacobi);
     void calcGrad(VEC_pD& params, Eigen::VectorXd& grad);
     void calcGrad(Eigen::VectorXd& grad);
 
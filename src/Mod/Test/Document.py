@@ -1720,6 +1720,29 @@ class DocumentExpressionCases(unittest.TestCase):
         self.assertEqual(self.Obj3.Float, 4)
         self.assertEqual(self.Obj3.evalExpression(self.Obj3.ExpressionEngine[0][1]), 4)
 
+    def testExpressionStats(self):
+        obj = self.Doc.addObject("App::FeatureTest", "Test")
+        obj.setExpression("Float", "Integer * 2")
+        self.Doc.recompute()
+        stats = obj.getExpressionStats()
+        self.assertEqual(stats["evaluated"], 1)
+
+        # the input of the expression is unchanged, the expression is skipped
+        obj.String = "changed"
+        self.Doc.recompute()
+        self.assertEqual(obj.getExpressionStats()["evaluated"], stats["evaluated"])
+        self.assertGreater(obj.getExpressionStats()["skipped"], stats["skipped"])
+
+        # touch() enforces the evaluation
+        obj.touch()
+        self.Doc.recompute()
+        self.assertEqual(obj.getExpressionStats()["evaluated"], stats["evaluated"] + 1)
+
+        obj.Integer = obj.Integer + 1
+        self.Doc.recompute()
+        self.assertEqual(obj.getExpressionStats()["evaluated"], stats["evaluated"] + 2)
+        self.assertEqual(obj.Float, obj.Integer * 2)
+
     def testIssue4649(self):
         class Cls:
             def __init__(self, obj):
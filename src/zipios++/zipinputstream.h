@@ -49,6 +49,10 @@ public:
   */
   ConstEntryPointer getNextEntry() ;
 
+  /** Reads the data of the current entry without decompressing it, see
+      ZipInputStreambuf::readRawEntry(). */
+  void readRawEntry( std::string &data ) ;
+
   /** Destructor. */
   virtual ~ZipInputStream() ;
 
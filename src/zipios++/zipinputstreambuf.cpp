@@ -79,6 +79,24 @@ ConstEntryPointer ZipInputStreambuf::getNextEntry() {
 }
 
 
+void ZipInputStreambuf::readRawEntry( std::string &data ) {
+  data.clear() ;
+  if ( ! _open_entry )
+    return ;
+
+  _inbuf->pubseekpos( _data_start ) ;
+  data.resize( _curr_entry.getCompressedSize() ) ;
+  int g = data.empty() ? 0 : _inbuf->sgetn( &( data[ 0 ] ), data.size() ) ;
+  data.resize( g > 0 ? g : 0 ) ;
+
+  // The stream is now positioned at the next entry
+  _open_entry = false ;
+  setg( &( _outvec[ 0 ] ),
+	&( _outvec[ 0 ] ) + _outvecsize,
+	&( _outvec[ 0 ] ) + _outvecsize ) ;
+}
+
+
 ZipInputStreambuf::~ZipInputStreambuf() {
 }
 
@@ -39,6 +39,11 @@ public:
   */
   ConstEntryPointer getNextEntry() ;
 
+  /** Reads the data of the current entry as stored in the archive,
+      i.e. without decompressing it. The entry is closed afterwards.
+      @param data is set to the raw data of the entry. */
+  void readRawEntry( std::string &data ) ;
+
   /** Destructor. */
   virtual ~ZipInputStreambuf() ;
 protected:
@@ -54,6 +54,12 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes a complete entry with already deflated data, see
+      ZipOutputStreambuf::putRawEntry(). */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data,
+                    uint32 compressed_size, uint32 size, uint32 crc,
+                    StorageMethod method = DEFLATED ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
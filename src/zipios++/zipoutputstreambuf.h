@@ -49,6 +49,20 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry with already deflated data. The data
+      must be a raw deflate stream, i.e. without zlib header, as
+      produced by deflateInit2() with negative window bits.
+      @param entry the entry to write.
+      @param data the deflated data.
+      @param compressed_size the size of the deflated data.
+      @param size the size of the uncompressed data.
+      @param crc the crc32 of the uncompressed data.
+      @param method DEFLATED, or STORED if data is the uncompressed
+      content, in which case compressed_size must equal size. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data,
+                    uint32 compressed_size, uint32 size, uint32 crc,
+                    StorageMethod method = DEFLATED ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Compares the Tree and the Flat storage of Data::ElementMap with setElementName(),
+// find() by mapped and by indexed name, save() and restore().
+// Usage: App_ElementMap_benchmark [elements, default 100000]
+
+#include <Benchmark.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/ElementMap.h>
+#include <App/StringHasher.h>
+#include <src/App/InitApplication.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+void run(Data::ElementMap::Storage storage,
+         const std::vector<Data::MappedName>& names,
+         App::Document* doc)
+{
+    Data::ElementMap::setDefaultStorage(storage);
+    int count = static_cast<int>(names.size());
+
+    Data::ElementMapPtr elementMap;
+    Benchmark::report("  setElementName", Benchmark::bestOf(3, [&elementMap, &names, count] {
+                          elementMap = std::make_shared<Data::ElementMap>();
+                          for (int i = 0; i < count; ++i) {
+                              elementMap->setElementName(Data::IndexedName("Edge", i + 1),
+                                                         names[i],
+                                                         1);
+                          }
+                      }));
+    Benchmark::report("  find mapped name", Benchmark::bestOf(3, [&elementMap, &names] {
+                          for (const auto& name : names) {
+                              elementMap->find(name);
+                          }
+                      }));
+    Benchmark::report("  find indexed name", Benchmark::bestOf(3, [&elementMap, count] {
+                          for (int i = 0; i < count; ++i) {
+                              elementMap->find(Data::IndexedName("Edge", i + 1));
+                          }
+                      }));
+
+    std::string saved;
+    Benchmark::report("  save", Benchmark::bestOf(3, [&elementMap, &saved] {
+                          std::stringstream stream;
+                          elementMap->save(stream);
+                          saved = stream.str();
+                      }));
+    App::StringHasherRef hasher(new App::StringHasher);
+    Benchmark::report("  restore", Benchmark::bestOf(3, [&saved, &hasher, doc] {
+                          std::istringstream stream(saved);
+                          App::GetApplication().signalStartRestoreDocument(*doc);
+                          std::make_shared<Data::ElementMap>()->restore(hasher, stream);
+                      }));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    tests::initApplication();
+    std::string docName = App::GetApplication().getUniqueDocumentName("benchmark");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "benchmark");
+
+    // names like those of a boolean operation
+    unsigned long count = Benchmark::argument(argc, argv, 1, 100000);
+    std::vector<Data::MappedName> names;
+    names.reserve(count);
+    for (unsigned long i = 1; i <= count; ++i) {
+        names.emplace_back(Data::MappedName(("Edge" + std::to_string(i)).c_str()),
+                           (";:M;FUS;:H" + std::to_string(i % 97)).c_str());
+    }
+    std::printf("%lu elements\n", count);
+
+    auto oldStorage = Data::ElementMap::getDefaultStorage();
+    std::printf("Tree storage\n");
+    run(Data::ElementMap::Storage::Tree, names, doc);
+    std::printf("Flat storage\n");
+    run(Data::ElementMap::Storage::Flat, names, doc);
+    Data::ElementMap::setDefaultStorage(oldStorage);
+
+    App::GetApplication().closeDocument(docName.c_str());
+    return 0;
+}
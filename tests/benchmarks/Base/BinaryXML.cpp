@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Compares reading a document like Document.xml with XMLReader from the XML text against
+// reading it from its BinaryXML form, in memory as a project file is opened and memory
+// mapped from a file. Also times converting the XML text to the binary form.
+// Usage: Base_BinaryXML_benchmark [objects, default 10000]
+
+#include <Benchmark.h>
+#include <Base/BinaryXML.h>
+#include <Base/FileInfo.h>
+#include <Base/Reader.h>
+#include <Base/Stream.h>
+#include <sstream>
+#include <string>
+
+#include <xercesc/util/PlatformUtils.hpp>
+
+namespace
+{
+// Creates a document with the objects and the properties of each object
+std::string createDocument(unsigned long count)
+{
+    std::ostringstream out;
+    out << "<?xml version='1.0' encoding='utf-8'?>\n"
+        << "<Document SchemaVersion=\"4\" ProgramVersion=\"0.22\" FileVersion=\"1\">\n"
+        << "    <Objects Count=\"" << count << "\">\n";
+    for (unsigned long i = 0; i < count; i++) {
+        out << "        <Object type=\"Part::Box\" name=\"Box" << i << "\" id=\"" << i
+            << "\" />\n";
+    }
+    out << "    </Objects>\n"
+        << "    <ObjectData Count=\"" << count << "\">\n";
+    for (unsigned long i = 0; i < count; i++) {
+        double pos = static_cast<double>(i) * 0.5;
+        out << "        <Object name=\"Box" << i << "\">\n"
+            << "            <Properties Count=\"6\">\n"
+            << "                <Property name=\"Label\" type=\"App::PropertyString\">\n"
+            << "                    <String value=\"Box &amp; " << i << "\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Length\" type=\"App::PropertyLength\">\n"
+            << "                    <Float value=\"10.0\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Width\" type=\"App::PropertyLength\">\n"
+            << "                    <Float value=\"20.0\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Height\" type=\"App::PropertyLength\">\n"
+            << "                    <Float value=\"30.0\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Placement\" type=\"App::PropertyPlacement\">\n"
+            << "                    <PropertyPlacement Px=\"" << pos << "\" Py=\"0\" Pz=\"0\" "
+            << "Q0=\"0\" Q1=\"0\" Q2=\"0\" Q3=\"1\" A=\"0\" Ox=\"0\" Oy=\"0\" Oz=\"1\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Shape\" type=\"Part::PropertyPartShape\">\n"
+            << "                    <Part file=\"PartShape" << i << ".brp\"/>\n"
+            << "                </Property>\n"
+            << "            </Properties>\n"
+            << "        </Object>\n";
+    }
+    out << "    </ObjectData>\n"
+        << "</Document>\n";
+    return out.str();
+}
+
+// Reads all elements and looks up the attributes like restoring the properties does
+std::size_t readDocument(Base::XMLReader& reader)
+{
+    std::size_t count = 0;
+    while (!reader.isEndOfDocument()) {
+        if (reader.readNextElement()) {
+            if (reader.hasAttribute("name")) {
+                count += std::string(reader.getAttribute("name")).size();
+            }
+            if (reader.hasAttribute("value")) {
+                count += std::string(reader.getAttribute("value")).size();
+            }
+        }
+    }
+    return count;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    XERCES_CPP_NAMESPACE::XMLPlatformUtils::Initialize();
+
+    unsigned long count = Benchmark::argument(argc, argv, 1, 10000);
+    std::string xml = createDocument(count);
+    std::string binary = Base::BinaryXML::fromXML(xml);
+    std::printf("%lu objects, XML %zu KB, binary %zu KB\n",
+                count,
+                xml.size() / 1024,
+                binary.size() / 1024);
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".fcbx");
+    {
+        Base::ofstream file(fi, std::ios::out | std::ios::binary);
+        file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+    }
+
+    Benchmark::report("BinaryXML::fromXML", Benchmark::bestOf(3, [&xml] {
+                          Base::BinaryXML::fromXML(xml);
+                      }));
+    Benchmark::report("read XML", Benchmark::bestOf(3, [&xml] {
+                          std::istringstream str(xml);
+                          Base::XMLReader reader("Document.xml", str);
+                          readDocument(reader);
+                      }));
+    Benchmark::report("read binary, in memory", Benchmark::bestOf(3, [&binary] {
+                          // the data is copied like when it's inflated from the project file
+                          Base::XMLReader reader("Document.xml",
+                                                 Base::BinaryXML::fromBuffer(binary));
+                          readDocument(reader);
+                      }));
+    Benchmark::report("read binary, memory mapped", Benchmark::bestOf(3, [&fi] {
+                          std::string path = fi.filePath();
+                          Base::XMLReader reader("Document.xml",
+                                                 Base::BinaryXML::fromFile(path.c_str()));
+                          readDocument(reader);
+                      }));
+
+    fi.deleteFile();
+    return 0;
+}
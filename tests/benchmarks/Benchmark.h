@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef TESTS_BENCHMARK_H
+#define TESTS_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace Benchmark
+{
+
+/**
+ * Calls \a func \a runs times and returns the best time in milliseconds.
+ */
+template<typename Func>
+double bestOf(int runs, Func func)
+{
+    using Clock = std::chrono::steady_clock;
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < runs; i++) {
+        auto start = Clock::now();
+        func();
+        std::chrono::duration<double, std::milli> time = Clock::now() - start;
+        best = std::min(best, time.count());
+    }
+    return best;
+}
+
+/**
+ * Returns the command line argument \a index as a number, or \a preset if it isn't given.
+ */
+inline unsigned long argument(int argc, char** argv, int index, unsigned long preset)
+{
+    if (index < argc) {
+        return std::strtoul(argv[index], nullptr, 10);
+    }
+    return preset;
+}
+
+/**
+ * Prints the time of a benchmark.
+ */
+inline void report(const char* name, double ms)
+{
+    std::printf("%-56s %10.2f ms\n", name, ms);
+}
+
+}  // namespace Benchmark
+
+#endif  // TESTS_BENCHMARK_H
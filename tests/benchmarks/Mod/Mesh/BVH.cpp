@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Compares MeshFacetBVH against MeshFacetGrid on a mesh of uneven density, a fine
+// patch next to two huge facets, for the build and for ray and nearest facet queries.
+// Usage: Mesh_BVH_benchmark [points per side of the patch, default 400] [queries, default 100]
+
+#include <Benchmark.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Creates two facets of 200 x 200 and a wavy patch of 0.01 spacing above them
+MeshCore::MeshKernel createSkewedMesh(unsigned long size)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    points.push_back(MeshCore::MeshPoint(-100.0F, -100.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(100.0F, -100.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(100.0F, 100.0F, 0.0F));
+    points.push_back(MeshCore::MeshPoint(-100.0F, 100.0F, 0.0F));
+    facets.push_back(MeshCore::MeshFacet(0, 1, 2));
+    facets.push_back(MeshCore::MeshFacet(0, 2, 3));
+
+    for (unsigned long i = 0; i < size; i++) {
+        for (unsigned long j = 0; j < size; j++) {
+            float x = static_cast<float>(i) * 0.01F;
+            float y = static_cast<float>(j) * 0.01F;
+            float z = 1.0F + 0.1F * std::sin(10.0F * x) * std::cos(10.0F * y);
+            points.push_back(MeshCore::MeshPoint(x, y, z));
+        }
+    }
+    for (unsigned long i = 0; i + 1 < size; i++) {
+        for (unsigned long j = 0; j + 1 < size; j++) {
+            MeshCore::PointIndex p = 4 + i * size + j;
+            facets.push_back(MeshCore::MeshFacet(p, p + size, p + 1));
+            facets.push_back(MeshCore::MeshFacet(p + 1, p + size, p + size + 1));
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    return kernel;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned long size = Benchmark::argument(argc, argv, 1, 400);
+    unsigned long count = Benchmark::argument(argc, argv, 2, 100);
+    MeshCore::MeshKernel kernel = createSkewedMesh(size);
+    std::printf("%lu facets\n", kernel.CountFacets());
+
+    Benchmark::report("build, grid", Benchmark::bestOf(3, [&kernel] {
+                          MeshCore::MeshFacetGrid grid(kernel);
+                      }));
+    Benchmark::report("build, BVH", Benchmark::bestOf(3, [&kernel] {
+                          MeshCore::MeshFacetBVH bvh(kernel);
+                      }));
+    MeshCore::MeshFacetGrid grid(kernel);
+    MeshCore::MeshFacetBVH bvh(kernel);
+    std::printf("memory, grid %zu KB, BVH %zu KB\n",
+                grid.GetMemSize() / 1024,
+                bvh.GetMemSize() / 1024);
+
+    // rays from above, slightly tilted, most of them hit the patch
+    float length = static_cast<float>(size) * 0.01F;
+    std::vector<std::pair<Base::Vector3f, Base::Vector3f>> rays;
+    for (unsigned long i = 0; i < count; i++) {
+        float t = static_cast<float>(i) / static_cast<float>(count);
+        Base::Vector3f start(-0.1F * length + 1.2F * length * t,
+                             -0.1F * length + 1.2F * length * std::fmod(7.0F * t, 1.0F),
+                             5.0F);
+        Base::Vector3f dir(0.1F * std::sin(13.0F * t), 0.1F * std::cos(11.0F * t), -1.0F);
+        rays.emplace_back(start, dir);
+    }
+
+    MeshCore::MeshAlgorithm alg(kernel);
+    Benchmark::report("rays, grid", Benchmark::bestOf(3, [&alg, &grid, &rays] {
+                          Base::Vector3f res;
+                          MeshCore::FacetIndex facet {};
+                          for (const auto& ray : rays) {
+                              alg.NearestFacetOnRay(ray.first, ray.second, grid, res, facet);
+                          }
+                      }));
+    Benchmark::report("rays, BVH", Benchmark::bestOf(3, [&alg, &bvh, &rays] {
+                          Base::Vector3f res;
+                          MeshCore::FacetIndex facet {};
+                          for (const auto& ray : rays) {
+                              alg.NearestFacetOnRay(ray.first, ray.second, bvh, res, facet);
+                          }
+                      }));
+    Benchmark::report("nearest facets, grid", Benchmark::bestOf(3, [&grid, &rays] {
+                          for (const auto& ray : rays) {
+                              grid.SearchNearestFromPoint(ray.first);
+                          }
+                      }));
+    Benchmark::report("nearest facets, BVH", Benchmark::bestOf(3, [&bvh, &rays] {
+                          for (const auto& ray : rays) {
+                              bvh.SearchNearestFromPoint(ray.first);
+                          }
+                      }));
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Compares building a MeshFacetGrid with its compact cell array against the nested
+// sets of cells used before, and times ray and nearest facet queries on the grid.
+// Usage: Mesh_Grid_benchmark [points per side, default 1000] [queries, default 1000]
+
+#include <Benchmark.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/Core/MeshTestHelpers.h>
+#include <set>
+
+namespace
+{
+using SetGrid = std::vector<std::vector<std::vector<std::set<MeshCore::ElementIndex>>>>;
+
+// Builds the nested sets of cells like MeshFacetGrid did before MeshGridCells
+class SetFacetGrid: public MeshCore::MeshFacetGrid
+{
+public:
+    explicit SetFacetGrid(const MeshCore::MeshKernel& mesh)
+        : MeshCore::MeshFacetGrid(mesh)
+    {}
+
+    void BuildSets(SetGrid& grid) const
+    {
+        grid.clear();
+        grid.resize(_ulCtGridsX);
+        for (auto& plane : grid) {
+            plane.resize(_ulCtGridsY);
+            for (auto& line : plane) {
+                line.resize(_ulCtGridsZ);
+            }
+        }
+
+        std::vector<unsigned long> cells;
+        for (MeshCore::ElementIndex i = 0; i < _pclMesh->CountFacets(); i++) {
+            cells.clear();
+            GetFacetCells(_pclMesh->GetFacet(i), cells);
+            for (unsigned long cell : cells) {
+                unsigned long x {}, y {}, z {};
+                GetPositionToIndex(cell, x, y, z);
+                grid[x][y][z].insert(i);
+            }
+        }
+    }
+};
+
+// Estimates the memory of the nested sets, a tree node holds three pointers, the color
+// and the value
+std::size_t getMemSize(const SetGrid& grid)
+{
+    std::size_t size = 0;
+    for (const auto& plane : grid) {
+        for (const auto& line : plane) {
+            size += line.capacity() * sizeof(std::set<MeshCore::ElementIndex>);
+            for (const auto& cell : line) {
+                size += cell.size() * (4 * sizeof(void*) + sizeof(MeshCore::ElementIndex));
+            }
+        }
+    }
+    return size;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned long size = Benchmark::argument(argc, argv, 1, 1000);
+    unsigned long count = Benchmark::argument(argc, argv, 2, 1000);
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(size);
+    std::printf("%lu facets\n", kernel.CountFacets());
+
+    Benchmark::report("build, cell array", Benchmark::bestOf(3, [&kernel] {
+                          MeshCore::MeshFacetGrid grid(kernel);
+                      }));
+    SetFacetGrid grid(kernel);
+    SetGrid sets;
+    Benchmark::report("build, nested sets", Benchmark::bestOf(3, [&grid, &sets] {
+                          grid.BuildSets(sets);
+                      }));
+    std::printf("memory, cell array %zu KB, nested sets %zu KB\n",
+                grid.GetMemSize() / 1024,
+                getMemSize(sets) / 1024);
+    SetGrid().swap(sets);
+
+    // points slightly above the mesh, rays start high above them
+    float length = static_cast<float>(size) * 0.1F;
+    std::vector<Base::Vector3f> points;
+    for (unsigned long i = 0; i < count; i++) {
+        float t = static_cast<float>(i) / static_cast<float>(count);
+        float x = length * t;
+        float y = length * std::fmod(7.3F * t, 1.0F);
+        points.emplace_back(x, y, std::sin(x) * std::cos(y) + 0.05F);
+    }
+
+    MeshCore::MeshAlgorithm alg(kernel);
+    Base::Vector3f dir(0.0F, 0.0F, -1.0F);
+    Benchmark::report("rays", Benchmark::bestOf(3, [&alg, &grid, &points, &dir] {
+                          Base::Vector3f res;
+                          MeshCore::FacetIndex facet {};
+                          for (const auto& pnt : points) {
+                              Base::Vector3f start(pnt.x, pnt.y, 2.0F);
+                              alg.NearestFacetOnRay(start, dir, grid, res, facet);
+                          }
+                      }));
+    Benchmark::report("nearest facets", Benchmark::bestOf(3, [&grid, &points] {
+                          for (const auto& pnt : points) {
+                              grid.SearchNearestFromPoint(pnt);
+                          }
+                      }));
+
+    return 0;
+}
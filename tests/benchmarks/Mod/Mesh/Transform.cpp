@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Compares MeshKernel::Transform(), which also updates the bounding box, and
+// CalcVertexNormals() with one and with all threads against the plain loops.
+// Usage: Mesh_Transform_benchmark [points per side, default 3000]
+
+#include <Benchmark.h>
+#include <Mod/Mesh/App/Core/Definitions.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/Core/MeshTestHelpers.h>
+
+int main(int argc, char** argv)
+{
+    unsigned long size = Benchmark::argument(argc, argv, 1, 3000);
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(size);
+    Base::Matrix4D mat = MeshTestHelpers::createMatrix();
+    std::printf("%lu points, %lu facets\n", kernel.CountPoints(), kernel.CountFacets());
+
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    Base::BoundBox3f box;
+    Benchmark::report("transform, loop", Benchmark::bestOf(5, [&points, &mat, &box] {
+                          box = Base::BoundBox3f();
+                          for (auto& pnt : points) {
+                              mat.multVec(pnt, pnt);
+                              box.Add(pnt);
+                          }
+                      }));
+
+    const MeshCore::MeshPointArray& kernelPoints = kernel.GetPoints();
+    const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+    Benchmark::report("vertex normals, loop", Benchmark::bestOf(5, [&kernelPoints, &facets] {
+                          std::vector<Base::Vector3f> normals(kernelPoints.size());
+                          for (const auto& face : facets) {
+                              const Base::Vector3f& p0 = kernelPoints[face._aulPoints[0]];
+                              const Base::Vector3f& p1 = kernelPoints[face._aulPoints[1]];
+                              const Base::Vector3f& p2 = kernelPoints[face._aulPoints[2]];
+                              Base::Vector3f normal = (p1 - p0) % (p2 - p0);
+                              for (auto index : face._aulPoints) {
+                                  normals[index] += normal;
+                              }
+                          }
+                          for (auto& normal : normals) {
+                              normal.Normalize();
+                          }
+                      }));
+
+    for (int threads : {1, 0}) {
+        MeshCore::MeshDefinitions::SetThreadCount(threads);
+        std::printf("%d thread(s)\n", MeshCore::MeshDefinitions::GetThreadCount());
+        Benchmark::report("  MeshKernel::Transform", Benchmark::bestOf(5, [&kernel, &mat] {
+                              kernel.Transform(mat);
+                          }));
+        Benchmark::report("  MeshKernel::CalcVertexNormals", Benchmark::bestOf(5, [&kernel] {
+                              kernel.CalcVertexNormals();
+                          }));
+    }
+
+    return 0;
+}
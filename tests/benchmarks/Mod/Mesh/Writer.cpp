@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Compares MeshOutput::SaveBinarySTL() with one and with all threads against writing
+// the records one by one, and times MeshOutput::SaveBinaryPLY(). The output is
+// discarded, so that only the writers are timed and not the disk.
+// Usage: Mesh_Writer_benchmark [points per side, default 2240, about 10M facets]
+
+#include <Benchmark.h>
+#include <Mod/Mesh/App/Core/Definitions.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/Core/MeshTestHelpers.h>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+
+namespace
+{
+// Counts and drops everything written to it
+class NullBuffer: public std::streambuf
+{
+public:
+    std::size_t size() const
+    {
+        return count;
+    }
+
+protected:
+    std::streamsize xsputn(const char* /*s*/, std::streamsize n) override
+    {
+        count += static_cast<std::size_t>(n);
+        return n;
+    }
+    int_type overflow(int_type ch) override
+    {
+        count++;
+        return traits_type::not_eof(ch);
+    }
+
+private:
+    std::size_t count {0};
+};
+
+// Writes the binary STL records one by one like MeshOutput did before
+void saveBinarySTLRecords(const MeshCore::MeshKernel& kernel, std::ostream& str)
+{
+    char header[80] {};
+    str.write(header, sizeof(header));
+    auto count = static_cast<uint32_t>(kernel.CountFacets());
+    str.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    uint16_t attribute = 0;
+    MeshCore::MeshFacetIterator it(kernel);
+    for (it.Init(); it.More(); it.Next()) {
+        Base::Vector3f normal = it->GetNormal();
+        str.write(reinterpret_cast<const char*>(&normal.x), 3 * sizeof(float));
+        for (const auto& pnt : it->_aclPoints) {
+            str.write(reinterpret_cast<const char*>(&pnt.x), 3 * sizeof(float));
+        }
+        str.write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned long size = Benchmark::argument(argc, argv, 1, 2240);
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(size);
+    std::printf("%lu facets\n", kernel.CountFacets());
+
+    Benchmark::report("binary STL, record by record", Benchmark::bestOf(3, [&kernel] {
+                          NullBuffer buf;
+                          std::ostream str(&buf);
+                          saveBinarySTLRecords(kernel, str);
+                      }));
+
+    for (int threads : {1, 0}) {
+        MeshCore::MeshDefinitions::SetThreadCount(threads);
+        std::printf("%d thread(s)\n", MeshCore::MeshDefinitions::GetThreadCount());
+        Benchmark::report("  MeshOutput::SaveBinarySTL", Benchmark::bestOf(3, [&kernel] {
+                              NullBuffer buf;
+                              std::ostream str(&buf);
+                              MeshCore::MeshOutput(kernel).SaveBinarySTL(str);
+                          }));
+        Benchmark::report("  MeshOutput::SaveBinaryPLY", Benchmark::bestOf(3, [&kernel] {
+                              NullBuffer buf;
+                              std::ostream str(&buf);
+                              MeshCore::MeshOutput(kernel).SaveBinaryPLY(str);
+                          }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Times TopoShape::getDomains() and BRepMesh::getFacesFromDomains() on a compound of
+// touching boxes with a cylinder on each, and compares merging the equal points of the
+// domains with the std::set used before.
+// Usage: Part_Faces_benchmark [boxes per side, default 34, about 10k faces]
+
+#include <Benchmark.h>
+#include <Mod/Part/App/BRepMesh.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <src/App/InitApplication.h>
+#include <set>
+
+#include <BRep_Builder.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+
+namespace
+{
+// Creates a grid of unit boxes which share their edges, and a cylinder standing on each
+// box. The cylinders give curved faces with many triangles.
+TopoDS_Shape createShape(unsigned long size)
+{
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (unsigned long i = 0; i < size; i++) {
+        for (unsigned long j = 0; j < size; j++) {
+            auto x = static_cast<double>(i);
+            auto y = static_cast<double>(j);
+            builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(x, y, 0.0), 1.0, 1.0, 1.0).Shape());
+            gp_Ax2 axis(gp_Pnt(x + 0.5, y + 0.5, 1.0), gp::DZ());
+            builder.Add(comp, BRepPrimAPI_MakeCylinder(axis, 0.4, 1.0).Shape());
+        }
+    }
+    return comp;
+}
+
+// Merges the equal points with a std::set like BRepMesh::getFacesFromDomains() did before
+std::size_t mergeWithSet(const std::vector<Part::BRepMesh::Domain>& domains)
+{
+    auto less = [](const Base::Vector3d& p1, const Base::Vector3d& p2) {
+        if (p1.x != p2.x) {
+            return p1.x < p2.x;
+        }
+        if (p1.y != p2.y) {
+            return p1.y < p2.y;
+        }
+        return p1.z < p2.z;
+    };
+
+    std::set<Base::Vector3d, decltype(less)> vertices(less);
+    for (const auto& domain : domains) {
+        for (const auto& facet : domain.facets) {
+            vertices.insert(domain.points[facet.I1]);
+            vertices.insert(domain.points[facet.I2]);
+            vertices.insert(domain.points[facet.I3]);
+        }
+    }
+    return vertices.size();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    tests::initApplication();
+
+    unsigned long size = Benchmark::argument(argc, argv, 1, 34);
+    Part::TopoShape shape(createShape(size));
+    std::printf("%lu faces\n", shape.countSubShapes(TopAbs_FACE));
+
+    Benchmark::report("BRepMesh_IncrementalMesh", Benchmark::bestOf(1, [&shape] {
+                          BRepMesh_IncrementalMesh mesh(shape.getShape(),
+                                                        0.01,
+                                                        Standard_False,
+                                                        0.5,
+                                                        Standard_True);
+                      }));
+
+    std::vector<Part::BRepMesh::Domain> domains;
+    Benchmark::report("TopoShape::getDomains", Benchmark::bestOf(3, [&shape, &domains] {
+                          domains.clear();
+                          shape.getDomains(domains);
+                      }));
+
+    std::size_t numPoints = 0;
+    std::size_t numFacets = 0;
+    for (const auto& domain : domains) {
+        numPoints += domain.points.size();
+        numFacets += domain.facets.size();
+    }
+    std::printf("%zu points, %zu facets in %zu domains\n", numPoints, numFacets, domains.size());
+
+    Benchmark::report("merge equal points, std::set", Benchmark::bestOf(3, [&domains] {
+                          mergeWithSet(domains);
+                      }));
+    Benchmark::report("BRepMesh::getFacesFromDomains", Benchmark::bestOf(3, [&domains] {
+                          std::vector<Base::Vector3d> points;
+                          std::vector<Part::BRepMesh::Facet> facets;
+                          Part::BRepMesh mesh;
+                          mesh.getFacesFromDomains(domains, points, facets);
+                      }));
+    Benchmark::report("TopoShape::getFaces", Benchmark::bestOf(3, [&shape] {
+                          std::vector<Base::Vector3d> points;
+                          std::vector<Data::ComplexGeoData::Facet> facets;
+                          shape.getFaces(points, facets, 0.01);
+                      }));
+
+    return 0;
+}
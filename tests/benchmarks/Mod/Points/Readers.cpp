@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Times reading a point cloud with normals and colors from ASCII and binary PLY and PCD
+// files, and reading the points of an ASCII file. The files are written to the temp
+// directory first and removed at the end.
+// Usage: Points_Readers_benchmark [points, default 1000000]
+
+#include <Benchmark.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Points/App/PointsAlgos.h>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Cloud
+{
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> normals;
+    std::vector<App::Color> colors;
+};
+
+// Creates points on a wavy surface
+Cloud createCloud(unsigned long count)
+{
+    Cloud cloud;
+    auto side = static_cast<unsigned long>(std::sqrt(static_cast<double>(count))) + 1;
+    for (unsigned long i = 0; i < count; i++) {
+        float x = static_cast<float>(i % side) * 0.01F;
+        float y = static_cast<float>(i / side) * 0.01F;
+        cloud.points.emplace_back(x, y, std::sin(x) * std::cos(y));
+        Base::Vector3f normal(-std::cos(x) * std::cos(y), std::sin(x) * std::sin(y), 1.0F);
+        cloud.normals.push_back(normal.Normalize());
+        cloud.colors.emplace_back(static_cast<float>(i % 256) / 255.0F,
+                                  static_cast<float>(i / 256 % 256) / 255.0F,
+                                  0.5F);
+    }
+    return cloud;
+}
+
+template<typename T>
+void writeValue(std::ostream& out, T value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// The writers only write ASCII files, so the binary files are written here
+void writeBinaryPLY(const Cloud& cloud, const std::string& filename)
+{
+    Base::ofstream out(Base::FileInfo(filename), std::ios::out | std::ios::binary);
+    out << "ply\n"
+        << "format binary_little_endian 1.0\n"
+        << "element vertex " << cloud.points.size() << "\n"
+        << "property float x\nproperty float y\nproperty float z\n"
+        << "property float nx\nproperty float ny\nproperty float nz\n"
+        << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+        << "end_header\n";
+    for (std::size_t i = 0; i < cloud.points.size(); i++) {
+        for (const auto& vec : {cloud.points[i], cloud.normals[i]}) {
+            writeValue(out, vec.x);
+            writeValue(out, vec.y);
+            writeValue(out, vec.z);
+        }
+        const App::Color& col = cloud.colors[i];
+        for (float value : {col.r, col.g, col.b}) {
+            writeValue(out, static_cast<uint8_t>(value * 255.0F + 0.5F));
+        }
+    }
+}
+
+void writeBinaryPCD(const Cloud& cloud, const std::string& filename)
+{
+    Base::ofstream out(Base::FileInfo(filename), std::ios::out | std::ios::binary);
+    out << "VERSION 0.7\n"
+        << "FIELDS x y z normal_x normal_y normal_z rgb\n"
+        << "SIZE 4 4 4 4 4 4 4\n"
+        << "TYPE F F F F F F U\n"
+        << "COUNT 1 1 1 1 1 1 1\n"
+        << "WIDTH " << cloud.points.size() << "\n"
+        << "HEIGHT 1\n"
+        << "VIEWPOINT 0 0 0 1 0 0 0\n"
+        << "POINTS " << cloud.points.size() << "\n"
+        << "DATA binary\n";
+    for (std::size_t i = 0; i < cloud.points.size(); i++) {
+        for (const auto& vec : {cloud.points[i], cloud.normals[i]}) {
+            writeValue(out, vec.x);
+            writeValue(out, vec.y);
+            writeValue(out, vec.z);
+        }
+        writeValue(out, cloud.colors[i].getPackedARGB());
+    }
+}
+
+void time(const char* name, Points::Reader& reader, const std::string& filename)
+{
+    Benchmark::report(name, Benchmark::bestOf(3, [&reader, &filename] {
+                          reader.read(filename);
+                      }));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned long count = Benchmark::argument(argc, argv, 1, 1000000);
+    Cloud cloud = createCloud(count);
+    std::printf("%lu points\n", count);
+
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(cloud.points);
+    std::vector<Base::FileInfo> files;
+    auto newFile = [&files](const char* extension) {
+        files.emplace_back(Base::FileInfo::getTempFileName() + extension);
+        return files.back().filePath();
+    };
+
+    std::string asc = newFile(".asc");
+    Points::AscWriter(kernel).write(asc);
+
+    std::string asciiPLY = newFile(".ply");
+    Points::PlyWriter plyWriter(kernel);
+    plyWriter.setNormals(cloud.normals);
+    plyWriter.setColors(cloud.colors);
+    plyWriter.write(asciiPLY);
+
+    std::string asciiPCD = newFile(".pcd");
+    Points::PcdWriter pcdWriter(kernel);
+    pcdWriter.setNormals(cloud.normals);
+    pcdWriter.setColors(cloud.colors);
+    pcdWriter.write(asciiPCD);
+
+    std::string binaryPLY = newFile(".ply");
+    writeBinaryPLY(cloud, binaryPLY);
+    std::string binaryPCD = newFile(".pcd");
+    writeBinaryPCD(cloud, binaryPCD);
+
+    Points::AscReader ascReader;
+    time("ASCII points", ascReader, asc);
+    Points::PlyReader plyReader;
+    time("ASCII PLY", plyReader, asciiPLY);
+    time("binary PLY", plyReader, binaryPLY);
+    Points::PcdReader pcdReader;
+    time("ASCII PCD", pcdReader, asciiPCD);
+    time("binary PCD", pcdReader, binaryPCD);
+
+    for (const auto& file : files) {
+        file.deleteFile();
+    }
+
+    return 0;
+}
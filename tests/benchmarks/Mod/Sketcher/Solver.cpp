@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Times the dense and the sparse Jacobian of a GCS::SubSystem, and diagnosing and solving
+// a GCS::System with the sparse QR decomposition, for a chain of segments that zigzags
+// like a staircase. Each segment adds two constraints, so the default sizes go from 100
+// to 10,000 constraints.
+// Usage: Sketcher_Solver_benchmark [segments, default 50, 500 and 5000]
+
+#include <Benchmark.h>
+#include <Mod/Sketcher/App/planegcs/Constraints.h>
+#include <Mod/Sketcher/App/planegcs/GCS.h>
+#include <Mod/Sketcher/App/planegcs/SubSystem.h>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace
+{
+// The dense Jacobian is skipped if it would take more than 32 MB
+constexpr long maxDenseSize = 4L * 1024L * 1024L;
+
+class Staircase
+{
+public:
+    // The points start near the solution. The first point is fixed, then horizontal and
+    // vertical segments of length 3 and 2 alternate.
+    explicit Staircase(int segments)
+    {
+        for (int i = 0; i <= segments; i++) {
+            GCS::Point pnt;
+            pnt.x = newParam((i + 1) / 2 * 3.0 + 0.1 * ((i * 7) % 5));
+            pnt.y = newParam(i / 2 * 2.0 - 0.1 * ((i * 3) % 4));
+            points.push_back(pnt);
+        }
+
+        int tag = 1;
+        system.addConstraintCoordinateX(points[0], newConst(0.0), tag++);
+        system.addConstraintCoordinateY(points[0], newConst(0.0), tag++);
+        addConstraint(new GCS::ConstraintEqual(points[0].x, newConst(0.0)));
+        addConstraint(new GCS::ConstraintEqual(points[0].y, newConst(0.0)));
+        for (int i = 0; i < segments; i++) {
+            GCS::Point& p1 = points[i];
+            GCS::Point& p2 = points[i + 1];
+            double* length = newConst(i % 2 == 0 ? 3.0 : 2.0);
+            if (i % 2 == 0) {
+                system.addConstraintHorizontal(p1, p2, tag++);
+                addConstraint(new GCS::ConstraintEqual(p1.y, p2.y));
+            }
+            else {
+                system.addConstraintVertical(p1, p2, tag++);
+                addConstraint(new GCS::ConstraintEqual(p1.x, p2.x));
+            }
+            system.addConstraintP2PDistance(p1, p2, length, tag++);
+            addConstraint(new GCS::ConstraintP2PDistance(p1, p2, length));
+        }
+    }
+
+    GCS::System system;
+    GCS::VEC_pD unknowns;
+    std::vector<GCS::Constraint*> clist;
+
+private:
+    double* newParam(double value)
+    {
+        values.push_back(value);
+        unknowns.push_back(&values.back());
+        return &values.back();
+    }
+
+    double* newConst(double value)
+    {
+        values.push_back(value);
+        return &values.back();
+    }
+
+    void addConstraint(GCS::Constraint* constr)
+    {
+        constraints.emplace_back(constr);
+        clist.push_back(constr);
+    }
+
+    std::deque<double> values;
+    std::deque<GCS::Point> points;
+    std::vector<std::unique_ptr<GCS::Constraint>> constraints;
+};
+
+void run(int segments)
+{
+    Staircase stairs(segments);
+    GCS::SubSystem subsys(stairs.clist, stairs.unknowns);
+    std::printf("%d constraints, %d parameters\n", subsys.cSize(), subsys.pSize());
+
+    if (static_cast<long>(subsys.cSize()) * subsys.pSize() <= maxDenseSize) {
+        Benchmark::report("  dense Jacobian", Benchmark::bestOf(5, [&subsys] {
+                              Eigen::MatrixXd jacobi;
+                              subsys.calcJacobi(jacobi);
+                          }));
+    }
+    else {
+        std::printf("  dense Jacobian skipped\n");
+    }
+    Benchmark::report("  sparse Jacobian", Benchmark::bestOf(5, [&subsys] {
+                          Eigen::SparseMatrix<double> jacobi;
+                          subsys.calcJacobi(jacobi);
+                      }));
+
+    // diagnosing and solving change the system, so they are timed once
+    GCS::System& system = stairs.system;
+    system.qrAlgorithm = GCS::EigenSparseQR;
+    Benchmark::report("  diagnose, sparse QR", Benchmark::bestOf(1, [&stairs, &system] {
+                          system.declareUnknowns(stairs.unknowns);
+                          system.initSolution(GCS::DogLeg);
+                      }));
+    Benchmark::report("  solve, DogLeg", Benchmark::bestOf(1, [&system] {
+                          system.solve(true, GCS::DogLeg);
+                      }));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) {
+        run(static_cast<int>(Benchmark::argument(argc, argv, 1, 0)));
+    }
+    else {
+        for (int segments : {50, 500, 5000}) {
+            run(segments);
+        }
+    }
+
+    return 0;
+}
@@ -5,6 +5,8 @@
 
 #include "App/Application.h"
 #include "App/Document.h"
+#include "App/DocumentObject.h"
+#include "App/PropertyStandard.h"
 #include "App/StringHasher.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
@@ -94,4 +96,31 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, undoLimitRemovesOldestTransactions)
+{
+    // Arrange
+    const std::size_t length {100000};
+    doc()->setUndoMode(1);
+    auto obj = doc()->addObject("App::DocumentObjectGroup", "Group");
+    auto prop = static_cast<App::PropertyString*>(
+        obj->addDynamicProperty("App::PropertyString", "Text"));
+    for (char c = 'a'; c <= 'e'; ++c) {
+        doc()->openTransaction("change");
+        prop->setValue(std::string(length, c));
+        doc()->commitTransaction();
+    }
+    // the first transaction holds the empty initial value
+    ASSERT_EQ(doc()->getAvailableUndos(), 5);
+    ASSERT_GE(doc()->getUndoMemSize(), 4 * length);
+
+    // Act
+    doc()->setUndoLimit(static_cast<unsigned int>(2 * length + length / 2));
+
+    // Assert
+    EXPECT_EQ(doc()->getAvailableUndos(), 2);
+    EXPECT_LE(doc()->getUndoMemSize(), 2 * length + length / 2);
+    EXPECT_TRUE(doc()->undo());
+    EXPECT_EQ(std::string(prop->getValue()), std::string(length, 'd'));
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -3,9 +3,12 @@
 #include "gtest/gtest.h"
 
 #include <App/Application.h>
+#include <App/Document.h>
 #include <App/ElementMap.h>
 #include <src/App/InitApplication.h>
 
+#include <sstream>
+
 // NOLINTBEGIN(readability-magic-numbers)
 
 
@@ -553,4 +556,55 @@ TEST_F(ElementMapTest, addAndGetChildElementsTest)
             return e.indexedName.toString() == "Pong2";
         }));
 }
+
+// Both storages find and restore the same mapped names
+TEST_F(ElementMapTest, compareStorage)
+{
+    // Arrange
+    constexpr int count {1000};
+    auto doc = App::GetApplication().getDocument(_docName.c_str());
+    auto oldStorage = Data::ElementMap::getDefaultStorage();
+    std::vector<Data::MappedName> names;
+    names.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        names.emplace_back(Data::MappedName(("Edge" + std::to_string(i)).c_str()),
+                           (";:M;FUS;:H" + std::to_string(i % 97)).c_str());
+    }
+
+    auto run = [&](Data::ElementMap::Storage storage) {
+        Data::ElementMap::setDefaultStorage(storage);
+        auto elementMap = std::make_shared<Data::ElementMap>();
+        long found = 0;
+
+        for (int i = 0; i < count; ++i) {
+            elementMap->setElementName(Data::IndexedName("Edge", i + 1), names[i], 1);
+        }
+        for (const auto& name : names) {
+            found += elementMap->find(name).getIndex();
+        }
+        for (int i = 0; i < count; ++i) {
+            found += elementMap->find(Data::IndexedName("Edge", i + 1)).size();
+        }
+
+        std::stringstream stream;
+        elementMap->save(stream);
+        App::GetApplication().signalStartRestoreDocument(*doc);
+        auto restored = std::make_shared<Data::ElementMap>()->restore(_hasher, stream);
+
+        for (int i = 0; i < count; i += 10) {
+            EXPECT_EQ(restored->find(names[i]), Data::IndexedName("Edge", i + 1));
+        }
+        EXPECT_EQ(restored->size(), count);
+        return found;
+    };
+
+    // Act
+    long treeFound = run(Data::ElementMap::Storage::Tree);
+    long flatFound = run(Data::ElementMap::Storage::Flat);
+    Data::ElementMap::setDefaultStorage(oldStorage);
+
+    // Assert
+    EXPECT_EQ(treeFound, flatFound);
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -288,4 +288,88 @@ TEST(Expression, test_e_rad)
     EXPECT_EQ(op->toString(), "e rad");
     op.release();
 }
+
+TEST(Expression, numericValueInteger)
+{
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(2.0)), App::OperatorExpression::MUL,
+        new App::NumberExpression(nullptr, Base::Quantity(3.0)));
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericInteger);
+    EXPECT_DOUBLE_EQ(value.getValue(), 6.0);
+}
+
+TEST(Expression, numericValueDivisionIsFloat)
+{
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(3.0)), App::OperatorExpression::DIV,
+        new App::NumberExpression(nullptr, Base::Quantity(2.0)));
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericFloat);
+    EXPECT_DOUBLE_EQ(value.getValue(), 1.5);
+}
+
+TEST(Expression, numericValueDivisionByZero)
+{
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(3.0)), App::OperatorExpression::DIV,
+        new App::NumberExpression(nullptr, Base::Quantity(0.0)));
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericNone);
+}
+
+TEST(Expression, numericValueQuantity)
+{
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(2.0, Base::Unit::Length)), App::OperatorExpression::MUL,
+        new App::NumberExpression(nullptr, Base::Quantity(1.5)));
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericQuantity);
+    EXPECT_DOUBLE_EQ(value.getValue(), 3.0);
+    EXPECT_EQ(value.getUnit(), Base::Unit::Length);
+}
+
+TEST(Expression, numericValueUnitMismatch)
+{
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(2.0, Base::Unit::Length)), App::OperatorExpression::ADD,
+        new App::NumberExpression(nullptr, Base::Quantity(1.0, Base::Unit::Area)));
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericNone);
+}
+
+TEST(Expression, numericValueComparisonUnsupported)
+{
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(2.0)), App::OperatorExpression::LT,
+        new App::NumberExpression(nullptr, Base::Quantity(1.0)));
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericNone);
+}
+
+TEST(Expression, numericValueFunctionWithoutOwner)
+{
+    App::FunctionExpression func(nullptr, App::FunctionExpression::SQRT, std::string("sqrt"),
+        {new App::NumberExpression(nullptr, Base::Quantity(16.0, Base::Unit::Area))});
+    Base::Quantity value;
+    EXPECT_EQ(func.getNumericValue(value), App::Expression::NumericQuantity);
+    EXPECT_DOUBLE_EQ(value.getValue(), 4.0);
+    EXPECT_EQ(value.getUnit(), Base::Unit::Length);
+}
+
+TEST(Expression, numericValueOfChangedNode)
+{
+    auto right = new App::NumberExpression(nullptr, Base::Quantity(3.0));
+    App::OperatorExpression op(nullptr,
+        new App::NumberExpression(nullptr, Base::Quantity(2.0)), App::OperatorExpression::MUL,
+        right);
+    Base::Quantity value;
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericInteger);
+    EXPECT_DOUBLE_EQ(value.getValue(), 6.0);
+
+    // The value of a node is kept for one evaluation only
+    right->setQuantity(Base::Quantity(4.0));
+    EXPECT_EQ(op.getNumericValue(value), App::Expression::NumericInteger);
+    EXPECT_DOUBLE_EQ(value.getValue(), 8.0);
+}
 // clang-format on
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include "App/MappedNameMap.h"
+
+#include <string>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+class MappedNameMapTest: public ::testing::TestWithParam<Data::MappedNameMap::Storage>
+{
+};
+
+TEST_P(MappedNameMapTest, insertAndFind)
+{
+    // Arrange
+    Data::MappedNameMap map(GetParam());
+    Data::IndexedName face1("Face", 1);
+    Data::IndexedName face2("Face", 2);
+
+    // Act
+    auto first = map.insert(Data::MappedName("Name1"), face1);
+    auto second = map.insert(Data::MappedName("Name1"), face2);
+    map.insert(Data::MappedName("Name2"), face2);
+
+    // Assert
+    EXPECT_TRUE(first.inserted);
+    EXPECT_FALSE(second.inserted);
+    EXPECT_EQ(*second.index, face1);
+    EXPECT_EQ(map.size(), 2);
+    ASSERT_NE(map.find(Data::MappedName("Name2")), nullptr);
+    EXPECT_EQ(*map.find(Data::MappedName("Name2")), face2);
+    EXPECT_EQ(map.find(Data::MappedName("Name3")), nullptr);
+}
+
+TEST_P(MappedNameMapTest, findWithDifferentPostfix)
+{
+    // Arrange
+    Data::MappedNameMap map(GetParam());
+    Data::MappedName split(Data::MappedName("Edge1"), ";:H2");
+    Data::MappedName whole("Edge1;:H2");
+
+    // Act
+    map.insert(split, Data::IndexedName("Edge", 1));
+
+    // Assert
+    EXPECT_EQ(split, whole);
+    EXPECT_EQ(Data::MappedNameMap::hash(split), Data::MappedNameMap::hash(whole));
+    EXPECT_NE(map.find(whole), nullptr);
+}
+
+TEST_P(MappedNameMapTest, eraseAndReinsert)
+{
+    // Arrange
+    Data::MappedNameMap map(GetParam());
+    constexpr int count = 1000;
+    for (int i = 0; i < count; ++i) {
+        map.insert(Data::MappedName(std::to_string(i).c_str()), Data::IndexedName("Edge", i + 1));
+    }
+
+    // Act
+    for (int i = 0; i < count; i += 2) {
+        EXPECT_TRUE(map.erase(Data::MappedName(std::to_string(i).c_str())));
+    }
+    bool erasedTwice = map.erase(Data::MappedName("0"));
+    map.insert(Data::MappedName("0"), Data::IndexedName("Face", 1));
+    int visited = 0;
+    map.forEach([&visited](const Data::MappedName&, const Data::IndexedName&) {
+        ++visited;
+    });
+
+    // Assert
+    EXPECT_FALSE(erasedTwice);
+    EXPECT_EQ(map.size(), count / 2 + 1);
+    EXPECT_EQ(visited, count / 2 + 1);
+    EXPECT_EQ(map.find(Data::MappedName("2")), nullptr);
+    ASSERT_NE(map.find(Data::MappedName("3")), nullptr);
+    EXPECT_EQ(*map.find(Data::MappedName("3")), Data::IndexedName("Edge", 4));
+    EXPECT_EQ(*map.find(Data::MappedName("0")), Data::IndexedName("Face", 1));
+}
+
+INSTANTIATE_TEST_SUITE_P(Storage,
+                         MappedNameMapTest,
+                         ::testing::Values(Data::MappedNameMap::Storage::Tree,
+                                           Data::MappedNameMap::Storage::Flat));
+
+// NOLINTEND(readability-magic-numbers)
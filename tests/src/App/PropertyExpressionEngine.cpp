@@ -55,6 +55,19 @@ private:
     App::Property* _target_prop {};
 };
 
+// Calls execute() and returns the number of expressions evaluated and skipped by this call
+static App::PropertyExpressionEngine::ExecuteStats execute(App::PropertyExpressionEngine& engine,
+    App::PropertyExpressionEngine::ExecuteOption option = App::PropertyExpressionEngine::ExecuteAll)
+{
+    auto before = engine.getExecuteStats();
+    engine.execute(option);
+    auto after = engine.getExecuteStats();
+    App::PropertyExpressionEngine::ExecuteStats stats;
+    stats.evaluated = after.evaluated - before.evaluated;
+    stats.skipped = after.skipped - before.skipped;
+    return stats;
+}
+
 // https://github.com/FreeCAD/FreeCAD/issues/11965
 TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
 {
@@ -90,4 +103,188 @@ TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
     ;
 }
 
+TEST_F(PropertyExpressionEngineTest, executeSkipsUnchangedExpressions)
+{
+    auto source_path = App::ObjectIdentifier::parse(this_obj(), source_name());
+    source_prop()->setPathValue(source_path, std::string("1 m"));
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + source_name() + ")"));
+    this_obj()->setExpression(target_path, target_rule);
+
+    auto& engine = this_obj()->ExpressionEngine;
+    App::PropertyExpressionEngine::ExecuteStats stats;
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+
+    // Nothing changed, nothing to evaluate
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 0U);
+    EXPECT_EQ(stats.skipped, 1U);
+
+    // Changed input
+    source_prop()->setPathValue(source_path, std::string("2 m"));
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 2000.0);
+
+    // Bound property changed outside of the engine, binding is re-applied
+    target_prop()->setPathValue(target_path, Base::Quantity(5.0, Base::Unit::Length));
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 2000.0);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeChangesOfFrozenObject)
+{
+    auto other = this_doc()->addObject("App::FeatureTest");
+    auto other_prop = other->addDynamicProperty("App::PropertyString", "source");
+    auto source_path = App::ObjectIdentifier::parse(other, "source");
+    other_prop->setPathValue(source_path, std::string("1 m"));
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + std::string(other->getNameInDocument()) + ".source)"));
+    this_obj()->setExpression(target_path, target_rule);
+
+    auto& engine = this_obj()->ExpressionEngine;
+    App::PropertyExpressionEngine::ExecuteStats stats;
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+
+    // Changes of a frozen object are not signaled
+    other->freeze();
+    other_prop->setPathValue(source_path, std::string("2 m"));
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 2000.0);
+
+    // Changed while frozen, but unfrozen before the next execute()
+    other_prop->setPathValue(source_path, std::string("3 m"));
+    other->unfreeze();
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 3000.0);
+
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 0U);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeAfterDeletedDependency)
+{
+    auto other = this_doc()->addObject("App::FeatureTest");
+    auto other_prop = other->addDynamicProperty("App::PropertyString", "source");
+    auto source_path = App::ObjectIdentifier::parse(other, "source");
+    other_prop->setPathValue(source_path, std::string("1 m"));
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + std::string(other->getNameInDocument()) + ".source)"));
+    this_obj()->setExpression(target_path, target_rule);
+
+    auto& engine = this_obj()->ExpressionEngine;
+    App::PropertyExpressionEngine::ExecuteStats stats;
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+
+    // The binding must not be skipped once its input is gone
+    this_doc()->removeObject(other->getNameInDocument());
+    EXPECT_THROW(engine.execute(), Base::Exception);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeAfterTouch)
+{
+    auto other = this_doc()->addObject("App::FeatureTest");
+    auto other_prop = other->addDynamicProperty("App::PropertyString", "source");
+    auto source_path = App::ObjectIdentifier::parse(other, "source");
+    other_prop->setPathValue(source_path, std::string("1 m"));
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + std::string(other->getNameInDocument()) + ".source)"));
+    this_obj()->setExpression(target_path, target_rule);
+
+    auto& engine = this_obj()->ExpressionEngine;
+    App::PropertyExpressionEngine::ExecuteStats stats;
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 0U);
+
+    // Touching the owner enforces the evaluation of all its expressions
+    this_obj()->touch();
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+
+    // Touching a dependency enforces the evaluation of its dependents
+    other->touch();
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 0U);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeThroughRetargetedLink)
+{
+    auto first = this_doc()->addObject("App::FeatureTest");
+    auto first_prop = first->addDynamicProperty("App::PropertyString", "source");
+    first_prop->setPathValue(App::ObjectIdentifier::parse(first, "source"), std::string("1 m"));
+    auto second = this_doc()->addObject("App::FeatureTest");
+    auto second_prop = second->addDynamicProperty("App::PropertyString", "source");
+    auto second_path = App::ObjectIdentifier::parse(second, "source");
+    second_prop->setPathValue(second_path, std::string("2 m"));
+    auto linker = this_doc()->addObject("App::FeatureTest");
+    auto link_prop = dynamic_cast<App::PropertyLink*>(linker->getPropertyByName("Link"));
+    ASSERT_NE(link_prop, nullptr);
+    link_prop->setValue(first);
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + std::string(linker->getNameInDocument()) + ".Link.source)"));
+    this_obj()->setExpression(target_path, target_rule);
+
+    auto& engine = this_obj()->ExpressionEngine;
+    execute(engine);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 1000.0);
+
+    // The value follows the link to its new target and the changes of the target
+    link_prop->setValue(second);
+    execute(engine);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 2000.0);
+    second_prop->setPathValue(second_path, std::string("3 m"));
+    execute(engine);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 3000.0);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeUntrackedExpressions)
+{
+    auto source_path = App::ObjectIdentifier::parse(this_obj(), source_name());
+    source_prop()->setPathValue(source_path, std::string("1 m"));
+    auto other_prop = this_obj()->addDynamicProperty("App::PropertyLength", "other_length");
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + source_name() + ")"));
+    this_obj()->setExpression(target_path, target_rule);
+    // Dependencies through a pseudo property are not tracked
+    auto other_path = App::ObjectIdentifier::parse(this_obj(), "other_length");
+    std::shared_ptr<App::Expression> other_rule(App::Expression::parse(this_obj(), "parsequant(_self." + source_name() + ")"));
+    this_obj()->setExpression(other_path, other_rule);
+
+    auto& engine = this_obj()->ExpressionEngine;
+    App::PropertyExpressionEngine::ExecuteStats stats;
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 2U);
+
+    // The untracked binding is always evaluated
+    stats = execute(engine);
+    EXPECT_EQ(stats.evaluated, 1U);
+    EXPECT_EQ(stats.skipped, 1U);
+    stats = execute(engine, App::PropertyExpressionEngine::ExecuteNonOutput);
+    EXPECT_EQ(stats.evaluated, 1U);
+    EXPECT_EQ(stats.skipped, 1U);
+
+    source_prop()->setPathValue(source_path, std::string("2 m"));
+    stats = execute(engine, App::PropertyExpressionEngine::ExecuteNonOutput);
+    EXPECT_EQ(stats.evaluated, 2U);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop()->getPathValue(target_path)).getValue(), 2000.0);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(other_prop->getPathValue(other_path)).getValue(), 2000.0);
+}
+
 // clang-format on
@@ -9,6 +9,10 @@
 
 #include <QCryptographicHash>
 #include <array>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 class StringIDTest: public ::testing::Test
 {
@@ -1583,3 +1587,55 @@ TEST_F(StringHasherTest, compact)  // NOLINT
     // Assert
     EXPECT_EQ(0, Hasher()->count());
 }
+
+TEST_F(StringHasherTest, getIDConcurrently)  // NOLINT
+{
+    // Arrange
+    const int threadCount {16};
+    const int nameCount {2000};
+    std::vector<std::vector<App::StringIDRef>> results(threadCount);
+    std::vector<std::thread> threads;
+
+    // Act: every thread maps the same names, starting at a different one
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([this, t, &results]() {
+            auto& result = results[t];
+            result.resize(nameCount);
+            QVector<App::StringIDRef> sids;
+            for (int n = 0; n < nameCount; ++n) {
+                int i = (n + t * nameCount / threadCount) % nameCount;
+                if (i % 2 == 0) {
+                    auto text = "Text" + std::to_string(i);
+                    result[i] = Hasher()->getID(text.c_str());
+                }
+                else {
+                    auto postfix = ";:M;FUS;:H" + std::to_string(i % 7);
+                    result[i] = Hasher()->getID(givenMappedName("Edge1", postfix.c_str()), sids);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Assert: all threads got the same StringIDs, stored once with unique IDs
+    std::set<long> ids;
+    for (int i = 0; i < nameCount; ++i) {
+        const auto& sid = results[0][i];
+        for (int t = 1; t < threadCount; ++t) {
+            EXPECT_EQ(results[t][i], sid);
+        }
+        EXPECT_EQ(Hasher()->getID(sid.value(), sid.getIndex()), sid);
+        if (i % 2 != 0) {
+            EXPECT_EQ(sid.getIndex(), 1);
+        }
+        ids.insert(sid.value());
+    }
+    // The odd names come down to 7 different names. These add an ID for each postfix, and one for
+    // the "Edge" prefix.
+    const std::size_t expectedSize = nameCount / 2 + 7 + 7 + 1;
+    EXPECT_EQ(ids.size(), nameCount / 2 + 7);
+    EXPECT_EQ(Hasher()->size(), expectedSize);
+    EXPECT_EQ(Hasher()->getIDMap().size(), expectedSize);
+}
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include "Base/BinaryXML.h"
+#include "Base/Exception.h"
+#include "Base/Reader.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace fs = boost::filesystem;
+
+class BinaryXMLTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        xercesc_3_2::XMLPlatformUtils::Initialize();
+    }
+
+    static std::string documentXML()
+    {
+        return R"(<?xml version='1.0' encoding='utf-8'?>
+<!-- comment -->
+<Document SchemaVersion="4" ProgramVersion="0.22">
+    <Properties Count="2">
+        <Property name="Label" type="App::PropertyString">
+            <String value="a &amp; &quot;b&quot;&#10;c"/>
+        </Property>
+        <Property name="Placement" type="App::PropertyPlacement">
+            <PropertyPlacement Px="1.5" Py="-2" Pz="0"/>
+        </Property>
+    </Properties>
+    <Text>some text</Text>
+</Document>
+)";
+    }
+
+    /// Lists the elements as seen by the reader
+    static std::string trace(Base::XMLReader& reader)
+    {
+        std::ostringstream out;
+        while (!reader.isEndOfDocument()) {
+            if (reader.readNextElement()) {
+                out << reader.level() << reader.localName() << reader.getAttributeCount() << ' ';
+            }
+        }
+        return out.str();
+    }
+
+    static std::string traceXML(const std::string& xml)
+    {
+        std::istringstream str(xml);
+        Base::XMLReader reader("Document.xml", str);
+        return trace(reader);
+    }
+
+    static std::string traceBinary(const std::string& binary)
+    {
+        Base::XMLReader reader("Document.xml", Base::BinaryXML::fromBuffer(binary));
+        return trace(reader);
+    }
+};
+
+TEST_F(BinaryXMLTest, readAttributes)
+{
+    // Arrange
+    auto binary = Base::BinaryXML::fromBuffer(Base::BinaryXML::fromXML(documentXML()));
+    Base::XMLReader reader("Document.xml", binary);
+
+    // Act
+    reader.readElement("Document");
+    long schema = reader.getAttributeAsInteger("SchemaVersion");
+    reader.readElement("Property");
+    std::string name = reader.getAttribute("name");
+    reader.readElement("String");
+    std::string value = reader.getAttribute("value");
+    reader.readElement("PropertyPlacement");
+    double px = reader.getAttributeAsFloat("Px");
+    bool hasPw = reader.hasAttribute("Pw");
+
+    // Assert
+    EXPECT_TRUE(reader.isValid());
+    EXPECT_EQ(schema, 4);
+    EXPECT_EQ(name, "Label");
+    EXPECT_EQ(value, "a & \"b\"\nc");
+    EXPECT_DOUBLE_EQ(px, 1.5);
+    EXPECT_FALSE(hasPw);
+    EXPECT_EQ(reader.getAttributeCount(), 3U);
+    EXPECT_THROW(reader.getAttribute("Pw"), Base::XMLAttributeError);
+}
+
+TEST_F(BinaryXMLTest, readCharacters)
+{
+    // Arrange
+    auto binary = Base::BinaryXML::fromBuffer(Base::BinaryXML::fromXML(documentXML()));
+    Base::XMLReader reader("Document.xml", binary);
+    reader.readElement("Text");
+
+    // Act
+    std::string text;
+    std::getline(reader.beginCharStream(), text);
+    reader.endCharStream();
+
+    // Assert
+    EXPECT_EQ(text, "some text");
+}
+
+TEST_F(BinaryXMLTest, roundTrip)
+{
+    // Arrange
+    std::string binary = Base::BinaryXML::fromXML(documentXML());
+
+    // Act
+    std::ostringstream xml;
+    Base::BinaryXML::fromBuffer(binary)->toXML(xml);
+
+    // Assert
+    EXPECT_EQ(traceBinary(binary), traceXML(documentXML()));
+    EXPECT_EQ(traceXML(xml.str()), traceXML(documentXML()));
+    EXPECT_EQ(traceBinary(Base::BinaryXML::fromXML(xml.str())), traceXML(documentXML()));
+}
+
+TEST_F(BinaryXMLTest, readEndElementSkipsContent)
+{
+    // Arrange
+    std::string xml = R"(<Root><P><X/><Y/></P><Q/><A><A></A><C/></A><D/></Root>)";
+    auto binary = Base::BinaryXML::fromBuffer(Base::BinaryXML::fromXML(xml));
+    std::istringstream str(xml);
+    Base::XMLReader xmlReader("Document.xml", str);
+    Base::XMLReader binReader("Document.xml", binary);
+
+    for (Base::XMLReader* reader : {&xmlReader, &binReader}) {
+        // Act
+        reader->readElement("P");
+        reader->readEndElement("P");
+        reader->readElement();
+        std::string afterP = reader->localName();
+        reader->readElement("A");
+        reader->readEndElement("A");  // the end of the nested element comes first
+        reader->readElement();
+        std::string afterNested = reader->localName();
+
+        // Assert
+        EXPECT_EQ(afterP, "Q");
+        EXPECT_EQ(afterNested, "C");
+        EXPECT_EQ(reader->level(), 2);
+    }
+}
+
+TEST_F(BinaryXMLTest, rejectInvalidData)
+{
+    std::string binary = Base::BinaryXML::fromXML(documentXML());
+    std::string truncated = binary.substr(0, binary.size() / 2);
+    std::string newer = binary;
+    newer[4] = 99;  // schema version
+
+    EXPECT_THROW(Base::BinaryXML::fromBuffer("<Document/>"), Base::FileException);
+    EXPECT_THROW(Base::BinaryXML::fromBuffer(truncated), Base::FileException);
+    EXPECT_THROW(Base::BinaryXML::fromBuffer(newer), Base::FileException);
+}
+
+TEST_F(BinaryXMLTest, mapFile)
+{
+    // Arrange
+    fs::path path = fs::temp_directory_path() / "unit_test_BinaryXML.fcbx";
+    {
+        std::ofstream file(path.string(), std::ios::binary);
+        file << Base::BinaryXML::fromXML(documentXML());
+    }
+
+    // Act
+    std::string result;
+    {
+        Base::XMLReader reader("Document.xml", Base::BinaryXML::fromFile(path.string().c_str()));
+        result = trace(reader);
+    }
+    fs::remove(path);
+
+    // Assert
+    EXPECT_EQ(result, traceXML(documentXML()));
+}
+
+// Read a document with several objects in both formats
+TEST_F(BinaryXMLTest, readManyObjects)
+{
+    // Arrange
+    constexpr int objects {50};
+    constexpr int properties {4};
+    std::ostringstream out;
+    out << "<?xml version='1.0' encoding='utf-8'?>\n<Document SchemaVersion=\"4\">\n<ObjectData>\n";
+    for (int i = 0; i < objects; ++i) {
+        out << "<Object name=\"Object" << i << "\">\n<Properties Count=\"" << properties
+            << "\">\n";
+        for (int j = 0; j < properties; ++j) {
+            out << "<Property name=\"Prop" << j << "\" type=\"App::PropertyFloat\">\n"
+                << "<Float value=\"" << i * j << ".25\"/>\n</Property>\n";
+        }
+        out << "</Properties>\n</Object>\n";
+    }
+    out << "</ObjectData>\n</Document>\n";
+    std::string xml = out.str();
+    std::string binary = Base::BinaryXML::fromXML(xml);
+
+    auto readAll = [](Base::XMLReader& reader) {
+        double sum = 0;
+        reader.readElement("ObjectData");
+        for (int i = 0; i < objects; ++i) {
+            reader.readElement("Object");
+            reader.readElement("Properties");
+            int count = static_cast<int>(reader.getAttributeAsInteger("Count"));
+            for (int j = 0; j < count; ++j) {
+                reader.readElement("Property");
+                reader.readElement("Float");
+                sum += reader.getAttributeAsFloat("value");
+                reader.readEndElement("Property");
+            }
+            reader.readEndElement("Properties");
+            reader.readEndElement("Object");
+        }
+        return sum;
+    };
+
+    // Act
+    std::istringstream str(xml);
+    Base::XMLReader xmlReader("Document.xml", str);
+    double xmlSum = readAll(xmlReader);
+    Base::XMLReader binReader("Document.xml", Base::BinaryXML::fromBuffer(binary));
+    double binSum = readAll(binReader);
+
+    // Assert
+    EXPECT_DOUBLE_EQ(xmlSum, binSum);
+}
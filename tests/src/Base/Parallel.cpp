@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include "Base/Exception.h"
+#include "Base/Parallel.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+TEST(Parallel, forVisitsEachIndexOnce)
+{
+    std::vector<int> visited(10007, 0);
+    Base::parallelFor(
+        visited.size(),
+        4,
+        [&visited](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                visited[i]++;
+            }
+        },
+        100);
+    EXPECT_EQ(std::accumulate(visited.begin(), visited.end(), 0), 10007);
+    EXPECT_EQ(*std::min_element(visited.begin(), visited.end()), 1);
+}
+
+TEST(Parallel, forWithoutElements)
+{
+    bool called = false;
+    Base::parallelFor(0, 4, [&called](std::size_t, std::size_t) {
+        called = true;
+    });
+    EXPECT_FALSE(called);
+}
+
+TEST(Parallel, forRethrowsException)
+{
+    auto func = [](std::size_t first, std::size_t last) {
+        if (first <= 500 && 500 < last) {
+            throw Base::ValueError("index 500");
+        }
+    };
+    EXPECT_THROW(Base::parallelFor(1000, 4, func, 10), Base::ValueError);
+}
+
+TEST(Parallel, forEachElement)
+{
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    Base::parallelForEach(values, 0, [](int& value) {
+        value *= 2;
+    });
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 9900);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -7,7 +7,10 @@
 #endif
 
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Reader.h"
+#include "Base/Writer.h"
+#include <zipios++/zipinputstream.h>
 #include <array>
 #include <boost/filesystem.hpp>
 #include <fstream>
@@ -292,3 +295,106 @@ TEST_F(ReaderTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("FreeCAD rocks! 🪨🪨🪨"), std::string(buffer.data()));
 }
+
+class TestFile: public Base::Persistence
+{
+public:
+    explicit TestFile(std::string data, bool deferrable = false)
+        : data(std::move(data))
+        , deferrable(deferrable)
+    {}
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << data;
+    }
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        data.assign(std::istreambuf_iterator<char>(reader), {});
+    }
+    bool canDeferRestoreDocFile() const override
+    {
+        return deferrable;
+    }
+    void deferRestoreDocFile(const std::shared_ptr<Base::DeferredFile>& file) override
+    {
+        deferred = file;
+    }
+
+    std::string data;
+    bool deferrable;
+    std::shared_ptr<Base::DeferredFile> deferred;
+};
+
+TEST_F(ReaderTest, readFilesConcurrentAndDeferred)
+{
+    // Arrange
+    TestFile fileA(std::string(100000, 'a'));
+    TestFile fileB("restored on demand");
+    TestFile fileC("stored");
+    std::stringstream zip;
+    {
+        Base::ZipWriter writer(zip);
+        writer.setLevel("txt", 0);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.addFile("A.bin", &fileA);
+        writer.addFile("B.bin", &fileB);
+        writer.addFile("C.txt", &fileC);
+        writer.writeFiles();
+    }
+    TestFile restoredA("");
+    TestFile restoredB("", true);
+    TestFile restoredC("");
+    givenDataAsXMLStream("");
+    Reader()->addFile("A.bin", &restoredA);
+    Reader()->addFile("B.bin", &restoredB);
+    Reader()->addFile("C.txt", &restoredC);
+    Reader()->setConcurrentRead(true);
+    Reader()->setDeferredRestore(true);
+
+    // Act
+    zip.seekg(0);
+    zipios::ZipInputStream zipstream(zip);
+    Reader()->readFiles(zipstream);
+
+    // Assert
+    EXPECT_EQ(restoredA.data, std::string(100000, 'a'));
+    EXPECT_TRUE(restoredB.data.empty());
+    ASSERT_TRUE(restoredB.deferred);
+    EXPECT_EQ(restoredB.deferred->getFileName(), "B.bin");
+    EXPECT_EQ(restoredB.deferred->inflate(), "restored on demand");
+    EXPECT_EQ(restoredC.data, "stored");
+}
+
+TEST_F(ReaderTest, deferredFileDeflateAndSpill)
+{
+    // Arrange
+    std::string data;
+    for (int i = 0; i < 10000; ++i) {
+        data += "line " + std::to_string(i % 100) + '\n';
+    }
+
+    // Act
+    auto file = Base::DeferredFile::deflate("data.txt", data);
+    std::size_t compressedSize = file->getDataSize();
+    std::string inflated = file->inflate();
+    bool spilled = file->spill();
+    std::string restored = file->inflate();
+
+    // Assert
+    EXPECT_LT(compressedSize, data.size() / 10);
+    EXPECT_EQ(file->getSize(), data.size());
+    EXPECT_EQ(inflated, data);
+    EXPECT_TRUE(spilled);
+    EXPECT_TRUE(file->isSpilled());
+    EXPECT_EQ(file->getDataSize(), 0);
+    EXPECT_EQ(restored, data);
+}
@@ -3,6 +3,7 @@
 #include "gtest/gtest.h"
 
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +130,78 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+class TestFile: public Base::Persistence
+{
+public:
+    TestFile(std::string data, bool concurrent)
+        : data(std::move(data))
+        , concurrent(concurrent)
+    {}
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << data;
+    }
+    bool canSaveDocFileConcurrently(const Base::Writer& /*writer*/) const override
+    {
+        return concurrent;
+    }
+
+private:
+    std::string data;
+    bool concurrent;
+};
+
+TEST(ZipWriterTest, writeFilesConcurrent)
+{
+    // Arrange
+    TestFile fileA(std::string(100000, 'a'), true);
+    TestFile fileB("serialized in calling thread", false);
+    TestFile fileC("stored", true);
+    std::stringstream zip;
+
+    // Act
+    {
+        Base::ZipWriter writer(zip);
+        writer.setConcurrent(true);
+        writer.setLevel("txt", 0);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.addFile("A.bin", &fileA);
+        writer.addFile("B.bin", &fileB);
+        writer.addFile("C.txt", &fileC);
+        writer.writeFiles();
+        EXPECT_EQ(writer.getFileTimes().size(), 3U);
+    }
+
+    // Assert
+    zip.seekg(0);
+    zipios::ZipInputStream zipstream(zip);
+    std::string document {std::istreambuf_iterator<char>(zipstream), {}};
+    EXPECT_EQ(document, "<Document/>");
+    std::vector<std::pair<std::string, std::string>> files;
+    std::vector<zipios::StorageMethod> methods;
+    for (auto entry = zipstream.getNextEntry(); entry->isValid();
+         entry = zipstream.getNextEntry()) {
+        files.emplace_back(entry->getName(),
+                           std::string {std::istreambuf_iterator<char>(zipstream), {}});
+        methods.push_back(entry->getMethod());
+    }
+    ASSERT_EQ(files.size(), 3U);
+    EXPECT_EQ(files[0].first, "A.bin");
+    EXPECT_EQ(files[0].second, std::string(100000, 'a'));
+    EXPECT_EQ(files[1].first, "B.bin");
+    EXPECT_EQ(files[1].second, "serialized in calling thread");
+    EXPECT_EQ(files[2].first, "C.txt");
+    EXPECT_EQ(files[2].second, "stored");
+    EXPECT_EQ(methods[0], zipios::DEFLATED);
+    EXPECT_EQ(methods[2], zipios::STORED);
+}
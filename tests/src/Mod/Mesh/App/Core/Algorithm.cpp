@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/TopoAlgorithm.h>
+#include <algorithm>
+#include <cmath>
+
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class AlgorithmTest: public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        MeshCore::MeshDefinitions::SetThreadCount(0);
+    }
+};
+
+TEST_F(AlgorithmTest, pointAdjacencyLikeSets)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(200);
+    MeshCore::MeshRefPointToPoints pointToPoints(kernel);
+    MeshCore::MeshRefPointToFacets pointToFacets(kernel);
+
+    // Act
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+
+    // Assert
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        MeshCore::MeshPointAdjacency::Range points = adjacency.GetPoints(i);
+        MeshCore::MeshPointAdjacency::Range facets = adjacency.GetFacets(i);
+        EXPECT_EQ(std::vector<MeshCore::PointIndex>(points.begin(), points.end()),
+                  std::vector<MeshCore::PointIndex>(pointToPoints[i].begin(),
+                                                    pointToPoints[i].end()));
+        EXPECT_EQ(std::vector<MeshCore::FacetIndex>(facets.begin(), facets.end()),
+                  std::vector<MeshCore::FacetIndex>(pointToFacets[i].begin(),
+                                                    pointToFacets[i].end()));
+        EXPECT_EQ(adjacency.IsBorder(i), pointToPoints[i].size() != pointToFacets[i].size());
+    }
+}
+
+TEST_F(AlgorithmTest, pointAdjacencyValidate)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(20);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    MeshCore::MeshKernel other = MeshTestHelpers::createGrid(30);
+
+    // Act
+    kernel = other;
+    adjacency.Validate();
+
+    // Assert
+    EXPECT_EQ(adjacency.GetPoints(30 * 30 - 1).size(), 2);
+    EXPECT_EQ(adjacency.GetFacets(30 * 30 - 1).size(), 1);
+}
+
+TEST_F(AlgorithmTest, pointAdjacencyValidateSwapEdge)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(20);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    auto hasNeighbour = [&adjacency](MeshCore::PointIndex point, MeshCore::PointIndex other) {
+        MeshCore::MeshPointAdjacency::Range range = adjacency.GetPoints(point);
+        return std::find(range.begin(), range.end(), other) != range.end();
+    };
+    ASSERT_FALSE(hasNeighbour(0, 21));
+
+    // Act
+    // The numbers of points and facets stay the same
+    MeshCore::MeshTopoAlgorithm topAlg(kernel);
+    topAlg.SwapEdge(0, 1);
+    adjacency.Validate();
+
+    // Assert
+    EXPECT_TRUE(hasNeighbour(0, 21));
+    EXPECT_FALSE(hasNeighbour(1, 20));
+}
+
+TEST_F(AlgorithmTest, pointAdjacencyValidateFixDuplicatePoints)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(20);
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+    // let the first facet use a copy of its first point
+    points.push_back(points[0]);
+    facets[0]._aulPoints[0] = points.size() - 1;
+    kernel.Adopt(points, facets);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    ASSERT_EQ(adjacency.GetFacets(0).size(), 0);
+
+    // Act
+    MeshCore::MeshFixDuplicatePoints(kernel).Fixup();
+    adjacency.Validate();
+
+    // Assert
+    ASSERT_EQ(kernel.CountPoints(), 20 * 20);
+    MeshCore::PointIndex index = kernel.GetFacets()[0]._aulPoints[0];
+    EXPECT_EQ(adjacency.GetFacets(index).size(), 1);
+    EXPECT_EQ(adjacency.GetPoints(index).size(), 2);
+}
+
+TEST_F(AlgorithmTest, topologyVersionAfterModifyFacets)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(20);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    unsigned long version = kernel.GetTopologyVersion();
+
+    // Act
+    MeshCore::MeshFacetModifier modifier = kernel.ModifyFacets();
+    unsigned long unchanged = kernel.GetTopologyVersion();
+    // the first facet no longer references point 0
+    modifier.Transpose(0, 0, 21);
+    adjacency.Validate();
+
+    // Assert
+    EXPECT_EQ(unchanged, version);
+    EXPECT_NE(kernel.GetTopologyVersion(), version);
+    EXPECT_EQ(adjacency.GetFacets(0).size(), 0);
+}
+
+TEST_F(AlgorithmTest, normalsIndependentOfThreadCount)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(300);
+
+    // Act
+    MeshCore::MeshDefinitions::SetThreadCount(1);
+    MeshCore::MeshRefNormalToPoints serial(kernel);
+    MeshCore::MeshDefinitions::SetThreadCount(4);
+    MeshCore::MeshRefNormalToPoints parallel(kernel);
+
+    // Assert
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(serial[i], parallel[i]);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
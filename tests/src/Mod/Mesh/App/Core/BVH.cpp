@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    // Two huge triangles at z=0 and a dense wavy patch of size x size points above them
+    static MeshCore::MeshKernel createSkewedMesh(unsigned long size)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        points.reserve(size * size + 4);
+        points.push_back(MeshCore::MeshPoint(-100.0F, -100.0F, 0.0F));
+        points.push_back(MeshCore::MeshPoint(100.0F, -100.0F, 0.0F));
+        points.push_back(MeshCore::MeshPoint(100.0F, 100.0F, 0.0F));
+        points.push_back(MeshCore::MeshPoint(-100.0F, 100.0F, 0.0F));
+        facets.push_back(MeshCore::MeshFacet(0, 1, 2));
+        facets.push_back(MeshCore::MeshFacet(0, 2, 3));
+
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                float x = static_cast<float>(i) * 0.01F;
+                float y = static_cast<float>(j) * 0.01F;
+                float z = 1.0F + 0.1F * std::sin(10.0F * x) * std::cos(10.0F * y);
+                points.push_back(MeshCore::MeshPoint(x, y, z));
+            }
+        }
+        for (unsigned long i = 0; i + 1 < size; i++) {
+            for (unsigned long j = 0; j + 1 < size; j++) {
+                MeshCore::PointIndex p = 4 + i * size + j;
+                facets.push_back(MeshCore::MeshFacet(p, p + size, p + 1));
+                facets.push_back(MeshCore::MeshFacet(p + 1, p + size, p + size + 1));
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets);
+        return kernel;
+    }
+
+    // Rays from above, distributed over the patch and the large triangles
+    static std::vector<std::pair<Base::Vector3f, Base::Vector3f>> createRays(int count)
+    {
+        std::vector<std::pair<Base::Vector3f, Base::Vector3f>> rays;
+        for (int i = 0; i < count; i++) {
+            float t = static_cast<float>(i) / static_cast<float>(count);
+            float x = -0.5F + 3.0F * t;
+            float y = 2.0F - 2.5F * std::fmod(7.0F * t, 1.0F);
+            Base::Vector3f dir(0.1F * std::sin(13.0F * t), 0.1F * std::cos(11.0F * t), -1.0F);
+            rays.emplace_back(Base::Vector3f(x, y, 5.0F), dir);
+        }
+        return rays;
+    }
+
+    static float bruteForceDistance(const MeshCore::MeshKernel& kernel, const Base::Vector3f& pnt)
+    {
+        float minDist = FLT_MAX;
+        MeshCore::MeshFacetIterator it(kernel);
+        for (it.Init(); it.More(); it.Next()) {
+            minDist = std::min(minDist, it->DistanceToPoint(pnt));
+        }
+        return minDist;
+    }
+};
+
+TEST_F(BVHTest, emptyMesh)
+{
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::Vector3f res;
+    MeshCore::FacetIndex facet {};
+
+    EXPECT_FALSE(bvh.NearestFacetOnRay(Base::Vector3f(0, 0, 1),
+                                       Base::Vector3f(0, 0, -1),
+                                       MeshCore::Mathf::PI,
+                                       res,
+                                       facet));
+    EXPECT_EQ(bvh.SearchNearestFromPoint(Base::Vector3f()), MeshCore::FACET_INDEX_MAX);
+}
+
+TEST_F(BVHTest, rayLikeBruteForce)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createSkewedMesh(100);
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm algo(kernel);
+
+    for (const auto& ray : createRays(200)) {
+        // Act
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex facet1 {}, facet2 {};
+        bool found1 = algo.NearestFacetOnRay(ray.first, ray.second, bvh, res1, facet1);
+        bool found2 = algo.NearestFacetOnRay(ray.first, ray.second, res2, facet2);
+
+        // Assert
+        ASSERT_EQ(found1, found2);
+        if (found1) {
+            EXPECT_NEAR(Base::Distance(ray.first, res1), Base::Distance(ray.first, res2), 1e-4F);
+        }
+    }
+}
+
+TEST_F(BVHTest, nearestFromPointLikeBruteForce)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createSkewedMesh(100);
+    MeshCore::MeshFacetBVH bvh(kernel);
+
+    for (const auto& ray : createRays(100)) {
+        Base::Vector3f pnt = ray.first + ray.second * 4.0F;
+
+        // Act
+        float dist {};
+        MeshCore::FacetIndex facet = bvh.SearchNearestFromPoint(pnt, FLT_MAX, dist);
+
+        // Assert
+        ASSERT_NE(facet, MeshCore::FACET_INDEX_MAX);
+        EXPECT_NEAR(dist, bruteForceDistance(kernel, pnt), 1e-5F);
+        EXPECT_NEAR(kernel.GetFacet(facet).DistanceToPoint(pnt), dist, 1e-5F);
+    }
+}
+
+TEST_F(BVHTest, insideLikeBoundingBoxes)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createSkewedMesh(100);
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::BoundBox3f box(0.2F, 0.3F, 0.5F, 0.4F, 0.6F, 1.5F);
+
+    // Act
+    std::vector<MeshCore::FacetIndex> facets;
+    bvh.Inside(box, facets);
+
+    // Assert
+    std::sort(facets.begin(), facets.end());
+    std::vector<MeshCore::FacetIndex> expected;
+    MeshCore::MeshFacetIterator it(kernel);
+    for (it.Init(); it.More(); it.Next()) {
+        if (it->GetBoundBox().Intersect(box)) {
+            expected.push_back(it.Position());
+        }
+    }
+    EXPECT_EQ(facets, expected);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
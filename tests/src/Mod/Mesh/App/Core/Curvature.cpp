@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <cmath>
+
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CurvatureTest: public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        MeshCore::MeshDefinitions::SetThreadCount(0);
+    }
+
+    static std::vector<MeshCore::CurvatureInfo> computePerVertex(const MeshCore::MeshKernel& kernel,
+                                                                 int threads)
+    {
+        MeshCore::MeshDefinitions::SetThreadCount(threads);
+        MeshCore::MeshCurvature curvature(kernel);
+        curvature.ComputePerVertex();
+        return curvature.GetCurvature();
+    }
+};
+
+TEST_F(CurvatureTest, perVertexLikeMeshCurvature)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(100);
+    std::vector<Wm4::Vector3<double>> points;
+    for (const auto& pnt : kernel.GetPoints()) {
+        points.emplace_back(pnt.x, pnt.y, pnt.z);
+    }
+    std::vector<int> indices;
+    for (const auto& facet : kernel.GetFacets()) {
+        for (MeshCore::PointIndex point : facet._aulPoints) {
+            indices.push_back(int(point));
+        }
+    }
+
+    // Act
+    std::vector<MeshCore::CurvatureInfo> info = computePerVertex(kernel, 4);
+    Wm4::MeshCurvature<double> serial(int(points.size()),
+                                      points.data(),
+                                      int(kernel.CountFacets()),
+                                      indices.data());
+
+    // Assert
+    ASSERT_EQ(info.size(), points.size());
+    for (std::size_t i = 0; i < info.size(); i++) {
+        EXPECT_EQ(info[i].fMaxCurvature, float(serial.GetMaxCurvatures()[i]));
+        EXPECT_EQ(info[i].fMinCurvature, float(serial.GetMinCurvatures()[i]));
+        EXPECT_EQ(info[i].cMaxCurvDir.x, float(serial.GetMaxDirections()[i].X()));
+        EXPECT_EQ(info[i].cMinCurvDir.y, float(serial.GetMinDirections()[i].Y()));
+    }
+}
+
+TEST_F(CurvatureTest, perVertexIndependentOfThreadCount)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(100);
+
+    // Act
+    std::vector<MeshCore::CurvatureInfo> info1 = computePerVertex(kernel, 1);
+    std::vector<MeshCore::CurvatureInfo> info4 = computePerVertex(kernel, 4);
+
+    // Assert
+    ASSERT_EQ(info1.size(), info4.size());
+    for (std::size_t i = 0; i < info1.size(); i++) {
+        EXPECT_EQ(info1[i].fMaxCurvature, info4[i].fMaxCurvature);
+        EXPECT_EQ(info1[i].fMinCurvature, info4[i].fMinCurvature);
+        EXPECT_EQ(info1[i].cMaxCurvDir, info4[i].cMaxCurvDir);
+        EXPECT_EQ(info1[i].cMinCurvDir, info4[i].cMinCurvDir);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,195 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    static std::size_t countBorderEdges(const MeshCore::MeshKernel& kernel)
+    {
+        std::size_t count = 0;
+        for (const auto& facet : kernel.GetFacets()) {
+            for (int i = 0; i < 3; i++) {
+                if (facet._aulNeighbours[i] == MeshCore::FACET_INDEX_MAX) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(DecimationTest, emptyMesh)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.targetSize = 100;
+
+    // Act
+    MeshCore::MeshSimplify::Result result = simplify.simplify(settings);
+
+    // Assert
+    EXPECT_EQ(result.numFacets, 0);
+    EXPECT_EQ(result.numCollapses, 0);
+    EXPECT_EQ(kernel.CountFacets(), 0);
+}
+
+TEST_F(DecimationTest, reachTargetSize)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(200);
+    std::size_t borderEdges = countBorderEdges(kernel);
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.targetSize = kernel.CountFacets() / 10;
+    settings.blocksPerAxis = 4;
+
+    // Act
+    MeshCore::MeshSimplify::Result result = simplify.simplify(settings);
+
+    // Assert
+    EXPECT_EQ(result.numFacets, kernel.CountFacets());
+    EXPECT_LE(result.numFacets, settings.targetSize + settings.targetSize / 20);
+    EXPECT_GT(result.maxError, 0.0);
+    EXPECT_GT(result.numPasses, 1);
+    // The border is kept and the mesh remains closed inside
+    EXPECT_EQ(countBorderEdges(kernel), borderEdges);
+    for (const auto& point : kernel.GetPoints()) {
+        EXPECT_NEAR(point.z, std::sin(point.x) * std::cos(point.y), 0.05F);
+    }
+}
+
+TEST_F(DecimationTest, limitError)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(200);
+    std::size_t numFacets = kernel.CountFacets();
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.maxError = 1e-6;
+    settings.blocksPerAxis = 4;
+
+    // Act
+    MeshCore::MeshSimplify::Result result = simplify.simplify(settings);
+
+    // Assert
+    EXPECT_LT(result.numFacets, numFacets);
+    EXPECT_GT(result.numCollapses, 0);
+    EXPECT_LE(result.maxError, settings.maxError);
+}
+
+TEST_F(DecimationTest, planeWithoutError)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(100, 0.0F);
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.maxError = 0.0;
+
+    // Act
+    MeshCore::MeshSimplify::Result result = simplify.simplify(settings);
+
+    // Assert
+    // Mostly the points of the border remain
+    EXPECT_LT(kernel.CountPoints(), 100 * 100 / 5);
+    EXPECT_EQ(result.maxError, 0.0);
+    for (const auto& point : kernel.GetPoints()) {
+        EXPECT_EQ(point.z, 0.0F);
+    }
+}
+
+TEST_F(DecimationTest, mapPointsToOriginal)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(100);
+    MeshCore::MeshPointArray original = kernel.GetPoints();
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.targetSize = kernel.CountFacets() / 4;
+
+    // Act
+    simplify.simplify(settings);
+
+    // Assert
+    const std::vector<MeshCore::PointIndex>& map = simplify.GetPointMap();
+    ASSERT_EQ(map.size(), kernel.CountPoints());
+    for (std::size_t i = 0; i < map.size(); i++) {
+        ASSERT_LT(map[i], original.size());
+        const MeshCore::MeshPoint& point = kernel.GetPoint(i);
+        // Points are only moved along the edges
+        EXPECT_LT(Base::Distance(point, original[map[i]]), 1.0F);
+        if (point.x == 0.0F) {
+            EXPECT_EQ(point, original[map[i]]);
+        }
+    }
+}
+
+TEST_F(DecimationTest, simplifyBorders)
+{
+    // Arrange
+    // A strip of two rows of points where each inner edge connects two border points
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (unsigned long i = 0; i < 50; i++) {
+        points.push_back(MeshCore::MeshPoint(static_cast<float>(i), 0.0F, 0.0F));
+        points.push_back(MeshCore::MeshPoint(static_cast<float>(i), 1.0F, 0.0F));
+    }
+    for (MeshCore::PointIndex p = 0; p + 3 < points.size(); p += 2) {
+        facets.push_back(MeshCore::MeshFacet(p, p + 2, p + 1));
+        facets.push_back(MeshCore::MeshFacet(p + 1, p + 2, p + 3));
+    }
+    std::size_t numFacets = facets.size();
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.targetSize = 2;
+    settings.keepBorders = false;
+
+    // Act
+    MeshCore::MeshSimplify::Result result = simplify.simplify(settings);
+
+    // Assert
+    EXPECT_GT(result.numCollapses, 0);
+    EXPECT_LT(kernel.CountFacets(), numFacets);
+    MeshCore::MeshEvalPointManifolds eval(kernel);
+    EXPECT_TRUE(eval.Evaluate());
+    MeshCore::MeshEvalTopology topo(kernel);
+    EXPECT_TRUE(topo.Evaluate());
+}
+
+TEST_F(DecimationTest, decimateOpenMesh)
+{
+    // Arrange
+    // An open grid split into several blocks whose borders run through the mesh
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(120);
+    std::size_t numFacets = kernel.CountFacets();
+    MeshCore::MeshSimplify simplify(kernel);
+    MeshCore::MeshSimplify::Settings settings;
+    settings.targetSize = numFacets / 8;
+    settings.keepBorders = false;
+    settings.blocksPerAxis = 3;
+
+    // Act
+    MeshCore::MeshSimplify::Result result = simplify.simplify(settings);
+
+    // Assert
+    EXPECT_LT(kernel.CountFacets(), numFacets / 2);
+    EXPECT_EQ(result.numFacets, kernel.CountFacets());
+    // The mesh stays open and no border points are pinched together
+    EXPECT_GT(countBorderEdges(kernel), 0);
+    MeshCore::MeshEvalPointManifolds eval(kernel);
+    EXPECT_TRUE(eval.Evaluate());
+    MeshCore::MeshEvalTopology topo(kernel);
+    EXPECT_TRUE(topo.Evaluate());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SelfIntersectionTest: public ::testing::Test
+{
+protected:
+    using FacetPairs = std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>>;
+
+    // Adds a grid of size x size points whose positions are given by func(u, v)
+    static void addGrid(MeshCore::MeshPointArray& points,
+                        MeshCore::MeshFacetArray& facets,
+                        unsigned long size,
+                        const std::function<Base::Vector3f(float, float)>& func)
+    {
+        MeshCore::PointIndex offset = points.size();
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                float u = static_cast<float>(i) * 0.1F;
+                float v = static_cast<float>(j) * 0.1F;
+                points.push_back(MeshCore::MeshPoint(func(u, v)));
+            }
+        }
+        for (unsigned long i = 0; i + 1 < size; i++) {
+            for (unsigned long j = 0; j + 1 < size; j++) {
+                MeshCore::PointIndex p = offset + i * size + j;
+                facets.push_back(MeshCore::MeshFacet(p, p + size, p + 1));
+                facets.push_back(MeshCore::MeshFacet(p + 1, p + size, p + size + 1));
+            }
+        }
+    }
+
+    // A wavy grid, optionally crossed by a second wavy grid standing upright
+    static MeshCore::MeshKernel createMesh(unsigned long size, bool crossed)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        addGrid(points, facets, size, [](float u, float v) {
+            return Base::Vector3f(u, v, std::sin(u) * std::cos(v));
+        });
+        if (crossed) {
+            float half = static_cast<float>(size) * 0.05F;
+            addGrid(points, facets, size, [half](float u, float v) {
+                return Base::Vector3f(u, half + 0.2F * std::sin(2.0F * u), v - half);
+            });
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets);
+        return kernel;
+    }
+
+    // The loop of MeshEvalSelfIntersection::GetIntersections() before it was parallelized
+    static FacetPairs intersectionsSerial(const MeshCore::MeshKernel& kernel)
+    {
+        FacetPairs intersection;
+        MeshCore::MeshFacetGrid grid(kernel);
+        const MeshCore::MeshFacetArray& faces = kernel.GetFacets();
+        MeshCore::MeshGridIterator gridIter(grid);
+        for (gridIter.Init(); gridIter.More(); gridIter.Next()) {
+            std::vector<MeshCore::FacetIndex> elements;
+            gridIter.GetElements(elements);
+            for (auto it = elements.begin(); it != elements.end(); ++it) {
+                MeshCore::MeshGeomFacet facet1 = kernel.GetFacet(*it);
+                for (auto jt = it + 1; jt != elements.end(); ++jt) {
+                    const MeshCore::MeshFacet& face1 = faces[*it];
+                    const MeshCore::MeshFacet& face2 = faces[*jt];
+                    bool common = false;
+                    for (int i = 0; i < 3; i++) {
+                        for (int j = 0; j < 3; j++) {
+                            common = common || face1._aulPoints[i] == face2._aulPoints[j];
+                        }
+                    }
+                    MeshCore::MeshGeomFacet facet2 = kernel.GetFacet(*jt);
+                    Base::Vector3f pt1, pt2;
+                    if (!common && (facet1.GetBoundBox() && facet2.GetBoundBox())
+                        && facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+                        intersection.emplace_back(*it, *jt);
+                    }
+                }
+            }
+        }
+        return intersection;
+    }
+};
+
+TEST_F(SelfIntersectionTest, noIntersections)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createMesh(100, false);
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+
+    // Act
+    FacetPairs intersection;
+    eval.GetIntersections(intersection);
+
+    // Assert
+    EXPECT_TRUE(eval.Evaluate());
+    EXPECT_TRUE(intersection.empty());
+}
+
+TEST_F(SelfIntersectionTest, intersectionsLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createMesh(100, true);
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+
+    // Act
+    FacetPairs intersection;
+    eval.GetIntersections(intersection);
+    std::vector<std::pair<Base::Vector3f, Base::Vector3f>> lines;
+    eval.GetIntersections(intersection, lines);
+
+    // Assert
+    EXPECT_FALSE(eval.Evaluate());
+    EXPECT_FALSE(intersection.empty());
+    EXPECT_EQ(intersection, intersectionsSerial(kernel));
+    EXPECT_EQ(lines.size(), intersection.size());
+}
+
+TEST_F(SelfIntersectionTest, fixFacetsLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createMesh(100, true);
+    FacetPairs intersection = intersectionsSerial(kernel);
+    MeshCore::MeshFixSelfIntersection fix(kernel, intersection);
+
+    // Act
+    std::vector<MeshCore::FacetIndex> facets = fix.GetFacets();
+
+    // Assert
+    std::vector<MeshCore::FacetIndex> expected;
+    const MeshCore::MeshFacetArray& faces = kernel.GetFacets();
+    for (const auto& it : intersection) {
+        unsigned short numOpenEdges1 = faces[it.first].CountOpenEdges();
+        unsigned short numOpenEdges2 = faces[it.second].CountOpenEdges();
+        if (numOpenEdges1 == 0 || numOpenEdges2 > 0) {
+            expected.push_back(it.second);
+        }
+        if (numOpenEdges1 > 0 || numOpenEdges2 == 0) {
+            expected.push_back(it.first);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+    EXPECT_EQ(facets, expected);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+using SetGrid = std::vector<std::vector<std::vector<std::set<MeshCore::ElementIndex>>>>;
+
+// Gives access to the cells of the facets to build the nested sets used before MeshGridCells
+class SetFacetGrid: public MeshCore::MeshFacetGrid
+{
+public:
+    SetFacetGrid(const MeshCore::MeshKernel& mesh, int ctGridsPerAxis)
+        : MeshCore::MeshFacetGrid(mesh, ctGridsPerAxis)
+    {}
+
+    void BuildSets(SetGrid& grid) const
+    {
+        grid.clear();
+        grid.resize(_ulCtGridsX);
+        for (auto& plane : grid) {
+            plane.resize(_ulCtGridsY);
+            for (auto& line : plane) {
+                line.resize(_ulCtGridsZ);
+            }
+        }
+
+        std::vector<unsigned long> cells;
+        for (MeshCore::ElementIndex i = 0; i < _pclMesh->CountFacets(); i++) {
+            cells.clear();
+            GetFacetCells(_pclMesh->GetFacet(i), cells);
+            for (unsigned long cell : cells) {
+                unsigned long x {}, y {}, z {};
+                GetPositionToIndex(cell, x, y, z);
+                grid[x][y][z].insert(i);
+            }
+        }
+    }
+};
+}  // namespace
+
+class GridTest: public ::testing::Test
+{
+protected:
+    // A wavy grid of size x size points
+    static MeshCore::MeshKernel createMesh(unsigned long size)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        points.reserve(size * size);
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                float x = static_cast<float>(i) * 0.1F;
+                float y = static_cast<float>(j) * 0.1F;
+                points.push_back(MeshCore::MeshPoint(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+        for (unsigned long i = 0; i + 1 < size; i++) {
+            for (unsigned long j = 0; j + 1 < size; j++) {
+                MeshCore::PointIndex p = i * size + j;
+                facets.push_back(MeshCore::MeshFacet(p, p + size, p + 1));
+                facets.push_back(MeshCore::MeshFacet(p + 1, p + size, p + size + 1));
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets);
+        return kernel;
+    }
+};
+
+TEST_F(GridTest, facetGridMatchesSets)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createMesh(300);
+    SetFacetGrid grid(kernel, 20);
+    SetGrid sets;
+
+    // Act
+    grid.BuildSets(sets);
+
+    // Assert
+    EXPECT_TRUE(grid.Verify());
+    unsigned long ctX {}, ctY {}, ctZ {};
+    grid.GetCtGrids(ctX, ctY, ctZ);
+    for (unsigned long x = 0; x < ctX; x++) {
+        for (unsigned long y = 0; y < ctY; y++) {
+            for (unsigned long z = 0; z < ctZ; z++) {
+                MeshCore::MeshGridCells::Range cell = grid.Cell(x, y, z);
+                std::vector<MeshCore::ElementIndex> elements(cell.begin(), cell.end());
+                std::vector<MeshCore::ElementIndex> expected(sets[x][y][z].begin(),
+                                                             sets[x][y][z].end());
+                EXPECT_EQ(elements, expected);
+            }
+        }
+    }
+}
+
+TEST_F(GridTest, pointGridContainsEachPointOnce)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = createMesh(300);
+
+    // Act
+    MeshCore::MeshPointGrid grid(kernel, 20);
+
+    // Assert
+    std::vector<int> found(kernel.CountPoints());
+    MeshCore::MeshGridIterator it(grid);
+    for (it.Init(); it.More(); it.Next()) {
+        std::vector<MeshCore::ElementIndex> elements;
+        it.GetElements(elements);
+        for (MeshCore::ElementIndex index : elements) {
+            EXPECT_TRUE(it.GetBoundBox().IsInBox(kernel.GetPoint(index)));
+            found[index]++;
+        }
+    }
+    EXPECT_EQ(std::count(found.begin(), found.end(), 1), static_cast<long>(found.size()));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/IO/ReaderData.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(ReaderDataTest, splitLines)
+{
+    // Arrange
+    std::string data = "first line\nsecond line\nthird line\nlast line";
+
+    // Act
+    auto blocks = MeshCore::SplitLines(data.c_str(), data.size(), 15);
+
+    // Assert
+    ASSERT_EQ(blocks.size(), 2);
+    EXPECT_EQ(std::string(blocks[0].first, blocks[0].second), "first line\nsecond line\n");
+    EXPECT_EQ(std::string(blocks[1].first, blocks[1].second), "third line\nlast line");
+    EXPECT_EQ(MeshCore::CountLines(data.c_str(), data.size()), 4);
+}
+
+TEST(ReaderDataTest, forEachLine)
+{
+    // Arrange
+    std::string data = "1.5\n\n2.5";
+    std::vector<std::string> lines;
+    std::vector<char> ends;
+
+    // Act
+    MeshCore::ForEachLine(data.c_str(), data.size(), [&](const char* begin, const char* end) {
+        lines.emplace_back(begin, end);
+        ends.push_back(*end);
+    });
+
+    // Assert
+    EXPECT_EQ(lines, std::vector<std::string>({"1.5", "", "2.5"}));
+    EXPECT_EQ(ends, std::vector<char>({'\n', '\n', '\0'}));
+}
+
+TEST(ReaderDataTest, readLines)
+{
+    // Arrange
+    std::string data = "a\nbb\na very long line\nccc\n\nend";
+    std::istringstream str(data);
+    std::vector<std::string> blocks;
+
+    // Act
+    MeshCore::ReadLines(str, 4, [&blocks](const char* block, std::size_t size) {
+        blocks.emplace_back(block, size);
+    });
+
+    // Assert
+    std::string joined;
+    for (const auto& it : blocks) {
+        EXPECT_TRUE(it.back() == '\n' || &it == &blocks.back());
+        joined += it;
+    }
+    EXPECT_EQ(joined, data);
+}
+
+TEST(ReaderDataTest, memoryBuffer)
+{
+    // Arrange
+    std::string data = "header\nbody";
+    MeshCore::MemoryBuffer buf(data.c_str(), data.size());
+    std::istream str(&buf);
+    std::string line;
+
+    // Act
+    std::getline(str, line);
+    auto pos = str.tellg();
+    str.seekg(2, std::ios::cur);
+    char c = static_cast<char>(str.get());
+
+    // Assert
+    EXPECT_EQ(line, "header");
+    EXPECT_EQ(pos, std::streampos(7));
+    EXPECT_EQ(c, 'd');
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
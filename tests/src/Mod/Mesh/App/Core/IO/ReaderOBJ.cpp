@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/IO/ReaderOBJ.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace fs = std::filesystem;
+
+class ReaderOBJTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = fs::temp_directory_path() / "unit_test_ReaderOBJ.obj";
+    }
+
+    void TearDown() override
+    {
+        fs::remove(_path);
+    }
+
+    // OBJ data of a wavy grid with size x size points. The first half of the rows is
+    // in group 'first' with triangles, the second one in group 'second' with quads and
+    // negative indices. The last line has no line break.
+    static std::string createData(unsigned long size)
+    {
+        std::ostringstream str;
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                float x = static_cast<float>(i) * 0.1F;
+                float y = static_cast<float>(j) * 0.1F;
+                str << "v " << x << " " << y << " " << std::sin(x) * std::cos(y) << '\n';
+            }
+        }
+
+        long count = static_cast<long>(size * size);
+        str << "g first\n";
+        for (unsigned long i = 0; i + 1 < size; i++) {
+            if (i + 1 == size / 2) {
+                str << "g second\n";
+            }
+            for (unsigned long j = 0; j + 1 < size; j++) {
+                long p = static_cast<long>(i * size + j);
+                long s = static_cast<long>(size);
+                if (i + 1 < size / 2) {
+                    str << "f " << p + 1 << " " << p + s + 1 << " " << p + 2 << '\n';
+                    str << "f " << p + 2 << " " << p + s + 1 << " " << p + s + 2 << '\n';
+                }
+                else {
+                    str << "f " << p - count << " " << p + s - count << " " << p + s + 1 - count
+                        << " " << p + 1 - count << '\n';
+                }
+            }
+        }
+
+        std::string data = str.str();
+        data.pop_back();
+        return data;
+    }
+
+    void writeFile(const std::string& data) const
+    {
+        std::ofstream str(_path, std::ios::out | std::ios::binary);
+        str << data;
+    }
+
+    fs::path _path;  // NOLINT Can't be private in a test framework
+};
+
+TEST_F(ReaderOBJTest, groupsAndNegativeIndices)
+{
+    // Arrange
+    unsigned long size = 300;
+    std::istringstream str(createData(size));
+    MeshCore::MeshKernel kernel;
+
+    // Act
+    MeshCore::ReaderOBJ reader(kernel, nullptr);
+    bool ok = reader.Load(str);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(kernel.CountPoints(), size * size);
+    EXPECT_EQ(kernel.CountFacets(), 2 * (size - 1) * (size - 1));
+    EXPECT_EQ(reader.GetGroupNames(), std::vector<std::string>({"first", "second"}));
+    std::size_t first = 2 * (size / 2 - 1) * (size - 1);
+    for (std::size_t i = 0; i < kernel.CountFacets(); i++) {
+        EXPECT_EQ(kernel.GetFacets()[i]._ulProp, i < first ? 1 : 2);
+    }
+    // the neighbourhood is set, only the border edges are open
+    std::size_t openEdges = 0;
+    for (const auto& facet : kernel.GetFacets()) {
+        openEdges += facet.CountOpenEdges();
+    }
+    EXPECT_EQ(openEdges, 4 * (size - 1));
+}
+
+TEST_F(ReaderOBJTest, mappedLikeStream)
+{
+    // Arrange
+    std::string data = createData(300);
+    writeFile(data);
+    std::istringstream str(data);
+    MeshCore::MeshKernel kernel1;
+    MeshCore::MeshKernel kernel2;
+
+    // Act
+    MeshCore::ReaderOBJ reader1(kernel1, nullptr);
+    bool mapped = reader1.Load(_path.string());
+    MeshCore::ReaderOBJ reader2(kernel2, nullptr);
+    bool streamed = reader2.Load(str);
+
+    // Assert
+    EXPECT_TRUE(mapped);
+    EXPECT_TRUE(streamed);
+    EXPECT_EQ(kernel1.GetPoints(), kernel2.GetPoints());
+    ASSERT_EQ(kernel1.CountFacets(), kernel2.CountFacets());
+    for (std::size_t i = 0; i < kernel1.CountFacets(); i++) {
+        const auto& facet1 = kernel1.GetFacets()[i];
+        const auto& facet2 = kernel2.GetFacets()[i];
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facet1._aulPoints[j], facet2._aulPoints[j]);
+        }
+        EXPECT_EQ(facet1._ulProp, facet2._ulProp);
+    }
+    EXPECT_EQ(reader1.GetGroupNames(), reader2.GetGroupNames());
+}
+
+TEST_F(ReaderOBJTest, cropToBoundBox)
+{
+    // Arrange
+    std::istringstream str(createData(300));
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshInput input(kernel);
+    Base::BoundBox3f box(20.05F, 1.05F, -2.0F, 21.05F, 3.05F, 2.0F);
+
+    // Act
+    input.SetBoundBox(box);
+    bool ok = input.LoadFormat(str, MeshCore::MeshIO::OBJ);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(kernel.CountFacets(), 2 * 11 * 21);
+    EXPECT_EQ(kernel.CountPoints(), 12 * 22);
+    for (const auto& facet : kernel.GetFacets()) {
+        EXPECT_TRUE(kernel.GetFacet(facet).GetBoundBox() && box);
+    }
+    // only the second group is left
+    EXPECT_EQ(input.GetGroupNames(), std::vector<std::string>({"second"}));
+}
+
+TEST_F(ReaderOBJTest, materialsAndColors)
+{
+    // Arrange
+    std::istringstream str("mtllib colors.mtl\n"
+                           "v 0 0 0 255 0 0\n"
+                           "v 1 0 0 0 255 0\n"
+                           "v 0 1 0 0 0 255\n"
+                           "v 1 1 0 0 0 255\n"
+                           "usemtl red\n"
+                           "f 1 2 3\n"
+                           "usemtl green\n"
+                           "f 2 4 3\n");
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material material;
+
+    // Act
+    MeshCore::ReaderOBJ reader(kernel, &material);
+    bool ok = reader.Load(str);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(kernel.CountFacets(), 2);
+    EXPECT_EQ(material.library, "colors.mtl");
+    EXPECT_EQ(material.binding, MeshCore::MeshIO::PER_VERTEX);
+    ASSERT_EQ(material.diffuseColor.size(), 4);
+    EXPECT_EQ(material.diffuseColor[1], App::Color(0.0F, 1.0F, 0.0F));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
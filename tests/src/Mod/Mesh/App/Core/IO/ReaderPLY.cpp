@@ -0,0 +1,212 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/IO/ReaderPLY.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "../MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace fs = std::filesystem;
+
+class ReaderPLYTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = fs::temp_directory_path() / "unit_test_ReaderPLY.ply";
+    }
+
+    void TearDown() override
+    {
+        fs::remove(_path);
+    }
+
+
+    void writeFile(const std::string& data) const
+    {
+        std::ofstream str(_path, std::ios::out | std::ios::binary);
+        str << data;
+    }
+
+    static void expectEqual(const MeshCore::MeshKernel& kernel1,
+                            const MeshCore::MeshKernel& kernel2)
+    {
+        ASSERT_EQ(kernel1.CountFacets(), kernel2.CountFacets());
+        EXPECT_EQ(kernel1.GetPoints(), kernel2.GetPoints());
+        for (std::size_t i = 0; i < kernel1.CountFacets(); i++) {
+            const auto& facet1 = kernel1.GetFacets()[i];
+            const auto& facet2 = kernel2.GetFacets()[i];
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(facet1._aulPoints[j], facet2._aulPoints[j]);
+            }
+        }
+    }
+
+    fs::path _path;  // NOLINT Can't be private in a test framework
+};
+
+TEST_F(ReaderPLYTest, binaryFile)
+{
+    // Arrange
+    MeshCore::MeshKernel grid = MeshTestHelpers::createGrid(400);
+    std::ostringstream out;
+    MeshCore::MeshOutput(grid).SaveBinaryPLY(out);
+    writeFile(out.str());
+    MeshCore::MeshKernel kernel1;
+    MeshCore::MeshKernel kernel2;
+    std::istringstream str(out.str());
+
+    // Act
+    MeshCore::ReaderPLY reader1(kernel1, nullptr);
+    bool mapped = reader1.Load(_path.string());
+    MeshCore::ReaderPLY reader2(kernel2, nullptr);
+    bool streamed = reader2.Load(str);
+
+    // Assert
+    EXPECT_TRUE(mapped);
+    EXPECT_TRUE(streamed);
+    expectEqual(kernel1, grid);
+    expectEqual(kernel2, grid);
+}
+
+TEST_F(ReaderPLYTest, asciiFile)
+{
+    // Arrange
+    MeshCore::MeshKernel grid = MeshTestHelpers::createGrid(400);
+    std::ostringstream out;
+    MeshCore::MeshOutput(grid).SaveAsciiPLY(out);
+    writeFile(out.str());
+    MeshCore::MeshKernel kernel1;
+    MeshCore::MeshKernel kernel2;
+    std::istringstream str(out.str());
+
+    // Act
+    MeshCore::ReaderPLY reader1(kernel1, nullptr);
+    bool mapped = reader1.Load(_path.string());
+    MeshCore::ReaderPLY reader2(kernel2, nullptr);
+    bool streamed = reader2.Load(str);
+
+    // Assert
+    EXPECT_TRUE(mapped);
+    EXPECT_TRUE(streamed);
+    EXPECT_EQ(kernel1.CountFacets(), grid.CountFacets());
+    expectEqual(kernel1, kernel2);
+    for (std::size_t i = 0; i < grid.CountPoints(); i++) {
+        EXPECT_LT(Base::Distance(kernel1.GetPoint(i), grid.GetPoint(i)), 1e-4F);
+    }
+}
+
+TEST_F(ReaderPLYTest, asciiColors)
+{
+    // Arrange
+    std::string data = "ply\n"
+                       "format ascii 1.0\n"
+                       "element vertex 3\n"
+                       "property float x\n"
+                       "property float y\n"
+                       "property float z\n"
+                       "property uchar red\n"
+                       "property uchar green\n"
+                       "property uchar blue\n"
+                       "element face 1\n"
+                       "property list uchar int vertex_indices\n"
+                       "end_header\n"
+                       "0 0 0 255 0 0\n"
+                       "1 0 0 0 255 0\n"
+                       "0 1 0 0 0 255\n"
+                       "3 0 1 2";
+    writeFile(data);
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material material;
+
+    // Act
+    MeshCore::ReaderPLY reader(kernel, &material);
+    bool ok = reader.Load(_path.string());
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(kernel.CountPoints(), 3);
+    EXPECT_EQ(kernel.CountFacets(), 1);
+    EXPECT_EQ(material.binding, MeshCore::MeshIO::PER_VERTEX);
+    ASSERT_EQ(material.diffuseColor.size(), 3);
+    EXPECT_EQ(material.diffuseColor[1], App::Color(0.0F, 1.0F, 0.0F));
+}
+
+TEST_F(ReaderPLYTest, binaryPolygons)
+{
+    // Arrange
+    std::string data = "ply\n"
+                       "format binary_big_endian 1.0\n"
+                       "element vertex 4\n"
+                       "property double x\n"
+                       "property double y\n"
+                       "property double z\n"
+                       "element face 2\n"
+                       "property list uchar int vertex_indices\n"
+                       "end_header\n";
+    auto addValue = [&data](auto value) {
+        char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        std::reverse(bytes, bytes + sizeof(value));
+        data.append(bytes, sizeof(value));
+    };
+    double coords[] = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+    for (double value : coords) {
+        addValue(value);
+    }
+    // a quad is skipped, only triangles are kept
+    addValue(uint8_t(4));
+    for (int32_t index : {0, 1, 2, 3}) {
+        addValue(index);
+    }
+    addValue(uint8_t(3));
+    for (int32_t index : {0, 2, 3}) {
+        addValue(index);
+    }
+    writeFile(data);
+    MeshCore::MeshKernel kernel1;
+    MeshCore::MeshKernel kernel2;
+    std::istringstream str(data);
+
+    // Act
+    MeshCore::ReaderPLY reader1(kernel1, nullptr);
+    bool mapped = reader1.Load(_path.string());
+    MeshCore::ReaderPLY reader2(kernel2, nullptr);
+    bool streamed = reader2.Load(str);
+
+    // Assert
+    EXPECT_TRUE(mapped);
+    EXPECT_TRUE(streamed);
+    // the point that is only used by the quad is removed
+    ASSERT_EQ(kernel1.CountFacets(), 1);
+    EXPECT_EQ(kernel1.CountPoints(), 3);
+    EXPECT_EQ(kernel1.GetPoint(1), Base::Vector3f(1.0F, 1.0F, 0.0F));
+    expectEqual(kernel1, kernel2);
+}
+
+TEST_F(ReaderPLYTest, truncatedVertices)
+{
+    // Arrange
+    MeshCore::MeshKernel grid = MeshTestHelpers::createGrid(10);
+    std::ostringstream out;
+    MeshCore::MeshOutput(grid).SaveBinaryPLY(out);
+    std::string data = out.str();
+    data.resize(data.find("end_header\n") + 11 + 50);
+    writeFile(data);
+    MeshCore::MeshKernel kernel;
+
+    // Act
+    MeshCore::ReaderPLY reader(kernel, nullptr);
+    bool ok = reader.Load(_path.string());
+
+    // Assert
+    EXPECT_FALSE(ok);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
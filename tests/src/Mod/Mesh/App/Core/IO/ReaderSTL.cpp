@@ -0,0 +1,235 @@
+#include "gtest/gtest.h"
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/Builder.h>
+#include <Mod/Mesh/App/Core/IO/ReaderSTL.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ReaderSTLTest: public ::testing::Test
+{
+protected:
+    // Binary STL data of a wavy grid with size x size points
+    static std::string createData(unsigned long size)
+    {
+        auto point = [](unsigned long i, unsigned long j) {
+            float x = static_cast<float>(i) * 0.1F;
+            float y = static_cast<float>(j) * 0.1F;
+            return Base::Vector3f(x, y, std::sin(x) * std::cos(y));
+        };
+
+        std::string data(MeshCore::ReaderSTL::HeaderSize, ' ');
+        uint32_t count = 0;
+        auto addFacet = [&data, &count](const Base::Vector3f& p1,
+                                        const Base::Vector3f& p2,
+                                        const Base::Vector3f& p3) {
+            float coords[12] =
+                {0.0F, 0.0F, 1.0F, p1.x, p1.y, p1.z, p2.x, p2.y, p2.z, p3.x, p3.y, p3.z};
+            char record[MeshCore::ReaderSTL::RecordSize] {};
+            std::memcpy(record, coords, sizeof(coords));
+            data.append(record, sizeof(record));
+            count++;
+        };
+        for (unsigned long i = 0; i + 1 < size; i++) {
+            for (unsigned long j = 0; j + 1 < size; j++) {
+                addFacet(point(i, j), point(i + 1, j), point(i, j + 1));
+                addFacet(point(i, j + 1), point(i + 1, j), point(i + 1, j + 1));
+            }
+        }
+        std::memcpy(&data[80], &count, sizeof(count));
+        return data;
+    }
+
+    // ASCII STL data with the facets of the binary STL data
+    static std::string toAscii(const std::string& data)
+    {
+        uint32_t count {};
+        std::memcpy(&count, &data[80], sizeof(count));
+        std::ostringstream str;
+        str.precision(9);
+        str << "solid grid\n";
+        for (uint32_t i = 0; i < count; i++) {
+            float coords[12];
+            std::memcpy(coords,
+                        &data[MeshCore::ReaderSTL::HeaderSize + i * MeshCore::ReaderSTL::RecordSize],
+                        sizeof(coords));
+            str << "facet normal " << coords[0] << " " << coords[1] << " " << coords[2] << "\n";
+            str << "outer loop\n";
+            for (int j = 3; j < 12; j += 3) {
+                str << "vertex " << coords[j] << " " << coords[j + 1] << " " << coords[j + 2]
+                    << "\n";
+            }
+            str << "endloop\nendfacet\n";
+        }
+        str << "endsolid grid\n";
+        return str.str();
+    }
+
+    // A stream buffer that cannot seek, so the file size is unknown
+    class PipeBuffer: public std::stringbuf
+    {
+    public:
+        explicit PipeBuffer(const std::string& data)
+            : std::stringbuf(data, std::ios::in)
+        {}
+
+    protected:
+        pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override
+        {
+            return pos_type(off_type(-1));
+        }
+    };
+};
+
+TEST_F(ReaderSTLTest, invalidData)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderSTL reader(kernel);
+    std::string data = createData(10);
+
+    // Act
+    bool tooShort = reader.LoadBinary(data.data(), 50);
+    bool truncated = reader.LoadBinary(data.data(), data.size() - 1);
+
+    // Assert
+    EXPECT_FALSE(tooShort);
+    EXPECT_FALSE(truncated);
+}
+
+TEST_F(ReaderSTLTest, truncatedStream)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshInput input(kernel);
+    std::string data = createData(10);
+    data.resize(data.size() - 1);
+    PipeBuffer buf(data);
+    std::istream str(&buf);
+
+    // Act & Assert
+    EXPECT_THROW(input.LoadBinarySTL(str), Base::BadFormatError);
+}
+
+TEST_F(ReaderSTLTest, mergeIdenticalPoints)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderSTL reader(kernel);
+    std::string data = createData(300);
+
+    // Act
+    bool ok = reader.LoadBinary(data.data(), data.size());
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(kernel.CountPoints(), 300 * 300);
+    EXPECT_EQ(kernel.CountFacets(), 2 * 299 * 299);
+    std::set<std::tuple<float, float, float>> points;
+    for (const auto& pnt : kernel.GetPoints()) {
+        points.emplace(pnt.x, pnt.y, pnt.z);
+    }
+    EXPECT_EQ(points.size(), kernel.CountPoints());
+    // the neighbourhood is set, only the border edges are open
+    std::size_t openEdges = 0;
+    for (const auto& facet : kernel.GetFacets()) {
+        openEdges += facet.CountOpenEdges();
+    }
+    EXPECT_EQ(openEdges, 4 * 299);
+}
+
+TEST_F(ReaderSTLTest, streamLikeMemory)
+{
+    // Arrange
+    std::string data = createData(300);
+    MeshCore::MeshKernel kernel1;
+    MeshCore::MeshKernel kernel2;
+    std::istringstream str(data);
+
+    // Act
+    MeshCore::ReaderSTL reader(kernel1);
+    reader.LoadBinary(data.data(), data.size());
+    MeshCore::MeshInput input(kernel2);
+    bool ok = input.LoadBinarySTL(str);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(kernel1.GetPoints(), kernel2.GetPoints());
+    EXPECT_EQ(kernel1.CountFacets(), kernel2.CountFacets());
+}
+
+TEST_F(ReaderSTLTest, cropToBoundBox)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderSTL reader(kernel);
+    std::string data = createData(300);
+    Base::BoundBox3f box(1.05F, 1.05F, -2.0F, 2.05F, 3.05F, 2.0F);
+
+    // Act
+    reader.SetBoundBox(box);
+    reader.LoadBinary(data.data(), data.size());
+
+    // Assert
+    EXPECT_EQ(kernel.CountFacets(), 2 * 11 * 21);
+    for (const auto& facet : kernel.GetFacets()) {
+        EXPECT_TRUE(kernel.GetFacet(facet).GetBoundBox() && box);
+    }
+}
+
+TEST_F(ReaderSTLTest, decimateByClusters)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    MeshCore::ReaderSTL reader(kernel);
+    std::string data = createData(300);
+
+    // Act
+    reader.SetClusterSize(0.5F);
+    reader.LoadBinary(data.data(), data.size());
+
+    // Assert
+    EXPECT_GT(kernel.CountFacets(), 0);
+    EXPECT_LT(kernel.CountPoints(), 100 * 100);
+    for (const auto& facet : kernel.GetFacets()) {
+        EXPECT_NE(facet._aulPoints[0], facet._aulPoints[1]);
+        EXPECT_NE(facet._aulPoints[1], facet._aulPoints[2]);
+        EXPECT_NE(facet._aulPoints[2], facet._aulPoints[0]);
+    }
+}
+
+TEST_F(ReaderSTLTest, asciiLikeBinary)
+{
+    // Arrange
+    std::string data = createData(300);
+    std::istringstream binary(data);
+    std::istringstream ascii(toAscii(data));
+    MeshCore::MeshKernel kernel1;
+    MeshCore::MeshKernel kernel2;
+    MeshCore::MeshInput input1(kernel1);
+    MeshCore::MeshInput input2(kernel2);
+    Base::BoundBox3f box(1.05F, 1.05F, -2.0F, 12.05F, 13.05F, 2.0F);
+
+    // Act
+    input1.SetBoundBox(box);
+    input1.SetClusterSize(0.5F);
+    bool ok1 = input1.LoadFormat(binary, MeshCore::MeshIO::BSTL);
+    input2.SetBoundBox(box);
+    input2.SetClusterSize(0.5F);
+    bool ok2 = input2.LoadFormat(ascii, MeshCore::MeshIO::ASTL);
+
+    // Assert
+    EXPECT_TRUE(ok1);
+    EXPECT_TRUE(ok2);
+    EXPECT_GT(kernel1.CountFacets(), 0);
+    EXPECT_EQ(kernel1.CountFacets(), kernel2.CountFacets());
+    EXPECT_EQ(kernel1.CountPoints(), kernel2.CountPoints());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include <Base/Matrix.h>
+#include <Base/Stream.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshOutputTest: public ::testing::Test
+{
+protected:
+    // The loops of MeshOutput::SaveBinarySTL() and SaveBinaryPLY() before they were parallelized
+    static std::string saveSTLSerial(const MeshCore::MeshKernel& kernel, const Base::Matrix4D& mat)
+    {
+        std::ostringstream str;
+        str.write(std::string(80, ' ').c_str(), 80);
+        uint32_t count = static_cast<uint32_t>(kernel.CountFacets());
+        str.write((const char*)&count, sizeof(count));
+
+        MeshCore::MeshFacetIterator it(kernel);
+        it.Transform(mat);
+        uint16_t attribute = 0;
+        for (it.Init(); it.More(); it.Next()) {
+            Base::Vector3f normal = it->GetNormal();
+            str.write((const char*)&normal, 3 * sizeof(float));
+            for (const auto& pnt : it->_aclPoints) {
+                str.write((const char*)&pnt, 3 * sizeof(float));
+            }
+            str.write((const char*)&attribute, sizeof(attribute));
+        }
+        return str.str();
+    }
+
+    static std::string savePLYSerial(const MeshCore::MeshKernel& kernel, const Base::Matrix4D& mat)
+    {
+        std::ostringstream str;
+        Base::OutputStream os(str);
+        os.setByteOrder(Base::Stream::LittleEndian);
+        for (const auto& pnt : kernel.GetPoints()) {
+            Base::Vector3f pt = mat * pnt;
+            os << pt.x << pt.y << pt.z;
+        }
+        unsigned char n = 3;
+        for (const auto& facet : kernel.GetFacets()) {
+            os << n;
+            os << (int)facet._aulPoints[0] << (int)facet._aulPoints[1] << (int)facet._aulPoints[2];
+        }
+        return str.str();
+    }
+
+    static void
+    expectFloatsNear(const std::string& data1, const std::string& data2, std::size_t pos)
+    {
+        float value1 {}, value2 {};
+        std::memcpy(&value1, &data1[pos], sizeof(float));
+        std::memcpy(&value2, &data2[pos], sizeof(float));
+        EXPECT_NEAR(value1, value2, 1e-6F);
+    }
+};
+
+TEST_F(MeshOutputTest, binarySTLLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(300);
+    Base::Matrix4D mat = MeshTestHelpers::createMatrix();
+    MeshCore::MeshOutput output(kernel);
+    output.Transform(mat);
+    std::ostringstream str;
+
+    // Act
+    bool ok = output.SaveBinarySTL(str);
+    std::string data = str.str();
+    std::string serial = saveSTLSerial(kernel, mat);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    ASSERT_EQ(data.size(), serial.size());
+    EXPECT_EQ(data.compare(80, 4, serial, 80, 4), 0);
+    for (std::size_t i = 84; i < data.size(); i += 50) {
+        // normals may differ in the last bit if the compiler contracts the serial operations
+        for (std::size_t j = 0; j < 3; j++) {
+            expectFloatsNear(data, serial, i + j * sizeof(float));
+        }
+        EXPECT_EQ(data.compare(i + 12, 38, serial, i + 12, 38), 0);
+    }
+}
+
+TEST_F(MeshOutputTest, binaryPLYLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(300);
+    Base::Matrix4D mat = MeshTestHelpers::createMatrix();
+    MeshCore::MeshOutput output(kernel);
+    output.Transform(mat);
+    std::ostringstream str;
+
+    // Act
+    bool ok = output.SaveBinaryPLY(str);
+    std::string data = str.str();
+    std::string serial = savePLYSerial(kernel, mat);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    std::size_t header = data.find("end_header\n");
+    ASSERT_NE(header, std::string::npos);
+    EXPECT_EQ(data.substr(header + 11), serial);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
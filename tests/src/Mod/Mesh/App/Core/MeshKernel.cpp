@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshKernelTest: public ::testing::Test
+{
+protected:
+    // The loops of MeshKernel::Transform() and CalcVertexNormals() before they were parallelized
+    static void transformSerial(MeshCore::MeshPointArray& points,
+                                const Base::Matrix4D& mat,
+                                Base::BoundBox3f& box)
+    {
+        box.SetVoid();
+        for (auto& point : points) {
+            point *= mat;
+            box.Add(point);
+        }
+    }
+
+    static std::vector<Base::Vector3f> normalsSerial(const MeshCore::MeshKernel& kernel)
+    {
+        std::vector<Base::Vector3f> normals(kernel.CountPoints());
+        const MeshCore::MeshPointArray& points = kernel.GetPoints();
+        for (const auto& facet : kernel.GetFacets()) {
+            MeshCore::PointIndex p1 = facet._aulPoints[0];
+            MeshCore::PointIndex p2 = facet._aulPoints[1];
+            MeshCore::PointIndex p3 = facet._aulPoints[2];
+            Base::Vector3f norm = (points[p2] - points[p1]) % (points[p3] - points[p1]);
+            normals[p1] += norm;
+            normals[p2] += norm;
+            normals[p3] += norm;
+        }
+        return normals;
+    }
+};
+
+TEST_F(MeshKernelTest, transformEmpty)
+{
+    MeshCore::MeshKernel kernel;
+
+    kernel.Transform(MeshTestHelpers::createMatrix());
+
+    EXPECT_FALSE(kernel.GetBoundBox().IsValid());
+}
+
+TEST_F(MeshKernelTest, transformLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(500);
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    Base::Matrix4D mat = MeshTestHelpers::createMatrix();
+    Base::BoundBox3f box;
+
+    // Act
+    kernel.Transform(mat);
+    transformSerial(points, mat, box);
+
+    // Assert
+    ASSERT_EQ(kernel.CountPoints(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_NEAR(Base::Distance(kernel.GetPoint(i), points[i]), 0.0F, 1e-5F);
+    }
+    const Base::BoundBox3f& result = kernel.GetBoundBox();
+    EXPECT_NEAR(result.MinX, box.MinX, 1e-5F);
+    EXPECT_NEAR(result.MinY, box.MinY, 1e-5F);
+    EXPECT_NEAR(result.MinZ, box.MinZ, 1e-5F);
+    EXPECT_NEAR(result.MaxX, box.MaxX, 1e-5F);
+    EXPECT_NEAR(result.MaxY, box.MaxY, 1e-5F);
+    EXPECT_NEAR(result.MaxZ, box.MaxZ, 1e-5F);
+}
+
+TEST_F(MeshKernelTest, recalcBoundBox)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(500);
+    Base::BoundBox3f box;
+    for (const auto& point : kernel.GetPoints()) {
+        box.Add(point);
+    }
+
+    // Act
+    kernel.RecalcBoundBox();
+
+    // Assert
+    const Base::BoundBox3f& result = kernel.GetBoundBox();
+    EXPECT_FLOAT_EQ(result.MinX, box.MinX);
+    EXPECT_FLOAT_EQ(result.MinY, box.MinY);
+    EXPECT_FLOAT_EQ(result.MinZ, box.MinZ);
+    EXPECT_FLOAT_EQ(result.MaxX, box.MaxX);
+    EXPECT_FLOAT_EQ(result.MaxY, box.MaxY);
+    EXPECT_FLOAT_EQ(result.MaxZ, box.MaxZ);
+}
+
+TEST_F(MeshKernelTest, vertexNormalsLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(500);
+
+    // Act
+    std::vector<Base::Vector3f> normals = kernel.CalcVertexNormals();
+    std::vector<Base::Vector3f> serial = normalsSerial(kernel);
+
+    // Assert
+    ASSERT_EQ(normals.size(), serial.size());
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        EXPECT_EQ(normals[i], serial[i]);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef MESH_TEST_HELPERS_H
+#define MESH_TEST_HELPERS_H
+
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <cmath>
+
+namespace MeshTestHelpers
+{
+
+/**
+ * Creates a grid of size x size points with a spacing of 0.1 and the height
+ * amplitude * sin(x) * cos(y). If \a noise is set a small deterministic pattern of
+ * up to four times \a noise is added to the height.
+ */
+inline MeshCore::MeshKernel createGrid(unsigned long size,
+                                       float amplitude = 1.0F,
+                                       float noise = 0.0F)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    points.reserve(size * size);
+    for (unsigned long i = 0; i < size; i++) {
+        for (unsigned long j = 0; j < size; j++) {
+            float x = static_cast<float>(i) * 0.1F;
+            float y = static_cast<float>(j) * 0.1F;
+            float z = amplitude * std::sin(x) * std::cos(y);
+            if (noise != 0.0F) {
+                z += static_cast<float>((i * 7 + j * 13) % 5) * noise;
+            }
+            points.push_back(MeshCore::MeshPoint(x, y, z));
+        }
+    }
+    for (unsigned long i = 0; i + 1 < size; i++) {
+        for (unsigned long j = 0; j + 1 < size; j++) {
+            MeshCore::PointIndex p = i * size + j;
+            facets.push_back(MeshCore::MeshFacet(p, p + size, p + 1));
+            facets.push_back(MeshCore::MeshFacet(p + 1, p + size, p + size + 1));
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    return kernel;
+}
+
+/**
+ * Creates a transformation with rotation, non-uniform scaling and translation.
+ */
+inline Base::Matrix4D createMatrix()
+{
+    Base::Matrix4D mat;
+    mat.rotX(0.3);
+    mat.rotZ(1.2);
+    mat.scale(2.0, 0.5, 1.5);
+    mat.move(Base::Vector3d(10.0, -3.0, 7.5));
+    return mat;
+}
+
+}  // namespace MeshTestHelpers
+
+#endif  // MESH_TEST_HELPERS_H
@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        MeshCore::MeshDefinitions::SetThreadCount(0);
+    }
+
+    // One step of the umbrella operator with the set based adjacency. Unless jacobi is set
+    // the points are moved in place.
+    static void umbrellaSerial(MeshCore::MeshKernel& kernel,
+                               const MeshCore::MeshRefPointToPoints& vv_it,
+                               const MeshCore::MeshRefPointToFacets& vf_it,
+                               double stepsize,
+                               bool jacobi)
+    {
+        MeshCore::MeshPointArray copy;
+        if (jacobi) {
+            copy = kernel.GetPoints();
+        }
+        const MeshCore::MeshPointArray& points = jacobi ? copy : kernel.GetPoints();
+        for (MeshCore::PointIndex pos = 0; pos < points.size(); pos++) {
+            const std::set<MeshCore::PointIndex>& cv = vv_it[pos];
+            if (cv.size() < 3 || cv.size() != vf_it[pos].size()) {
+                continue;
+            }
+
+            double w = 1.0 / double(cv.size());
+            double delx = 0.0, dely = 0.0, delz = 0.0;
+            for (MeshCore::PointIndex it : cv) {
+                delx += w * static_cast<double>(points[it].x - points[pos].x);
+                dely += w * static_cast<double>(points[it].y - points[pos].y);
+                delz += w * static_cast<double>(points[it].z - points[pos].z);
+            }
+
+            auto x = static_cast<float>(static_cast<double>(points[pos].x) + stepsize * delx);
+            auto y = static_cast<float>(static_cast<double>(points[pos].y) + stepsize * dely);
+            auto z = static_cast<float>(static_cast<double>(points[pos].z) + stepsize * delz);
+            kernel.SetPoint(pos, x, y, z);
+        }
+    }
+
+    template<class Smoothing>
+    static MeshCore::MeshPointArray smooth(const MeshCore::MeshKernel& mesh,
+                                           int threads,
+                                           unsigned int iterations)
+    {
+        MeshCore::MeshDefinitions::SetThreadCount(threads);
+        MeshCore::MeshKernel kernel = mesh;
+        Smoothing smoothing(kernel);
+        smoothing.SetJacobi(true);
+        smoothing.Smooth(iterations);
+        return kernel.GetPoints();
+    }
+
+    static void expectEqual(const MeshCore::MeshPointArray& points1,
+                            const MeshCore::MeshPointArray& points2)
+    {
+        ASSERT_EQ(points1.size(), points2.size());
+        for (std::size_t i = 0; i < points1.size(); i++) {
+            EXPECT_EQ(points1[i], points2[i]);
+        }
+    }
+};
+
+TEST_F(SmoothingTest, laplaceLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(200, 1.0F, 0.01F);
+    MeshCore::MeshKernel serial = kernel;
+    MeshCore::MeshRefPointToPoints vv_it(serial);
+    MeshCore::MeshRefPointToFacets vf_it(serial);
+    MeshCore::LaplaceSmoothing smoothing(kernel);
+
+    // Act
+    smoothing.Smooth(3);
+    for (int i = 0; i < 3; i++) {
+        umbrellaSerial(serial, vv_it, vf_it, smoothing.GetLambda(), false);
+    }
+
+    // Assert
+    expectEqual(kernel.GetPoints(), serial.GetPoints());
+}
+
+TEST_F(SmoothingTest, laplaceJacobiLikeSerialLoop)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(200, 1.0F, 0.01F);
+    MeshCore::MeshKernel serial = kernel;
+    MeshCore::MeshRefPointToPoints vv_it(serial);
+    MeshCore::MeshRefPointToFacets vf_it(serial);
+    MeshCore::LaplaceSmoothing smoothing(kernel);
+    smoothing.SetJacobi(true);
+
+    // Act
+    smoothing.Smooth(3);
+    for (int i = 0; i < 3; i++) {
+        umbrellaSerial(serial, vv_it, vf_it, smoothing.GetLambda(), true);
+    }
+
+    // Assert
+    expectEqual(kernel.GetPoints(), serial.GetPoints());
+}
+
+TEST_F(SmoothingTest, smoothPointsKeepsOthers)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(50, 1.0F, 0.01F);
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    std::vector<MeshCore::PointIndex> indices = {60, 61, 62, 1001, 1002};
+    MeshCore::TaubinSmoothing smoothing(kernel);
+
+    // Act
+    smoothing.SmoothPoints(4, indices);
+
+    // Assert
+    for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+        bool moved = std::find(indices.begin(), indices.end(), i) != indices.end();
+        EXPECT_EQ(kernel.GetPoint(i) != points[i], moved);
+    }
+}
+
+TEST_F(SmoothingTest, smoothDuplicatedPoints)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel1 = MeshTestHelpers::createGrid(50, 1.0F, 0.01F);
+    MeshCore::MeshKernel kernel2 = kernel1;
+    std::vector<MeshCore::PointIndex> indices = {60, 61, 62, 1001, 1002};
+    std::vector<MeshCore::PointIndex> duplicated = {1002, 60, 61, 60, 62, 1001, 1002};
+    MeshCore::LaplaceSmoothing smoothing1(kernel1);
+    MeshCore::LaplaceSmoothing smoothing2(kernel2);
+    smoothing1.SetJacobi(true);
+    smoothing2.SetJacobi(true);
+
+    // Act
+    smoothing1.SmoothPoints(4, indices);
+    smoothing2.SmoothPoints(4, duplicated);
+
+    // Assert
+    expectEqual(kernel1.GetPoints(), kernel2.GetPoints());
+}
+
+TEST_F(SmoothingTest, independentOfThreadCount)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel = MeshTestHelpers::createGrid(200, 1.0F, 0.01F);
+
+    // Act & Assert
+    expectEqual(smooth<MeshCore::LaplaceSmoothing>(kernel, 1, 5),
+                smooth<MeshCore::LaplaceSmoothing>(kernel, 4, 5));
+    expectEqual(smooth<MeshCore::TaubinSmoothing>(kernel, 1, 5),
+                smooth<MeshCore::TaubinSmoothing>(kernel, 4, 5));
+    expectEqual(smooth<MeshCore::MedianFilterSmoothing>(kernel, 1, 2),
+                smooth<MeshCore::MedianFilterSmoothing>(kernel, 4, 2));
+    expectEqual(smooth<MeshCore::PlaneFitSmoothing>(kernel, 1, 2),
+                smooth<MeshCore::PlaneFitSmoothing>(kernel, 4, 2));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -128,6 +128,34 @@ protected:
         domains.push_back(domain2);
         return domains;
     }
+
+    // A grid of size x size quads where each quad is a domain of two triangles
+    std::vector<Part::BRepMesh::Domain> getGridDomains(int size) const
+    {
+        std::vector<Part::BRepMesh::Domain> domains;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                Part::BRepMesh::Domain domain;
+                domain.points.emplace_back(i, j, 0);
+                domain.points.emplace_back(i + 1, j, 0);
+                domain.points.emplace_back(i + 1, j + 1, 0);
+                domain.points.emplace_back(i, j + 1, -0.0);
+
+                Part::BRepMesh::Facet f1;
+                f1.I1 = 0;
+                f1.I2 = 1;
+                f1.I3 = 2;
+                domain.facets.emplace_back(f1);
+                Part::BRepMesh::Facet f2;
+                f2.I1 = 0;
+                f2.I2 = 2;
+                f2.I3 = 3;
+                domain.facets.emplace_back(f2);
+                domains.push_back(domain);
+            }
+        }
+        return domains;
+    }
 };
 
 TEST_F(BRepMeshTest, testNoDomains)
@@ -173,4 +201,49 @@ TEST_F(BRepMeshTest, testUnconnectedDomains)
     EXPECT_EQ(points.size(), 6);
     EXPECT_EQ(faces.size(), 4);
 }
+
+TEST_F(BRepMeshTest, testGridDomains)
+{
+    std::vector<Base::Vector3d> points;
+    std::vector<Part::BRepMesh::Facet> faces;
+    Part::BRepMesh brepMesh;
+    brepMesh.getFacesFromDomains(getGridDomains(120), points, faces);
+
+    EXPECT_EQ(points.size(), 121 * 121);
+    EXPECT_EQ(faces.size(), 2 * 120 * 120);
+
+    // the points are numbered in the order they are used by the facets
+    EXPECT_EQ(points[0], Base::Vector3d(0, 0, 0));
+    EXPECT_EQ(points[1], Base::Vector3d(1, 0, 0));
+    EXPECT_EQ(points[2], Base::Vector3d(1, 1, 0));
+    EXPECT_EQ(points[3], Base::Vector3d(0, 1, 0));
+    EXPECT_EQ(faces[2].I1, 3);
+    EXPECT_EQ(faces[2].I2, 2);
+    EXPECT_EQ(faces[2].I3, 4);
+
+    auto segments = brepMesh.createSegments();
+    EXPECT_EQ(segments.size(), 120 * 120);
+    EXPECT_EQ(segments.back().back(), faces.size() - 1);
+}
+
+TEST_F(BRepMeshTest, testDegeneratedFacets)
+{
+    auto domains = getConnectedDomains();
+    Part::BRepMesh::Facet face;
+    face.I1 = 0;
+    face.I2 = 1;
+    face.I3 = 0;
+    domains[0].facets.push_back(face);
+
+    std::vector<Base::Vector3d> points;
+    std::vector<Part::BRepMesh::Facet> faces;
+    Part::BRepMesh brepMesh;
+    brepMesh.getFacesFromDomains(domains, points, faces);
+
+    EXPECT_EQ(points.size(), 6);
+    EXPECT_EQ(faces.size(), 4);
+    auto segments = brepMesh.createSegments();
+    EXPECT_EQ(segments.size(), 2);
+    EXPECT_EQ(segments[0].size(), 2);
+}
 // NOLINTEND
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include <App/Expression.h>
+#include <App/ObjectIdentifier.h>
+#include "Mod/Part/App/FeatureCompound.h"
+#include "Mod/Part/App/FeaturePartBox.h"
+#include <src/App/InitApplication.h>
+
+#include "PartTestHelpers.h"
+
+class FeaturePartBoxTest: public ::testing::Test, public PartTestHelpers::PartTestHelperClass
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        createTestDoc();
+        _hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+        _parallel = _hGrp->GetBool("ParallelRecompute", false);
+        _hGrp->SetBool("ParallelRecompute", true);
+    }
+
+    void TearDown() override
+    {
+        _hGrp->SetBool("ParallelRecompute", _parallel);
+    }
+
+    std::vector<App::DocumentObject*> recompute()
+    {
+        std::vector<App::DocumentObject*> recomputed;
+        auto conn = _doc->signalRecomputedObject.connect(
+            [&recomputed](const App::DocumentObject& obj) {
+                recomputed.push_back(const_cast<App::DocumentObject*>(&obj));  // NOLINT
+            });
+        _doc->recompute();
+        conn.disconnect();
+        return recomputed;
+    }
+
+    ParameterGrp::handle _hGrp;  // NOLINT Can't be private in a test framework
+    bool _parallel = false;      // NOLINT Can't be private in a test framework
+};
+
+TEST_F(FeaturePartBoxTest, testParallelRecompute)
+{
+    // Arrange
+    auto compound = dynamic_cast<Part::Compound*>(_doc->addObject("Part::Compound"));
+    compound->Links.setValues({_boxes[0], _boxes[2]});
+    // The fourth box depends on the first one through an expression
+    auto path = App::ObjectIdentifier::parse(_boxes[3], "Length");
+    std::shared_ptr<App::Expression> expr(
+        App::Expression::parse(_boxes[3], std::string(_boxes[0]->getNameInDocument()) + ".Length * 2"));
+    _boxes[3]->setExpression(path, expr);
+    _boxes[0]->Length.setValue(4);
+
+    // Act
+    auto recomputed = recompute();
+
+    // Assert
+    for (unsigned i = 0; i < _boxes.size(); i++) {
+        double length = i == 0 ? 4.0 : (i == 3 ? 8.0 : 1.0);
+        EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_boxes[i]->Shape.getValue()), length * 6.0);
+        EXPECT_FALSE(_boxes[i]->isError());
+    }
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(compound->Shape.getValue()), 30.0);
+    // the objects are still signaled in topological order
+    auto sorted = App::Document::getDependencyList(_doc->getObjects(), App::Document::DepSort);
+    EXPECT_EQ(recomputed, sorted);
+}
+
+TEST_F(FeaturePartBoxTest, testParallelRecomputeAfterChange)
+{
+    // Arrange
+    recompute();
+    _boxes[1]->Height.setValue(5);
+    _boxes[4]->Width.setValue(7);
+
+    // Act
+    auto recomputed = recompute();
+
+    // Assert
+    std::vector<App::DocumentObject*> sorted;
+    for (auto obj : App::Document::getDependencyList(_doc->getObjects(), App::Document::DepSort)) {
+        if (obj == _boxes[1] || obj == _boxes[4]) {
+            sorted.push_back(obj);
+        }
+    }
+    EXPECT_EQ(recomputed, sorted);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_boxes[1]->Shape.getValue()), 10.0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_boxes[4]->Shape.getValue()), 21.0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_boxes[0]->Shape.getValue()), 6.0);
+}
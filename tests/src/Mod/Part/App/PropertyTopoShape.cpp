@@ -3,6 +3,8 @@
 #include "gtest/gtest.h"
 
 #include <BRepFilletAPI_MakeFillet.hxx>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
 #include "Mod/Part/App/FeaturePartCommon.h"
 #include "Mod/Part/App/PropertyTopoShape.h"
 #include <src/App/InitApplication.h>
@@ -76,6 +78,28 @@ TEST_F(PropertyTopoShapeTest, testPropertyPartShapeTopoDSShape)
     EXPECT_EQ(topoShapeOut.getElementMapSize(), 0);  // We passed in a TopoDS_Shape so lost the map
 }
 
+TEST_F(PropertyTopoShapeTest, testPropertyPartShapeCompressUndo)
+{
+    // Arrange
+    auto partShape = PropertyPartShape();
+    partShape.setValue(_common->Shape.getValue());
+    std::unique_ptr<App::Property> copy(partShape.Copy());
+    Base::StringWriter writer;
+    auto restored = PropertyPartShape();
+    // Act
+    copy->SaveDocFile(writer);
+    restored.deferRestoreDocFile(
+        Base::DeferredFile::deflate(copy->getTypeId().getName(), writer.getString()));
+    // Assert
+    EXPECT_TRUE(copy->canCompressUndo());
+    EXPECT_NEAR(getVolume(restored.getValue()), 3, 1e-9);  // NOLINT magic number
+#ifdef FC_USE_TNP_FIX
+    // The element map is not part of the file, so keep such a shape uncompressed
+    partShape.setValue(_common->Shape.getShape());
+    EXPECT_FALSE(partShape.canCompressUndo());
+#endif
+}
+
 TEST_F(PropertyTopoShapeTest, testPropertyPartShapeGetPyObject)
 {
     // Arrange
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+#include <Mod/Part/App/TessellationCache.h>
+
+#include <sstream>
+#include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <Base/Parameter.h>
+#include <BRep_Tool.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <gp_Trsf.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class TessellationCacheTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        // the cache is disabled by default and the test shapes have few faces
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General");
+        hGrp->SetBool("TessellationCache", true);
+        hGrp->SetInt("TessellationCacheMinFaces", 0);
+    }
+
+    static int countTriangles(const TopoDS_Shape& shape)
+    {
+        int count = 0;
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+            TopLoc_Location loc;
+            Handle(Poly_Triangulation) tria =
+                BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc);
+            if (tria.IsNull()) {
+                return -1;
+            }
+            count += tria->NbTriangles();
+        }
+        return count;
+    }
+};
+
+TEST_F(TessellationCacheTest, writeReadBox)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.01, Standard_False, 0.1, Standard_True);
+    std::stringstream str;
+    Part::TessellationCache::write(box, str);
+    TopoDS_Shape copy = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+
+    // Act
+    bool ok = Part::TessellationCache::read(copy, str);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(countTriangles(copy), countTriangles(box));
+}
+
+TEST_F(TessellationCacheTest, writeReadCylinderWithSeam)
+{
+    // Arrange
+    TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(2.0, 5.0).Shape();
+    BRepMesh_IncrementalMesh(cylinder, 0.01, Standard_False, 0.1, Standard_True);
+    std::stringstream str;
+    Part::TessellationCache::write(cylinder, str);
+    TopoDS_Shape copy = BRepPrimAPI_MakeCylinder(2.0, 5.0).Shape();
+
+    // Act
+    bool ok = Part::TessellationCache::read(copy, str);
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(countTriangles(copy), countTriangles(cylinder));
+    // The attached triangulation must be sufficient so that meshing again does nothing
+    BRepMesh_IncrementalMesh mesh(copy, 0.01, Standard_False, 0.1, Standard_True);
+    EXPECT_FALSE(mesh.IsModified());
+}
+
+TEST_F(TessellationCacheTest, readDifferentShape)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.01, Standard_False, 0.1, Standard_True);
+    std::stringstream str;
+    Part::TessellationCache::write(box, str);
+    TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(2.0, 5.0).Shape();
+
+    // Act
+    bool ok = Part::TessellationCache::read(cylinder, str);
+
+    // Assert
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(countTriangles(cylinder), -1);
+}
+
+TEST_F(TessellationCacheTest, readInvalidData)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    std::stringstream str("not a tessellation");
+
+    // Act
+    bool ok = Part::TessellationCache::read(box, str);
+
+    // Assert
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(countTriangles(box), -1);
+}
+
+TEST_F(TessellationCacheTest, keyOfMeshedShapeIsEmpty)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto& cache = Part::TessellationCache::instance();
+
+    // Act
+    std::string key1 = cache.getKey(box, 0.01, 0.1);
+    BRepMesh_IncrementalMesh(box, 0.01, Standard_False, 0.1, Standard_True);
+    std::string key2 = cache.getKey(box, 0.01, 0.1);
+
+    // Assert
+    EXPECT_FALSE(key1.empty());
+    EXPECT_TRUE(key2.empty());
+}
+
+TEST_F(TessellationCacheTest, keyOfShapeWithFewFacesIsEmpty)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto& cache = Part::TessellationCache::instance();
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+
+    // Act
+    hGrp->SetInt("TessellationCacheMinFaces", 7);
+    std::string key1 = cache.getKey(box, 0.01, 0.1);
+    hGrp->SetInt("TessellationCacheMinFaces", 6);
+    std::string key2 = cache.getKey(box, 0.01, 0.1);
+    hGrp->SetInt("TessellationCacheMinFaces", 0);
+
+    // Assert
+    EXPECT_TRUE(key1.empty());
+    EXPECT_FALSE(key2.empty());
+}
+
+TEST_F(TessellationCacheTest, keyDependsOnDeflection)
+{
+    // Arrange
+    TopoDS_Shape box1 = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    TopoDS_Shape box2 = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto& cache = Part::TessellationCache::instance();
+
+    // Act
+    std::string key1 = cache.getKey(box1, 0.01, 0.1);
+    std::string key2 = cache.getKey(box2, 0.01, 0.1);
+    std::string key3 = cache.getKey(box2, 0.02, 0.1);
+
+    // Assert
+    EXPECT_EQ(key1, key2);
+    EXPECT_NE(key1, key3);
+}
+
+TEST_F(TessellationCacheTest, keyIgnoresPlacement)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(5.0, 0.0, 0.0));
+    TopoDS_Shape moved = box.Moved(TopLoc_Location(trsf));
+    auto& cache = Part::TessellationCache::instance();
+
+    // Act
+    std::string key1 = cache.getKey(box, 0.01, 0.1);
+    std::string key2 = cache.getKey(moved, 0.01, 0.1);
+    std::string key3 = cache.getKey(box, 0.01, 0.1);
+
+    // Assert
+    EXPECT_FALSE(key1.empty());
+    EXPECT_EQ(key1, key2);
+    EXPECT_EQ(key1, key3);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <fstream>
+#include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
@@ -138,6 +140,39 @@ TEST_F(PointsTest, TestASCII)
     EXPECT_EQ(reader.getHeight(), 1);
 }
 
+TEST_F(PointsTest, TestLargeASCII)
+{
+    // enough lines for the text to be parsed in several chunks, lines which are no points must
+    // be skipped
+    const int numPoints = 150000;
+    std::string name = getFileName() + ".asc";
+    {
+        std::ofstream out(name);
+        out << "# ASCII\n";
+        for (int i = 0; i < numPoints; i++) {
+            out << i << " -" << i << ".5 " << (i % 11) << "e1\n";
+            if (i % 1000 == 0) {
+                out << "# comment\n"
+                    << "1 2\n"
+                    << "1. 2 3\n";
+            }
+        }
+    }
+
+    Points::AscReader reader;
+    reader.read(name);
+    Base::FileInfo(name).deleteFile();
+
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), numPoints);
+    EXPECT_EQ(reader.getWidth(), numPoints);
+    for (int i = 0; i < numPoints; i += 1009) {
+        EXPECT_EQ(points.getPoint(i), Base::Vector3d(i, -i - 0.5, (i % 11) * 10));
+    }
+    EXPECT_EQ(points.getPoint(numPoints - 1),
+              Base::Vector3d(numPoints - 1, 0.5 - numPoints, ((numPoints - 1) % 11) * 10));
+}
+
 TEST_F(PointsTest, TestPlainPLY)
 {
     std::string name = getFileName();
@@ -238,4 +273,139 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestLargePLY)
+{
+    // enough points for the text to be parsed in several chunks
+    const int numPoints = 100000;
+    std::vector<Base::Vector3f> pts;
+    for (int i = 0; i < numPoints; i++) {
+        pts.emplace_back(float(i), float(i % 7), -float(i % 13));
+    }
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(pts);
+
+    std::string name = getFileName();
+    Points::PlyWriter writer(kernel);
+    writer.setIntensities(std::vector<float>(numPoints, 0.5F));
+    writer.write(name);
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), numPoints);
+    ASSERT_EQ(reader.getIntensities().size(), numPoints);
+    for (int i = 0; i < numPoints; i += 997) {
+        EXPECT_EQ(points.getPoint(i), Base::Vector3d(pts[i].x, pts[i].y, pts[i].z));
+    }
+    EXPECT_EQ(points.getPoint(numPoints - 1), Base::Vector3d(numPoints - 1, 4, -3));
+    EXPECT_FLOAT_EQ(reader.getIntensities().back(), 0.5F);
+}
+
+TEST_F(PointsTest, TestBinaryPLY)
+{
+    const int numPoints = 5000;
+    std::string name = getFileName();
+    {
+        std::ofstream out(name, std::ios::out | std::ios::binary);
+        // the element before the vertices must be skipped
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element camera 1\n"
+            << "property float view\n"
+            << "element vertex " << numPoints << "\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property double z\n"
+            << "property uchar red\n"
+            << "property uchar green\n"
+            << "property uchar blue\n"
+            << "property uchar alpha\n"
+            << "end_header\n";
+        float view = 1.0F;
+        out.write(reinterpret_cast<const char*>(&view), sizeof(view));
+        for (int i = 0; i < numPoints; i++) {
+            float x = float(i);
+            float y = 2.0F * float(i);
+            double z = -0.5 * i;
+            unsigned char rgba[4] = {255, 0, 51, 255};
+            out.write(reinterpret_cast<const char*>(&x), sizeof(x));
+            out.write(reinterpret_cast<const char*>(&y), sizeof(y));
+            out.write(reinterpret_cast<const char*>(&z), sizeof(z));
+            out.write(reinterpret_cast<const char*>(rgba), sizeof(rgba));
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), numPoints);
+    ASSERT_EQ(reader.getColors().size(), numPoints);
+    EXPECT_FALSE(reader.hasNormals());
+    EXPECT_FALSE(reader.hasIntensities());
+    EXPECT_EQ(points.getPoint(0), Base::Vector3d(0, 0, 0));
+    EXPECT_EQ(points.getPoint(numPoints - 1),
+              Base::Vector3d(numPoints - 1, 2 * (numPoints - 1), -0.5 * (numPoints - 1)));
+    EXPECT_FLOAT_EQ(reader.getColors().back().r, 1.0F);
+    EXPECT_FLOAT_EQ(reader.getColors().back().g, 0.0F);
+    EXPECT_FLOAT_EQ(reader.getColors().back().b, 0.2F);
+}
+
+TEST_F(PointsTest, TestBinaryPCD)
+{
+    const int numPoints = 5000;
+    std::string name = getFileName();
+    {
+        std::ofstream out(name, std::ios::out | std::ios::binary);
+        out << "VERSION 0.7\n"
+            << "FIELDS x y z intensity rgb\n"
+            << "SIZE 4 4 4 4 4\n"
+            << "TYPE F F F F U\n"
+            << "COUNT 1 1 1 1 1\n"
+            << "WIDTH " << numPoints << "\n"
+            << "HEIGHT 1\n"
+            << "POINTS " << numPoints << "\n"
+            << "DATA binary\n";
+        for (int i = 0; i < numPoints; i++) {
+            float xyzi[4] = {float(i), 1.0F, float(-i), 0.25F};
+            uint32_t rgb = 0xff00ff00;
+            out.write(reinterpret_cast<const char*>(xyzi), sizeof(xyzi));
+            out.write(reinterpret_cast<const char*>(&rgb), sizeof(rgb));
+        }
+    }
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), numPoints);
+    ASSERT_EQ(reader.getIntensities().size(), numPoints);
+    ASSERT_EQ(reader.getColors().size(), numPoints);
+    EXPECT_EQ(points.getPoint(numPoints - 1), Base::Vector3d(numPoints - 1, 1, 1 - numPoints));
+    EXPECT_FLOAT_EQ(reader.getIntensities().back(), 0.25F);
+    EXPECT_FLOAT_EQ(reader.getColors().back().g, 1.0F);
+    EXPECT_FLOAT_EQ(reader.getColors().back().r, 0.0F);
+}
+
+TEST_F(PointsTest, TestTruncatedBinaryPLY)
+{
+    std::string name = getFileName();
+    {
+        std::ofstream out(name, std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex 10\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "end_header\n";
+        float xyz[3] = {1.0F, 2.0F, 3.0F};
+        out.write(reinterpret_cast<const char*>(xyz), sizeof(xyz));
+    }
+
+    Points::PlyReader reader;
+    EXPECT_THROW(reader.read(name), Base::BadFormatError);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -50,3 +50,129 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, diagnoseDecoupledComponents)  // NOLINT
+{
+    // Arrange
+    // many decoupled pairs of equal parameters, one pair with a redundant constraint and one
+    // pair with conflicting constraints
+    const int numPairs {100};
+    std::vector<double> values(2 * numPairs + 4, 0.0);
+    GCS::VEC_pD params;
+    for (auto& value : values) {
+        params.push_back(&value);
+    }
+    for (int i = 0; i < numPairs; ++i) {
+        System()->addConstraintEqual(params[2 * i], params[2 * i + 1], i + 1);
+    }
+    double* redundant1 = params[2 * numPairs];
+    double* redundant2 = params[2 * numPairs + 1];
+    System()->addConstraintEqual(redundant1, redundant2, numPairs + 1);
+    System()->addConstraintEqual(redundant1, redundant2, numPairs + 2);
+    double* conflicting1 = params[2 * numPairs + 2];
+    double* conflicting2 = params[2 * numPairs + 3];
+    double difference1 {1.0};
+    double difference2 {2.0};
+    System()->addConstraintDifference(conflicting1, conflicting2, &difference1, numPairs + 3);
+    System()->addConstraintDifference(conflicting1, conflicting2, &difference2, numPairs + 4);
+    System()->declareUnknowns(params);
+
+    // Act
+    System()->initSolution();
+
+    // Assert
+    GCS::VEC_I conflicting;
+    GCS::VEC_I redundant;
+    System()->getConflicting(conflicting);
+    System()->getRedundant(redundant);
+    EXPECT_EQ(System()->dofsNumber(), numPairs + 2);
+    EXPECT_EQ(conflicting, GCS::VEC_I({numPairs + 3, numPairs + 4}));
+    EXPECT_EQ(redundant, GCS::VEC_I({numPairs + 2}));
+}
+
+TEST_F(GCSTest, solveLargeConnectedSystem)  // NOLINT
+{
+    // Arrange
+    // a single chain of parameters, large enough to be solved with sparse jacobians
+    const int numParams {300};
+    std::vector<double> values(numParams, 0.5);
+    GCS::VEC_pD params;
+    for (auto& value : values) {
+        params.push_back(&value);
+    }
+    double origin {0.0};
+    double difference {1.0};
+    System()->addConstraintEqual(params[0], &origin, 1);
+    for (int i = 1; i < numParams; ++i) {
+        System()->addConstraintDifference(params[i - 1], params[i], &difference, i + 1);
+    }
+    System()->declareUnknowns(params);
+
+    for (auto alg : {GCS::DogLeg, GCS::LevenbergMarquardt}) {
+        // Act
+        std::fill(values.begin(), values.end(), 0.5);
+        System()->initSolution(alg);
+        int result = System()->solve(true, alg);
+        System()->applySolution();
+
+        // Assert
+        EXPECT_EQ(result, GCS::Success);
+        EXPECT_EQ(System()->dofsNumber(), 0);
+        for (int i = 0; i < numParams; ++i) {
+            EXPECT_NEAR(values[i], i, 1e-8);
+        }
+    }
+}
+
+TEST_F(GCSTest, solveWithTemporaryConstraints)  // NOLINT
+{
+    // Arrange
+    // two decoupled components, the first one fully constrained and the second one with a degree
+    // of freedom, which temporary constraints join and move like a drag
+    std::vector<double> values {0.5, 0.5, 0.5, 0.5};
+    GCS::VEC_pD params;
+    for (auto& value : values) {
+        params.push_back(&value);
+    }
+    double origin {0.0};
+    double difference {1.0};
+    System()->addConstraintEqual(params[0], &origin, 1);
+    System()->addConstraintDifference(params[0], params[1], &difference, 2);
+    System()->addConstraintDifference(params[2], params[3], &difference, 3);
+    System()->declareUnknowns(params);
+    System()->initSolution();
+    ASSERT_EQ(System()->solve(), GCS::Success);
+    System()->applySolution();
+    ASSERT_EQ(System()->dofsNumber(), 1);
+
+    // Act
+    double joinDifference {2.0};
+    System()->addConstraintDifference(params[1],
+                                      params[2],
+                                      &joinDifference,
+                                      GCS::DefaultTemporaryConstraint);
+    System()->initSolution();
+    int joinedResult = System()->solve(false);
+    System()->applySolution();
+    std::vector<double> joinedValues = values;
+
+    System()->clearByTag(GCS::DefaultTemporaryConstraint);
+    double target {10.0};
+    System()->addConstraintEqual(params[3], &target, GCS::DefaultTemporaryConstraint);
+    System()->initSolution();
+    int movedResult = System()->solve(false);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(joinedResult, GCS::Success);
+    EXPECT_NEAR(joinedValues[0], 0.0, 1e-8);
+    EXPECT_NEAR(joinedValues[1], 1.0, 1e-8);
+    EXPECT_NEAR(joinedValues[2], 3.0, 1e-8);
+    EXPECT_NEAR(joinedValues[3], 4.0, 1e-8);
+    EXPECT_EQ(movedResult, GCS::Success);
+    EXPECT_NEAR(values[0], 0.0, 1e-8);
+    EXPECT_NEAR(values[1], 1.0, 1e-8);
+    EXPECT_NEAR(values[2], 9.0, 1e-8);
+    EXPECT_NEAR(values[3], 10.0, 1e-8);
+    EXPECT_EQ(System()->dofsNumber(), 1);
+}
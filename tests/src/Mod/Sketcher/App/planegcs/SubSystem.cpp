@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Mod/Sketcher/App/planegcs/Constraints.h"
+#include "Mod/Sketcher/App/planegcs/Geo.h"
+#include "Mod/Sketcher/App/planegcs/SubSystem.h"
+
+// The constraints of a type are evaluated in a GCS::ConstraintBlock from 16 constraints on, so
+// every batched type is added more often than that.
+constexpr int numPerType = 20;
+
+class SubSystemTest: public ::testing::Test
+{
+protected:
+    // Adds a parameter, with a value depending on its index so that no derivative is degenerate.
+    // Unknowns are listed as parameters of the subsystems, the other parameters are fixed.
+    double* newParam(bool unknown = true)
+    {
+        double index = static_cast<double>(values.size());
+        values.push_back(1.0 + 0.37 * index + std::sin(1.3 * index));
+        if (unknown) {
+            params.push_back(&values.back());
+        }
+        return &values.back();
+    }
+
+    GCS::Point newPoint()
+    {
+        double* x = newParam();
+        double* y = newParam();
+        return GCS::Point(x, y);
+    }
+
+    GCS::Line newLine()
+    {
+        GCS::Line line;
+        line.p1 = newPoint();
+        line.p2 = newPoint();
+        return line;
+    }
+
+    void addConstraint(GCS::Constraint* constr)
+    {
+        constraints.emplace_back(constr);
+        clist.push_back(constr);
+    }
+
+    // Adds numPerType constraints of each type which is evaluated in a block
+    void addConstraints()
+    {
+        for (int i = 0; i < numPerType; i++) {
+            addConstraint(new GCS::ConstraintEqual(newParam(), newParam(), 1.0 + 0.1 * i));
+            addConstraint(new GCS::ConstraintDifference(newParam(), newParam(), newParam(false)));
+
+            GCS::Point p1 = newPoint();
+            GCS::Point p2 = newPoint();
+            addConstraint(new GCS::ConstraintP2PDistance(p1, p2, newParam(false)));
+            addConstraint(new GCS::ConstraintP2PAngle(p1, p2, newParam(), 0.1 * i));
+
+            // points on both sides of the line, so that the signed area is negative for half of
+            // the constraints
+            GCS::Line line = newLine();
+            GCS::Point p0 = newPoint();
+            double side = (i % 2 == 0) ? 1.0 : -1.0;
+            *p0.x = 0.5 * (*line.p1.x + *line.p2.x) - side * (*line.p2.y - *line.p1.y);
+            *p0.y = 0.5 * (*line.p1.y + *line.p2.y) + side * (*line.p2.x - *line.p1.x);
+            addConstraint(new GCS::ConstraintP2LDistance(p0, line, newParam(false)));
+            addConstraint(new GCS::ConstraintPointOnLine(p0, line));
+
+            GCS::Line line2 = newLine();
+            addConstraint(new GCS::ConstraintParallel(line, line2));
+            addConstraint(new GCS::ConstraintPerpendicular(line, line2));
+
+            addConstraint(new GCS::ConstraintTangentCircumf(p1,
+                                                            p2,
+                                                            newParam(),
+                                                            newParam(),
+                                                            i % 2 == 0));
+        }
+
+        // one parameter in two slots of the same constraint
+        double* shared = newParam();
+        GCS::Point p1(shared, newParam());
+        GCS::Point p2(newParam(), shared);
+        addConstraint(new GCS::ConstraintP2PDistance(p1, p2, newParam(false)));
+        addConstraint(new GCS::ConstraintEqual(shared, shared, 2.0));
+    }
+
+    // Checks the jacobi matrices and the gradient of the subsystem against the derivatives and
+    // errors of the constraints evaluated one at a time
+    static void checkDerivatives(GCS::SubSystem& subsys)
+    {
+        // Arrange
+        subsys.redirectParams();
+        GCS::VEC_pD plist;
+        subsys.getParamList(plist);
+        GCS::MAP_pD_pD pmap;
+        subsys.getParamMap(pmap);
+        std::vector<GCS::Constraint*> clist;
+        subsys.getConstraintList(clist);
+        int csize = subsys.cSize();
+        int psize = subsys.pSize();
+
+        Eigen::MatrixXd expectedJacobi(csize, psize);
+        Eigen::VectorXd expectedGrad = Eigen::VectorXd::Zero(psize);
+        for (int i = 0; i < csize; i++) {
+            double error = clist[i]->error();
+            for (int j = 0; j < psize; j++) {
+                expectedJacobi(i, j) = clist[i]->grad(pmap[plist[j]]);
+                expectedGrad[j] += error * expectedJacobi(i, j);
+            }
+        }
+
+        // Act
+        Eigen::MatrixXd denseJacobi;
+        subsys.calcJacobi(denseJacobi);
+        Eigen::SparseMatrix<double> sparseJacobi;
+        subsys.calcJacobi(sparseJacobi);
+        Eigen::VectorXd grad(psize);
+        subsys.calcGrad(grad);
+        subsys.revertParams();
+
+        // Assert
+        ASSERT_EQ(denseJacobi.rows(), csize);
+        ASSERT_EQ(denseJacobi.cols(), psize);
+        ASSERT_EQ(sparseJacobi.rows(), csize);
+        ASSERT_EQ(sparseJacobi.cols(), psize);
+        Eigen::MatrixXd sparseAsDense(sparseJacobi);
+        for (int i = 0; i < csize; i++) {
+            for (int j = 0; j < psize; j++) {
+                EXPECT_NEAR(denseJacobi(i, j), expectedJacobi(i, j), 1e-12)
+                    << "constraint " << i << ", parameter " << j;
+                EXPECT_NEAR(sparseAsDense(i, j), expectedJacobi(i, j), 1e-12)
+                    << "constraint " << i << ", parameter " << j;
+            }
+        }
+        for (int j = 0; j < psize; j++) {
+            EXPECT_NEAR(grad[j], expectedGrad[j], 1e-10) << "parameter " << j;
+        }
+    }
+
+    std::deque<double> values;
+    GCS::VEC_pD params;
+    std::vector<std::unique_ptr<GCS::Constraint>> constraints;
+    std::vector<GCS::Constraint*> clist;
+};
+
+TEST_F(SubSystemTest, batchedDerivativesMatchConstraints)  // NOLINT
+{
+    // Arrange
+    addConstraints();
+
+    // Act
+    GCS::SubSystem subsys(clist, params);
+
+    // Assert
+    checkDerivatives(subsys);
+}
+
+TEST_F(SubSystemTest, batchedDerivativesMatchConstraintsWithReducedParams)  // NOLINT
+{
+    // Arrange
+    addConstraints();
+    // merge pairs of unknowns, the derivatives of slots reduced to the same unknown are summed
+    GCS::MAP_pD_pD reductionmap;
+    for (std::size_t i = 0; i + 7 < params.size(); i += 7) {
+        *params[i + 3] = *params[i];
+        reductionmap[params[i + 3]] = params[i];
+    }
+
+    // Act
+    GCS::SubSystem subsys(clist, params, reductionmap);
+
+    // Assert
+    EXPECT_LT(subsys.pSize(), static_cast<int>(params.size()));
+    checkDerivatives(subsys);
+}